@@ -7,17 +7,23 @@
 #include "Containers/ConsumeAllMpmcQueue.h"
 #include "Logging/LogMacros.h"
 #include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CountersTrace.h"
 #include "HAL/MallocAnsi.h"
 #include "HAL/PlatformMallocCrash.h"
 #include "HAL/RunnableThread.h"
+#include "HAL/ThreadManager.h"
 #include "Misc/ScopeLock.h"
 #include "Misc/CommandLine.h"
 #include "Misc/Fork.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/StringBuilder.h"
 #include "CoreGlobals.h"
 
 extern CORE_API bool GTaskGraphUseDynamicPrioritization;
 extern CORE_API float GTaskGraphOversubscriptionRatio;
 extern CORE_API bool GTaskGraphUseDynamicThreadCreation;
+extern CORE_API bool GTaskGraphUseCacheDomainAffinity;
+extern CORE_API bool GTaskGraphWorkerStats;
 
 CSV_DEFINE_CATEGORY(Scheduler, true);
 
@@ -141,9 +147,20 @@ namespace LowLevelTasks
 		return *TlsValuesHolder.TlsValues;
 	}
 
+	FCacheDomainAffinityScope::FCacheDomainAffinityScope(uint32 CacheDomain)
+		: PreviousCacheDomain(FSchedulerTls::GetTlsValuesRef().PreferredCacheDomain)
+	{
+		FSchedulerTls::GetTlsValuesRef().PreferredCacheDomain = CacheDomain;
+	}
+
+	FCacheDomainAffinityScope::~FCacheDomainAffinityScope()
+	{
+		FSchedulerTls::GetTlsValuesRef().PreferredCacheDomain = PreviousCacheDomain;
+	}
+
 	FScheduler FScheduler::Singleton;
 
-	TUniquePtr<FThread> FScheduler::CreateWorker(uint32 WorkerId, const TCHAR* Name, bool bPermitBackgroundWork, FThread::EForkable IsForkable, Private::FWaitEvent* ExternalWorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, EThreadPriority Priority, uint64 InAffinity)
+	TUniquePtr<FThread> FScheduler::CreateWorker(uint32 WorkerId, const TCHAR* Name, bool bPermitBackgroundWork, FThread::EForkable IsForkable, Private::FWaitEvent* ExternalWorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, EThreadPriority Priority, uint64 InAffinity, uint32 CacheDomain)
 	{
 		const uint32 WaitTimes[8] = { 719, 991, 1361, 1237, 1597, 953, 587, 1439 };
 		uint32 WaitTime = WaitTimes[WorkerId % 8];
@@ -158,26 +175,42 @@ namespace LowLevelTasks
 			ThreadAffinityMask = InAffinity;
 		}
 
-		const FProcessorGroupDesc& ProcessorGroups = FPlatformMisc::GetProcessorGroupDesc();
-		int32 CpuGroupCount = ProcessorGroups.NumProcessorGroups;
-		uint16 CpuGroup = 0;
-
-		//offset the first set of workers to leave space for Game, RHI and Renderthread.
-		uint64 GroupWorkerId = WorkerId + 2;
-		for (uint16 GroupIndex = 0; GroupIndex < CpuGroupCount; GroupIndex++)
+		// Workers are only pinned to a cache domain when TaskGraph.UseCacheDomainAffinity is set. Otherwise they get the legacy
+		// affinity, which is the default (unpinned) one on platforms without processor groups.
+		FThreadAffinity WorkerThreadAffinity;
+		const FProcessorTopologyDesc& Topology = FPlatformMisc::GetProcessorTopologyDesc();
+		if (GTaskGraphUseCacheDomainAffinity && CacheDomain < Topology.NumCacheDomains)
+		{
+			// Topology aware placement: pin the worker to all the cores sharing its last level cache and let the OS balance inside the domain.
+			const FProcessorCacheDomain& Domain = Topology.CacheDomains[CacheDomain];
+			const uint64 DomainAffinityMask = ThreadAffinityMask & Domain.ThreadAffinity;
+			WorkerThreadAffinity = FThreadAffinity{ DomainAffinityMask ? DomainAffinityMask : Domain.ThreadAffinity, Domain.ProcessorGroup };
+		}
+		else
 		{
-			CpuGroup = GroupIndex;
+			const FProcessorGroupDesc& ProcessorGroups = FPlatformMisc::GetProcessorGroupDesc();
+			int32 CpuGroupCount = ProcessorGroups.NumProcessorGroups;
+			uint16 CpuGroup = 0;
 
-			uint32 CpusInGroup = FMath::CountBits(ProcessorGroups.ThreadAffinities[GroupIndex]);
-			if (GroupWorkerId < CpusInGroup)
+			//offset the first set of workers to leave space for Game, RHI and Renderthread.
+			uint64 GroupWorkerId = WorkerId + 2;
+			for (uint16 GroupIndex = 0; GroupIndex < CpuGroupCount; GroupIndex++)
 			{
-				if (CpuGroup != 0) // don't pin larger groups workers to a core and leave first group as is for legacy reasons
+				CpuGroup = GroupIndex;
+
+				uint32 CpusInGroup = FMath::CountBits(ProcessorGroups.ThreadAffinities[GroupIndex]);
+				if (GroupWorkerId < CpusInGroup)
 				{
-					ThreadAffinityMask = MAX_uint64;
+					if (CpuGroup != 0) // don't pin larger groups workers to a core and leave first group as is for legacy reasons
+					{
+						ThreadAffinityMask = MAX_uint64;
+					}
+					break;
 				}
-				break;
+				GroupWorkerId -= CpusInGroup;
 			}
-			GroupWorkerId -= CpusInGroup;
+
+			WorkerThreadAffinity = FThreadAffinity{ ThreadAffinityMask & ProcessorGroups.ThreadAffinities[CpuGroup], CpuGroup };
 		}
 		
 		return MakeUnique<FThread>
@@ -186,7 +219,7 @@ namespace LowLevelTasks
 			[this, ExternalWorkerEvent, ExternalWorkerLocalQueue, WaitTime, bPermitBackgroundWork]
 			{ 
 				WorkerMain(ExternalWorkerEvent, ExternalWorkerLocalQueue, WaitTime, bPermitBackgroundWork);
-			}, 0, Priority, FThreadAffinity{ ThreadAffinityMask & ProcessorGroups.ThreadAffinities[CpuGroup], CpuGroup }, IsForkable
+			}, 0, Priority, WorkerThreadAffinity, IsForkable
 		);
 	}
 
@@ -205,6 +238,11 @@ namespace LowLevelTasks
 			GTaskGraphUseDynamicThreadCreation = Value != 0;
 		}
 
+		if (FParse::Value(FCommandLine::Get(), TEXT("TaskGraphUseCacheDomainAffinity="), Value))
+		{
+			GTaskGraphUseCacheDomainAffinity = Value != 0;
+		}
+
 		if (NumForegroundWorkers == 0 && NumBackgroundWorkers == 0)
 		{
 			NumForegroundWorkers = FMath::Max<int32>(1, FMath::Min<int32>(2, FPlatformMisc::NumberOfWorkerThreadsToSpawn() - 1));
@@ -242,6 +280,26 @@ namespace LowLevelTasks
 			const int32 MaxWorkers = MaxForegroundWorkers + MaxBackgroundWorkers;
 			const EThreadPriority ActualBackgroundPriority = GTaskGraphUseDynamicPrioritization ? WorkerPriority : BackgroundPriority;
 
+			const FProcessorTopologyDesc& Topology = FPlatformMisc::GetProcessorTopologyDesc();
+			const uint32 LocalNumCacheDomains = (GTaskGraphUseCacheDomainAffinity && Topology.NumCacheDomains > 1) ? FMath::Min<uint32>(Topology.NumCacheDomains, FSchedulerTls::FQueueRegistry::MaxCacheDomains) : 1;
+			for (uint32 DomainIndex = 0; LocalNumCacheDomains > 1 && DomainIndex < LocalNumCacheDomains; DomainIndex++)
+			{
+				for (int32 QueueIndex = 0; QueueIndex < 2; QueueIndex++)
+				{
+					// Domain queues are never freed so that late wakeups can't race with a restart. They only track parked workers,
+					// oversubscription and thread creation stay with the shared waiting queues.
+					TUniquePtr<Private::FWaitingQueue>& DomainQueue = DomainWaitingQueue[QueueIndex][DomainIndex];
+					if (!DomainQueue.IsValid())
+					{
+						DomainQueue = MakeUnique<Private::FWaitingQueue>(WorkerEvents, OversubscriptionLimitReachedEvent);
+					}
+					DomainQueue->Init(0, 0, nullptr, 0);
+				}
+			}
+			NumCacheDomains.store(LocalNumCacheDomains, std::memory_order_relaxed);
+			QueueRegistry.SetNumCacheDomains(LocalNumCacheDomains > 1 ? LocalNumCacheDomains : 0);
+			UE_CLOG(LocalNumCacheDomains > 1, LowLevelTasks, Log, TEXT("Spreading task workers over %d cache domains on %d NUMA nodes"), LocalNumCacheDomains, Topology.NumNumaNodes);
+
 			if (GameThreadLocalQueue == nullptr)
 			{
 				GameThreadLocalQueue = MakeUnique<FSchedulerTls::FLocalQueueType>(QueueRegistry, Private::ELocalQueueType::EForeground);
@@ -249,6 +307,7 @@ namespace LowLevelTasks
 			FSchedulerTls::GetTlsValuesRef().LocalQueue = GameThreadLocalQueue.Get();
 
 			WorkerEvents.SetNum(MaxWorkers);
+			WorkerStats.SetNum(MaxWorkers);
 			WorkerLocalQueues.Reserve(MaxWorkers);
 			WorkerThreads.SetNum(MaxWorkers);
 
@@ -274,9 +333,13 @@ namespace LowLevelTasks
 						WorkerName = FString::Printf(TEXT("%s Worker #%d"), Prefix, LocalCreationIndex);
 					}
 
+					// Spread workers round robin over the cache domains so that each domain gets its share of foreground and background workers
+					const uint32 LocalNumCacheDomains = NumCacheDomains.load(std::memory_order_relaxed);
+					const uint32 CacheDomain = LocalNumCacheDomains > 1 ? uint32(LocalCreationIndex) % LocalNumCacheDomains : FSchedulerTls::FQueueRegistry::InvalidCacheDomain;
+
 					uint32 WorkerId = NextWorkerId++;
 					UE::Trace::ThreadGroupBegin(ThreadGroup);
-					WorkerLocalQueues.Emplace(QueueRegistry, LocalQueueType);
+					WorkerLocalQueues.Emplace(QueueRegistry, LocalQueueType, CacheDomain);
 					WorkerEvents[WorkerId].bIsStandby = bIsStandbyWorker;
 					WorkerThreads[WorkerId] =
 						CreateWorker(
@@ -287,7 +350,8 @@ namespace LowLevelTasks
 							&WorkerEvents[WorkerId],
 							&WorkerLocalQueues[WorkerId],
 							Priority,
-							Affinity).Release();
+							Affinity,
+							CacheDomain).Release();
 
 					UE::Trace::ThreadGroupEnd();
 				};
@@ -410,6 +474,13 @@ namespace LowLevelTasks
 			WaitingQueue[0].StartShutdown();
 			WaitingQueue[1].StartShutdown();
 
+			const uint32 LocalNumCacheDomains = NumCacheDomains.load(std::memory_order_relaxed);
+			for (uint32 DomainIndex = 0; LocalNumCacheDomains > 1 && DomainIndex < LocalNumCacheDomains; DomainIndex++)
+			{
+				DomainWaitingQueue[0][DomainIndex]->StartShutdown();
+				DomainWaitingQueue[1][DomainIndex]->StartShutdown();
+			}
+
 			// We wait on threads to exit, once we're done with that
 			// it means no more threads can possibly get created.
 			for (std::atomic<FThread*>& ThreadEntry : WorkerThreads)
@@ -424,6 +495,17 @@ namespace LowLevelTasks
 			WaitingQueue[0].FinishShutdown();
 			WaitingQueue[1].FinishShutdown();
 
+			for (uint32 DomainIndex = 0; LocalNumCacheDomains > 1 && DomainIndex < LocalNumCacheDomains; DomainIndex++)
+			{
+				DomainWaitingQueue[0][DomainIndex]->FinishShutdown();
+				DomainWaitingQueue[1][DomainIndex]->FinishShutdown();
+			}
+
+			// Items hinted to a cache domain must survive a restart with a different topology setting
+			QueueRegistry.FlushCacheDomainQueues();
+			QueueRegistry.SetNumCacheDomains(0);
+			NumCacheDomains.store(1, std::memory_order_relaxed);
+
 			GameThreadLocalQueue.Reset();
 			FSchedulerTls::GetTlsValuesRef().LocalQueue = nullptr;
 
@@ -431,6 +513,7 @@ namespace LowLevelTasks
 			WorkerThreads.Reset();
 			WorkerLocalQueues.Reset();
 			WorkerEvents.Reset();
+			WorkerStats.Reset();
 
 			if (bDrainGlobalQueue)
 			{
@@ -500,6 +583,7 @@ namespace LowLevelTasks
 			const bool bIsBackgroundWorker = LocalTlsValues.IsBackgroundWorker();
 			const bool bIsStandbyWorker = LocalTlsValues.IsStandbyWorker();
 			FSchedulerTls::FLocalQueueType* const CachedLocalQueue = LocalTlsValues.LocalQueue;
+			const uint32 PreferredCacheDomain = LocalTlsValues.PreferredCacheDomain;
 
 			// Standby workers always enqueue to the global queue and perform wakeup
 			// as they can go to sleep whenever the oversubscription period is done
@@ -519,9 +603,26 @@ namespace LowLevelTasks
 				bWakeUpWorker = true; // The game thread is never pumping its local queue directly, need to always perform a wakeup.
 			}
 
-			if (CachedLocalQueue && QueuePreference != EQueuePreference::GlobalQueuePreference)
+			// A cache domain hint only redirects the task when we are not already running inside that domain
+			const bool bUseCacheDomainQueue = PreferredCacheDomain < NumCacheDomains.load(std::memory_order_relaxed)
+				&& !bIsStandbyWorker
+				&& (CachedLocalQueue == nullptr || CachedLocalQueue->GetCacheDomain() != PreferredCacheDomain);
+
+			if (bUseCacheDomainQueue)
+			{
+				QueueRegistry.EnqueueCacheDomain(&Task, uint32(Task.GetPriority()), PreferredCacheDomain);
+				bWakeUpWorker = true;
+			}
+			else if (CachedLocalQueue && QueuePreference != EQueuePreference::GlobalQueuePreference)
 			{
 				CachedLocalQueue->Enqueue(&Task, uint32(Task.GetPriority()));
+
+#if LOWLEVELTASKS_WORKER_STATS
+				if (GTaskGraphWorkerStats && LocalTlsValues.WorkerStats)
+				{
+					LocalTlsValues.WorkerStats->UpdatePeakLocalQueueDepth(CachedLocalQueue->ApproximateNum());
+				}
+#endif
 			}
 			else
 			{
@@ -556,7 +657,15 @@ namespace LowLevelTasks
 					}
 				}
 
-				if (!WakeUpWorker(bIsBackgroundTask) && !bIsBackgroundTask)
+				if (bUseCacheDomainQueue)
+				{
+					// Wake a worker of the hinted domain, other domains are only woken when all of its workers are busy
+					if (!WakeUpDomainWorker(bIsBackgroundTask, PreferredCacheDomain) && !bIsBackgroundTask)
+					{
+						WakeUpDomainWorker(true, PreferredCacheDomain);
+					}
+				}
+				else if (!WakeUpWorker(bIsBackgroundTask) && !bIsBackgroundTask)
 				{
 					WakeUpWorker(true);
 				}
@@ -598,8 +707,24 @@ namespace LowLevelTasks
 			// total number of oversubscription down and show any regressions.
 			CSV_CUSTOM_STAT(Scheduler, Oversubscription, 1, ECsvCustomStatOp::Accumulate);
 
+#if LOWLEVELTASKS_WORKER_STATS
+			if (Private::FWorkerStats* Stats = FSchedulerTls::GetTlsValuesRef().WorkerStats; Stats && GTaskGraphWorkerStats)
+			{
+				Private::FWorkerStats::Add(Stats->NumOversubscriptions, 1);
+			}
+#endif
+
 			const bool bPermitBackgroundWork = LocalWorkerType == FSchedulerTls::EWorkerType::Background;
-			WaitingQueue[bPermitBackgroundWork].IncrementOversubscription();
+			if (NumCacheDomains.load(std::memory_order_relaxed) > 1)
+			{
+				// Parked workers wait in the queues of their cache domains, prefer waking one of those over starting a standby worker
+				WaitingQueue[bPermitBackgroundWork].IncrementOversubscription(false /* bNotify */);
+				WakeUpWorker(bPermitBackgroundWork);
+			}
+			else
+			{
+				WaitingQueue[bPermitBackgroundWork].IncrementOversubscription();
+			}
 		}
 	}
 
@@ -621,6 +746,57 @@ namespace LowLevelTasks
 	}
 #endif
 
+	uint32 FScheduler::GetCurrentCacheDomain() const
+	{
+		FTlsValues& LocalTlsValues = FSchedulerTls::GetTlsValuesRef();
+		if (LocalTlsValues.ActiveScheduler == this && LocalTlsValues.LocalQueue != nullptr)
+		{
+			return LocalTlsValues.LocalQueue->GetCacheDomain();
+		}
+		return FSchedulerTls::FQueueRegistry::InvalidCacheDomain;
+	}
+
+	Private::FWaitingQueue& FScheduler::GetWorkerWaitingQueue(bool bPermitBackgroundWork, uint32 CacheDomain)
+	{
+		if (CacheDomain < NumCacheDomains.load(std::memory_order_relaxed))
+		{
+			return *DomainWaitingQueue[bPermitBackgroundWork][CacheDomain];
+		}
+		return WaitingQueue[bPermitBackgroundWork];
+	}
+
+	bool FScheduler::WakeUpDomainWorker(bool bBackgroundWorker, uint32 CacheDomain)
+	{
+		const uint32 LocalNumCacheDomains = NumCacheDomains.load(std::memory_order_relaxed);
+		if (LocalNumCacheDomains <= 1)
+		{
+			return WaitingQueue[bBackgroundWorker].Notify() != 0;
+		}
+
+		// Without a target domain start with the caller's own domain so that work stays close to the thread that launched it
+		uint32 FirstDomain = CacheDomain;
+		if (FirstDomain >= LocalNumCacheDomains)
+		{
+			FSchedulerTls::FLocalQueueType* LocalQueue = GetTlsValuesRef().LocalQueue;
+			FirstDomain = LocalQueue ? LocalQueue->GetCacheDomain() : FSchedulerTls::FQueueRegistry::InvalidCacheDomain;
+			if (FirstDomain >= LocalNumCacheDomains)
+			{
+				FirstDomain = FPlatformTLS::GetCurrentThreadId() % LocalNumCacheDomains;
+			}
+		}
+
+		for (uint32 Offset = 0; Offset < LocalNumCacheDomains; Offset++)
+		{
+			if (DomainWaitingQueue[bBackgroundWorker][(FirstDomain + Offset) % LocalNumCacheDomains]->Notify() != 0)
+			{
+				return true;
+			}
+		}
+
+		// Nobody is parked in any domain, the shared queue takes care of standby workers and dynamic thread creation
+		return WaitingQueue[bBackgroundWorker].Notify() != 0;
+	}
+
 	bool FSchedulerTls::IsWorkerThread() const
 	{
 		FTlsValues& LocalTlsValues = FSchedulerTls::GetTlsValuesRef();
@@ -633,11 +809,23 @@ namespace LowLevelTasks
 	}
 
 	template<typename QueueType, FTask* (QueueType::*DequeueFunction)(bool), bool bIsStandbyWorker>
-	bool FScheduler::TryExecuteTaskFrom(Private::FWaitEvent* WaitEvent, QueueType* Queue, Private::FOutOfWork& OutOfWork, bool bPermitBackgroundWork)
+	bool FScheduler::TryExecuteTaskFrom(Private::FWaitEvent* WaitEvent, QueueType* Queue, Private::FOutOfWork& OutOfWork, bool bPermitBackgroundWork, Private::FWorkerStats* Stats)
 	{
 		bool AnyExecuted = false;
 
 		FTask* Task = (Queue->*DequeueFunction)(bPermitBackgroundWork);
+
+#if LOWLEVELTASKS_WORKER_STATS
+		if (Stats)
+		{
+			// Anything but dequeuing from our own queue takes the task away from another thread
+			if constexpr (DequeueFunction != &QueueType::Dequeue)
+			{
+				Private::FWorkerStats::Add(Task ? Stats->NumSuccessfulSteals : Stats->NumFailedSteals, 1);
+			}
+		}
+#endif
+
 		while (Task)
 		{
 			checkSlow(FTask::ActiveTask == nullptr);
@@ -649,7 +837,7 @@ namespace LowLevelTasks
 				{
 					// CancelWait will tell us if we need to start a new worker to replace
 					// a potential wakeup we might have consumed during the cancellation.
-					if (WaitingQueue[bPermitBackgroundWork].CancelWait(WaitEvent))
+					if (GetWorkerWaitingQueue(bPermitBackgroundWork, GetTlsValuesRef().LocalQueue->GetCacheDomain()).CancelWait(WaitEvent))
 					{
 						if (!WakeUpWorker(bPermitBackgroundWork) && !GetTlsValuesRef().IsBackgroundWorker())
 						{
@@ -661,6 +849,13 @@ namespace LowLevelTasks
 
 			AnyExecuted = true;
 
+#if LOWLEVELTASKS_WORKER_STATS
+			if (Stats)
+			{
+				Private::FWorkerStats::Add(Stats->NumExecutedTasks, 1);
+			}
+#endif
+
 			// Executing a task can return a continuation.
 			if ((Task = ExecuteTask(Task)) != nullptr)
 			{
@@ -674,12 +869,14 @@ namespace LowLevelTasks
 	{
 		bool bPreparingStandby = false;
 		Private::FOutOfWork OutOfWork;
+		Private::FWorkerStats* const WorkerStatsPtr = GetTlsValuesRef().WorkerStats;
 		while (true)
 		{
+			Private::FWorkerStats* Stats = GTaskGraphWorkerStats ? WorkerStatsPtr : nullptr;
 			bool bExecutedSomething = false;
-			while (TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::StealLocal, true>(WorkerEvent, GameThreadLocalQueue.Get(), OutOfWork, bPermitBackgroundWork)
-				|| TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::Dequeue, true>(WorkerEvent, WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
-				|| TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::DequeueSteal, true>(WorkerEvent, WorkerLocalQueue, OutOfWork, bPermitBackgroundWork))
+			while (TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::StealLocal, true>(WorkerEvent, GameThreadLocalQueue.Get(), OutOfWork, bPermitBackgroundWork, Stats)
+				|| TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::Dequeue, true>(WorkerEvent, WorkerLocalQueue, OutOfWork, bPermitBackgroundWork, Stats)
+				|| TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::DequeueSteal, true>(WorkerEvent, WorkerLocalQueue, OutOfWork, bPermitBackgroundWork, Stats))
 			{
 				bPreparingStandby = false;
 				bExecutedSomething = true;
@@ -703,10 +900,27 @@ namespace LowLevelTasks
 					WaitingQueue[bPermitBackgroundWork].PrepareStandby(WorkerEvent);
 					bPreparingStandby = true;
 				}
-				else if (WaitingQueue[bPermitBackgroundWork].CommitStandby(WorkerEvent, OutOfWork))
+				else
 				{
-					// Only reset this when the commit succeeded, otherwise we're backing off the commit and looking at the queue again
-					bPreparingStandby = false;
+					uint64 WaitStartCycles = 0;
+					if (Stats)
+					{
+						// Publish what was done since the last nap before going to sleep, the worker might not wake up for a long time
+						TraceWorkerStats(*Stats, uint32(WorkerEvent - WorkerEvents.GetData()));
+						WaitStartCycles = FPlatformTime::Cycles64();
+					}
+
+					if (WaitingQueue[bPermitBackgroundWork].CommitStandby(WorkerEvent, OutOfWork))
+					{
+						// Only reset this when the commit succeeded, otherwise we're backing off the commit and looking at the queue again
+						bPreparingStandby = false;
+					}
+
+					if (Stats)
+					{
+						// Standby workers don't spin, they block right away
+						Private::FWorkerStats::Add(Stats->ParkCycles, FPlatformTime::Cycles64() - WaitStartCycles);
+					}
 				}
 			}
 		}
@@ -716,12 +930,15 @@ namespace LowLevelTasks
 	{
 		bool bPreparingWait = false;
 		Private::FOutOfWork OutOfWork;
+		Private::FWorkerStats* const WorkerStatsPtr = GetTlsValuesRef().WorkerStats;
+		Private::FWaitingQueue& WorkerWaitingQueue = GetWorkerWaitingQueue(bPermitBackgroundWork, WorkerLocalQueue->GetCacheDomain());
 		while (true)
 		{
+			Private::FWorkerStats* Stats = GTaskGraphWorkerStats ? WorkerStatsPtr : nullptr;
 			bool bExecutedSomething = false;
-			while (TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::StealLocal, false>(WorkerEvent, GameThreadLocalQueue.Get(), OutOfWork, bPermitBackgroundWork)
-				|| TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::Dequeue, false>(WorkerEvent, WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
-				|| TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::DequeueSteal, false>(WorkerEvent, WorkerLocalQueue, OutOfWork, bPermitBackgroundWork))
+			while (TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::StealLocal, false>(WorkerEvent, GameThreadLocalQueue.Get(), OutOfWork, bPermitBackgroundWork, Stats)
+				|| TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::Dequeue, false>(WorkerEvent, WorkerLocalQueue, OutOfWork, bPermitBackgroundWork, Stats)
+				|| TryExecuteTaskFrom<FSchedulerTls::FLocalQueueType, &FSchedulerTls::FLocalQueueType::DequeueSteal, false>(WorkerEvent, WorkerLocalQueue, OutOfWork, bPermitBackgroundWork, Stats))
 			{
 				bPreparingWait = false;
 				bExecutedSomething = true;
@@ -733,7 +950,7 @@ namespace LowLevelTasks
 				// Don't leave the waiting queue in a bad state
 				if (OutOfWork.Stop())
 				{
-					WaitingQueue[bPermitBackgroundWork].CancelWait(WorkerEvent);
+					WorkerWaitingQueue.CancelWait(WorkerEvent);
 				}
 				break;
 			}
@@ -743,13 +960,32 @@ namespace LowLevelTasks
 				if (!bPreparingWait)
 				{
 					OutOfWork.Start();
-					WaitingQueue[bPermitBackgroundWork].PrepareWait(WorkerEvent);
+					WorkerWaitingQueue.PrepareWait(WorkerEvent);
 					bPreparingWait = true;
 				}
-				else if (WaitingQueue[bPermitBackgroundWork].CommitWait(WorkerEvent, OutOfWork, WorkerSpinCycles, WaitCycles))
+				else
 				{
-					// Only reset this when the commit succeeded, otherwise we're backing off the commit and looking at the queue again
-					bPreparingWait = false;
+					uint64 WaitStartCycles = 0;
+					uint64 SpinCycles = 0;
+					if (Stats)
+					{
+						// Publish what was done since the last nap before going to sleep, the worker might not wake up for a long time
+						TraceWorkerStats(*Stats, uint32(WorkerEvent - WorkerEvents.GetData()));
+						WaitStartCycles = FPlatformTime::Cycles64();
+					}
+
+					if (WorkerWaitingQueue.CommitWait(WorkerEvent, OutOfWork, WorkerSpinCycles, WaitCycles, Stats ? &SpinCycles : nullptr))
+					{
+						// Only reset this when the commit succeeded, otherwise we're backing off the commit and looking at the queue again
+						bPreparingWait = false;
+					}
+
+					if (Stats)
+					{
+						const uint64 CommitCycles = FPlatformTime::Cycles64() - WaitStartCycles;
+						Private::FWorkerStats::Add(Stats->SpinCycles, SpinCycles);
+						Private::FWorkerStats::Add(Stats->ParkCycles, CommitCycles - FMath::Min(SpinCycles, CommitCycles));
+					}
 				}
 			}
 		}
@@ -770,6 +1006,9 @@ namespace LowLevelTasks
 		LocalTlsValues.WorkerType = bPermitBackgroundWork ? FSchedulerTls::EWorkerType::Background : FSchedulerTls::EWorkerType::Foreground;
 		LocalTlsValues.SetStandbyWorker(WorkerEvent->bIsStandby);
 		LocalTlsValues.LocalQueue = WorkerLocalQueue;
+#if LOWLEVELTASKS_WORKER_STATS
+		LocalTlsValues.WorkerStats = &WorkerStats[int32(WorkerEvent - WorkerEvents.GetData())];
+#endif
 
 		{
 			Private::FOversubscriptionAllowedScope _(true);
@@ -785,12 +1024,106 @@ namespace LowLevelTasks
 		}
 
 		LocalTlsValues.LocalQueue = nullptr;
+		LocalTlsValues.WorkerStats = nullptr;
 		LocalTlsValues.ActiveScheduler = nullptr;
 		LocalTlsValues.SetStandbyWorker(false);
 		LocalTlsValues.WorkerType = FSchedulerTls::EWorkerType::None;
 		FMemory::ClearAndDisableTLSCachesOnCurrentThread();
 	}
 
+	void FScheduler::TraceWorkerStats(Private::FWorkerStats& Stats, uint32 WorkerId)
+	{
+#if COUNTERSTRACE_ENABLED && LOWLEVELTASKS_WORKER_STATS
+		// Publishing is done by the worker itself right before it commits to parking, throttled so that short naps don't flood the trace.
+		// Spin and park times are therefore published with one nap of delay.
+		if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(CountersChannel))
+		{
+			return;
+		}
+
+		const uint64 NowCycles = FPlatformTime::Cycles64();
+		if (NowCycles - Stats.LastTracedCycles < FPlatformTime::SecondsToCycles64(0.001))
+		{
+			return;
+		}
+		Stats.LastTracedCycles = NowCycles;
+
+		static const TCHAR* CounterNames[] = { TEXT("ExecutedTasks"), TEXT("SuccessfulSteals"), TEXT("FailedSteals"), TEXT("Oversubscriptions"), TEXT("SpinTimeMs"), TEXT("ParkTimeMs") };
+		static_assert(UE_ARRAY_COUNT(CounterNames) == UE_ARRAY_COUNT(Stats.TraceCounterIds), "Missing a worker counter name");
+
+		for (int32 CounterIndex = 0; CounterIndex < UE_ARRAY_COUNT(CounterNames); ++CounterIndex)
+		{
+			if (Stats.TraceCounterIds[CounterIndex] == 0)
+			{
+				TStringBuilder<128> CounterName;
+				CounterName.Appendf(TEXT("Scheduler/Worker #%u/%s"), WorkerId, CounterNames[CounterIndex]);
+				Stats.TraceCounterIds[CounterIndex] = FCountersTrace::OutputInitCounter(*CounterName, TraceCounterType_Int, TraceCounterDisplayHint_None);
+			}
+		}
+
+		FCountersTrace::OutputSetValue(Stats.TraceCounterIds[0], int64(Stats.NumExecutedTasks.load(std::memory_order_relaxed)));
+		FCountersTrace::OutputSetValue(Stats.TraceCounterIds[1], int64(Stats.NumSuccessfulSteals.load(std::memory_order_relaxed)));
+		FCountersTrace::OutputSetValue(Stats.TraceCounterIds[2], int64(Stats.NumFailedSteals.load(std::memory_order_relaxed)));
+		FCountersTrace::OutputSetValue(Stats.TraceCounterIds[3], int64(Stats.NumOversubscriptions.load(std::memory_order_relaxed)));
+		FCountersTrace::OutputSetValue(Stats.TraceCounterIds[4], int64(FPlatformTime::ToMilliseconds64(Stats.SpinCycles.load(std::memory_order_relaxed))));
+		FCountersTrace::OutputSetValue(Stats.TraceCounterIds[5], int64(FPlatformTime::ToMilliseconds64(Stats.ParkCycles.load(std::memory_order_relaxed))));
+#endif
+	}
+
+	void FScheduler::DumpWorkerStats(FOutputDevice& Ar, bool bReset)
+	{
+#if LOWLEVELTASKS_WORKER_STATS
+		UE::TUniqueLock Lock(WorkerThreadsCS);
+
+		if (!GTaskGraphWorkerStats)
+		{
+			Ar.Logf(TEXT("Worker stats are not being collected, enable them with TaskGraph.WorkerStats 1"));
+			return;
+		}
+
+		Ar.Logf(TEXT("%-32s %12s %12s %12s %10s %12s %12s %10s"), TEXT("Worker"), TEXT("Executed"), TEXT("Steals"), TEXT("FailedSteals"), TEXT("Oversub"), TEXT("SpinMs"), TEXT("ParkMs"), TEXT("PeakQueue"));
+
+		Private::FWorkerStats Total;
+		uint32 TotalPeakQueueDepth = 0;
+		const int32 NumCreatedWorkers = FMath::Min<int32>(NextWorkerId.load(std::memory_order_relaxed), WorkerStats.Num());
+		for (int32 WorkerId = 0; WorkerId < NumCreatedWorkers; ++WorkerId)
+		{
+			Private::FWorkerStats& Stats = WorkerStats[WorkerId];
+			const FThread* Thread = WorkerThreads[WorkerId].load(std::memory_order_relaxed);
+			const uint64 NumExecutedTasks = Stats.NumExecutedTasks.load(std::memory_order_relaxed);
+			const uint64 NumSuccessfulSteals = Stats.NumSuccessfulSteals.load(std::memory_order_relaxed);
+			const uint64 NumFailedSteals = Stats.NumFailedSteals.load(std::memory_order_relaxed);
+			const uint64 NumOversubscriptions = Stats.NumOversubscriptions.load(std::memory_order_relaxed);
+			const uint64 SpinCycles = Stats.SpinCycles.load(std::memory_order_relaxed);
+			const uint64 ParkCycles = Stats.ParkCycles.load(std::memory_order_relaxed);
+			const uint32 PeakLocalQueueDepth = Stats.PeakLocalQueueDepth.load(std::memory_order_relaxed);
+
+			Ar.Logf(TEXT("%-32s %12" UINT64_FMT " %12" UINT64_FMT " %12" UINT64_FMT " %10" UINT64_FMT " %12.2f %12.2f %10u"),
+				Thread ? *FThreadManager::GetThreadName(Thread->GetThreadId()) : TEXT("<exited>"),
+				NumExecutedTasks, NumSuccessfulSteals, NumFailedSteals, NumOversubscriptions, FPlatformTime::ToMilliseconds64(SpinCycles), FPlatformTime::ToMilliseconds64(ParkCycles), PeakLocalQueueDepth);
+
+			Private::FWorkerStats::Add(Total.NumExecutedTasks, NumExecutedTasks);
+			Private::FWorkerStats::Add(Total.NumSuccessfulSteals, NumSuccessfulSteals);
+			Private::FWorkerStats::Add(Total.NumFailedSteals, NumFailedSteals);
+			Private::FWorkerStats::Add(Total.NumOversubscriptions, NumOversubscriptions);
+			Private::FWorkerStats::Add(Total.SpinCycles, SpinCycles);
+			Private::FWorkerStats::Add(Total.ParkCycles, ParkCycles);
+			TotalPeakQueueDepth = FMath::Max(TotalPeakQueueDepth, PeakLocalQueueDepth);
+
+			if (bReset)
+			{
+				Stats.Reset();
+			}
+		}
+
+		Ar.Logf(TEXT("%-32s %12" UINT64_FMT " %12" UINT64_FMT " %12" UINT64_FMT " %10" UINT64_FMT " %12.2f %12.2f %10u"), TEXT("Total"),
+			Total.NumExecutedTasks.load(), Total.NumSuccessfulSteals.load(), Total.NumFailedSteals.load(), Total.NumOversubscriptions.load(),
+			FPlatformTime::ToMilliseconds64(Total.SpinCycles.load()), FPlatformTime::ToMilliseconds64(Total.ParkCycles.load()), TotalPeakQueueDepth);
+#else
+		Ar.Logf(TEXT("Worker stats are compiled out (LOWLEVELTASKS_WORKER_STATS=0)"));
+#endif
+	}
+
 	void FScheduler::BusyWaitInternal(const FConditional& Conditional, bool ForceAllowBackgroundWork)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(FScheduler::BusyWaitInternal);
@@ -9,6 +9,7 @@
 #include "Experimental/Coroutine/CoroEvent.h"
 #include "Experimental/Coroutine/CoroParallelFor.h"
 #include "Experimental/Coroutine/CoroSpinLock.h"
+#include "Experimental/Coroutine/CoroTasks.h"
 #include "Experimental/Coroutine/CoroTimeout.h"
 
 #include <atomic>
@@ -794,6 +795,23 @@ namespace Tasks2Tests
 
 			CoroParallelFor(TEXT("CoroTimeoutForTest"), 100, WorkLambda, EParallelForFlags::None);
 		}
+		{
+			UE::Tasks::FTaskEvent Prerequisite(UE_SOURCE_LOCATION);
+			std::atomic<bool> bResumed = false;
+			auto WorkLambda = [&]() -> CORO_TASK(void)
+			{
+				CO_AWAIT CoroAwaitTasks(UE::Tasks::Prerequisites(Prerequisite));
+				bResumed = true;
+				CO_RETURN_TASK();
+			};
+
+			UE::Tasks::FTask Task = LaunchCoroAsTask(TEXT("CoroAwaitTasksTest"), WorkLambda());
+			FPlatformProcess::Sleep(0.001f);
+			verify(!bResumed && !Task.IsCompleted());
+			Prerequisite.Trigger();
+			Task.Wait();
+			verify(bResumed);
+		}
 #endif
 		return true;
 	}
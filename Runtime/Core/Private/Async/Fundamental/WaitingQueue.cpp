@@ -196,7 +196,7 @@ void FWaitingQueue::CheckStandbyState(uint64 InState)
 #endif
 }
 
-bool FWaitingQueue::CommitWait(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycles, int32 WaitCycles)
+bool FWaitingQueue::CommitWait(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycles, int32 WaitCycles, uint64* OutSpinCycles)
 {
 	using namespace WaitingQueueImpl;
 
@@ -248,7 +248,7 @@ bool FWaitingQueue::CommitWait(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 Sp
 		}
 	}
 
-	Park(Node, OutOfWork, SpinCycles, WaitCycles);
+	Park(Node, OutOfWork, SpinCycles, WaitCycles, OutSpinCycles);
 	return true;
 }
 
@@ -405,7 +405,7 @@ bool FWaitingQueue::CommitStandby(FWaitEvent* Node, FOutOfWork& OutOfWork)
 	return true;
 }
 
-void FWaitingQueue::IncrementOversubscription()
+void FWaitingQueue::IncrementOversubscription(bool bNotify)
 {
 	using namespace WaitingQueueImpl;
 
@@ -421,7 +421,10 @@ void FWaitingQueue::IncrementOversubscription()
 	// Notify -> TryStartNewThread takes care of updating StandbyState for us, but only
 	// when standby threads are actually needed.
 
-	Notify();
+	if (bNotify)
+	{
+		Notify();
+	}
 }
 
 void FWaitingQueue::DecrementOversubscription()
@@ -581,7 +584,7 @@ int32 FWaitingQueue::NotifyInternal(int32 Count)
 	return Notifications;
 }
 
-void FWaitingQueue::Park(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycles, int32 WaitCycles)
+void FWaitingQueue::Park(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycles, int32 WaitCycles, uint64* OutSpinCycles)
 {
 	using namespace WaitingQueueImpl;
 
@@ -594,6 +597,14 @@ void FWaitingQueue::Park(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycl
 			// since we're giving the other threads a final chance to wake us with an 
 			// atomic only instead of a more costly kernel call.
 			WAITINGQUEUE_EVENT_SCOPE(FWaitingQueue_Park_Spin);
+			const uint64 SpinStartCycles = OutSpinCycles ? FPlatformTime::Cycles64() : 0;
+			ON_SCOPE_EXIT
+			{
+				if (OutSpinCycles)
+				{
+					*OutSpinCycles += FPlatformTime::Cycles64() - SpinStartCycles;
+				}
+			};
 			for (int Spin = 0; Spin < SpinCycles; ++Spin)
 			{
 				if (Node->State.load(std::memory_order_relaxed) == EWaitState::NotSignaled)
@@ -126,6 +126,34 @@ static FAutoConsoleVariableRef CVarTaskDynamicThreadCreation(
 	ECVF_ReadOnly
 );
 
+CORE_API bool GTaskGraphUseCacheDomainAffinity = false;
+static FAutoConsoleVariableRef CVarTaskCacheDomainAffinity(
+	TEXT("TaskGraph.UseCacheDomainAffinity"),
+	GTaskGraphUseCacheDomainAffinity,
+	TEXT("Pin workers to the last level cache domains and NUMA nodes of the machine and prefer stealing work from the same domain.\n")
+	TEXT("Helps on multi-socket and chiplet based CPUs where stealing across domains is expensive. Requires the scheduler to be restarted to have an affect."),
+	ECVF_ReadOnly
+);
+
+CORE_API bool GTaskGraphWorkerStats = false;
+static FAutoConsoleVariableRef CVarTaskGraphWorkerStats(
+	TEXT("TaskGraph.WorkerStats"),
+	GTaskGraphWorkerStats,
+	TEXT("Collect per-worker counters (executed tasks, steals, spin and park time in the waiting queue, oversubscription, peak local queue depth).\n")
+	TEXT("They are published to the Counters trace channel and can be printed with TaskGraph.DumpWorkerStats.")
+);
+
+static FAutoConsoleCommandWithOutputDevice CVarTaskGraphDumpWorkerStats(
+	TEXT("TaskGraph.DumpWorkerStats"),
+	TEXT("Prints the per-worker counters collected while TaskGraph.WorkerStats is enabled and resets them."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(
+		[](FOutputDevice& Ar)
+		{
+			LowLevelTasks::FScheduler::Get().DumpWorkerStats(Ar, true /* bReset */);
+		}
+	)
+);
+
 UE_DEPRECATED(5.5, "This variable is no longer used and will be removed.")
 CORE_API int32 GUseNewTaskBackend = 1;
 CORE_API int32 GNumForegroundWorkers = 2;
@@ -1696,6 +1696,28 @@ const FProcessorGroupDesc& FGenericPlatformMisc::GetProcessorGroupDesc()
 	return Desc;
 }
 
+static FProcessorTopologyDesc InternalGetProcessorTopologyDesc()
+{
+	const FProcessorGroupDesc& GroupDesc = FPlatformMisc::GetProcessorGroupDesc();
+
+	FProcessorTopologyDesc Desc;
+	Desc.NumNumaNodes = 1;
+	for (uint16 GroupIndex = 0; GroupIndex < GroupDesc.NumProcessorGroups && Desc.NumCacheDomains < FProcessorTopologyDesc::MaxNumCacheDomains; GroupIndex++)
+	{
+		FProcessorCacheDomain& Domain = Desc.CacheDomains[Desc.NumCacheDomains++];
+		Domain.ThreadAffinity = GroupDesc.ThreadAffinities[GroupIndex];
+		Domain.ProcessorGroup = GroupIndex;
+		Domain.NumaNode = 0;
+	}
+	return Desc;
+}
+
+const FProcessorTopologyDesc& FGenericPlatformMisc::GetProcessorTopologyDesc()
+{
+	static FProcessorTopologyDesc Desc = InternalGetProcessorTopologyDesc();
+	return Desc;
+}
+
 int32 FGenericPlatformMisc::NumberOfWorkerThreadsToSpawn()
 {
 	static int32 MaxGameThreads = 4;
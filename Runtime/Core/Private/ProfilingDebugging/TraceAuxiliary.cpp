@@ -747,7 +747,16 @@ bool FTraceAuxiliaryImpl::WriteToFile(const TCHAR* Path, const FTraceAuxiliary::
 		return false;
 	}
 
-	if (!UE::Trace::WriteTo(*NativePath, SendFlags))
+	// Files can be written through memory mapped segments instead, see UE::Trace::WriteToMapped()
+	uint32 MappedSegmentSizeMb = 0;
+	uint64 MappedMaxSizeMb = 0;
+	const bool bWriteMapped = FParse::Value(FCommandLine::Get(), TEXT("-tracemappedsegmentmb="), MappedSegmentSizeMb) && MappedSegmentSizeMb > 0;
+	FParse::Value(FCommandLine::Get(), TEXT("-tracemappedmaxmb="), MappedMaxSizeMb);
+
+	const bool bWriting = bWriteMapped
+		? UE::Trace::WriteToMapped(*NativePath, MappedSegmentSizeMb << 20, MappedMaxSizeMb << 20, SendFlags)
+		: UE::Trace::WriteTo(*NativePath, SendFlags);
+	if (!bWriting)
 	{
 		if (FPathViews::Equals(NativePath, FStringView(Path)))
 		{
@@ -1927,6 +1936,9 @@ void FTraceAuxiliary::Initialize(const TCHAR* CommandLine)
 		Desc.TailSizeBytes <<= 20;
 	}
 
+	// Threads that LZ4 encode trace blocks alongside the trace worker thread
+	FParse::Value(CommandLine, TEXT("-traceencodelanes="), Desc.EncodeLaneCount);
+
 	// Memory tracing is very chatty. To reduce load on trace we'll speed up the
 	// worker thread so it can clear events faster.
 	extern bool MemoryTrace_IsActive();
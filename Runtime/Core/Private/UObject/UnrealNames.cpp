@@ -16,6 +16,7 @@
 #include "Misc/StringBuilder.h"
 #include "Misc/TransactionallySafeRWLock.h"
 #include "Containers/UnrealString.h"
+#include "Containers/AnsiString.h"
 #include "Containers/Utf8String.h"
 #include "UObject/NameTypes.h"
 #include "Logging/LogMacros.h"
@@ -46,6 +47,11 @@
 #define USE_FNAME_MMAP 0
 #endif
 
+// Look up existing names without taking the shard lock, falling back to it while the slot table is regrown
+#ifndef UE_FNAME_LOCK_FREE_FIND
+#define UE_FNAME_LOCK_FREE_FIND 1
+#endif
+
 #if USE_FNAME_MMAP
 #include <sys/mman.h>
 #if PLATFORM_ANDROID
@@ -498,6 +504,20 @@ struct FNameSlot
 	bool operator==(FNameSlot Rhs) const { return IdAndHash == Rhs.IdAndHash; }
 
 	bool Used() const { return !!IdAndHash;  }
+
+	// Slots in a live table are read without the shard lock, so the entry a slot points to
+	// must be visible before the slot is
+	FNameSlot LoadAcquire() const
+	{
+		FNameSlot Out;
+		Out.IdAndHash = static_cast<uint32>(FPlatformAtomics::AtomicRead(reinterpret_cast<volatile const int32*>(&IdAndHash)));
+		return Out;
+	}
+
+	void StoreRelease(FNameSlot Value)
+	{
+		FPlatformAtomics::AtomicStore(reinterpret_cast<volatile int32*>(&IdAndHash), static_cast<int32>(Value.IdAndHash));
+	}
 private:
 	uint32 IdAndHash = 0;
 };
@@ -1186,24 +1206,30 @@ public:
 		UE_TRACE_METADATA_CLEAR_SCOPE();
 		Entries = &InEntries;
 
-		Slots = (FNameSlot*)FMemory::Malloc(FNamePoolInitialSlotsPerShard * sizeof(FNameSlot), alignof(FNameSlot));
-		memset(Slots, 0, FNamePoolInitialSlotsPerShard * sizeof(FNameSlot));
-		CapacityMask = FNamePoolInitialSlotsPerShard - 1;
+		FNameSlot* InitialSlots = (FNameSlot*)FMemory::Malloc(FNamePoolInitialSlotsPerShard * sizeof(FNameSlot), alignof(FNameSlot));
+		memset(InitialSlots, 0, FNamePoolInitialSlotsPerShard * sizeof(FNameSlot));
+		Slots.store(InitialSlots, std::memory_order_relaxed);
+		CapacityMask.store(FNamePoolInitialSlotsPerShard - 1, std::memory_order_relaxed);
 	}
 
 	// This and ~FNamePool() is not called during normal shutdown
 	// but only via explicit FName::TearDown() call
 	~FNamePoolShardBase()
 	{
-		FMemory::Free(Slots);
+		FMemory::Free(GetSlots());
+		for (FNameSlot* Retired : RetiredSlots)
+		{
+			FMemory::Free(Retired);
+		}
+		RetiredSlots.Empty();
 		UsedSlots = 0;
-		CapacityMask = 0;
-		Slots = nullptr;
+		CapacityMask.store(0, std::memory_order_relaxed);
+		Slots.store(nullptr, std::memory_order_relaxed);
 		NumCreatedEntries = 0;
 		NumCreatedWideEntries = 0;
 	}
 
-	uint32 Capacity() const	{ return CapacityMask + 1; }
+	uint32 Capacity() const	{ return GetCapacityMask() + 1; }
 	uint32 NumCreated() const { return NumCreatedEntries.load(std::memory_order_relaxed); }
 	uint32 NumCreatedWide() const { return NumCreatedWideEntries.load(std::memory_order_relaxed); }
 	uint32 NumCreatedWithNumber() const { return NumCreatedWithNumberEntries.load(std::memory_order_relaxed); }
@@ -1213,13 +1239,31 @@ protected:
 
 	mutable FRWLock Lock;
 	uint32 UsedSlots = 0;
-	uint32 CapacityMask = 0;
-	FNameSlot* Slots = nullptr;
+	// Atomic as lock-free readers load them while Grow() replaces them, see TryProbeLockFree()
+	std::atomic<uint32> CapacityMask{0};
+	std::atomic<FNameSlot*> Slots{nullptr};
 	FNameEntryAllocator* Entries = nullptr;
 	std::atomic<uint32> NumCreatedEntries{0};
 	std::atomic<uint32> NumCreatedWideEntries{0};
 	std::atomic<uint32> NumCreatedWithNumberEntries{0};
 
+	// Odd while Grow() replaces Slots and CapacityMask, lets lock-free readers detect a torn snapshot
+	std::atomic<uint32> SlotsVersion{0};
+	// Tables replaced by Grow() are kept alive since lock-free readers may still be probing them.
+	// Capacity doubles so these never add up to more than the live table.
+	TArray<FNameSlot*> RetiredSlots;
+
+	/** Where a lock-free probe stopped, lets the locked probe after a miss resume there instead of probing the name again */
+	struct FLockFreeProbe
+	{
+		FNameSlot Slot;
+		uint32 SlotIndex = 0;
+		uint32 Version = 0;
+	};
+
+	// Relaxed is enough for code holding the lock, which Grow() also holds
+	FNameSlot* GetSlots() const { return Slots.load(std::memory_order_relaxed); }
+	uint32 GetCapacityMask() const { return CapacityMask.load(std::memory_order_relaxed); }
 
 	template<ENameCase Sensitivity>
 	FORCEINLINE static bool EntryEqualsValue(const FNameEntry& Entry, const FNameValue<Sensitivity>& Value)
@@ -1280,7 +1324,7 @@ public:
 
 		for (uint32 i = 0; i < Capacity(); ++i)
 		{
-			FNameSlot& Slot = Slots[i];
+			FNameSlot& Slot = GetSlots()[i];
 			if (!Slot.Used()) 
 			{
 				continue; 
@@ -1292,7 +1336,7 @@ public:
 			if (RehashNameWithNumber(Entry, Value))
 			{
 				CountByUnmaskedIndex.FindOrAdd(Value.Hash.UnmaskedSlotIndex)++;
-				CountByMaskedIndex.FindOrAdd(FNameHash::GetProbeStart(Value.Hash.UnmaskedSlotIndex, CapacityMask))++;
+				CountByMaskedIndex.FindOrAdd(FNameHash::GetProbeStart(Value.Hash.UnmaskedSlotIndex, GetCapacityMask()))++;
 				CountBySlotProbeHash.FindOrAdd(Value.Hash.SlotProbeHash)++;
 			}
 			else
@@ -1302,7 +1346,7 @@ public:
 				FNameStringView Name = Entry.MakeView(DecodeBuffer);
 				FNameHash Hash = HashName<Sensitivity>(Name);
 				CountByUnmaskedIndex.FindOrAdd(Hash.UnmaskedSlotIndex)++;
-				CountByMaskedIndex.FindOrAdd(FNameHash::GetProbeStart(Hash.UnmaskedSlotIndex, CapacityMask))++;
+				CountByMaskedIndex.FindOrAdd(FNameHash::GetProbeStart(Hash.UnmaskedSlotIndex, GetCapacityMask()))++;
 				CountBySlotProbeHash.FindOrAdd(Hash.SlotProbeHash)++;
 			}
 		}
@@ -1354,9 +1398,17 @@ public:
 		FNameEntryId Result;
 		UE_AUTORTFM_OPEN
 		{
-			FRWScopeLock _(Lock, FRWScopeLockType::SLT_ReadOnly);
-
-			FNameSlot& Slot = Probe(Value);
+			FLockFreeProbe LockFree;
+			FNameSlot Slot;
+			if (TryProbeLockFree(Value, LockFree))
+			{
+				Slot = LockFree.Slot;
+			}
+			else
+			{
+				FRWScopeLock _(Lock, FRWScopeLockType::SLT_ReadOnly);
+				Slot = Probe(Value);
+			}
 			Result = Slot.GetId();
 		};
 		return Result;
@@ -1365,8 +1417,16 @@ public:
 	template<class ScopeLock = FWriteScopeLock>
 	FORCEINLINE FNameEntryId Insert(const FNameValue<Sensitivity>& Value, bool& bCreatedNewEntry)
 	{
+		// Most names already exist, only take the write lock to create new ones
+		FLockFreeProbe Existing;
+		const bool bProbedLockFree = std::is_same_v<ScopeLock, FWriteScopeLock> && TryProbeLockFree(Value, Existing);
+		if (bProbedLockFree && Existing.Slot.Used())
+		{
+			return Existing.Slot.GetId();
+		}
+
 		ScopeLock _(Lock);
-		FNameSlot& Slot = Probe(Value);
+		FNameSlot& Slot = Probe(Value, bProbedLockFree ? &Existing : nullptr);
 
 		if (Slot.Used())
 		{
@@ -1385,17 +1445,28 @@ public:
 #if UE_FNAME_OUTLINE_NUMBER
 	FNameEntryId FindWithNumber(const FNumberedNameValue<Sensitivity>& Value) const
 	{
-		FRWScopeLock _(Lock, FRWScopeLockType::SLT_ReadOnly);
+		FLockFreeProbe LockFree;
+		if (TryProbeWithNumberLockFree(Value, LockFree))
+		{
+			return LockFree.Slot.GetId();
+		}
 
-		FNameSlot& Slot = ProbeWithNumber(Value);
-		return Slot.GetId();
+		FRWScopeLock _(Lock, FRWScopeLockType::SLT_ReadOnly);
+		return ProbeWithNumber(Value).GetId();
 	}
 
 	template<class ScopeLock = FWriteScopeLock>
 	FNameEntryId InsertWithNumber(const FNumberedNameValue<Sensitivity>& Value, bool& bCreatedNewEntry)
 	{
+		FLockFreeProbe Existing;
+		const bool bProbedLockFree = std::is_same_v<ScopeLock, FWriteScopeLock> && TryProbeWithNumberLockFree(Value, Existing);
+		if (bProbedLockFree && Existing.Slot.Used())
+		{
+			return Existing.Slot.GetId();
+		}
+
 		ScopeLock _(Lock);
-		FNameSlot& Slot = ProbeWithNumber(Value);
+		FNameSlot& Slot = ProbeWithNumber(Value, bProbedLockFree ? &Existing : nullptr);
 
 		if (Slot.Used())
 		{
@@ -1420,9 +1491,16 @@ private:
 	{
 		FNameSlot NewLookup(ExistingId, Hash.SlotProbeHash);
 
+		FLockFreeProbe Existing;
+		const bool bProbedLockFree = std::is_same_v<ShardScopeLock, FWriteScopeLock> && TryProbeLockFree(Hash.UnmaskedSlotIndex, [=](FNameSlot Old) { return Old == NewLookup; }, Existing);
+		if (bProbedLockFree && Existing.Slot.Used())
+		{
+			return;
+		}
+
 		ShardScopeLock _(Lock);
 		 
-		FNameSlot& Slot = Probe(Hash.UnmaskedSlotIndex, [=](FNameSlot Old) { return Old == NewLookup; });
+		FNameSlot& Slot = Probe(Hash.UnmaskedSlotIndex, [=](FNameSlot Old) { return Old == NewLookup; }, bProbedLockFree ? &Existing : nullptr);
 		if (!Slot.Used())
 		{
 			ClaimSlot(Slot, NewLookup);
@@ -1542,7 +1620,7 @@ private:
 	{
 		checkSlow(!UnusedSlot.Used());
 
-		UnusedSlot = NewValue;
+		UnusedSlot.StoreRelease(NewValue);
 
 		++UsedSlots;
 		if (UsedSlots * LoadFactorDivisor > LoadFactorQuotient * Capacity())
@@ -1591,13 +1669,19 @@ private:
 		LLM_TAGSET_SCOPE_CLEAR(ELLMTagSet::AssetClasses);
 #endif // LLM_ALLOW_ASSETS_TAGS
 		UE_TRACE_METADATA_CLEAR_SCOPE();
-		TArrayView<FNameSlot> OldSlots(Slots, Capacity());
+		TArrayView<FNameSlot> OldSlots(GetSlots(), Capacity());
 		const uint32 OldUsedSlots = UsedSlots;
 
-		Slots = (FNameSlot*)FMemory::Malloc(NewCapacity * sizeof(FNameSlot), alignof(FNameSlot));
-		memset(Slots, 0, NewCapacity * sizeof(FNameSlot));
+		// Make lock-free readers that snapshot Slots and CapacityMask from here on fall back to the lock
+		const uint32 OldVersion = SlotsVersion.load(std::memory_order_relaxed);
+		SlotsVersion.store(OldVersion + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		FNameSlot* NewSlots = (FNameSlot*)FMemory::Malloc(NewCapacity * sizeof(FNameSlot), alignof(FNameSlot));
+		memset(NewSlots, 0, NewCapacity * sizeof(FNameSlot));
 		UsedSlots = 0;
-		CapacityMask = NewCapacity - 1;
+		Slots.store(NewSlots, std::memory_order_relaxed);
+		CapacityMask.store(NewCapacity - 1, std::memory_order_relaxed);
 
 		// Prefetch FNameEntry* before rehashing. Yielded 2.4x rehash speedup on a Gen5 console.
 		constexpr uint32 PrefetchDepth = 8;
@@ -1631,14 +1715,20 @@ private:
 
 		check(OldUsedSlots == UsedSlots);
 
+		SlotsVersion.store(OldVersion + 2, std::memory_order_release);
+
+#if UE_FNAME_LOCK_FREE_FIND
+		RetiredSlots.Add(OldSlots.GetData());
+#else
 		FMemory::Free(OldSlots.GetData());
+#endif
 	}
 
 	void ProbePrefetch(const FNameValue<Sensitivity>& Value) const
 	{
 		// Prefetch name data and FNameSlot*
 		FPlatformMisc::Prefetch(Value.Name.Data);
-		FPlatformMisc::Prefetch(Slots + FNameHash::GetProbeStart(Value.Hash.UnmaskedSlotIndex, CapacityMask));
+		FPlatformMisc::Prefetch(GetSlots() + FNameHash::GetProbeStart(Value.Hash.UnmaskedSlotIndex, GetCapacityMask()));
 		
 		// Prefetching the FNameEntry* might help, but it involves waiting for FNameSlot* 
 		// and potentially a branch if we don't want to prefetch null pointers for unused slots.
@@ -1647,21 +1737,34 @@ private:
 	}
 
 	/** Find slot containing value or the first free slot that should be used to store it  */
-	FORCEINLINE FNameSlot& Probe(const FNameValue<Sensitivity>& Value) const
+	FORCEINLINE FNameSlot& Probe(const FNameValue<Sensitivity>& Value, const FLockFreeProbe* LockFreeMiss = nullptr) const
 	{
 		return Probe(Value.Hash.UnmaskedSlotIndex, 
 			[&](FNameSlot Slot)	{ return Slot.GetProbeHash() == Value.Hash.SlotProbeHash && 
-									EntryEqualsValue<Sensitivity>(Entries->Resolve(Slot.GetId()), Value); });
+									EntryEqualsValue<Sensitivity>(Entries->Resolve(Slot.GetId()), Value); },
+			LockFreeMiss);
 	}
 
-	/** Find slot that fulfills predicate or the first free slot  */
+	/**
+	 * Find slot that fulfills predicate or the first free slot.
+	 *
+	 * LockFreeMiss is a lock-free probe for the same predicate that found a free slot. If the table hasn't been
+	 * replaced since, the slots before it are still used by other names and probing resumes at the free slot.
+	 */
 	template<class PredicateFn>
-	FORCEINLINE FNameSlot& Probe(uint32 UnmaskedSlotIndex, PredicateFn Predicate) const
+	FORCEINLINE FNameSlot& Probe(uint32 UnmaskedSlotIndex, PredicateFn Predicate, const FLockFreeProbe* LockFreeMiss = nullptr) const
 	{
-		const uint32 Mask = CapacityMask;
-		for (uint32 I = FNameHash::GetProbeStart(UnmaskedSlotIndex, Mask); true; I = (I + 1) & Mask)
+		const uint32 Mask = GetCapacityMask();
+		FNameSlot* ProbeSlots = GetSlots();
+		uint32 Start = FNameHash::GetProbeStart(UnmaskedSlotIndex, Mask);
+		if (LockFreeMiss && LockFreeMiss->Version == SlotsVersion.load(std::memory_order_relaxed))
+		{
+			Start = LockFreeMiss->SlotIndex;
+		}
+
+		for (uint32 I = Start; true; I = (I + 1) & Mask)
 		{
-			FNameSlot& Slot = Slots[I];
+			FNameSlot& Slot = ProbeSlots[I];
 			if (!Slot.Used() || Predicate(Slot))
 			{
 				return Slot;
@@ -1671,14 +1774,69 @@ private:
 
 #if UE_FNAME_OUTLINE_NUMBER
 	/** Find slot containing value or the first free slot that should be used to store it  */
-	FORCEINLINE FNameSlot& ProbeWithNumber(const FNumberedNameValue<Sensitivity>& Value) const
+	FORCEINLINE FNameSlot& ProbeWithNumber(const FNumberedNameValue<Sensitivity>& Value, const FLockFreeProbe* LockFreeMiss = nullptr) const
 	{
 		return Probe(Value.Hash.UnmaskedSlotIndex,
 			[&](FNameSlot Slot) { return Slot.GetProbeHash() == Value.Hash.SlotProbeHash &&
-			EntryEqualsValue(Entries->Resolve(Slot.GetId()), Value); });
+			EntryEqualsValue(Entries->Resolve(Slot.GetId()), Value); },
+			LockFreeMiss);
+	}
+#endif // UE_FNAME_OUTLINE_NUMBER
+
+	FORCEINLINE bool TryProbeLockFree(const FNameValue<Sensitivity>& Value, FLockFreeProbe& Out) const
+	{
+		return TryProbeLockFree(Value.Hash.UnmaskedSlotIndex,
+			[&](FNameSlot Slot)	{ return Slot.GetProbeHash() == Value.Hash.SlotProbeHash && 
+									EntryEqualsValue<Sensitivity>(Entries->Resolve(Slot.GetId()), Value); },
+			Out);
+	}
+
+#if UE_FNAME_OUTLINE_NUMBER
+	FORCEINLINE bool TryProbeWithNumberLockFree(const FNumberedNameValue<Sensitivity>& Value, FLockFreeProbe& Out) const
+	{
+		return TryProbeLockFree(Value.Hash.UnmaskedSlotIndex,
+			[&](FNameSlot Slot) { return Slot.GetProbeHash() == Value.Hash.SlotProbeHash &&
+			EntryEqualsValue(Entries->Resolve(Slot.GetId()), Value); },
+			Out);
 	}
 #endif // UE_FNAME_OUTLINE_NUMBER
 
+	/**
+	 * Find slot that fulfills predicate or the first free slot without taking the lock.
+	 *
+	 * Works like a seqlock: fails if Grow() is replacing the table, in which case the caller takes the lock.
+	 * Slots are only ever claimed and Grow() does not free tables, so a probe of a valid snapshot
+	 * finds every name inserted before the lookup began. Names inserted concurrently may be missed.
+	 */
+	template<class PredicateFn>
+	FORCEINLINE bool TryProbeLockFree(uint32 UnmaskedSlotIndex, PredicateFn Predicate, FLockFreeProbe& Out) const
+	{
+#if UE_FNAME_LOCK_FREE_FIND
+		const uint32 Version = SlotsVersion.load(std::memory_order_acquire);
+		const FNameSlot* SnapshotSlots = Slots.load(std::memory_order_relaxed);
+		const uint32 SnapshotMask = CapacityMask.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if ((Version & 1) || Version != SlotsVersion.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		for (uint32 I = FNameHash::GetProbeStart(UnmaskedSlotIndex, SnapshotMask); true; I = (I + 1) & SnapshotMask)
+		{
+			const FNameSlot Slot = SnapshotSlots[I].LoadAcquire();
+			if (!Slot.Used() || Predicate(Slot))
+			{
+				Out.Slot = Slot;
+				Out.SlotIndex = I;
+				Out.Version = Version;
+				return true;
+			}
+		}
+#else
+		return false;
+#endif
+	}
+
 	FORCENOINLINE // Doesn't impact performance and makes sampling profiles more informative
 	void RehashAndInsert(FNameSlot OldSlot)
 	{
@@ -5382,6 +5540,137 @@ TFunction<TArray<FDisplayNameEntryId>()> LoadNameBatchAsync(FArchive& Ar, uint32
 }
 
 
+// Narrows pure ANSI wide strings the same way FNameHelper::MakeWithNumber does
+static FNameStringView MakeBatchNameView(const ANSICHAR* Str, int32 Len, ANSICHAR*& NarrowIt)
+{
+	return FNameStringView(Str, Len);
+}
+
+static FNameStringView MakeBatchNameView(const WIDECHAR* Str, int32 Len, ANSICHAR*& NarrowIt)
+{
+	if (IsWide(Str, Len))
+	{
+		return FNameStringView(Str, Len);
+	}
+
+	ANSICHAR* Narrowed = NarrowIt;
+	for (int32 I = 0; I < Len; ++I)
+	{
+		Narrowed[I] = static_cast<ANSICHAR>(Str[I]);
+	}
+	NarrowIt += Len;
+	return FNameStringView(Narrowed, Len);
+}
+
+template<typename CharType>
+static void CreateNameBatchImpl(TArrayView<const TStringView<CharType>> Strings, TArrayView<FName> OutNames)
+{
+	check(Strings.Num() == OutNames.Num());
+	const int32 Num = Strings.Num();
+
+	// Sorting by shard doesn't pay off for small batches
+	if (Num < static_cast<int32>(FNamePoolShards))
+	{
+		for (int32 Idx = 0; Idx < Num; ++Idx)
+		{
+			OutNames[Idx] = FName(Strings[Idx].Len(), Strings[Idx].GetData());
+		}
+		return;
+	}
+
+	// Narrowed strings are referenced until the batch is stored, size the buffer up front so it never moves
+	TArray<ANSICHAR> NarrowedStrings;
+	if constexpr (sizeof(CharType) != sizeof(ANSICHAR))
+	{
+		int32 NumChars = 0;
+		for (TStringView<CharType> String : Strings)
+		{
+			NumChars += String.Len();
+		}
+		NarrowedStrings.SetNumUninitialized(NumChars);
+	}
+	ANSICHAR* NarrowIt = NarrowedStrings.GetData();
+
+	// Split number suffixes and hash names, names FName construction treats specially are created directly
+	TArray<FNameComparisonValue> Values;
+	TArray<int32> InputIndices;
+	TArray<int32> Numbers;
+	Values.Reserve(Num);
+	InputIndices.Reserve(Num);
+	Numbers.Reserve(Num);
+
+	FShardTargetArray Targets;
+	FMemory::Memzero(Targets);
+
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		const TStringView<CharType> String = Strings[Idx];
+		int32 Len = String.Len();
+		const uint32 InternalNumber = Len ? FNameHelper::ParseNumber(String.GetData(), /* may be shortened */ Len) : NAME_NO_NUMBER_INTERNAL;
+
+		if (Len == 0 || Len >= NAME_SIZE)
+		{
+			OutNames[Idx] = FName(String.Len(), String.GetData());
+			continue;
+		}
+
+		const FNameComparisonValue& Value = Values.Emplace_GetRef(MakeBatchNameView(String.GetData(), Len, NarrowIt));
+		InputIndices.Add(Idx);
+		Numbers.Add(static_cast<int32>(InternalNumber));
+		++Targets[Value.Hash.ShardIndex].Num;
+	}
+
+	uint32 SortIdx = 0;
+	for (FShardTarget& Target : Targets)
+	{
+		Target.SortIdx = SortIdx;
+		SortIdx += Target.Num;
+	}
+	check(SortIdx == static_cast<uint32>(Values.Num()));
+
+	// Prepare batch loading requests sorted by shard index
+	TArray<FDisplayNameEntryId> DisplayIds;
+	TArray<FNameComparisonLoad> ShardSortedLoads;
+	DisplayIds.SetNumUninitialized(Values.Num());
+	ShardSortedLoads.SetNumUninitialized(Values.Num());
+	for (int32 Idx = 0; Idx < Values.Num(); ++Idx)
+	{
+		FShardTarget& Target = Targets[Values[Idx].Hash.ShardIndex];
+		ShardSortedLoads[Target.SortIdx] = FNameComparisonLoad {Values[Idx], &DisplayIds[Idx]};
+		++Target.SortIdx;
+	}
+
+	// Take each shard lock once for all of its names
+	FNamePool& Pool = GetNamePoolPostInit();
+	FNameComparisonLoad* LoadIt = ShardSortedLoads.GetData();
+	for (FShardTarget& Target : Targets)
+	{
+		TArrayView<FNameComparisonLoad> Batch(LoadIt, Target.Num);
+		LoadIt += Target.Num;
+		Pool.StoreBatch(&Target - Targets, Batch);
+	}
+	check(LoadIt == ShardSortedLoads.GetData() + ShardSortedLoads.Num());
+
+#if WITH_CASE_PRESERVING_NAME
+	LoadDisplayNames(ShardSortedLoads);
+#endif
+
+	for (int32 Idx = 0; Idx < DisplayIds.Num(); ++Idx)
+	{
+		OutNames[InputIndices[Idx]] = DisplayIds[Idx].ToName(Numbers[Idx]);
+	}
+}
+
+void CreateNameBatch(TArrayView<const FAnsiStringView> Strings, TArrayView<FName> OutNames)
+{
+	CreateNameBatchImpl(Strings, OutNames);
+}
+
+void CreateNameBatch(TArrayView<const FWideStringView> Strings, TArrayView<FName> OutNames)
+{
+	CreateNameBatchImpl(Strings, OutNames);
+}
+
 #if 0 && ALLOW_NAME_BATCH_SAVING  
 
 FORCENOINLINE void PerfTestLoadNameBatch(TArray<FLoadedNameEntryId>& OutNames, TArrayView<const uint8> NameData, TArrayView<const uint8> HashData)
@@ -5594,6 +5883,49 @@ static void TestNameBatch()
 	TestArchiveRoundtrip(LargeBatch);
 
 #endif // ALLOW_NAME_BATCH_SAVING
+
+	// Test CreateNameBatch() yields the same names as FName construction, with new names, duplicates,
+	// different casing, number suffixes and special cases in a batch large enough to be sorted by shard
+	TArray<FString> Strings;
+	for (int32 Idx = 0; Idx < 2 * FNamePoolShards; ++Idx)
+	{
+		Strings.Add(FString::Printf(TEXT("CreateNameBatch%d"), Idx / 2));
+		Strings.Add(FString::Printf(TEXT("createnamebatch_%d"), Idx));
+	}
+	Strings.Append({TEXT(""), TEXT("None"), TEXT("_3"), TEXT("Hej_0"), TEXT("Hej_01"), TEXT("Hej_2147483647")});
+	FString WideString(TEXT("Wide batch"));
+	WideString[4] = 60000;
+	Strings.Add(WideString);
+
+	TArray<FWideStringView> WideViews;
+	TArray<FAnsiStringView> AnsiViews;
+	TArray<FAnsiString> AnsiStrings;
+	AnsiStrings.Reserve(Strings.Num());
+	for (const FString& String : Strings)
+	{
+		WideViews.Add(*String);
+		if (String != WideString)
+		{
+			AnsiViews.Add(*AnsiStrings.Emplace_GetRef(*String));
+		}
+	}
+
+	TArray<FName> BatchNames;
+	BatchNames.SetNum(WideViews.Num());
+	CreateNameBatch(WideViews, BatchNames);
+	for (int32 Idx = 0; Idx < Strings.Num(); ++Idx)
+	{
+		check(BatchNames[Idx] == FName(*Strings[Idx]));
+		check(BatchNames[Idx].GetDisplayIndex() == FName(*Strings[Idx]).GetDisplayIndex());
+	}
+
+	BatchNames.SetNum(AnsiViews.Num());
+	CreateNameBatch(AnsiViews, BatchNames);
+	for (int32 Idx = 0; Idx < AnsiViews.Num(); ++Idx)
+	{
+		check(BatchNames[Idx].GetDisplayIndex() == FName(*Strings[Idx]).GetDisplayIndex());
+		check(BatchNames[Idx].GetNumber() == FName(*Strings[Idx]).GetNumber());
+	}
 }
 
 #if !UE_BUILD_SHIPPING && !UE_BUILD_TEST
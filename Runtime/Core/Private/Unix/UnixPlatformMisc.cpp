@@ -762,6 +762,173 @@ int32 FUnixPlatformMisc::NumberOfCoresIncludingHyperthreads()
 	return NumCoreIds;
 }
 
+namespace UnixPlatformMiscImpl
+{
+	/** Reads a single integer from a sysfs file, returns false if the file is missing or malformed. */
+	static bool ReadSysfsInt(const char* FileName, int& OutValue)
+	{
+		bool bSuccess = false;
+		if (FILE* File = fopen(FileName, "r"))
+		{
+			bSuccess = (1 == fscanf(File, "%d", &OutValue));
+			fclose(File);
+		}
+		return bSuccess;
+	}
+
+	/** Parses a sysfs cpu list (e.g. "0-15,64-79") and calls Visitor for every cpu index in it. */
+	template<typename VisitorType>
+	static bool ParseSysfsCpuList(const char* FileName, VisitorType&& Visitor)
+	{
+		FILE* File = fopen(FileName, "r");
+		if (File == nullptr)
+		{
+			return false;
+		}
+
+		int First = 0;
+		while (1 == fscanf(File, "%d", &First))
+		{
+			int Last = First;
+			int Separator = fgetc(File);
+			if (Separator == '-')
+			{
+				if (1 != fscanf(File, "%d", &Last))
+				{
+					break;
+				}
+				Separator = fgetc(File);
+			}
+
+			for (int CpuIdx = First; CpuIdx <= Last && CpuIdx < CPU_SETSIZE; ++CpuIdx)
+			{
+				Visitor(CpuIdx);
+			}
+
+			if (Separator != ',')
+			{
+				break;
+			}
+		}
+
+		fclose(File);
+		return true;
+	}
+}
+
+const FProcessorTopologyDesc& FUnixPlatformMisc::GetProcessorTopologyDesc()
+{
+	// WARNING: like NumberOfCores() this ignores CPUs going offline or affinity mask changes after the first call
+	static FProcessorTopologyDesc Desc = []()
+	{
+		using namespace UnixPlatformMiscImpl;
+
+		FProcessorTopologyDesc Result;
+
+		cpu_set_t AvailableCpusMask;
+		CPU_ZERO(&AvailableCpusMask);
+		if (0 != sched_getaffinity(0, sizeof(AvailableCpusMask), &AvailableCpusMask))
+		{
+			return FGenericPlatformMisc::GetProcessorTopologyDesc();
+		}
+
+		// NUMA nodes are listed as /sys/devices/system/node/nodeN/cpulist, a missing directory means a single node
+		int16 CpuNumaNodes[CPU_SETSIZE];
+		FMemory::Memzero(CpuNumaNodes);
+		int MaxNumaNode = 0;
+		char FileNameBuffer[1024];
+		for (int NodeIdx = 0, NumMissing = 0; NodeIdx < CPU_SETSIZE && NumMissing < 8; ++NodeIdx)
+		{
+			// node ids can be sparse, tolerate a few holes before giving up
+			sprintf(FileNameBuffer, "/sys/devices/system/node/node%d/cpulist", NodeIdx);
+			const bool bFound = ParseSysfsCpuList(FileNameBuffer, [&CpuNumaNodes, NodeIdx](int CpuIdx)
+			{
+				CpuNumaNodes[CpuIdx] = int16(NodeIdx);
+			});
+
+			if (bFound)
+			{
+				MaxNumaNode = NodeIdx;
+				NumMissing = 0;
+			}
+			else
+			{
+				++NumMissing;
+			}
+		}
+		Result.NumNumaNodes = uint16(MaxNumaNode + 1);
+
+		struct FDomainKey
+		{
+			int NumaNode;
+			int Package;
+			int CacheId;
+			uint16 ProcessorGroup;
+		};
+		FDomainKey DomainKeys[FProcessorTopologyDesc::MaxNumCacheDomains];
+
+		for (int32 CpuIdx = 0; CpuIdx < CPU_SETSIZE; ++CpuIdx)
+		{
+			if (!CPU_ISSET(CpuIdx, &AvailableCpusMask))
+			{
+				continue;
+			}
+
+			FDomainKey Key;
+			Key.NumaNode = CpuNumaNodes[CpuIdx];
+			Key.ProcessorGroup = uint16(CpuIdx / 64);
+
+			sprintf(FileNameBuffer, "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", CpuIdx);
+			if (!ReadSysfsInt(FileNameBuffer, Key.Package) || Key.Package < 0)
+			{
+				Key.Package = 0;
+			}
+
+			// index3 is the L3 on every x64 and most AArch64 server parts, fall back to the package when it's not exposed
+			sprintf(FileNameBuffer, "/sys/devices/system/cpu/cpu%d/cache/index3/id", CpuIdx);
+			if (!ReadSysfsInt(FileNameBuffer, Key.CacheId))
+			{
+				Key.CacheId = -1;
+			}
+
+			int32 DomainIndex = 0;
+			for (; DomainIndex < Result.NumCacheDomains; ++DomainIndex)
+			{
+				const FDomainKey& Other = DomainKeys[DomainIndex];
+				if (Other.NumaNode == Key.NumaNode && Other.Package == Key.Package && Other.CacheId == Key.CacheId && Other.ProcessorGroup == Key.ProcessorGroup)
+				{
+					break;
+				}
+			}
+
+			if (DomainIndex == Result.NumCacheDomains)
+			{
+				if (Result.NumCacheDomains == FProcessorTopologyDesc::MaxNumCacheDomains)
+				{
+					// too many domains to describe, it's not worth being topology aware on such a system
+					return FGenericPlatformMisc::GetProcessorTopologyDesc();
+				}
+
+				DomainKeys[DomainIndex] = Key;
+				FProcessorCacheDomain& Domain = Result.CacheDomains[Result.NumCacheDomains++];
+				Domain.ProcessorGroup = Key.ProcessorGroup;
+				Domain.NumaNode = uint16(Key.NumaNode);
+			}
+
+			Result.CacheDomains[DomainIndex].ThreadAffinity |= 1ull << (CpuIdx % 64);
+		}
+
+		if (Result.NumCacheDomains == 0)
+		{
+			return FGenericPlatformMisc::GetProcessorTopologyDesc();
+		}
+
+		return Result;
+	}();
+
+	return Desc;
+}
+
 const TCHAR* FUnixPlatformMisc::GetNullRHIShaderFormat()
 {
 	if (FParse::Param(FCommandLine::Get(), TEXT("sm5")))
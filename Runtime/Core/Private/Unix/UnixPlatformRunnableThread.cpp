@@ -7,6 +7,7 @@
 #include "Containers/UnrealString.h"
 #include "Containers/StringConv.h"
 #include "Logging/LogMacros.h"
+#include "HAL/PlatformAffinity.h"
 #include "Misc/AssertionMacros.h"
 
 #include <sys/resource.h>
@@ -113,6 +114,37 @@ void FRunnableThreadUnix::SetThreadPriority(pthread_t InThread, EThreadPriority
 	FUnixPlatformProcess::SetThreadNiceValue(ThreadID, ModifiedPriority);
 }
 
+bool FRunnableThreadUnix::SetThreadAffinity(const FThreadAffinity& Affinity)
+{
+	// Unix has no processor groups, treat each group as the next 64 logical cpus so that masks coming from
+	// FPlatformMisc::GetProcessorTopologyDesc() can address machines with more than 64 hardware threads.
+	// The default affinity keeps the historical behavior of leaving placement to the kernel.
+	if (Affinity.ProcessorGroup == 0 && Affinity.ThreadAffinityMask == FPlatformAffinity::GetNoAffinityMask())
+	{
+		return false;
+	}
+
+	cpu_set_t CpuSet;
+	CPU_ZERO(&CpuSet);
+	for (int32 Bit = 0; Bit < 64; ++Bit)
+	{
+		const int32 CpuIdx = int32(Affinity.ProcessorGroup) * 64 + Bit;
+		if ((Affinity.ThreadAffinityMask & (1ull << Bit)) != 0 && CpuIdx < CPU_SETSIZE)
+		{
+			CPU_SET(CpuIdx, &CpuSet);
+		}
+	}
+
+	if (CPU_COUNT(&CpuSet) == 0)
+	{
+		return false;
+	}
+
+	const int Result = pthread_setaffinity_np(Thread, sizeof(CpuSet), &CpuSet);
+	UE_CLOG(Result != 0, LogHAL, Verbose, TEXT("pthread_setaffinity_np(group %d, mask 0x%" UINT64_X_FMT ") failed for thread '%s' (err=%d)"), Affinity.ProcessorGroup, Affinity.ThreadAffinityMask, *ThreadName, Result);
+	return Result == 0;
+}
+
 void FRunnableThreadUnix::PreRun()
 {
 	FString SizeLimitedThreadName = ThreadName;
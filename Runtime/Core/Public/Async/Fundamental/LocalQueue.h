@@ -17,6 +17,9 @@
 	#define LOCALQUEUEREGISTRYDEFAULTS_MAX_ITEMCOUNT 1024
 #endif
 
+// Matches FProcessorTopologyDesc::MaxNumCacheDomains
+#define LOCALQUEUEREGISTRYDEFAULTS_MAX_CACHEDOMAINS 64
+
 namespace LowLevelTasks
 {
 namespace LocalQueue_Impl
@@ -102,6 +105,13 @@ protected:
 		} while(true);
 	}
 
+	//approximate number of items in the queue (this can only be exact on the thread that accesses the head, other threads might see a stale value)
+	inline uint32 ApproximateNum() const
+	{
+		const uint32 Num = (Head + 1) - Tail.load(std::memory_order_relaxed);
+		return Num <= NumItems ? Num : 0;
+	}
+
 private:
 	struct FAlignedElement
 	{
@@ -133,6 +143,11 @@ public:
 	{
 		return TWorkStealingQueueBase2<NumItems>::Steal(reinterpret_cast<uintptr_t&>(Item));
 	}
+
+	inline uint32 ApproximateNum() const
+	{
+		return TWorkStealingQueueBase2<NumItems>::ApproximateNum();
+	}
 };
 }
 
@@ -151,6 +166,8 @@ enum class ELocalQueueType
  * or when a Thread has no LocalQueue installed or when the LocalQueue is at capacity. A new LocalQueue is registers itself always.         *
  * A Dequeue Operation can only be done starting from a LocalQueue, than the GlobalQueue will be checked.                                   *
  * Finally Items might get Stolen from other LocalQueues that are registered with the LocalQueueRegistry.                                   *
+ * When cache domains are enabled every LocalQueue belongs to a domain (a set of cores sharing a last level cache), stealing prefers the    *
+ * LocalQueues of the same domain and Items can be enqueued to a per domain OverflowQueue that is dequeued first by workers of that domain. *
  ********************************************************************************************************************************************/
 template<uint32 NumLocalItems = LOCALQUEUEREGISTRYDEFAULTS_MAX_ITEMCOUNT, uint32 MaxLocalQueues = LOCALQUEUEREGISTRYDEFAULTS_MAX_LOCALQUEUES>
 class TLocalQueueRegistry
@@ -166,11 +183,19 @@ class TLocalQueueRegistry
 public:
 	class TLocalQueue;
 
+	static constexpr uint32 MaxCacheDomains = LOCALQUEUEREGISTRYDEFAULTS_MAX_CACHEDOMAINS;
+	static constexpr uint32 InvalidCacheDomain = ~0u;
+
 private:
 	using FLocalQueueType	 = LocalQueue_Impl::TWorkStealingQueue2<FTask, NumLocalItems>;
 	using FOverflowQueueType = FAAArrayQueue<FTask>;
 	using DequeueHazard		 = typename FOverflowQueueType::DequeueHazard;
 
+	struct FCacheDomainQueues
+	{
+		FOverflowQueueType OverflowQueues[uint32(ETaskPriority::Count)];
+	};
+
 public:
 	class TLocalQueue
 	{
@@ -178,7 +203,7 @@ public:
 		friend class TLocalQueueRegistry;
 
 	public:
-		TLocalQueue(TLocalQueueRegistry& InRegistry, ELocalQueueType InQueueType) : Registry(&InRegistry), QueueType(InQueueType)
+		TLocalQueue(TLocalQueueRegistry& InRegistry, ELocalQueueType InQueueType, uint32 InCacheDomain = InvalidCacheDomain) : Registry(&InRegistry), QueueType(InQueueType), CacheDomain(InCacheDomain)
 		{
 			// Local queues are never unregistered, everything is shutdown at once.
 			Registry->AddLocalQueue(this);
@@ -233,10 +258,11 @@ public:
 			return nullptr;
 		}
 
-		// Check both the local and global queue in priority order
+		// Check the local, cache domain and global queue in priority order
 		inline FTask* Dequeue(bool GetBackGroundTasks)
 		{
 			const int32 MaxPriority = GetBackGroundTasks ? int32(ETaskPriority::Count)   : int32(ETaskPriority::ForegroundCount);
+			FCacheDomainQueues* DomainQueues = Registry->GetCacheDomainQueues(CacheDomain);
 
 			for (int32 PriorityIndex = 0; PriorityIndex < MaxPriority; ++PriorityIndex)
 			{
@@ -246,6 +272,15 @@ public:
 					return Item;
 				}
 
+				if (DomainQueues)
+				{
+					Item = DomainQueues->OverflowQueues[PriorityIndex].dequeue();
+					if (Item)
+					{
+						return Item;
+					}
+				}
+
 				Item = Registry->OverflowQueues[PriorityIndex].dequeue(DequeueHazards[PriorityIndex]);
 				if (Item)
 				{
@@ -262,7 +297,7 @@ public:
 				CachedRandomIndex = Rand();
 			}
 
-			FTask* Result = Registry->StealItem(CachedRandomIndex, CachedPriorityIndex, GetBackGroundTasks);
+			FTask* Result = Registry->StealItem(CachedRandomIndex, CachedPriorityIndex, GetBackGroundTasks, CacheDomain);
 			if (Result)
 			{
 				return Result;
@@ -270,6 +305,22 @@ public:
 			return nullptr;
 		}
 
+		inline uint32 GetCacheDomain() const
+		{
+			return CacheDomain;
+		}
+
+		// number of items in the local queues of all priorities, only exact when called from the thread the queue is installed on
+		inline uint32 ApproximateNum() const
+		{
+			uint32 Num = 0;
+			for (int32 PriorityIndex = 0; PriorityIndex < int32(ETaskPriority::Count); ++PriorityIndex)
+			{
+				Num += LocalQueues[PriorityIndex].ApproximateNum();
+			}
+			return Num;
+		}
+
 	private:
 		static constexpr uint32    InvalidIndex = ~0u;
 		FLocalQueueType            LocalQueues[uint32(ETaskPriority::Count)];
@@ -278,12 +329,21 @@ public:
 		uint32                     CachedRandomIndex = InvalidIndex;
 		uint32                     CachedPriorityIndex = 0;
 		ELocalQueueType            QueueType;
+		uint32                     CacheDomain;
 	};
 
 	TLocalQueueRegistry()
 	{
 	}
 
+	~TLocalQueueRegistry()
+	{
+		for (std::atomic<FCacheDomainQueues*>& DomainQueues : CacheDomainQueues)
+		{
+			delete DomainQueues.exchange(nullptr, std::memory_order_relaxed);
+		}
+	}
+
 private:
 	// Add a queue to the Registry. Thread-safe.
 	void AddLocalQueue(TLocalQueue* QueueToAdd)
@@ -295,31 +355,73 @@ private:
 		LocalQueues[Index].store(QueueToAdd, std::memory_order_release);
 	}
 
+	// returns the OverflowQueues of a cache domain or nullptr if cache domains are disabled
+	inline FCacheDomainQueues* GetCacheDomainQueues(uint32 CacheDomain) const
+	{
+		if (CacheDomain < NumCacheDomains.load(std::memory_order_relaxed))
+		{
+			return CacheDomainQueues[CacheDomain].load(std::memory_order_acquire);
+		}
+		return nullptr;
+	}
+
 	// StealItem tries to steal an Item from a Registered LocalQueue
+	// LocalQueues of the same cache domain are tried first, then the other LocalQueues and finally the OverflowQueues of the other cache domains
 	// Thread-safe with AddLocalQueue
-	FTask* StealItem(uint32& CachedRandomIndex, uint32& CachedPriorityIndex, bool GetBackGroundTasks)
+	FTask* StealItem(uint32& CachedRandomIndex, uint32& CachedPriorityIndex, bool GetBackGroundTasks, uint32 CacheDomain = InvalidCacheDomain)
 	{
 		uint32 NumQueues   = NumLocalQueues.load(std::memory_order_relaxed);
 		uint32 MaxPriority = GetBackGroundTasks ? int32(ETaskPriority::Count) : int32(ETaskPriority::ForegroundCount);
 		CachedRandomIndex  = CachedRandomIndex % NumQueues;
 
-		for (uint32 Index = 0; Index < NumLocalQueues; Index++)
+		const bool bPreferCacheDomain = CacheDomain < NumCacheDomains.load(std::memory_order_relaxed);
+		for (uint32 Pass = bPreferCacheDomain ? 0 : 1; Pass < 2; Pass++)
 		{
-			// Test for null in case we race on reading NumLocalQueues reserved index before the pointer is set
-			if (TLocalQueue* LocalQueue = LocalQueues[Index].load(std::memory_order_acquire))
+			for (uint32 Index = 0; Index < NumLocalQueues; Index++)
 			{
-				for(uint32 PriorityIndex = 0; PriorityIndex < MaxPriority; PriorityIndex++)
+				// Test for null in case we race on reading NumLocalQueues reserved index before the pointer is set
+				if (TLocalQueue* LocalQueue = LocalQueues[Index].load(std::memory_order_acquire))
 				{
-					FTask* Item;
-					if (LocalQueue->LocalQueues[PriorityIndex].Steal(Item))
+					// First pass only visits our own cache domain, second pass everything else
+					if (bPreferCacheDomain && (LocalQueue->CacheDomain == CacheDomain) != (Pass == 0))
 					{
-						return Item;
+						continue;
 					}
-					CachedPriorityIndex = ++CachedPriorityIndex < MaxPriority ? CachedPriorityIndex : 0;
+
+					for(uint32 PriorityIndex = 0; PriorityIndex < MaxPriority; PriorityIndex++)
+					{
+						FTask* Item;
+						if (LocalQueue->LocalQueues[PriorityIndex].Steal(Item))
+						{
+							return Item;
+						}
+						CachedPriorityIndex = ++CachedPriorityIndex < MaxPriority ? CachedPriorityIndex : 0;
+					}
+					CachedRandomIndex = ++CachedRandomIndex < NumQueues ? CachedRandomIndex : 0;
 				}
-				CachedRandomIndex = ++CachedRandomIndex < NumQueues ? CachedRandomIndex : 0;
 			}
 		}
+
+		// Items hinted to another cache domain are only taken as a last resort so that they never starve.
+		// Go over every domain that was ever allocated as items can be left behind when the number of domains shrinks.
+		const uint32 NumDomainQueues = NumAllocatedCacheDomains.load(std::memory_order_acquire);
+		for (uint32 DomainIndex = 0; DomainIndex < NumDomainQueues; DomainIndex++)
+		{
+			FCacheDomainQueues* DomainQueues = CacheDomainQueues[DomainIndex].load(std::memory_order_acquire);
+			if (DomainIndex == CacheDomain || DomainQueues == nullptr)
+			{
+				continue;
+			}
+
+			for (uint32 PriorityIndex = 0; PriorityIndex < MaxPriority; PriorityIndex++)
+			{
+				if (FTask* Item = DomainQueues->OverflowQueues[PriorityIndex].dequeue())
+				{
+					return Item;
+				}
+			}
+		}
+
 		CachedPriorityIndex = 0;
 		CachedRandomIndex = TLocalQueue::InvalidIndex;
 		return nullptr;
@@ -335,6 +437,67 @@ public:
 		OverflowQueues[PriorityIndex].enqueue(Item);
 	}
 
+	// enqueue an Item into the OverflowQueue of a cache domain, falls back to the Global OverflowQueue if cache domains are disabled
+	void EnqueueCacheDomain(FTask* Item, uint32 PriorityIndex, uint32 CacheDomain)
+	{
+		check(PriorityIndex < int32(ETaskPriority::Count));
+		check(Item != nullptr);
+
+		if (FCacheDomainQueues* DomainQueues = GetCacheDomainQueues(CacheDomain))
+		{
+			DomainQueues->OverflowQueues[PriorityIndex].enqueue(Item);
+		}
+		else
+		{
+			OverflowQueues[PriorityIndex].enqueue(Item);
+		}
+	}
+
+	// Sets the number of cache domains LocalQueues can belong to, 0 disables cache domains.
+	// Not thread-safe with itself, OverflowQueues of the domains are never freed until the registry is destroyed.
+	void SetNumCacheDomains(uint32 InNumCacheDomains)
+	{
+		check(InNumCacheDomains <= MaxCacheDomains);
+
+		for (uint32 DomainIndex = 0; DomainIndex < InNumCacheDomains; DomainIndex++)
+		{
+			if (CacheDomainQueues[DomainIndex].load(std::memory_order_relaxed) == nullptr)
+			{
+				CacheDomainQueues[DomainIndex].store(new FCacheDomainQueues(), std::memory_order_release);
+			}
+		}
+
+		if (InNumCacheDomains > NumAllocatedCacheDomains.load(std::memory_order_relaxed))
+		{
+			NumAllocatedCacheDomains.store(InNumCacheDomains, std::memory_order_release);
+		}
+		NumCacheDomains.store(InNumCacheDomains, std::memory_order_release);
+	}
+
+	uint32 GetNumCacheDomains() const
+	{
+		return NumCacheDomains.load(std::memory_order_relaxed);
+	}
+
+	// Move every Item left in the cache domains OverflowQueues to the Global OverflowQueue
+	void FlushCacheDomainQueues()
+	{
+		const uint32 NumDomainQueues = NumAllocatedCacheDomains.load(std::memory_order_acquire);
+		for (uint32 DomainIndex = 0; DomainIndex < NumDomainQueues; DomainIndex++)
+		{
+			if (FCacheDomainQueues* DomainQueues = CacheDomainQueues[DomainIndex].load(std::memory_order_acquire))
+			{
+				for (uint32 PriorityIndex = 0; PriorityIndex < uint32(ETaskPriority::Count); PriorityIndex++)
+				{
+					while (FTask* Item = DomainQueues->OverflowQueues[PriorityIndex].dequeue())
+					{
+						OverflowQueues[PriorityIndex].enqueue(Item);
+					}
+				}
+			}
+		}
+	}
+
 	// grab an Item directy from the Global OverflowQueue
 	FTask* DequeueGlobal(bool GetBackGroundTasks = true)
 	{
@@ -375,9 +538,12 @@ public:
 	}
 
 private:
-	FOverflowQueueType        OverflowQueues[uint32(ETaskPriority::Count)];
-	std::atomic<TLocalQueue*> LocalQueues[MaxLocalQueues] { nullptr };
-	std::atomic<uint32>       NumLocalQueues {0};
+	FOverflowQueueType                OverflowQueues[uint32(ETaskPriority::Count)];
+	std::atomic<TLocalQueue*>         LocalQueues[MaxLocalQueues] { nullptr };
+	std::atomic<uint32>               NumLocalQueues {0};
+	std::atomic<FCacheDomainQueues*>  CacheDomainQueues[MaxCacheDomains] { nullptr };
+	std::atomic<uint32>               NumCacheDomains {0};
+	std::atomic<uint32>               NumAllocatedCacheDomains {0};
 };
 
 } // namespace Private
@@ -26,8 +26,57 @@
 
 #include <atomic>
 
+#ifndef LOWLEVELTASKS_WORKER_STATS
+	#define LOWLEVELTASKS_WORKER_STATS !UE_BUILD_SHIPPING
+#endif
+
+class FOutputDevice;
+
 namespace LowLevelTasks
 {
+	namespace Private
+	{
+		// Counters of a single worker, collected when TaskGraph.WorkerStats is enabled.
+		// Only the owning worker writes them (no read-modify-write atomics needed) so collecting never adds contention between workers.
+		struct alignas(PLATFORM_CACHE_LINE_SIZE) FWorkerStats
+		{
+			std::atomic<uint64> NumExecutedTasks { 0 };
+			std::atomic<uint64> NumSuccessfulSteals { 0 };
+			std::atomic<uint64> NumFailedSteals { 0 };
+			std::atomic<uint64> NumOversubscriptions { 0 };
+			std::atomic<uint64> SpinCycles { 0 };		// spinning in the waiting queue before blocking
+			std::atomic<uint64> ParkCycles { 0 };		// blocked on the worker event
+			std::atomic<uint32> PeakLocalQueueDepth { 0 };
+			uint64              LastTracedCycles = 0;
+			uint16              TraceCounterIds[6] = {};
+
+			static void Add(std::atomic<uint64>& Counter, uint64 Value)
+			{
+				Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+			}
+
+			void UpdatePeakLocalQueueDepth(uint32 Depth)
+			{
+				if (Depth > PeakLocalQueueDepth.load(std::memory_order_relaxed))
+				{
+					PeakLocalQueueDepth.store(Depth, std::memory_order_relaxed);
+				}
+			}
+
+			// racy with the owning worker, values written concurrently might survive the reset
+			void Reset()
+			{
+				NumExecutedTasks.store(0, std::memory_order_relaxed);
+				NumSuccessfulSteals.store(0, std::memory_order_relaxed);
+				NumFailedSteals.store(0, std::memory_order_relaxed);
+				NumOversubscriptions.store(0, std::memory_order_relaxed);
+				SpinCycles.store(0, std::memory_order_relaxed);
+				ParkCycles.store(0, std::memory_order_relaxed);
+				PeakLocalQueueDepth.store(0, std::memory_order_relaxed);
+			}
+		};
+	}
+
 	enum class EQueuePreference
 	{
 		GlobalQueuePreference,
@@ -111,8 +160,12 @@ namespace LowLevelTasks
 		}
 	};
 
+	class FCacheDomainAffinityScope;
+
 	class FSchedulerTls
 	{
+		friend class FCacheDomainAffinityScope;
+
 	protected:
 		class FImpl;
 
@@ -133,6 +186,8 @@ namespace LowLevelTasks
 			EWorkerType WorkerType = EWorkerType::None;
 			std::atomic<bool> bPendingWakeUp = false;
 			bool        bIsStandbyWorker = false;
+			uint32      PreferredCacheDomain = FQueueRegistry::InvalidCacheDomain;
+			Private::FWorkerStats* WorkerStats = nullptr;
 
 			inline bool IsBackgroundWorker()
 			{
@@ -222,9 +277,18 @@ namespace LowLevelTasks
 		//get the background priority set when workers were started
 		inline EThreadPriority GetBackgroundPriority() const { return BackgroundPriority; }
 
+		//number of last level cache domains the workers are spread over, 1 when topology aware placement is disabled (see TaskGraph.UseCacheDomainAffinity)
+		inline uint32 GetNumCacheDomains() const;
+
+		//cache domain the current worker thread is pinned to, or ~0u if the current thread is not a worker or placement is disabled
+		CORE_API uint32 GetCurrentCacheDomain() const;
+
 		//determine if we're currently out of workers for a given task priority
 		CORE_API bool IsOversubscriptionLimitReached(ETaskPriority TaskPriority) const;
 
+		//log the per-worker counters collected while TaskGraph.WorkerStats is enabled, optionally resetting them afterwards
+		CORE_API void DumpWorkerStats(FOutputDevice& Ar, bool bReset = false);
+
 		//event that will fire when the scheduler has reached its oversubscription limit (all threads are waiting).
 		//note: This event can be broadcasted from any thread so the receiver needs to be thread-safe
 		//      For optimal performance, avoid binding UObjects to this event and use AddRaw/AddLambda instead.
@@ -236,32 +300,39 @@ namespace LowLevelTasks
 
 	private: 
 		[[nodiscard]] FTask* ExecuteTask(FTask* InTask);
-		TUniquePtr<FThread> CreateWorker(uint32 WorkerId, const TCHAR* Name, bool bPermitBackgroundWork = false, FThread::EForkable IsForkable = FThread::NonForkable, Private::FWaitEvent* ExternalWorkerEvent = nullptr, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue = nullptr, EThreadPriority Priority = EThreadPriority::TPri_Normal, uint64 InAffinity = 0);
+		TUniquePtr<FThread> CreateWorker(uint32 WorkerId, const TCHAR* Name, bool bPermitBackgroundWork = false, FThread::EForkable IsForkable = FThread::NonForkable, Private::FWaitEvent* ExternalWorkerEvent = nullptr, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue = nullptr, EThreadPriority Priority = EThreadPriority::TPri_Normal, uint64 InAffinity = 0, uint32 CacheDomain = FQueueRegistry::InvalidCacheDomain);
 		void WorkerMain(Private::FWaitEvent* WorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, uint32 WaitCycles, bool bPermitBackgroundWork);
 		void StandbyLoop(Private::FWaitEvent* WorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, uint32 WaitCycles, bool bPermitBackgroundWork);
 		void WorkerLoop(Private::FWaitEvent* WorkerEvent, FSchedulerTls::FLocalQueueType* ExternalWorkerLocalQueue, uint32 WaitCycles, bool bPermitBackgroundWork);
 		CORE_API void LaunchInternal(FTask& Task, EQueuePreference QueuePreference, bool bWakeUpWorker);
 		CORE_API void BusyWaitInternal(const FConditional& Conditional, bool ForceAllowBackgroundWork);
 		inline bool WakeUpWorker(bool bBackgroundWorker);
+		CORE_API bool WakeUpDomainWorker(bool bBackgroundWorker, uint32 CacheDomain);
+		Private::FWaitingQueue& GetWorkerWaitingQueue(bool bPermitBackgroundWork, uint32 CacheDomain);
 		CORE_API void IncrementOversubscription();
 		CORE_API void DecrementOversubscription();
 		template<typename QueueType, FTask* (QueueType::*DequeueFunction)(bool), bool bIsStandbyWorker>
-		bool TryExecuteTaskFrom(Private::FWaitEvent* WaitEvent, QueueType* Queue, Private::FOutOfWork& OutOfWork, bool bPermitBackgroundWork);
+		bool TryExecuteTaskFrom(Private::FWaitEvent* WaitEvent, QueueType* Queue, Private::FOutOfWork& OutOfWork, bool bPermitBackgroundWork, Private::FWorkerStats* Stats);
+		void TraceWorkerStats(Private::FWorkerStats& Stats, uint32 WorkerId);
 
 		friend class FOversubscriptionScope;
 	private:
 		Private::FWaitingQueue                         WaitingQueue[2] = { { WorkerEvents, OversubscriptionLimitReachedEvent }, { WorkerEvents, OversubscriptionLimitReachedEvent } };
+		// Non-standby workers park in the queue of their cache domain when topology aware placement is enabled so that domain hinted work can wake a worker of that domain
+		TUniquePtr<Private::FWaitingQueue>             DomainWaitingQueue[2][FSchedulerTls::FQueueRegistry::MaxCacheDomains];
 		FSchedulerTls::FQueueRegistry                  QueueRegistry;
 		UE::FPlatformRecursiveMutex                    WorkerCreationCS;
 		UE::FPlatformRecursiveMutex                    WorkerThreadsCS;
 		TArray<std::atomic<FThread*>>                  WorkerThreads;
 		TAlignedArray<FSchedulerTls::FLocalQueueType>  WorkerLocalQueues;
 		TAlignedArray<Private::FWaitEvent>             WorkerEvents;
+		TAlignedArray<Private::FWorkerStats>           WorkerStats;
 		TUniquePtr<FSchedulerTls::FLocalQueueType>     GameThreadLocalQueue;
 		std::atomic_uint                               ActiveWorkers { 0 };
 		std::atomic_uint                               NextWorkerId { 0 };
 		std::atomic<int32>                             ForegroundCreationIndex{ 0 };
 		std::atomic<int32>                             BackgroundCreationIndex{ 0 };
+		std::atomic_uint                               NumCacheDomains{ 1 };
 		uint64                                         WorkerAffinity = 0;
 		uint64                                         BackgroundAffinity = 0;
 		EThreadPriority                                WorkerPriority = EThreadPriority::TPri_Normal;
@@ -307,6 +378,20 @@ namespace LowLevelTasks
 		};
 	}
 
+	//hints that the tasks launched by the current thread inside this scope should run on the workers of the given cache domain.
+	//workers of other domains still pick those tasks up once they run out of work so the hint can't cause starvation.
+	class FCacheDomainAffinityScope
+	{
+		UE_NONCOPYABLE(FCacheDomainAffinityScope);
+
+	public:
+		CORE_API explicit FCacheDomainAffinityScope(uint32 CacheDomain);
+		CORE_API ~FCacheDomainAffinityScope();
+
+	private:
+		uint32 PreviousCacheDomain;
+	};
+
 	class FOversubscriptionScope
 	{
 		UE_NONCOPYABLE(FOversubscriptionScope);
@@ -399,6 +484,11 @@ namespace LowLevelTasks
 		return ActiveWorkers.load(std::memory_order_relaxed);
 	}
 
+	inline uint32 FScheduler::GetNumCacheDomains() const
+	{
+		return NumCacheDomains.load(std::memory_order_relaxed);
+	}
+
 	template<typename TaskType>
 	inline void FScheduler::BusyWait(const TaskType& Task, bool ForceAllowBackgroundWork)
 	{
@@ -444,6 +534,10 @@ namespace LowLevelTasks
 
 	inline bool FScheduler::WakeUpWorker(bool bBackgroundWorker)
 	{
+		if (NumCacheDomains.load(std::memory_order_relaxed) > 1)
+		{
+			return WakeUpDomainWorker(bBackgroundWorker, FSchedulerTls::FQueueRegistry::InvalidCacheDomain);
+		}
 		return WaitingQueue[bBackgroundWorker].Notify() != 0;
 	}
 
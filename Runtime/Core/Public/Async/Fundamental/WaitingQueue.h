@@ -72,7 +72,8 @@ namespace LowLevelTasks::Private
 		// First step run by normal workers when no more work is found in the queues.
 		CORE_API void PrepareWait(FWaitEvent* Node);
 		// Second step run by normal workers when no more work is found in the queues.
-		CORE_API bool CommitWait(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycles, int32 WaitCycles);
+		// When OutSpinCycles is provided, the time spent spinning before blocking on the event is added to it.
+		CORE_API bool CommitWait(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycles, int32 WaitCycles, uint64* OutSpinCycles = nullptr);
 
 		// Step to run by normal workers if they detect new work after they called prepare wait.
 		// Returns true if we need to wake up a new worker.
@@ -80,7 +81,8 @@ namespace LowLevelTasks::Private
 
 		// Increment oversubscription and notify a thread if we're under the allowed thread count.
 		// If dynamic thread creation is allowed, this could spawn a new thread if needed.
-		CORE_API void IncrementOversubscription();
+		// Callers that wake workers parked in other waiting queues first can skip the notification here.
+		CORE_API void IncrementOversubscription(bool bNotify = true);
 
 		// Decrement oversubscription only, any active threads will finish their current task and will
 		// go to sleep if conditional standby determines we're now over the active thread count.
@@ -99,7 +101,7 @@ namespace LowLevelTasks::Private
 	private:
 		CORE_API bool  TryStartNewThread();
 		CORE_API int32 NotifyInternal(int32 Count);
-		CORE_API void  Park(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycles, int32 WaitCycles);
+		CORE_API void  Park(FWaitEvent* Node, FOutOfWork& OutOfWork, int32 SpinCycles, int32 WaitCycles, uint64* OutSpinCycles);
 		CORE_API int32 Unpark(FWaitEvent* InNode);
 		CORE_API void  CheckState(uint64 State, bool bIsWaiter = false);
 		CORE_API void  CheckStandbyState(uint64 State);
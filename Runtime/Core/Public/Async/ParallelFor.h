@@ -60,6 +60,10 @@ enum class EParallelForFlags
 
 	// tasks should run on background priority threads
 	BackgroundPriority = 8,
+
+	//Splits the range into one contiguous sub-range per worker, idle workers steal the back half of the largest remaining sub-range.
+	//Keeps neighbouring iterations on the same core and adapts the granularity to the body cost, MinBatchSize is the smallest range that is split.
+	RangeSplitting = 16,
 };
 
 ENUM_CLASS_FLAGS(EParallelForFlags)
@@ -158,7 +162,13 @@ namespace ParallelForImpl
 		int32 BatchSize = 1;
 		int32 NumBatches = Num;
 		bool bIsUnbalanced = (Flags & EParallelForFlags::Unbalanced) == EParallelForFlags::Unbalanced;
-		if (!bIsUnbalanced)
+		const bool bRangeSplitting = (Flags & EParallelForFlags::RangeSplitting) == EParallelForFlags::RangeSplitting;
+		if (bRangeSplitting)
+		{
+			// ranges are split on demand, the batch size is only used as the splitting grain and every item is tracked individually
+			BatchSize = FMath::Max(MinBatchSize, 1);
+		}
+		else if (!bIsUnbalanced)
 		{
 			for (int32 Div = 6; Div; Div--)
 			{
@@ -205,6 +215,28 @@ namespace ParallelForImpl
 			std::atomic<TaskTrace::FId> TraceId = TaskTrace::InvalidId;
 		};
 
+		// [Begin, End) of the items owned by a worker in EParallelForFlags::RangeSplitting mode, packed in a single word so that
+		// the owner taking items from the front and thieves splitting off the back half can race on it with a single CAS
+		struct alignas(PLATFORM_CACHE_LINE_SIZE) FWorkerRange
+		{
+			static constexpr uint64 Pack(int32 Begin, int32 End)
+			{
+				return (uint64(uint32(Begin)) << 32) | uint64(uint32(End));
+			}
+
+			static constexpr int32 GetBegin(uint64 Range)
+			{
+				return int32(uint32(Range >> 32));
+			}
+
+			static constexpr int32 GetEnd(uint64 Range)
+			{
+				return int32(uint32(Range));
+			}
+
+			std::atomic<uint64> Range { 0 };
+		};
+
 		//shared data between tasks
 		struct alignas(PLATFORM_CACHE_LINE_SIZE) FParallelForData 
 			: public TConcurrentLinearObject<FParallelForData, FTaskGraphBlockAllocationTag>
@@ -213,7 +245,7 @@ namespace ParallelForImpl
 		{
 			using UE::FInheritedContextBase::RestoreInheritedContext;
 
-			FParallelForData(const TCHAR* InDebugName, int32 InNum, int32 InBatchSize, int32 InNumBatches, int32 InNumWorkers, const TArrayView<ContextType>& InContexts, const BodyType& InBody, FEventRef& InFinishedSignal, LowLevelTasks::ETaskPriority InPriority)
+			FParallelForData(const TCHAR* InDebugName, int32 InNum, int32 InBatchSize, int32 InNumBatches, int32 InNumWorkers, const TArrayView<ContextType>& InContexts, const BodyType& InBody, FEventRef& InFinishedSignal, LowLevelTasks::ETaskPriority InPriority, bool bInRangeSplitting)
 				: DebugName(InDebugName)
 				, Num(InNum)
 				, BatchSize(InBatchSize)
@@ -222,10 +254,24 @@ namespace ParallelForImpl
 				, Body(InBody)
 				, FinishedSignal(InFinishedSignal)
 				, Priority(InPriority)
+				, bRangeSplitting(bInRangeSplitting)
 			{
 				IncompleteBatches.store(NumBatches, std::memory_order_relaxed);
 				Tasks.AddDefaulted(InNumWorkers);
 
+				if (bRangeSplitting)
+				{
+					// one contiguous range per worker plus one for the master, which uses the last worker index
+					const int32 NumRanges = InNumWorkers + 1;
+					Ranges.AddDefaulted(NumRanges);
+					for (int32 RangeIndex = 0; RangeIndex < NumRanges; RangeIndex++)
+					{
+						const int32 Begin = int32((int64(Num) * RangeIndex) / NumRanges);
+						const int32 End = int32((int64(Num) * (RangeIndex + 1)) / NumRanges);
+						Ranges[RangeIndex].Range.store(FWorkerRange::Pack(Begin, End), std::memory_order_relaxed);
+					}
+				}
+
 				CaptureInheritedContext();
 			}
 
@@ -257,8 +303,10 @@ namespace ParallelForImpl
 			const BodyType& Body;
 			FEventRef& FinishedSignal;
 			LowLevelTasks::ETaskPriority Priority;
+			bool bRangeSplitting;
 
 			TArray<FTracedTask, TConcurrentLinearArrayAllocator<FTaskGraphBlockAllocationTag>> Tasks;
+			TArray<FWorkerRange, TConcurrentLinearArrayAllocator<FTaskGraphBlockAllocationTag>> Ranges;
 		};
 		using FDataHandle = TRefCountPtr<FParallelForData>;
 
@@ -315,7 +363,11 @@ namespace ParallelForImpl
 
 				// We're going to consume one ourself, so we need at least 2 left to consider launching a new worker
 				// We also do not launch a worker from the master as we already launched one before doing prework.
-				if (bIsMaster == false && Data->BatchItem.load(std::memory_order_relaxed) + 2 <= NumBatches)
+				// In range splitting mode the IncompleteBatches counts items, a new worker is only worth it if it can split off at least a batch.
+				const bool bHasWorkLeft = Data->bRangeSplitting
+					? Data->IncompleteBatches.load(std::memory_order_relaxed) >= 2 * Data->BatchSize
+					: Data->BatchItem.load(std::memory_order_relaxed) + 2 <= NumBatches;
+				if (bIsMaster == false && bHasWorkLeft)
 				{
 					LaunchAnotherWorkerIfNeeded(Data);
 				}
@@ -338,6 +390,62 @@ namespace ParallelForImpl
 				const TArrayView<ContextType>& Contexts = Data->Contexts;
 				const BodyType& Body = Data->Body;
 
+				if (Data->bRangeSplitting)
+				{
+					std::atomic<uint64>& OwnRange = Data->Ranges[WorkerIndex].Range;
+					for (;;)
+					{
+						uint64 Range = OwnRange.load(std::memory_order_acquire);
+						const int32 Begin = FWorkerRange::GetBegin(Range);
+						const int32 End = FWorkerRange::GetEnd(Range);
+						if (Begin >= End)
+						{
+							// Only the owner refills its empty range, so nobody can race with us installing a stolen range
+							if (!StealRange(OwnRange))
+							{
+								// Nothing left to split, remaining items are being processed by other workers
+								return false;
+							}
+							continue;
+						}
+
+						// Take a chunk from the front that shrinks with the remaining range, so that a thief always finds the bulk of it
+						// while the number of CAS stays logarithmic in the range size
+						const int32 ChunkSize = FMath::Min(End - Begin, FMath::Max(BatchSize, (End - Begin) / 8));
+						if (!OwnRange.compare_exchange_weak(Range, FWorkerRange::Pack(Begin + ChunkSize, End), std::memory_order_acq_rel, std::memory_order_relaxed))
+						{
+							continue;
+						}
+
+						for (int32 Index = Begin; Index < Begin + ChunkSize; Index++)
+						{
+							CallBody(Body, Contexts, WorkerIndex, Index);
+						}
+
+						// Same as below, the last one to complete items publishes the results and signals the master
+						if (Data->IncompleteBatches.fetch_sub(ChunkSize, std::memory_order_acq_rel) == ChunkSize)
+						{
+							if (!bIsMaster)
+							{
+								Data->FinishedSignal->Trigger();
+							}
+
+							return true;
+						}
+						else if (!bIsBackgroundPriority)
+						{
+							continue;
+						}
+
+						if (Now() - Start > YieldingThreshold)
+						{
+							// Abort and reschedule to give higher priority tasks a chance to run, our range stays available to thieves meanwhile
+							bReschedule = true;
+							return false;
+						}
+					}
+				}
+
 				const bool bSaveLastBlockForMaster = (Num > NumBatches);
 				for(;;)
 				{
@@ -394,6 +502,47 @@ namespace ParallelForImpl
 				}
 			}
 
+			// Moves the back half of the largest remaining range into OwnRange, the victim keeps the front half its caches are warm on.
+			// Returns false when all ranges are empty.
+			bool StealRange(std::atomic<uint64>& OwnRange) const
+			{
+				const int32 BatchSize = Data->BatchSize;
+				for (;;)
+				{
+					int32 VictimIndex = INDEX_NONE;
+					uint64 VictimRange = 0;
+					int32 VictimSize = 0;
+					for (int32 RangeIndex = 0; RangeIndex < Data->Ranges.Num(); RangeIndex++)
+					{
+						const uint64 Range = Data->Ranges[RangeIndex].Range.load(std::memory_order_acquire);
+						const int32 Size = FWorkerRange::GetEnd(Range) - FWorkerRange::GetBegin(Range);
+						if (Size > VictimSize)
+						{
+							VictimIndex = RangeIndex;
+							VictimRange = Range;
+							VictimSize = Size;
+						}
+					}
+
+					if (VictimIndex == INDEX_NONE)
+					{
+						return false;
+					}
+
+					// Ranges below two batches are not worth splitting, take them as a whole
+					const int32 Begin = FWorkerRange::GetBegin(VictimRange);
+					const int32 End = FWorkerRange::GetEnd(VictimRange);
+					const int32 Split = VictimSize >= 2 * BatchSize ? Begin + VictimSize / 2 : Begin;
+
+					// Items are never handed back, so a range can't reappear with the same bounds after it changed (no ABA)
+					if (Data->Ranges[VictimIndex].Range.compare_exchange_strong(VictimRange, FWorkerRange::Pack(Begin, Split), std::memory_order_acq_rel, std::memory_order_relaxed))
+					{
+						OwnRange.store(FWorkerRange::Pack(Split, End), std::memory_order_release);
+						return true;
+					}
+				}
+			}
+
 			static void LaunchTask(FDataHandle&& InData, int32 InWorkerIndex, bool bWakeUpWorker = true)
 			{
 				FTracedTask& TracedTask = InData->Tasks[InWorkerIndex];
@@ -425,7 +574,7 @@ namespace ParallelForImpl
 
 		//launch all the worker tasks
 		FEventRef FinishedSignal { EEventMode::ManualReset };
-		FDataHandle Data = new FParallelForData(DebugName, Num, BatchSize, NumBatches, NumWorkers, Contexts, Body, FinishedSignal, Priority);
+		FDataHandle Data = new FParallelForData(DebugName, Num, BatchSize, NumBatches, NumWorkers, Contexts, Body, FinishedSignal, Priority, bRangeSplitting);
 
 		// Launch the first worker before we start doing prework
 		FParallelExecutor::LaunchAnotherWorkerIfNeeded(Data);
@@ -467,7 +616,7 @@ namespace ParallelForImpl
 				}
 			}
 		}
-		checkSlow(LocalExecutor.GetData()->BatchItem.load(std::memory_order_relaxed) * LocalExecutor.GetData()->BatchSize >= LocalExecutor.GetData()->Num);
+		checkSlow(bRangeSplitting || LocalExecutor.GetData()->BatchItem.load(std::memory_order_relaxed) * LocalExecutor.GetData()->BatchSize >= LocalExecutor.GetData()->Num);
 	}
 }
 
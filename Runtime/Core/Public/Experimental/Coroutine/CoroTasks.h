@@ -0,0 +1,109 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Coroutine.h"
+#include "Tasks/Task.h"
+
+#if WITH_CPP_COROUTINES
+
+namespace CoroTask_Detail
+{
+	COROFORCEINLINE bool IsTaskCompleted(const UE::Tasks::Private::FTaskHandle& Task)
+	{
+		return Task.IsCompleted();
+	}
+
+	COROFORCEINLINE bool IsTaskCompleted(const FGraphEventRef& Task)
+	{
+		return !Task.IsValid() || Task->IsCompleted();
+	}
+
+	COROFORCEINLINE bool IsTaskCompleted(const UE::Tasks::Private::FTaskBase* Task)
+	{
+		return Task == nullptr || Task->IsCompleted();
+	}
+}
+
+/*
+* TCoroTasksAwaitable suspends a launched Coroutine until a collection of UE::Tasks (or FGraphEvents) is completed,
+* instead of blocking the thread that runs it. Like FCoroEvent the resumption can't be expedited, so it can't be used with SYNC_INVOKE.
+* usage: CO_AWAIT CoroAwaitTasks(Prerequisites);
+*/
+template<typename TaskCollectionType>
+class TCoroTasksAwaitable
+{
+	const TaskCollectionType& Tasks;
+
+public:
+	explicit TCoroTasksAwaitable(const TaskCollectionType& InTasks) : Tasks(InTasks)
+	{
+	}
+
+	inline bool await_ready() const noexcept
+	{
+		for (const auto& Task : Tasks)
+		{
+			if (!CoroTask_Detail::IsTaskCompleted(Task))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename PromiseType>
+	inline void await_suspend(coroutine_handle<PromiseType> Continuation) noexcept
+	{
+		FLockedTask DummyTask = FLockedTask::Create();
+		Continuation.promise().Suspend(DummyTask.GetPromise());
+
+		// the unlocking task is never executed inline, the Coroutine might still be suspending on this thread
+		UE::Tasks::Launch(TEXT("CoroTasksAwaitable"), [DummyTask = MoveTemp(DummyTask)]() mutable
+		{
+			while (!DummyTask.HasSubsequent())
+			{
+				//This is only spinning for a very short time because the subsequent is registered right after the Coroutine left await_suspend.
+				FPlatformProcess::Yield();
+			}
+			DummyTask.Unlock();
+		}, Tasks, UE::Tasks::ETaskPriority::High);
+	}
+
+	inline void await_resume() noexcept
+	{
+		//waiting does not return any values
+	}
+};
+
+/*
+* Suspends the calling Coroutine until all Tasks are completed
+* @param Tasks: any iterable collection of UE::Tasks or FGraphEventRefs, `UE::Tasks::Prerequisites()` can be used to build one on the fly
+*/
+template<typename TaskCollectionType>
+inline TCoroTasksAwaitable<TaskCollectionType> CoroAwaitTasks(const TaskCollectionType& Tasks)
+{
+	return TCoroTasksAwaitable<TaskCollectionType>(Tasks);
+}
+
+/*
+* Launches a Coroutine Task and returns a UE::Tasks::FTask that is completed with it, so that regular tasks can use the Coroutine as a prerequisite
+* and named threads can wait for it while executing other work
+*/
+inline UE::Tasks::FTask LaunchCoroAsTask(const TCHAR* DebugName, CORO_TASK(void)&& CoroTask, LowLevelTasks::ETaskPriority Priority = LowLevelTasks::ETaskPriority::Normal)
+{
+	UE::Tasks::FTaskEvent CompletionEvent(DebugName);
+
+	auto CompletionLambda = [](CORO_TASK(void) InnerTask, UE::Tasks::FTaskEvent InCompletionEvent) -> CORO_TASK(void)
+	{
+		CO_AWAIT InnerTask;
+		InCompletionEvent.Trigger();
+		CO_RETURN_TASK();
+	};
+	// the launched Coroutine keeps itself alive until it's done, completion is only observed through the event
+	LAUNCHED_TASK(void) LaunchedTask = CompletionLambda(MoveTemp(CoroTask), CompletionEvent).Launch(DebugName, Priority, LowLevelTasks::EQueuePreference::GlobalQueuePreference);
+
+	return CompletionEvent;
+}
+
+#endif // WITH_CPP_COROUTINES
@@ -421,6 +421,25 @@ struct FProcessorGroupDesc
 	uint16 NumProcessorGroups = 0;
 };
 
+/**
+ * A set of logical processors that share a last level cache and a NUMA node.
+ * Workers placed in the same cache domain can exchange work without crossing a socket or an L3 boundary.
+ */
+struct FProcessorCacheDomain
+{
+	uint64 ThreadAffinity = 0;
+	uint16 ProcessorGroup = 0;
+	uint16 NumaNode = 0;
+};
+
+struct FProcessorTopologyDesc
+{
+	static constexpr uint16 MaxNumCacheDomains = 64;
+	FProcessorCacheDomain CacheDomains[MaxNumCacheDomains] = {};
+	uint16 NumCacheDomains = 0;
+	uint16 NumNumaNodes = 0;
+};
+
 /**
  * Different types of Page Fault stats
  */
@@ -1168,6 +1187,11 @@ public:
 	*/
 	static CORE_API const FProcessorGroupDesc& GetProcessorGroupDesc();
 
+	/**
+	* @return a description of the last level cache domains and NUMA nodes of the current system, one domain per processor group by default
+	*/
+	static CORE_API const FProcessorTopologyDesc& GetProcessorTopologyDesc();
+
 	/**
 	 * return the number of logical CPU cores
 	 */
@@ -135,6 +135,12 @@ struct FExternalPhysicsCustomObjectVersion
 		// Added one-way interaction flag
 		AddOneWayInteraction,
 
+		// Triangle mesh BVH can be stored with quantized bounds
+		TrimeshQuantizedBVH,
+
+		// Static AABBTree stores whether queries use wide nodes
+		AABBTreeUseWideNodes,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
 		LatestVersion = VersionPlusOne - 1
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Containers/ArrayView.h"
+#include "Containers/StringFwd.h"
 #include "UObject/NameTypes.h"
 #include "Templates/Function.h"
 
@@ -54,4 +55,15 @@ CORE_API TArray<FDisplayNameEntryId> LoadNameBatch(FArchive& Ar, ENameBatchLoadi
 // @return function that waits before returning result, like a simple future.
 CORE_API TFunction<TArray<FDisplayNameEntryId>()> LoadNameBatchAsync(FArchive& Ar, uint32 MaxWorkers, ENameBatchLoadingFlags Flags = ENameBatchLoadingFlags::None);
 
+//////////////////////////////////////////////////////////////////////////
+
+// Create names from many strings at once, e.g. when deserializing string tables without saved hashes.
+//
+// Yields the same names as constructing each FName with FNAME_Add, number suffixes included.
+// Large batches are hashed up front and stored one name pool shard at a time, taking each shard lock once.
+//
+// @param OutNames must have as many elements as Strings
+CORE_API void CreateNameBatch(TArrayView<const FAnsiStringView> Strings, TArrayView<FName> OutNames);
+CORE_API void CreateNameBatch(TArrayView<const FWideStringView> Strings, TArrayView<FName> OutNames);
+
 //////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -63,6 +63,7 @@ struct FUnixPlatformMisc : public FGenericPlatformMisc
 
 	static CORE_API int32 NumberOfCores();
 	static CORE_API int32 NumberOfCoresIncludingHyperthreads();
+	static CORE_API const FProcessorTopologyDesc& GetProcessorTopologyDesc();
 	static CORE_API FString GetOperatingSystemId();
 	static CORE_API bool GetDiskTotalAndFreeSpace(const FString& InPath, uint64& TotalNumberOfBytes, uint64& NumberOfFreeBytes);
 	static CORE_API bool GetPageFaultStats(FPageFaultStats& OutStats, EPageFaultFlags Flags=EPageFaultFlags::All);
@@ -87,6 +87,11 @@ protected:
 
 	void SetThreadPriority(pthread_t InThread, EThreadPriority NewPriority) override;
 
+public:
+
+	/** When TaskGraph.UseCacheDomainAffinity is enabled, pins the thread to the logical cpus of Affinity, where processor group N maps to cpus [N * 64, N * 64 + 63]. */
+	bool SetThreadAffinity(const FThreadAffinity& Affinity) override;
+
 private:
 
 	/**
@@ -1274,6 +1274,76 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 		UE_BENCHMARK(5, TestBatchSpawning<100000>);
 	}
 
+	// busy loop for about the given number of nanoseconds, used to emulate ParallelFor bodies of a known cost
+	inline void SpinForNanoseconds(uint64 Nanoseconds)
+	{
+		const uint64 EndCycles = FPlatformTime::Cycles64() + uint64(double(Nanoseconds) * 1e-9 / FPlatformTime::GetSecondsPerCycle64());
+		while (FPlatformTime::Cycles64() < EndCycles)
+		{
+		}
+	}
+
+	template<int32 Num, EParallelForFlags Flags>
+	void ParallelForCheapBodyTest()
+	{
+		// ~10ns per item, dominated by the scheduling overhead and the cache locality of the batches
+		TArray<float> Data;
+		Data.SetNumZeroed(Num);
+		ParallelFor(TEXT("ParallelForCheapBodyTest"), Num, 1,
+			[&Data](int32 Index)
+			{
+				float Value = Data[Index];
+				for (int32 Iteration = 0; Iteration < 8; ++Iteration)
+				{
+					Value = Value * 0.5f + 1.0f;
+				}
+				Data[Index] = Value;
+			}, Flags);
+	}
+
+	template<int32 Num, EParallelForFlags Flags>
+	void ParallelForExpensiveBodyTest()
+	{
+		// ~10us per item, every 16th item being 10x more expensive to reward load balancing
+		ParallelFor(TEXT("ParallelForExpensiveBodyTest"), Num, 1, [](int32 Index) { SpinForNanoseconds((Index % 16 == 0) ? 100'000 : 10'000); }, Flags);
+	}
+
+	TEST_CASE_NAMED(FTaskGraphParallelForRangeSplittingTest, "System::Core::Async::TaskGraph::ParallelForRangeSplitting", "[.][ApplicationContextMask][EngineFilter]")
+	{
+		{	// every item is visited exactly once, with and without contexts
+			for (int32 Num : { 1, 2, 3, 7, 100, 1000, 100000 })
+			{
+				for (int32 MinBatchSize : { 1, 3, 64 })
+				{
+					TArray<int32> Visits;
+					Visits.SetNumZeroed(Num);
+					ParallelFor(TEXT("RangeSplitting"), Num, MinBatchSize, [&Visits](int32 Index) { FPlatformAtomics::InterlockedIncrement(&Visits[Index]); }, EParallelForFlags::RangeSplitting);
+					for (int32 Index = 0; Index < Num; ++Index)
+					{
+						check(Visits[Index] == 1);
+					}
+				}
+
+				TArray<int64> Contexts;
+				ParallelForWithTaskContext(Contexts, Num, [](int64& Sum, int32 Index) { Sum += Index; }, EParallelForFlags::RangeSplitting);
+				int64 Total = 0;
+				for (int64 Sum : Contexts)
+				{
+					Total += Sum;
+				}
+				check(Total == int64(Num) * (Num - 1) / 2);
+			}
+		}
+
+		UE_BENCHMARK(5, ParallelForCheapBodyTest<1'000'000, EParallelForFlags::None>);
+		UE_BENCHMARK(5, ParallelForCheapBodyTest<1'000'000, EParallelForFlags::Unbalanced>);
+		UE_BENCHMARK(5, ParallelForCheapBodyTest<1'000'000, EParallelForFlags::RangeSplitting>);
+
+		UE_BENCHMARK(5, ParallelForExpensiveBodyTest<2'000, EParallelForFlags::None>);
+		UE_BENCHMARK(5, ParallelForExpensiveBodyTest<2'000, EParallelForFlags::Unbalanced>);
+		UE_BENCHMARK(5, ParallelForExpensiveBodyTest<2'000, EParallelForFlags::RangeSplitting>);
+	}
+
 	template<uint32 Num>
 	void OversubscriptionStressTest()
 	{
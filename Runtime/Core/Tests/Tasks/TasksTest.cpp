@@ -12,11 +12,15 @@
 #include "Async/ManualResetEvent.h"
 #include "Tests/TestHarnessAdapter.h"
 #include "Containers/UnrealString.h"
+#include "Experimental/Coroutine/CoroTasks.h"
 
 #include <atomic>
 
 #if WITH_TESTS
 
+extern CORE_API bool GTaskGraphUseCacheDomainAffinity;
+extern CORE_API bool GTaskGraphWorkerStats;
+
 namespace UE { namespace TasksTests
 {
 	using namespace Tasks;
@@ -1792,6 +1796,179 @@ namespace UE { namespace TasksTests
 		LowLevelTasks::FScheduler::Get().RestartWorkers();
 	}
 
+	// ParallelFor over a working set that is re-read every pass, locality of the workers that steal the iterations dominates the cost
+	template<int32 NumElements, int32 NumPasses>
+	void ParallelForCacheLocalityTest()
+	{
+		TArray<float> Data;
+		Data.SetNumUninitialized(NumElements);
+		ParallelFor(NumElements, [&Data](int32 Index) { Data[Index] = float(Index); });
+
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			ParallelFor(TEXT("CacheLocalityTest"), NumElements / 1024, 1,
+				[&Data](int32 BlockIndex)
+				{
+					float* Block = Data.GetData() + BlockIndex * 1024;
+					for (int32 Index = 0; Index < 1024; ++Index)
+					{
+						Block[Index] = Block[Index] * 0.5f + 1.0f;
+					}
+				});
+		}
+	}
+
+	// Launch one batch of nested ParallelFor per cache domain with a domain hint
+	template<int32 NumElements>
+	void CacheDomainHintTest()
+	{
+		LowLevelTasks::FScheduler& Scheduler = LowLevelTasks::FScheduler::Get();
+		const uint32 NumCacheDomains = Scheduler.GetNumCacheDomains();
+
+		TArray<FTask> Tasks;
+		for (uint32 CacheDomain = 0; CacheDomain < NumCacheDomains; ++CacheDomain)
+		{
+			LowLevelTasks::FCacheDomainAffinityScope AffinityScope(CacheDomain);
+			Tasks.Add(Launch(UE_SOURCE_LOCATION, [] { ParallelForCacheLocalityTest<NumElements, 4>(); }));
+		}
+		Wait(Tasks);
+	}
+
+	TEST_CASE_NAMED(FTasksCacheDomainAffinityBenchmark, "System::Core::Async::Tasks::CacheDomainAffinity", "[.][ApplicationContextMask][EngineFilter]")
+	{
+		const bool bPreviousCacheDomainAffinity = GTaskGraphUseCacheDomainAffinity;
+
+		for (bool bCacheDomainAffinity : { false, true })
+		{
+			GTaskGraphUseCacheDomainAffinity = bCacheDomainAffinity;
+			LowLevelTasks::FScheduler::Get().RestartWorkers();
+
+			UE_LOG(LogTemp, Display, TEXT("Cache domain affinity %s, %u cache domains, %u workers"), bCacheDomainAffinity ? TEXT("enabled") : TEXT("disabled"), LowLevelTasks::FScheduler::Get().GetNumCacheDomains(), LowLevelTasks::FScheduler::Get().GetNumWorkers());
+
+			// the hint must never strand work, even when it targets another domain than the launching thread
+			{
+				std::atomic<int32> NumExecuted = 0;
+				TArray<FTask> Tasks;
+				for (uint32 CacheDomain = 0; CacheDomain < LowLevelTasks::FScheduler::Get().GetNumCacheDomains() + 1; ++CacheDomain)
+				{
+					LowLevelTasks::FCacheDomainAffinityScope AffinityScope(CacheDomain);
+					Tasks.Add(Launch(UE_SOURCE_LOCATION, [&NumExecuted] { ++NumExecuted; }));
+				}
+				Wait(Tasks);
+				check(NumExecuted == Tasks.Num());
+			}
+
+			UE_BENCHMARK(5, ParallelForCacheLocalityTest<256 * 1024, 100>);
+			UE_BENCHMARK(5, ParallelForCacheLocalityTest<16 * 1024 * 1024, 10>);
+			UE_BENCHMARK(5, CacheDomainHintTest<4 * 1024 * 1024>);
+		}
+
+		// Restore original worker setup
+		GTaskGraphUseCacheDomainAffinity = bPreviousCacheDomainAffinity;
+		LowLevelTasks::FScheduler::Get().RestartWorkers();
+	}
+
+	TEST_CASE_NAMED(FTasksWorkerStats, "System::Core::Async::Tasks::WorkerStats", "[.][ApplicationContextMask][EngineFilter]")
+	{
+		const bool bPreviousWorkerStats = GTaskGraphWorkerStats;
+		GTaskGraphWorkerStats = true;
+
+		// unbalanced bodies so that workers both steal and go idle
+		ParallelFor(TEXT("WorkerStatsTest"), 10000, 1, [](int32 Index) { FPlatformProcess::SleepNoStats((Index % 100 == 0) ? 0.001f : 0.0f); });
+		UE_BENCHMARK(5, TestWorkStealing<100, 100>);
+
+		FStringOutputDevice Output;
+		LowLevelTasks::FScheduler::Get().DumpWorkerStats(Output, true /* bReset */);
+		UE_LOG(LogTemp, Display, TEXT("%s"), *Output);
+		check(Output.Contains(TEXT("Total")));
+
+		GTaskGraphWorkerStats = bPreviousWorkerStats;
+	}
+
+#if WITH_CPP_COROUTINES
+	// Emulates a render thread scene update made of phases that each need the tasks launched by the previous phase, followed by
+	// work that doesn't depend on the update. Compares the time the calling thread spends blocked with plain waits and with coroutines.
+	namespace CoroSceneUpdate
+	{
+		constexpr int32 NumPhases = 8;
+		constexpr int32 NumTasksPerPhase = 16;
+		constexpr int32 NumOtherWorkItems = 64;
+		constexpr double WorkItemSeconds = 20e-6;
+
+		double BlockedSeconds = 0.0;
+
+		void DoWorkItem()
+		{
+			const double EndTime = FPlatformTime::Seconds() + WorkItemSeconds;
+			while (FPlatformTime::Seconds() < EndTime)
+			{
+			}
+		}
+
+		TArray<FTask> LaunchPhase()
+		{
+			TArray<FTask> Tasks;
+			for (int32 TaskIndex = 0; TaskIndex < NumTasksPerPhase; ++TaskIndex)
+			{
+				Tasks.Add(Launch(UE_SOURCE_LOCATION, [] { DoWorkItem(); }));
+			}
+			return Tasks;
+		}
+
+		void BlockingWaits()
+		{
+			for (int32 Phase = 0; Phase < NumPhases; ++Phase)
+			{
+				TArray<FTask> Tasks = LaunchPhase();
+				const double WaitStart = FPlatformTime::Seconds();
+				Wait(Tasks);
+				BlockedSeconds += FPlatformTime::Seconds() - WaitStart;
+			}
+
+			for (int32 WorkIndex = 0; WorkIndex < NumOtherWorkItems; ++WorkIndex)
+			{
+				DoWorkItem();
+			}
+		}
+
+		CORO_TASK(void) UpdatePhases()
+		{
+			for (int32 Phase = 0; Phase < NumPhases; ++Phase)
+			{
+				TArray<FTask> Tasks = LaunchPhase();
+				CO_AWAIT CoroAwaitTasks(Tasks);
+			}
+			CO_RETURN_TASK();
+		}
+
+		void CoroutineSuspension()
+		{
+			FTask SceneUpdate = LaunchCoroAsTask(TEXT("CoroSceneUpdate"), UpdatePhases());
+
+			// the calling thread is free to do other work while the update is suspended on its prerequisites
+			for (int32 WorkIndex = 0; WorkIndex < NumOtherWorkItems; ++WorkIndex)
+			{
+				DoWorkItem();
+			}
+
+			const double WaitStart = FPlatformTime::Seconds();
+			SceneUpdate.Wait();
+			BlockedSeconds += FPlatformTime::Seconds() - WaitStart;
+		}
+	}
+
+	TEST_CASE_NAMED(FTasksCoroSceneUpdateBenchmark, "System::Core::Async::Tasks::CoroSceneUpdate", "[.][ApplicationContextMask][EngineFilter]")
+	{
+		CoroSceneUpdate::BlockedSeconds = 0.0;
+		UE_BENCHMARK(5, CoroSceneUpdate::BlockingWaits);
+		UE_LOG(LogTemp, Display, TEXT("Blocking waits: %.3f ms blocked per run"), CoroSceneUpdate::BlockedSeconds * 1000.0 / 5);
+
+		CoroSceneUpdate::BlockedSeconds = 0.0;
+		UE_BENCHMARK(5, CoroSceneUpdate::CoroutineSuspension);
+		UE_LOG(LogTemp, Display, TEXT("Coroutine suspension: %.3f ms blocked per run"), CoroSceneUpdate::BlockedSeconds * 1000.0 / 5);
+	}
+#endif // WITH_CPP_COROUTINES
+
 #if PLATFORM_SUPPORTS_ASYMMETRIC_FENCES
 	TEST_CASE_NAMED(FAsymmetricThreadFence, "System::Core::Async::AsymmetricThreadFence", "[.][ApplicationContextMask][EngineFilter]")
 	{
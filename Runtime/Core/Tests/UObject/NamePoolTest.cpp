@@ -0,0 +1,136 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_TESTS
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include "UObject/NameBatchSerialization.h"
+#include "Tests/TestHarnessAdapter.h"
+
+#include <atomic>
+
+namespace UE::NamePoolTest
+{
+	/** Runs Body(ThreadIndex) on NumThreads threads released at the same time, returns the wall time in seconds */
+	static double RunOnThreads(int32 NumThreads, TFunctionRef<void(int32)> Body)
+	{
+		std::atomic<int32> NumReady{0};
+		std::atomic<bool> bStart{false};
+
+		TArray<FThread> Threads;
+		Threads.Reserve(NumThreads);
+		for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+		{
+			Threads.Emplace(TEXT("NamePoolTest"), [&NumReady, &bStart, &Body, ThreadIndex]()
+			{
+				NumReady.fetch_add(1);
+				while (!bStart.load(std::memory_order_acquire))
+				{
+					FPlatformProcess::Yield();
+				}
+				Body(ThreadIndex);
+			});
+		}
+
+		while (NumReady.load() < NumThreads)
+		{
+			FPlatformProcess::Yield();
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		bStart.store(true, std::memory_order_release);
+		for (FThread& Thread : Threads)
+		{
+			Thread.Join();
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+TEST_CASE_NAMED(FNamePoolPerfTest, "System::Core::UObject::NamePoolPerf", "[ApplicationContextMask][PerfFilter]")
+{
+	using namespace UE::NamePoolTest;
+
+	// The total amount of names is fixed so names/sec is comparable across thread counts.
+	// Every run creates names that don't exist yet, this permanently grows the name pool by a few MB.
+	const int32 NumNames = 1 << 17;
+	const int32 ThreadCounts[] = {1, 2, 4, 8, 16, 32};
+
+	for (int32 NumThreads : ThreadCounts)
+	{
+		const int32 NamesPerThread = NumNames / NumThreads;
+
+		auto MakeStrings = [NumThreads, NamesPerThread](const TCHAR* Mode)
+		{
+			TArray<TArray<FString>> Strings;
+			Strings.SetNum(NumThreads);
+			for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+			{
+				Strings[ThreadIndex].Reserve(NamesPerThread);
+				for (int32 Index = 0; Index < NamesPerThread; ++Index)
+				{
+					Strings[ThreadIndex].Add(FString::Printf(TEXT("/Game/NamePoolPerf/%s%d/Thread%d/Asset%d.Asset%d"), Mode, NumThreads, ThreadIndex, Index, Index));
+				}
+			}
+			return Strings;
+		};
+
+		auto Log = [NumThreads](const TCHAR* Mode, double Seconds)
+		{
+			GLog->Logf(TEXT("%-24s %2d threads: %6.2f M names/s"), Mode, NumThreads, NumNames / Seconds / 1.0e6);
+		};
+
+		// Create new names one at a time
+		const TArray<TArray<FString>> SingleStrings = MakeStrings(TEXT("Single"));
+		Log(TEXT("Create"), RunOnThreads(NumThreads, [&SingleStrings](int32 ThreadIndex)
+		{
+			for (const FString& String : SingleStrings[ThreadIndex])
+			{
+				FName Name(*String);
+			}
+		}));
+
+		// Find and add names that exist, which takes no shard locks
+		Log(TEXT("Find existing"), RunOnThreads(NumThreads, [&SingleStrings](int32 ThreadIndex)
+		{
+			for (const FString& String : SingleStrings[ThreadIndex])
+			{
+				FName Name(*String, FNAME_Find);
+			}
+		}));
+
+		Log(TEXT("Add existing"), RunOnThreads(NumThreads, [&SingleStrings](int32 ThreadIndex)
+		{
+			for (const FString& String : SingleStrings[ThreadIndex])
+			{
+				FName Name(*String);
+			}
+		}));
+
+		// Create new names in batches, taking each shard lock once per batch
+		const TArray<TArray<FString>> BatchStrings = MakeStrings(TEXT("Batch"));
+		TArray<TArray<FName>> BatchNames;
+		BatchNames.SetNum(NumThreads);
+		Log(TEXT("Create batch"), RunOnThreads(NumThreads, [&BatchStrings, &BatchNames](int32 ThreadIndex)
+		{
+			TArray<FWideStringView> Views;
+			Views.Reserve(BatchStrings[ThreadIndex].Num());
+			for (const FString& String : BatchStrings[ThreadIndex])
+			{
+				Views.Add(String);
+			}
+
+			BatchNames[ThreadIndex].SetNum(Views.Num());
+			CreateNameBatch(Views, BatchNames[ThreadIndex]);
+		}));
+
+		for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+		{
+			CHECK(BatchNames[ThreadIndex].Last() == FName(*BatchStrings[ThreadIndex].Last(), FNAME_Find));
+			CHECK(FName(*SingleStrings[ThreadIndex].Last(), FNAME_Find) != NAME_None);
+		}
+	}
+}
+
+#endif // WITH_TESTS
@@ -57,6 +57,8 @@
 #include "Serialization/UnversionedPropertySerialization.h"
 #include "Internationalization/PackageLocalizationManager.h"
 #include "Serialization/Zenaphore.h"
+#include "Serialization/AsyncLoadingPrefetch.h"
+#include "Serialization/AsyncLoadingPostLoad.h"
 #include "UObject/GCObject.h"
 #include "UObject/ObjectRedirector.h"
 #include "Serialization/BulkData.h"
@@ -534,6 +536,27 @@ static FAutoConsoleVariableRef CVar_AllowPreemptingPackagesDuringGC(
 	TEXT("Allow the async loading thread to get pre-empted by garbage collection while it's creating packages."),
 	ECVF_Default);
 
+static bool GAsyncLoading2_ParallelExportSerialization = false;
+static FAutoConsoleVariableRef CVar_ParallelExportSerialization(
+	TEXT("s.ParallelExportSerialization"),
+	GAsyncLoading2_ParallelExportSerialization,
+	TEXT("Serialize runs of exports whose class returns true from IsSerializeThreadSafe on worker threads."),
+	ECVF_Default);
+
+static int32 GAsyncLoading2_ParallelExportSerializationMinBatchSize = 4;
+static FAutoConsoleVariableRef CVar_ParallelExportSerializationMinBatchSize(
+	TEXT("s.ParallelExportSerialization.MinBatchSize"),
+	GAsyncLoading2_ParallelExportSerializationMinBatchSize,
+	TEXT("Minimum number of consecutive thread safe exports of a package to serialize them on worker threads."),
+	ECVF_Default);
+
+static int32 GAsyncLoading2_ParallelExportSerializationMaxBatchSize = 256;
+static FAutoConsoleVariableRef CVar_ParallelExportSerializationMaxBatchSize(
+	TEXT("s.ParallelExportSerialization.MaxBatchSize"),
+	GAsyncLoading2_ParallelExportSerializationMaxBatchSize,
+	TEXT("Maximum number of exports serialized on worker threads before the async loading thread checks its time limit again."),
+	ECVF_Default);
+
 #if USING_INSTRUMENTATION
 static bool GDetectRaceDuringLoading = false;
 static FAutoConsoleVariableRef CVarDetectRaceDuringLoading(
@@ -552,6 +575,8 @@ TRACE_DECLARE_ATOMIC_INT_COUNTER(AsyncLoadingLoadingPackages, TEXT("AsyncLoading
 TRACE_DECLARE_ATOMIC_INT_COUNTER(AsyncLoadingPackagesWithRemainingWork, TEXT("AsyncLoading/PackagesWithRemainingWork"));
 TRACE_DECLARE_ATOMIC_INT_COUNTER(AsyncLoadingPendingIoRequests, TEXT("AsyncLoading/PendingIoRequests"));
 TRACE_DECLARE_ATOMIC_MEMORY_COUNTER(AsyncLoadingTotalLoaded, TEXT("AsyncLoading/TotalLoaded"));
+TRACE_DECLARE_ATOMIC_INT_COUNTER(AsyncLoadingParallelSerializedExports, TEXT("AsyncLoading/ParallelSerializedExports"));
+TRACE_DECLARE_FLOAT_COUNTER(AsyncLoadingParallelSerializeConcurrency, TEXT("AsyncLoading/ParallelSerializeConcurrency"));
 
 FString FormatPackageId(FPackageId PackageId)
 {
@@ -3850,6 +3875,15 @@ public:
 
 	void EventDrivenCreateExport(const FAsyncPackageHeaderData& Header, int32 LocalExportIndex);
 	bool EventDrivenSerializeExport(const FAsyncPackageHeaderData& Header, int32 LocalExportIndex, FExportArchive* Ar);
+	/** Serializes an export whose dependencies have already been processed */
+	void SerializeExportObject(const FAsyncPackageHeaderData& Header, int32 LocalExportIndex, FExportArchive& Ar);
+	/**
+	 * Serializes the run of thread safe exports starting at ExportBundleEntryIndex on worker threads and advances ExportBundleEntryIndex
+	 * past it. Returns false if the run is shorter than s.ParallelExportSerialization.MinBatchSize, in which case nothing was done.
+	 */
+	bool TryParallelSerializeExports(const FAsyncPackageHeaderData& Header, const FIoBuffer& IoBuffer, bool bIsOptionalSegment);
+	/** Calls ConditionalPostLoad on worker threads for objects that FPostLoadScheduler::CanPostLoadInParallel */
+	void ParallelPostLoad(TConstArrayView<UObject*> Objects);
 
 	void EventDrivenCreateCellExport(const FAsyncPackageHeaderData& Header, int32 LocalExportIndex, FExportArchive* Ar);
 	bool EventDrivenSerializeCellExport(const FAsyncPackageHeaderData& Header, int32 LocalExportIndex, FExportArchive* Ar);
@@ -4181,6 +4215,9 @@ private:
 	/** I/O Dispatcher */
 	FIoDispatcher& IoDispatcher;
 
+	/** Records and prefetches the package load order of maps */
+	FPackageLoadOrderPrefetcher LoadOrderPrefetcher;
+
 	IAsyncPackageLoader* UncookedPackageLoader;
 
 	FPackageStore& PackageStore;
@@ -6597,10 +6634,7 @@ void FAsyncPackage2::StartLoading(FAsyncLoadingThreadState2& ThreadState, FIoBat
 	const uint16 ChunkIndex = 0;
 #endif
 	FIoChunkId ChunkId = CreateIoChunkId(Desc.PackageIdToLoad.Value(), ChunkIndex, EIoChunkType::ExportBundleData);
-	SerializationState.IoRequest = IoBatch.ReadWithCallback(ChunkId,
-		ReadOptions,
-		Desc.Priority,
-		[this](TIoStatusOr<FIoBuffer> Result)
+	FIoReadCallback ReadCallback = [this](TIoStatusOr<FIoBuffer> Result)
 		{
 			if (Result.IsOk())
 			{
@@ -6621,7 +6655,12 @@ void FAsyncPackage2::StartLoading(FAsyncLoadingThreadState2& ThreadState, FIoBat
 			{
 				LocalAsyncLoadingThread.AltZenaphore.NotifyOne();
 			}
-		});
+		};
+	FPackageLoadOrderPrefetcher& LoadOrderPrefetcher = AsyncLoadingThread.LoadOrderPrefetcher;
+	if (!LoadOrderPrefetcher.IsActive() || !LoadOrderPrefetcher.OnPackageRead(Desc.PackageIdToLoad, ChunkId, Desc.Priority, ReadCallback, SerializationState.IoRequest))
+	{
+		SerializationState.IoRequest = IoBatch.ReadWithCallback(ChunkId, ReadOptions, Desc.Priority, MoveTemp(ReadCallback));
+	}
 
 	if (!Data.ShaderMapHashes.IsEmpty())
 	{
@@ -7530,6 +7569,11 @@ EEventLoadNodeExecutionResult FAsyncPackage2::Event_ProcessExportBundle(FAsyncLo
 			{
 				return EEventLoadNodeExecutionResult::Timeout;
 			}
+			if (GAsyncLoading2_ParallelExportSerialization && BundleEntry.CommandType == FExportBundleEntry::ExportCommandType_Serialize &&
+				Package->TryParallelSerializeExports(*HeaderData, IoBuffer, bIsOptionalSegment))
+			{
+				continue;
+			}
 			if (BundleEntry.LocalExportIndex < uint32(HeaderData->ExportMap.Num()))
 			{
 				const FExportMapEntry& ExportMapEntry = HeaderData->ExportMap[BundleEntry.LocalExportIndex];
@@ -8226,6 +8270,17 @@ bool FAsyncPackage2::EventDrivenSerializeExport(const FAsyncPackageHeaderData& H
 
 	ProcessExportDependencies(Header, LocalExportIndex, FExportBundleEntry::ExportCommandType_Serialize);
 
+	SerializeExportObject(Header, LocalExportIndex, *Ar);
+
+	return true;
+}
+
+void FAsyncPackage2::SerializeExportObject(const FAsyncPackageHeaderData& Header, int32 LocalExportIndex, FExportArchive& Ar)
+{
+	const FExportMapEntry& Export = Header.ExportMap[LocalExportIndex];
+	FExportObject& ExportObject = Header.ExportsView[LocalExportIndex];
+	UObject* Object = ExportObject.Object;
+
 	// If this is a struct, make sure that its parent struct is completely loaded
 	if (UStruct* Struct = dynamic_cast<UStruct*>(Object))
 	{
@@ -8255,35 +8310,36 @@ bool FAsyncPackage2::EventDrivenSerializeExport(const FAsyncPackageHeaderData& H
 	UObject* PrevSerializedObject = LoadContext->SerializedObject;
 	LoadContext->SerializedObject = Object;
 
-	Ar->ExportBufferBegin(Object, Export.CookedSerialOffset, Export.CookedSerialSize);
+	Ar.ExportBufferBegin(Object, Export.CookedSerialOffset, Export.CookedSerialSize);
 
-	const int64 Pos = Ar->Tell();
+	const int64 Pos = Ar.Tell();
 
-	check(!Ar->TemplateForGetArchetypeFromLoader);
-	Ar->TemplateForGetArchetypeFromLoader = ExportObject.TemplateObject;
+	check(!Ar.TemplateForGetArchetypeFromLoader);
+	Ar.TemplateForGetArchetypeFromLoader = ExportObject.TemplateObject;
 
 	if (Object->HasAnyFlags(RF_ClassDefaultObject))
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(SerializeDefaultObject);
-		Object->GetClass()->SerializeDefaultObject(Object, *Ar);
+		Object->GetClass()->SerializeDefaultObject(Object, Ar);
 	}
 	else
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(SerializeObject);
 		UE_SERIALIZE_ACCCESS_SCOPE(Object);
-		Object->Serialize(*Ar);
+		Object->Serialize(Ar);
 	}
-	Ar->TemplateForGetArchetypeFromLoader = nullptr;
+	Ar.TemplateForGetArchetypeFromLoader = nullptr;
 
 	UE_ASYNC_PACKAGE_CLOG(
-		Export.CookedSerialSize != uint64(Ar->Tell() - Pos), Fatal, Desc, TEXT("ObjectSerializationError"),
+		Export.CookedSerialSize != uint64(Ar.Tell() - Pos), Fatal, Desc, TEXT("ObjectSerializationError"),
 		TEXT("%s: Serial size mismatch: Expected read size %lld, Actual read size %lld"),
-		Object ? *Object->GetFullName() : TEXT("null"), Export.CookedSerialSize, uint64(Ar->Tell() - Pos));
+		Object ? *Object->GetFullName() : TEXT("null"), Export.CookedSerialSize, uint64(Ar.Tell() - Pos));
 
-	Ar->ExportBufferEnd();
+	Ar.ExportBufferEnd();
 
 	Object->SetFlags(RF_LoadCompleted);
 	LoadContext->SerializedObject = PrevSerializedObject;
+	AsyncLoadingThread.LoadOrderPrefetcher.OnExportSerialized();
 
 #if DO_CHECK
 	if (Object->HasAnyFlags(RF_ClassDefaultObject) && Object->GetClass()->HasAnyClassFlags(CLASS_CompiledFromBlueprint))
@@ -8297,7 +8353,89 @@ bool FAsyncPackage2::EventDrivenSerializeExport(const FAsyncPackageHeaderData& H
 
 	// push stats so that we don't overflow number of tags per thread during blocking loading
 	LLM_PUSH_STATS_FOR_ASSET_TAGS();
+}
+
+bool FAsyncPackage2::TryParallelSerializeExports(const FAsyncPackageHeaderData& Header, const FIoBuffer& IoBuffer, bool bIsOptionalSegment)
+{
+	// Gather the run of serialize commands for thread safe exports, exports that don't need to be serialized are skipped over
+	TArray<int32, TInlineAllocator<64>> LocalExportIndices;
+	const int32 MaxBatchSize = FMath::Max(GAsyncLoading2_ParallelExportSerializationMaxBatchSize, 1);
+	int32 EndEntryIndex = ExportBundleEntryIndex;
+	for (; EndEntryIndex < Header.ExportBundleEntries.Num() && LocalExportIndices.Num() < MaxBatchSize; ++EndEntryIndex)
+	{
+		const FExportBundleEntry& BundleEntry = Header.ExportBundleEntries[EndEntryIndex];
+		if (BundleEntry.CommandType != FExportBundleEntry::ExportCommandType_Serialize || BundleEntry.LocalExportIndex >= uint32(Header.ExportMap.Num()))
+		{
+			break;
+		}
+		const FExportObject& ExportObject = Header.ExportsView[BundleEntry.LocalExportIndex];
+		UObject* Object = ExportObject.Object;
+		if (ExportObject.bFiltered || ExportObject.bExportLoadFailed || !Object || !Object->HasAllFlags(RF_NeedLoad))
+		{
+			continue;
+		}
+		// Default objects and structs update state shared with other objects of their class when serialized
+		if (Object->HasAnyFlags(RF_ClassDefaultObject) || dynamic_cast<UStruct*>(Object) || !Object->IsSerializeThreadSafe())
+		{
+			break;
+		}
+		LocalExportIndices.Add(BundleEntry.LocalExportIndex);
+	}
+
+	if (LocalExportIndices.Num() < FMath::Max(GAsyncLoading2_ParallelExportSerializationMinBatchSize, 1))
+	{
+		return false;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(ParallelSerializeExports);
+
+	// Dependencies can create and serialize other exports and imports so they are processed here, on the loading thread. This also
+	// serializes exports of the run that other exports of the run depend on, those are skipped below.
+	for (int32 LocalExportIndex : LocalExportIndices)
+	{
+		ProcessExportDependencies(Header, LocalExportIndex, FExportBundleEntry::ExportCommandType_Serialize);
+	}
+	LocalExportIndices.RemoveAll([&Header](int32 LocalExportIndex)
+	{
+		return !Header.ExportsView[LocalExportIndex].Object->HasAllFlags(RF_NeedLoad);
+	});
 
+	// Every task gets its own archive, external read dependencies are gathered per export to keep them in bundle order
+	TArray<TArray<FExternalReadCallback>, TInlineAllocator<64>> TaskExternalReadDependencies;
+	TaskExternalReadDependencies.SetNum(LocalExportIndices.Num());
+	std::atomic<uint64> SerializeCycles = 0;
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	TRACE_COUNTER_ADD(AsyncLoadingParallelSerializedExports, LocalExportIndices.Num());
+
+	ParallelFor(TEXT("ParallelSerializeExports"), LocalExportIndices.Num(), 1,
+		[this, &Header, &IoBuffer, bIsOptionalSegment, &LocalExportIndices, &TaskExternalReadDependencies, &SerializeCycles](int32 Index)
+		{
+			const int32 LocalExportIndex = LocalExportIndices[Index];
+			TRACE_LOADTIME_SERIALIZE_EXPORT_SCOPE(Header.ExportsView[LocalExportIndex].Object, Header.ExportMap[LocalExportIndex].CookedSerialSize);
+			const uint64 TaskStartCycles = FPlatformTime::Cycles64();
+
+			FAsyncPackageScope2 Scope(this);
+			FExportArchive Ar(IoBuffer);
+			InitializeExportArchive(Ar, bIsOptionalSegment);
+			Ar.ExternalReadDependencies = &TaskExternalReadDependencies[Index];
+			SerializeExportObject(Header, LocalExportIndex, Ar);
+
+			SerializeCycles.fetch_add(FPlatformTime::Cycles64() - TaskStartCycles, std::memory_order_relaxed);
+		});
+
+	for (TArray<FExternalReadCallback>& ReadDependencies : TaskExternalReadDependencies)
+	{
+		ExternalReadDependencies.Append(MoveTemp(ReadDependencies));
+	}
+
+	const uint64 WallCycles = FMath::Max<uint64>(FPlatformTime::Cycles64() - StartCycles, 1);
+	const double Concurrency = double(SerializeCycles.load(std::memory_order_relaxed)) / double(WallCycles);
+	TRACE_COUNTER_SET(AsyncLoadingParallelSerializeConcurrency, Concurrency);
+	UE_ASYNC_PACKAGE_LOG_VERBOSE(Verbose, Desc, TEXT("ParallelSerializeExports"),
+		TEXT("Serialized %d exports in parallel in %.3fms with a concurrency of %.2f"),
+		LocalExportIndices.Num(), FPlatformTime::ToMilliseconds64(WallCycles), Concurrency);
+
+	ExportBundleEntryIndex = EndEntryIndex;
 	return true;
 }
 
@@ -8828,6 +8966,9 @@ EEventLoadNodeExecutionResult FAsyncPackage2::Event_PostLoadExportBundle(FAsyncL
 
 		const bool bAsyncPostLoadEnabled = FAsyncLoadingThreadSettings::Get().bAsyncPostLoadEnabled;
 		const bool bIsMultithreaded = Package->AsyncLoadingThread.IsMultithreaded();
+		const bool bParallelPostLoad = bIsMultithreaded && bAsyncPostLoadEnabled && FPostLoadScheduler::IsParallelPostLoadEnabled();
+		const bool bTrackClassTimes = FPostLoadScheduler::IsTrackingClassTimes();
+		TArray<UObject*, TInlineAllocator<64>> ParallelPostLoadBatch;
 
 		{
 #if WITH_EDITOR
@@ -8883,18 +9024,45 @@ EEventLoadNodeExecutionResult FAsyncPackage2::Event_PostLoadExportBundle(FAsyncL
 					check(Object->IsReadyForAsyncPostLoad());
 					if (!bIsMultithreaded || (bAsyncPostLoadEnabled && CanPostLoadOnAsyncLoadingThread(Object)))
 					{
+						if (bParallelPostLoad && FPostLoadScheduler::CanPostLoadInParallel(Object))
+						{
+							ParallelPostLoadBatch.Add(Object);
+							if (ParallelPostLoadBatch.Num() >= FPostLoadScheduler::GetMaxParallelBatchSize())
+							{
+								Package->ParallelPostLoad(ParallelPostLoadBatch);
+								ParallelPostLoadBatch.Reset();
+							}
+							break;
+						}
+						if (ParallelPostLoadBatch.Num())
+						{
+							// Keep the bundle order between batched objects and the ones that can't be batched
+							Package->ParallelPostLoad(ParallelPostLoadBatch);
+							ParallelPostLoadBatch.Reset();
+						}
 #if WITH_EDITOR
 						SCOPED_LOADTIMER_ASSET_TEXT(*Object->GetPathName());
 #endif
+						const UClass* ObjectClass = Object->GetClass();
+						const uint64 StartCycles = bTrackClassTimes ? FPlatformTime::Cycles64() : 0;
 						ThreadContext.CurrentlyPostLoadedObjectByALT = Object;
 						Object->ConditionalPostLoad();
 						ThreadContext.CurrentlyPostLoadedObjectByALT = nullptr;
+						if (bTrackClassTimes)
+						{
+							FPostLoadScheduler::Get().RecordPostLoad(ObjectClass, FPlatformTime::Cycles64() - StartCycles,
+								IsInGameThread() ? EPostLoadThread::GameThread : EPostLoadThread::AsyncLoadingThread);
+						}
 					}
 				} while (false);
 			}
 			++Package->ExportBundleEntryIndex;
 		}
 
+		if (ParallelPostLoadBatch.Num())
+		{
+			Package->ParallelPostLoad(ParallelPostLoadBatch);
+		}
 		}
 
 		// End async loading, simulates EndLoad
@@ -8922,6 +9090,34 @@ EEventLoadNodeExecutionResult FAsyncPackage2::Event_PostLoadExportBundle(FAsyncL
 	return EEventLoadNodeExecutionResult::Complete;
 }
 
+void FAsyncPackage2::ParallelPostLoad(TConstArrayView<UObject*> Objects)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ParallelPostLoad);
+	TArray<uint64, TInlineAllocator<64>> PostLoadCycles;
+	PostLoadCycles.SetNumZeroed(Objects.Num());
+
+	ParallelFor(TEXT("ParallelPostLoad"), Objects.Num(), 1, [this, Objects, &PostLoadCycles](int32 Index)
+		{
+			UObject* Object = Objects[Index];
+			FAsyncPackageScope2 PackageScope(this);
+			TGuardValue<bool> GuardIsRoutingPostLoad(PackageScope.ThreadContext.IsRoutingPostLoad, true);
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			PackageScope.ThreadContext.CurrentlyPostLoadedObjectByALT = Object;
+			Object->ConditionalPostLoad();
+			PackageScope.ThreadContext.CurrentlyPostLoadedObjectByALT = nullptr;
+			PostLoadCycles[Index] = FPlatformTime::Cycles64() - StartCycles;
+		});
+
+	if (FPostLoadScheduler::IsTrackingClassTimes())
+	{
+		for (int32 Index = 0; Index < Objects.Num(); ++Index)
+		{
+			FPostLoadScheduler::Get().RecordPostLoad(Objects[Index]->GetClass(), PostLoadCycles[Index], EPostLoadThread::Worker);
+		}
+	}
+}
+
 EEventLoadNodeExecutionResult FAsyncPackage2::Event_DeferredPostLoadExportBundle(FAsyncLoadingThreadState2& ThreadState, FAsyncPackage2* Package, int32 InExportBundleIndex)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FAsyncPackage_PostLoadObjectsGameThread);
@@ -8954,6 +9150,8 @@ EEventLoadNodeExecutionResult FAsyncPackage2::Event_DeferredPostLoadExportBundle
 		TRACE_LOADTIME_POSTLOAD_SCOPE;
 
 		FAsyncLoadingTickScope2 InAsyncLoadingTick(Package->AsyncLoadingThread);
+		FPostLoadScheduler& PostLoadScheduler = FPostLoadScheduler::Get();
+		const bool bTrackClassTimes = FPostLoadScheduler::IsTrackingClassTimes();
 
 #if WITH_EDITOR
 		UE::Core::Private::FPlayInEditorLoadingScope PlayInEditorIDScope(Package->Desc.PIEInstanceID);
@@ -8984,6 +9182,7 @@ EEventLoadNodeExecutionResult FAsyncPackage2::Event_DeferredPostLoadExportBundle
 
 			if (BundleEntry.CommandType == FExportBundleEntry::ExportCommandType_Serialize)
 			{
+				bool bOutOfBudget = false;
 				do
 				{
 					if (uint32(HeaderData->ExportsView.Num()) <= BundleEntry.LocalExportIndex)
@@ -9002,9 +9201,17 @@ EEventLoadNodeExecutionResult FAsyncPackage2::Event_DeferredPostLoadExportBundle
 					checkObject(Object, !Object->HasAnyFlags(RF_NeedLoad));
 					if (Object->HasAnyFlags(RF_NeedPostLoad))
 					{
+						const UClass* ObjectClass = Object->GetClass();
+						// Flushes aren't time limited so they ignore the per frame budget
+						if (ThreadState.bUseTimeLimit && !PostLoadScheduler.HasGameThreadBudget(ObjectClass))
+						{
+							bOutOfBudget = true;
+							break;
+						}
 #if WITH_EDITOR
 						SCOPED_LOADTIMER_ASSET_TEXT(*Object->GetPathName());
 #endif
+						const uint64 StartCycles = FPlatformTime::Cycles64();
 						PackageScope.ThreadContext.CurrentlyPostLoadedObjectByALT = Object;
 						{
 							FScopeCycleCounterUObject ConstructorScope(Object, GET_STATID(STAT_FAsyncPackage_PostLoadObjectsGameThread));
@@ -9016,8 +9223,24 @@ EEventLoadNodeExecutionResult FAsyncPackage2::Event_DeferredPostLoadExportBundle
 							Object->ConditionalPostLoad();
 						}
 						PackageScope.ThreadContext.CurrentlyPostLoadedObjectByALT = nullptr;
+
+						const uint64 PostLoadCycles = FPlatformTime::Cycles64() - StartCycles;
+						if (ThreadState.bUseTimeLimit)
+						{
+							PostLoadScheduler.ConsumeGameThreadBudget(PostLoadCycles);
+						}
+						if (bTrackClassTimes)
+						{
+							PostLoadScheduler.RecordPostLoad(ObjectClass, PostLoadCycles, EPostLoadThread::GameThread);
+						}
 					}
 				} while (false);
+
+				if (bOutOfBudget)
+				{
+					LoadingState = EEventLoadNodeExecutionResult::Timeout;
+					break;
+				}
 			}
 			++Package->ExportBundleEntryIndex;
 		}
@@ -9279,6 +9502,13 @@ EAsyncPackageState::Type FAsyncLoadingThread2::ProcessLoadedPackagesFromGameThre
 			break;
 		}
 
+		if (ThreadState.bUseTimeLimit && FPostLoadScheduler::Get().IsGameThreadBudgetExhausted())
+		{
+			// Deferred PostLoads used up the budget of this frame, they resume next frame
+			Result = EAsyncPackageState::TimeOut;
+			break;
+		}
+
 		bool bLocalDidSomething = false;
 		FAsyncPackage2* PackageToRepriortize;
 		while (ThreadState.PackagesToReprioritize.Dequeue(PackageToRepriortize))
@@ -9593,6 +9823,7 @@ EAsyncPackageState::Type FAsyncLoadingThread2::TickAsyncLoadingFromGameThread(FA
 FAsyncLoadingThread2::FAsyncLoadingThread2(FIoDispatcher& InIoDispatcher, IAsyncPackageLoader* InUncookedPackageLoader)
 	: Thread(nullptr)
 	, IoDispatcher(InIoDispatcher)
+	, LoadOrderPrefetcher(InIoDispatcher)
 	, UncookedPackageLoader(InUncookedPackageLoader)
 	, PackageStore(FPackageStore::Get())
 	, GlobalImportStore(*this)
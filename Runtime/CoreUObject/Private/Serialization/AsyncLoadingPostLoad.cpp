@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/AsyncLoadingPostLoad.h"
+#include "Async/UniqueLock.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "UObject/Class.h"
+
+static bool GParallelPostLoad = false;
+static FAutoConsoleVariableRef CVarParallelPostLoad(
+	TEXT("s.ParallelPostLoad"),
+	GParallelPostLoad,
+	TEXT("Call thread safe PostLoads in batches on worker threads instead of one at a time on the async loading thread."),
+	ECVF_Default
+);
+
+static int32 GParallelPostLoadMaxBatchSize = 128;
+static FAutoConsoleVariableRef CVarParallelPostLoadMaxBatchSize(
+	TEXT("s.ParallelPostLoad.MaxBatchSize"),
+	GParallelPostLoadMaxBatchSize,
+	TEXT("Maximum number of objects post loaded by a parallel batch before the async loading thread checks its time limit again."),
+	ECVF_Default
+);
+
+static float GDeferredPostLoadBudgetMs = 0.0f;
+static FAutoConsoleVariableRef CVarDeferredPostLoadBudgetMs(
+	TEXT("s.DeferredPostLoadBudgetMs"),
+	GDeferredPostLoadBudgetMs,
+	TEXT("Maximum time per frame spent in game thread PostLoad by time limited async loading, in milliseconds. 0 means no limit other than the async loading time limit."),
+	ECVF_Default
+);
+
+static bool GTrackPostLoadClassTimes = false;
+static FAutoConsoleVariableRef CVarTrackPostLoadClassTimes(
+	TEXT("s.TrackPostLoadClassTimes"),
+	GTrackPostLoadClassTimes,
+	TEXT("Records the time spent in PostLoad per class and thread, see s.DumpPostLoadClassTimes."),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithArgsAndOutputDevice GDumpPostLoadClassTimesCmd(
+	TEXT("s.DumpPostLoadClassTimes"),
+	TEXT("Prints the classes that spent the most time in game thread PostLoad while s.TrackPostLoadClassTimes was set. Optional argument: number of classes (default 30)."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		int32 NumClasses = 30;
+		if (Args.Num() > 0)
+		{
+			LexFromString(NumClasses, *Args[0]);
+		}
+		FPostLoadScheduler::Get().DumpClassTimes(Ar, FMath::Max(NumClasses, 1));
+	}));
+
+static FAutoConsoleCommand GResetPostLoadClassTimesCmd(
+	TEXT("s.ResetPostLoadClassTimes"),
+	TEXT("Resets the class times printed by s.DumpPostLoadClassTimes"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FPostLoadScheduler::Get().Reset();
+	}));
+
+uint64 FPostLoadScheduler::FClassTimes::GetTotalCount() const
+{
+	uint64 Total = 0;
+	for (uint64 ThreadCount : Count)
+	{
+		Total += ThreadCount;
+	}
+	return Total;
+}
+
+uint64 FPostLoadScheduler::FClassTimes::GetTotalCycles() const
+{
+	uint64 Total = 0;
+	for (uint64 ThreadCycles : Cycles)
+	{
+		Total += ThreadCycles;
+	}
+	return Total;
+}
+
+FPostLoadScheduler& FPostLoadScheduler::Get()
+{
+	static FPostLoadScheduler Scheduler;
+	return Scheduler;
+}
+
+bool FPostLoadScheduler::IsParallelPostLoadEnabled()
+{
+	return GParallelPostLoad;
+}
+
+int32 FPostLoadScheduler::GetMaxParallelBatchSize()
+{
+	return FMath::Max(GParallelPostLoadMaxBatchSize, 1);
+}
+
+bool FPostLoadScheduler::CanPostLoadInParallel(const UObject* Object)
+{
+	// Default objects, archetypes and structs are post loaded by the objects that depend on them
+	if (Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) || dynamic_cast<const UStruct*>(Object))
+	{
+		return false;
+	}
+	for (const UObject* Outer = Object->GetOuter(); Outer; Outer = Outer->GetOuter())
+	{
+		if (Outer->HasAnyFlags(RF_NeedPostLoad))
+		{
+			return false;
+		}
+	}
+	const UObject* Archetype = Object->GetArchetype();
+	return !Archetype || !Archetype->HasAnyFlags(RF_NeedPostLoad);
+}
+
+bool FPostLoadScheduler::IsTrackingClassTimes()
+{
+	return GTrackPostLoadClassTimes;
+}
+
+void FPostLoadScheduler::RecordPostLoad(const UClass* Class, uint64 Cycles, EPostLoadThread Thread)
+{
+	// Doesn't create the default object, which isn't safe from worker threads
+	const UObject* DefaultObject = Class->GetDefaultObject(false);
+	if (!DefaultObject)
+	{
+		return;
+	}
+
+	UE::TUniqueLock Lock(ClassTimesMutex);
+	FClassTimes& Times = ClassTimes.FindOrAdd(Class->GetClassPathName());
+	Times.Count[(int32)Thread]++;
+	Times.Cycles[(int32)Thread] += Cycles;
+	Times.MaxCycles = FMath::Max(Times.MaxCycles, Cycles);
+	Times.bThreadSafe = DefaultObject->IsPostLoadThreadSafe();
+}
+
+void FPostLoadScheduler::ResetBudgetIfNewFrame()
+{
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		BudgetSpentCycles = 0;
+		bBudgetExhausted = false;
+	}
+}
+
+bool FPostLoadScheduler::HasGameThreadBudget(const UClass* NextClass)
+{
+	if (GDeferredPostLoadBudgetMs <= 0.0f)
+	{
+		return true;
+	}
+
+	ResetBudgetIfNewFrame();
+	if (BudgetSpentCycles == 0)
+	{
+		// Always make progress
+		return true;
+	}
+
+	uint64 EstimatedCycles = 0;
+	if (GTrackPostLoadClassTimes)
+	{
+		UE::TUniqueLock Lock(ClassTimesMutex);
+		if (const FClassTimes* Times = ClassTimes.Find(NextClass->GetClassPathName()))
+		{
+			const uint64 NumGameThreadPostLoads = Times->Count[(int32)EPostLoadThread::GameThread];
+			EstimatedCycles = NumGameThreadPostLoads ? Times->Cycles[(int32)EPostLoadThread::GameThread] / NumGameThreadPostLoads : 0;
+		}
+	}
+
+	// Refusing on the estimate ends the frame's budget too, otherwise the game thread would keep retrying the same PostLoad until the frame time limit
+	const double BudgetSeconds = GDeferredPostLoadBudgetMs / 1000.0;
+	bBudgetExhausted = FPlatformTime::ToSeconds64(BudgetSpentCycles + EstimatedCycles) >= BudgetSeconds;
+	return !bBudgetExhausted;
+}
+
+void FPostLoadScheduler::ConsumeGameThreadBudget(uint64 Cycles)
+{
+	ResetBudgetIfNewFrame();
+	BudgetSpentCycles += Cycles;
+}
+
+bool FPostLoadScheduler::IsGameThreadBudgetExhausted() const
+{
+	return GDeferredPostLoadBudgetMs > 0.0f && BudgetFrame == GFrameCounter
+		&& (bBudgetExhausted || FPlatformTime::ToSeconds64(BudgetSpentCycles) >= GDeferredPostLoadBudgetMs / 1000.0);
+}
+
+void FPostLoadScheduler::DumpClassTimes(FOutputDevice& Ar, int32 NumClasses) const
+{
+	TArray<TPair<FTopLevelAssetPath, FClassTimes>> SortedTimes;
+	{
+		UE::TUniqueLock Lock(ClassTimesMutex);
+		SortedTimes.Reserve(ClassTimes.Num());
+		for (const TPair<FTopLevelAssetPath, FClassTimes>& Pair : ClassTimes)
+		{
+			SortedTimes.Add(Pair);
+		}
+	}
+	// Game thread time first as that's what converting a class to thread safe PostLoad saves
+	SortedTimes.Sort([](const TPair<FTopLevelAssetPath, FClassTimes>& A, const TPair<FTopLevelAssetPath, FClassTimes>& B)
+	{
+		const uint64 GameThreadA = A.Value.Cycles[(int32)EPostLoadThread::GameThread];
+		const uint64 GameThreadB = B.Value.Cycles[(int32)EPostLoadThread::GameThread];
+		return GameThreadA != GameThreadB ? GameThreadA > GameThreadB : A.Value.GetTotalCycles() > B.Value.GetTotalCycles();
+	});
+
+	Ar.Logf(TEXT("PostLoad times of %d classes:"), SortedTimes.Num());
+	Ar.Logf(TEXT("%-60s %10s %12s %12s %12s %12s %10s %s"), TEXT("Class"), TEXT("Count"), TEXT("GT (ms)"), TEXT("ALT (ms)"), TEXT("Worker (ms)"), TEXT("Avg (us)"), TEXT("Max (ms)"), TEXT("Thread safe"));
+	for (int32 Index = 0; Index < FMath::Min(NumClasses, SortedTimes.Num()); ++Index)
+	{
+		const FClassTimes& Times = SortedTimes[Index].Value;
+		const uint64 TotalCount = Times.GetTotalCount();
+		Ar.Logf(TEXT("%-60s %10llu %12.3f %12.3f %12.3f %12.3f %10.3f %s"),
+			*SortedTimes[Index].Key.ToString(),
+			TotalCount,
+			FPlatformTime::ToMilliseconds64(Times.Cycles[(int32)EPostLoadThread::GameThread]),
+			FPlatformTime::ToMilliseconds64(Times.Cycles[(int32)EPostLoadThread::AsyncLoadingThread]),
+			FPlatformTime::ToMilliseconds64(Times.Cycles[(int32)EPostLoadThread::Worker]),
+			TotalCount ? FPlatformTime::ToMilliseconds64(Times.GetTotalCycles()) * 1000.0 / TotalCount : 0.0,
+			FPlatformTime::ToMilliseconds64(Times.MaxCycles),
+			Times.bThreadSafe ? TEXT("yes") : TEXT("no"));
+	}
+}
+
+void FPostLoadScheduler::Reset()
+{
+	UE::TUniqueLock Lock(ClassTimesMutex);
+	ClassTimes.Empty();
+}
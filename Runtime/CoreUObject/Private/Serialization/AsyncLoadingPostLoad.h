@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Mutex.h"
+#include "UObject/TopLevelAssetPath.h"
+
+enum class EPostLoadThread : uint8
+{
+	GameThread,
+	AsyncLoadingThread,
+	Worker,
+	Count
+};
+
+/**
+ * Decides where and when the async loader calls PostLoad.
+ *
+ * With s.ParallelPostLoad set, thread safe PostLoads that the async loading thread would call one at a time are batched and called on
+ * worker threads. An object only joins a batch if none of its outers and not its archetype still need PostLoad, as ConditionalPostLoad
+ * would otherwise post load them from several workers at once.
+ *
+ * With s.DeferredPostLoadBudgetMs set, game thread PostLoads of time limited async loading stop once the budget of the current frame is
+ * spent. When class times are tracked the average PostLoad time of the next class is used to stop before the budget is exceeded.
+ *
+ * With s.TrackPostLoadClassTimes set, PostLoad time is recorded per class and thread, see s.DumpPostLoadClassTimes.
+ */
+class FPostLoadScheduler
+{
+public:
+	static FPostLoadScheduler& Get();
+
+	static bool IsParallelPostLoadEnabled();
+
+	/** Maximum number of objects post loaded by a single parallel batch */
+	static int32 GetMaxParallelBatchSize();
+
+	/** True if Object can be post loaded on a worker thread at the same time as the other objects of the current batch */
+	static bool CanPostLoadInParallel(const UObject* Object);
+
+	static bool IsTrackingClassTimes();
+
+	/** Records the PostLoad time of an object of Class, only called while IsTrackingClassTimes */
+	void RecordPostLoad(const UClass* Class, uint64 Cycles, EPostLoadThread Thread);
+
+	/**
+	 * Called on the game thread before post loading an object of NextClass during time limited loading.
+	 * Returns false if the PostLoad should wait for the next frame, in which case the budget of the current frame counts as exhausted.
+	 */
+	bool HasGameThreadBudget(const UClass* NextClass);
+
+	/** Called on the game thread after post loading an object during time limited loading */
+	void ConsumeGameThreadBudget(uint64 Cycles);
+
+	/** True once the deferred PostLoad budget of the current frame has been spent */
+	bool IsGameThreadBudgetExhausted() const;
+
+	/** Prints the NumClasses classes that spent the most time in game thread PostLoad */
+	void DumpClassTimes(FOutputDevice& Ar, int32 NumClasses) const;
+
+	void Reset();
+
+private:
+	struct FClassTimes
+	{
+		uint64 Count[(int32)EPostLoadThread::Count] = {};
+		uint64 Cycles[(int32)EPostLoadThread::Count] = {};
+		uint64 MaxCycles = 0;
+		bool bThreadSafe = false;
+
+		uint64 GetTotalCount() const;
+		uint64 GetTotalCycles() const;
+	};
+
+	void ResetBudgetIfNewFrame();
+
+	mutable UE::FMutex ClassTimesMutex;
+	/** Keyed by class path as classes of different packages can share a name */
+	TMap<FTopLevelAssetPath, FClassTimes> ClassTimes;
+
+	/** Game thread only */
+	uint64 BudgetFrame = 0;
+	uint64 BudgetSpentCycles = 0;
+	/** Set when HasGameThreadBudget refused a PostLoad whose estimated time didn't fit the rest of the budget */
+	bool bBudgetExhausted = false;
+};
@@ -0,0 +1,363 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/AsyncLoadingPrefetch.h"
+#include "Async/UniqueLock.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+static int32 GLoadOrderFileRecord = 0;
+static FAutoConsoleVariableRef CVarLoadOrderFileRecord(
+	TEXT("s.LoadOrderFile.Record"),
+	GLoadOrderFileRecord,
+	TEXT("Records the order in which packages are requested while a map is loading to Saved/LoadOrder/<MapName>.loadorder"),
+	ECVF_Default
+);
+
+static int32 GLoadOrderFilePrefetch = 0;
+static FAutoConsoleVariableRef CVarLoadOrderFilePrefetch(
+	TEXT("s.LoadOrderFile.Prefetch"),
+	GLoadOrderFilePrefetch,
+	TEXT("Reads the packages listed in the load order file of a map ahead of the loader while the map is loading"),
+	ECVF_Default
+);
+
+static int32 GLoadOrderFilePrefetchWindow = 256;
+static FAutoConsoleVariableRef CVarLoadOrderFilePrefetchWindow(
+	TEXT("s.LoadOrderFile.PrefetchWindow"),
+	GLoadOrderFilePrefetchWindow,
+	TEXT("Maximum number of prefetched packages not yet claimed by the loader"),
+	ECVF_Default
+);
+
+static int32 GLoadOrderFilePrefetchPriority = IoDispatcherPriority_Low;
+static FAutoConsoleVariableRef CVarLoadOrderFilePrefetchPriority(
+	TEXT("s.LoadOrderFile.PrefetchPriority"),
+	GLoadOrderFilePrefetchPriority,
+	TEXT("I/O priority of prefetched reads until the loader claims them"),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithOutputDevice GLoadOrderFileDumpStatsCmd(
+	TEXT("s.LoadOrderFile.DumpStats"),
+	TEXT("Prints time to first export and map load times with and without load order prefetching"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		if (FPackageLoadOrderPrefetcher* Prefetcher = FPackageLoadOrderPrefetcher::Get())
+		{
+			Prefetcher->DumpStats(Ar);
+		}
+	}));
+
+namespace UE::LoadOrderFile
+{
+	static constexpr uint32 Magic = 0x4C4F4446; // 'LODF'
+	static constexpr uint32 Version = 1;
+}
+
+FPackageLoadOrderPrefetcher* FPackageLoadOrderPrefetcher::Instance = nullptr;
+
+void FPackageLoadOrderPrefetcher::FLoadTimes::Add(double LoadTime, double TimeToFirstExport)
+{
+	++NumLoads;
+	TotalLoadTime += LoadTime;
+	TotalTimeToFirstExport += TimeToFirstExport;
+	MinLoadTime = FMath::Min(MinLoadTime, LoadTime);
+	MaxLoadTime = FMath::Max(MaxLoadTime, LoadTime);
+}
+
+FPackageLoadOrderPrefetcher::FPackageLoadOrderPrefetcher(FIoDispatcher& InIoDispatcher)
+	: IoDispatcher(InIoDispatcher)
+{
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &FPackageLoadOrderPrefetcher::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FPackageLoadOrderPrefetcher::OnPostLoadMap);
+	Instance = this;
+}
+
+FPackageLoadOrderPrefetcher::~FPackageLoadOrderPrefetcher()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	{
+		UE::TUniqueLock Lock(Mutex);
+		CancelPrefetches();
+	}
+	if (Instance == this)
+	{
+		Instance = nullptr;
+	}
+}
+
+bool FPackageLoadOrderPrefetcher::OnPackageRead(FPackageId PackageId, const FIoChunkId& ChunkId, int32 Priority, FIoReadCallback& Callback, FIoRequest& OutRequest)
+{
+	// Only the main export bundle chunk is recorded and prefetched
+	if (ChunkId != CreateIoChunkId(PackageId.Value(), 0, EIoChunkType::ExportBundleData))
+	{
+		return false;
+	}
+
+	TSharedPtr<FPrefetch, ESPMode::ThreadSafe> Prefetch;
+	{
+		UE::TUniqueLock Lock(Mutex);
+		bool bAlreadyRequested = false;
+		RequestedPackages.Add(PackageId, &bAlreadyRequested);
+		if (bRecording && !bAlreadyRequested)
+		{
+			RecordedLoadOrder.Add(PackageId);
+		}
+		if (!bPrefetching || !Prefetches.RemoveAndCopyValue(PackageId, Prefetch))
+		{
+			return false;
+		}
+		++NumPrefetchesClaimed;
+		IssuePrefetches();
+	}
+
+	OutRequest = Prefetch->Request;
+	{
+		UE::TUniqueLock Lock(Prefetch->Mutex);
+		if (!Prefetch->bCompleted)
+		{
+			// The prefetch completion forwards the result to the loader
+			Prefetch->Callback = MoveTemp(Callback);
+		}
+	}
+
+	if (Callback)
+	{
+		if (const FIoBuffer* Result = OutRequest.GetResult())
+		{
+			Callback(TIoStatusOr<FIoBuffer>(*Result));
+		}
+		else
+		{
+			Callback(TIoStatusOr<FIoBuffer>(OutRequest.Status()));
+		}
+	}
+	else if (Priority > GLoadOrderFilePrefetchPriority)
+	{
+		OutRequest.UpdatePriority(Priority);
+	}
+	return true;
+}
+
+void FPackageLoadOrderPrefetcher::IssuePrefetches()
+{
+	const int32 Window = FMath::Max(GLoadOrderFilePrefetchWindow, 1);
+	if (Prefetches.Num() > Window / 2 || NextPrefetchIndex >= LoadOrder.Num())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(IssueLoadOrderPrefetches);
+	FIoBatch IoBatch = IoDispatcher.NewBatch();
+	while (Prefetches.Num() < Window && NextPrefetchIndex < LoadOrder.Num())
+	{
+		const FPackageId PackageId = LoadOrder[NextPrefetchIndex++];
+		if (RequestedPackages.Contains(PackageId))
+		{
+			// The loader got there first
+			continue;
+		}
+
+		TSharedPtr<FPrefetch, ESPMode::ThreadSafe> Prefetch = MakeShared<FPrefetch, ESPMode::ThreadSafe>();
+		// The dispatcher resets the callback once it has been called which releases this reference
+		Prefetch->Request = IoBatch.ReadWithCallback(CreateIoChunkId(PackageId.Value(), 0, EIoChunkType::ExportBundleData),
+			FIoReadOptions(),
+			GLoadOrderFilePrefetchPriority,
+			[Prefetch](TIoStatusOr<FIoBuffer> Result)
+			{
+				FIoReadCallback Callback;
+				{
+					UE::TUniqueLock Lock(Prefetch->Mutex);
+					Prefetch->bCompleted = true;
+					Callback = MoveTemp(Prefetch->Callback);
+				}
+				if (Callback)
+				{
+					Callback(MoveTemp(Result));
+				}
+			});
+		Prefetches.Add(PackageId, MoveTemp(Prefetch));
+		++NumPrefetchesIssued;
+	}
+	IoBatch.Issue();
+}
+
+int32 FPackageLoadOrderPrefetcher::CancelPrefetches()
+{
+	const int32 NumCancelled = Prefetches.Num();
+	for (TPair<FPackageId, TSharedPtr<FPrefetch, ESPMode::ThreadSafe>>& Pair : Prefetches)
+	{
+		Pair.Value->Request.Cancel();
+	}
+	Prefetches.Empty();
+	return NumCancelled;
+}
+
+void FPackageLoadOrderPrefetcher::OnPreLoadMap(const FString& MapName)
+{
+	if (!GLoadOrderFileRecord && !GLoadOrderFilePrefetch)
+	{
+		return;
+	}
+
+	UE::TUniqueLock Lock(Mutex);
+	// A previous map load that never completed
+	CancelPrefetches();
+
+	FString MapPackageName;
+	MapName.Split(TEXT("?"), &MapPackageName, nullptr);
+	CurrentMapName = FPackageName::GetShortName(MapPackageName.IsEmpty() ? MapName : MapPackageName);
+	LoadStartTime = FPlatformTime::Seconds();
+	FirstExportTime.store(0.0, std::memory_order_relaxed);
+
+	bRecording = !!GLoadOrderFileRecord;
+	RecordedLoadOrder.Reset();
+	RequestedPackages.Reset();
+
+	LoadOrder.Reset();
+	NextPrefetchIndex = 0;
+	NumPrefetchesIssued = 0;
+	NumPrefetchesClaimed = 0;
+	bPrefetching = GLoadOrderFilePrefetch && LoadLoadOrderFile(CurrentMapName, LoadOrder);
+	if (bPrefetching)
+	{
+		IssuePrefetches();
+	}
+
+	bActive.store(true, std::memory_order_relaxed);
+}
+
+void FPackageLoadOrderPrefetcher::OnPostLoadMap(UWorld* World)
+{
+	if (!IsActive())
+	{
+		return;
+	}
+
+	UE::TUniqueLock Lock(Mutex);
+	bActive.store(false, std::memory_order_relaxed);
+
+	const double LoadTime = FPlatformTime::Seconds() - LoadStartTime;
+	const double LocalFirstExportTime = FirstExportTime.load(std::memory_order_relaxed);
+	const double TimeToFirstExport = LocalFirstExportTime > 0.0 ? LocalFirstExportTime - LoadStartTime : LoadTime;
+	const int32 NumPrefetchesWasted = CancelPrefetches();
+
+	FMapStats& Stats = MapStats.FindOrAdd(CurrentMapName);
+	if (bPrefetching)
+	{
+		Stats.WithPrefetch.Add(LoadTime, TimeToFirstExport);
+		Stats.NumPrefetchesIssued += NumPrefetchesIssued;
+		Stats.NumPrefetchesClaimed += NumPrefetchesClaimed;
+		Stats.NumPrefetchesWasted += NumPrefetchesWasted;
+		UE_LOG(LogStreaming, Display, TEXT("Loaded %s with load order prefetching in %.3fs, first export after %.3fs, %d packages prefetched, %d claimed, %d wasted"),
+			*CurrentMapName, LoadTime, TimeToFirstExport, NumPrefetchesIssued, NumPrefetchesClaimed, NumPrefetchesWasted);
+	}
+	else
+	{
+		Stats.WithoutPrefetch.Add(LoadTime, TimeToFirstExport);
+		UE_LOG(LogStreaming, Display, TEXT("Loaded %s without load order prefetching in %.3fs, first export after %.3fs"),
+			*CurrentMapName, LoadTime, TimeToFirstExport);
+	}
+
+	if (bRecording && RecordedLoadOrder.Num())
+	{
+		SaveLoadOrderFile(CurrentMapName, RecordedLoadOrder);
+	}
+
+	bRecording = false;
+	bPrefetching = false;
+	RecordedLoadOrder.Empty();
+	RequestedPackages.Empty();
+	LoadOrder.Empty();
+}
+
+void FPackageLoadOrderPrefetcher::DumpStats(FOutputDevice& Ar) const
+{
+	auto DumpLoadTimes = [&Ar](const TCHAR* Name, const FLoadTimes& LoadTimes)
+	{
+		if (LoadTimes.NumLoads)
+		{
+			Ar.Logf(TEXT("  %s: %d loads, avg %.3fs (min %.3fs, max %.3fs), avg time to first export %.3fs"),
+				Name, LoadTimes.NumLoads, LoadTimes.TotalLoadTime / LoadTimes.NumLoads, LoadTimes.MinLoadTime, LoadTimes.MaxLoadTime,
+				LoadTimes.TotalTimeToFirstExport / LoadTimes.NumLoads);
+		}
+	};
+
+	UE::TUniqueLock Lock(Mutex);
+	for (const TPair<FString, FMapStats>& Pair : MapStats)
+	{
+		const FMapStats& Stats = Pair.Value;
+		Ar.Logf(TEXT("%s:"), *Pair.Key);
+		DumpLoadTimes(TEXT("Without prefetch"), Stats.WithoutPrefetch);
+		DumpLoadTimes(TEXT("With prefetch"), Stats.WithPrefetch);
+		if (Stats.NumPrefetchesIssued)
+		{
+			Ar.Logf(TEXT("  %d packages prefetched, %d claimed, %d wasted"), Stats.NumPrefetchesIssued, Stats.NumPrefetchesClaimed, Stats.NumPrefetchesWasted);
+		}
+		if (Stats.WithoutPrefetch.NumLoads && Stats.WithPrefetch.NumLoads)
+		{
+			const double AvgWithout = Stats.WithoutPrefetch.TotalLoadTime / Stats.WithoutPrefetch.NumLoads;
+			const double AvgWith = Stats.WithPrefetch.TotalLoadTime / Stats.WithPrefetch.NumLoads;
+			Ar.Logf(TEXT("  Prefetching saved %.3fs (%.1f%%) of load time on average"), AvgWithout - AvgWith, AvgWithout > 0.0 ? 100.0 * (AvgWithout - AvgWith) / AvgWithout : 0.0);
+		}
+	}
+}
+
+FString FPackageLoadOrderPrefetcher::GetLoadOrderFilename(const FString& MapName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("LoadOrder") / MapName + TEXT(".loadorder");
+}
+
+bool FPackageLoadOrderPrefetcher::LoadLoadOrderFile(const FString& MapName, TArray<FPackageId>& OutLoadOrder)
+{
+	const FString Filename = GetLoadOrderFilename(MapName);
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent));
+	if (!Ar)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	FString FileMapName;
+	*Ar << Magic;
+	*Ar << Version;
+	if (Magic != UE::LoadOrderFile::Magic || Version != UE::LoadOrderFile::Version)
+	{
+		UE_LOG(LogStreaming, Warning, TEXT("Ignoring load order file '%s' with unknown version"), *Filename);
+		return false;
+	}
+	*Ar << FileMapName;
+	*Ar << OutLoadOrder;
+	if (Ar->IsError())
+	{
+		UE_LOG(LogStreaming, Warning, TEXT("Failed to read load order file '%s'"), *Filename);
+		OutLoadOrder.Empty();
+		return false;
+	}
+	return OutLoadOrder.Num() > 0;
+}
+
+void FPackageLoadOrderPrefetcher::SaveLoadOrderFile(const FString& MapName, TArray<FPackageId>& LoadOrder)
+{
+	const FString Filename = GetLoadOrderFilename(MapName);
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Ar)
+	{
+		UE_LOG(LogStreaming, Warning, TEXT("Failed to create load order file '%s'"), *Filename);
+		return;
+	}
+
+	uint32 Magic = UE::LoadOrderFile::Magic;
+	uint32 Version = UE::LoadOrderFile::Version;
+	FString FileMapName = MapName;
+	*Ar << Magic;
+	*Ar << Version;
+	*Ar << FileMapName;
+	*Ar << LoadOrder;
+	UE_LOG(LogStreaming, Display, TEXT("Wrote load order file '%s' with %d packages"), *Filename, LoadOrder.Num());
+}
@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Mutex.h"
+#include "IO/IoDispatcher.h"
+#include "IO/PackageId.h"
+#include <atomic>
+
+class UWorld;
+
+/**
+ * Records the order in which the async loader requests package export bundle chunks while a map is loading and replays it on later
+ * loads of the same map by reading the chunks up front in batches, ahead of the packages that need them.
+ *
+ * The load order file is written to Saved/LoadOrder/<MapName>.loadorder when s.LoadOrderFile.Record is set. When
+ * s.LoadOrderFile.Prefetch is set and a load order file exists for the map being loaded, a window of reads is issued at
+ * s.LoadOrderFile.PrefetchPriority and the loader claims them instead of issuing its own reads, which raises the priority of the
+ * claimed read to the priority of the package. Reads that were never claimed by the time the map has loaded are cancelled.
+ *
+ * Time to first serialized export and total map load time are tracked per map with and without prefetching, see
+ * s.LoadOrderFile.DumpStats.
+ */
+class FPackageLoadOrderPrefetcher
+{
+public:
+	FPackageLoadOrderPrefetcher(FIoDispatcher& InIoDispatcher);
+	~FPackageLoadOrderPrefetcher();
+
+	/** True while a map is loading and either recording or prefetching is enabled */
+	FORCEINLINE bool IsActive() const
+	{
+		return bActive.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Called by the loader before reading the export bundle chunk of a package. Returns true if the read was prefetched, in which
+	 * case OutRequest is set to the prefetched request and Callback will be called when (or, if it already has, before) it completes.
+	 * Returns false if the loader should issue the read itself.
+	 */
+	bool OnPackageRead(FPackageId PackageId, const FIoChunkId& ChunkId, int32 Priority, FIoReadCallback& Callback, FIoRequest& OutRequest);
+
+	/** Called by the loader when an export has been serialized */
+	FORCEINLINE void OnExportSerialized()
+	{
+		if (IsActive() && FirstExportTime.load(std::memory_order_relaxed) == 0.0)
+		{
+			double Expected = 0.0;
+			FirstExportTime.compare_exchange_strong(Expected, FPlatformTime::Seconds(), std::memory_order_relaxed);
+		}
+	}
+
+	/** Prints the load time metrics of every map loaded since startup */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	static FPackageLoadOrderPrefetcher* Get()
+	{
+		return Instance;
+	}
+
+private:
+	struct FPrefetch
+	{
+		FIoRequest Request;
+		/** Callback of the loader, set when a prefetch is claimed before it completed */
+		FIoReadCallback Callback;
+		UE::FMutex Mutex;
+		bool bCompleted = false;
+	};
+
+	struct FLoadTimes
+	{
+		int32 NumLoads = 0;
+		double TotalLoadTime = 0.0;
+		double TotalTimeToFirstExport = 0.0;
+		double MinLoadTime = DBL_MAX;
+		double MaxLoadTime = 0.0;
+
+		void Add(double LoadTime, double TimeToFirstExport);
+	};
+
+	struct FMapStats
+	{
+		FLoadTimes WithoutPrefetch;
+		FLoadTimes WithPrefetch;
+		int32 NumPrefetchesIssued = 0;
+		int32 NumPrefetchesClaimed = 0;
+		int32 NumPrefetchesWasted = 0;
+	};
+
+	void OnPreLoadMap(const FString& MapName);
+	void OnPostLoadMap(UWorld* World);
+
+	/** Tops up the prefetch window once half of it has been claimed, called with Mutex locked */
+	void IssuePrefetches();
+
+	/** Cancels all unclaimed prefetches and returns how many there were, called with Mutex locked */
+	int32 CancelPrefetches();
+
+	static FString GetLoadOrderFilename(const FString& MapName);
+	static bool LoadLoadOrderFile(const FString& MapName, TArray<FPackageId>& OutLoadOrder);
+	static void SaveLoadOrderFile(const FString& MapName, TArray<FPackageId>& LoadOrder);
+
+	static FPackageLoadOrderPrefetcher* Instance;
+
+	FIoDispatcher& IoDispatcher;
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+
+	std::atomic<bool> bActive = false;
+	std::atomic<double> FirstExportTime = 0.0;
+
+	mutable UE::FMutex Mutex;
+	FString CurrentMapName;
+	double LoadStartTime = 0.0;
+	bool bRecording = false;
+	bool bPrefetching = false;
+
+	/** Packages in the order their export bundles were first requested during the current map load */
+	TArray<FPackageId> RecordedLoadOrder;
+	TSet<FPackageId> RequestedPackages;
+
+	/** Load order read from the load order file of the current map */
+	TArray<FPackageId> LoadOrder;
+	int32 NextPrefetchIndex = 0;
+	TMap<FPackageId, TSharedPtr<FPrefetch, ESPMode::ThreadSafe>> Prefetches;
+	int32 NumPrefetchesIssued = 0;
+	int32 NumPrefetchesClaimed = 0;
+
+	TMap<FString, FMapStats> MapStats;
+};
@@ -40,6 +40,8 @@
 #include "UObject/FieldPathProperty.h"
 #include "UObject/GarbageCollectionHistory.h"
 #include "UObject/GarbageCollectionInternalFlags.h"
+#include "UObject/GarbageCollectionNursery.h"
+#include "UObject/GarbageCollectionProfiling.h"
 #include "UObject/GarbageCollectionTesting.h"
 #include "UObject/InstanceDataObjectUtils.h"
 #include "UObject/PropertyBagRepository.h"
@@ -228,6 +230,23 @@ static FAutoConsoleVariableRef CIncrementalBeginDestroyEnabled(
 	ECVF_Default
 );
 
+static int32 GConcurrentPurgeEnabled = 0;
+static FAutoConsoleVariableRef CConcurrentPurgeEnabled(
+	TEXT("gc.ConcurrentPurge"),
+	GConcurrentPurgeEnabled,
+	TEXT("If true, unreachable objects whose IsDestructionThreadSafe() returns true are destroyed and freed on background worker threads ")
+	TEXT("while the game thread only runs the destructors of the remaining objects"),
+	ECVF_Default
+);
+
+static int32 GConcurrentPurgeBatchSize = 512;
+static FAutoConsoleVariableRef CConcurrentPurgeBatchSize(
+	TEXT("gc.ConcurrentPurgeBatchSize"),
+	GConcurrentPurgeBatchSize,
+	TEXT("Number of objects destroyed by each background task when gc.ConcurrentPurge is enabled"),
+	ECVF_Default
+);
+
 #if WITH_VERSE_VM || defined(__INTELLISENSE__)
 bool GEnableFrankenGC = true;
 static FAutoConsoleVariableRef CEnableFrankenGC(
@@ -260,6 +279,20 @@ static FAutoConsoleCommandWithOutputDevice GUnlinkReachabilityStressDataCmd(TEXT
 										 "stress test data for collection in the next cycle."),
 FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&UnlinkReachabilityStressData));
 
+static FAutoConsoleCommandWithArgsAndOutputDevice GBenchmarkNurseryChurnCmd(
+	TEXT("gc.BenchmarkNurseryChurn"),
+	TEXT("Creates short lived objects every frame on top of the reachability stress data and logs the GC pause time histograms with gc.Nursery disabled and enabled. ")
+	TEXT("Optional argument: number of frames (default 100)."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		int32 NumFrames = 100;
+		if (Args.Num() > 0)
+		{
+			LexFromString(NumFrames, *Args[0]);
+		}
+		BenchmarkNurseryChurn(FMath::Max(NumFrames, 1), Ar);
+	}));
+
 #if UE_BUILD_SHIPPING
 static constexpr int32 GGarbageReferenceTrackingEnabled = 0;
 static constexpr int32 GDelayReachabilityIterations = 0;
@@ -374,6 +407,33 @@ static FAutoConsoleVariableRef CVarAllowSkipDestroyGarbage(
 	ECVF_Default
 );
 
+static int32 GNurseryCollection = 0;
+static FAutoConsoleVariableRef CVarNurseryCollection(
+	TEXT("gc.Nursery"),
+	GNurseryCollection,
+	TEXT("If true, non-full garbage collections only collect objects created since the previous collection and the periodic full collections run reachability analysis over all objects. ")
+	TEXT("Relies on references from older objects being stored in TObjectPtrs, just like incremental reachability analysis, so it requires the TObjectPtr GC barrier and gc.AllowIncrementalReachability. ")
+	TEXT("Older objects whose class has raw object pointer properties or overrides AddReferencedObjects are traversed by every collection."),
+	ECVF_Default
+);
+
+static int32 GNurseryFullCollectionInterval = 10;
+static FAutoConsoleVariableRef CVarNurseryFullCollectionInterval(
+	TEXT("gc.Nursery.FullCollectionInterval"),
+	GNurseryFullCollectionInterval,
+	TEXT("Number of collections after which a full reachability analysis is performed when gc.Nursery is enabled"),
+	ECVF_Default
+);
+
+static void DumpNurseryStats(FOutputDevice& Ar)
+{
+	UE::GC::Private::FGCNursery::Get().DumpStats(Ar);
+}
+
+static FAutoConsoleCommandWithOutputDevice GDumpNurseryStatsCmd(TEXT("gc.Nursery.DumpStats"),
+	TEXT("Prints the pause time histograms of nursery and full garbage collections"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&DumpNurseryStats));
+
 
 
 namespace UE::GC
@@ -589,6 +649,15 @@ namespace UE::GC
 
 	void MarkAsReachable(const UObject* Obj)
 	{
+		if (GIsNurseryWriteBarrierEnabled)
+		{
+			// Young objects stored in a TObjectPtr may be referenced by old objects which nursery collections don't traverse
+			Private::FGCNursery::Get().Remember(Obj);
+			if (!GIsIncrementalReachabilityPending)
+			{
+				return;
+			}
+		}
 		Obj->MarkAsReachable();
 	}
 
@@ -786,6 +855,83 @@ class FObjectPurge
 	/** True if all objects from the last purge phase have been destroyed */
 	bool bFinishedDestroyingObjects = true;
 
+	/** Objects with thread safe destruction that are destroyed on background worker threads */
+	TArray<UObject*> ConcurrentlyDestroyedObjects;
+	/** Classes, structs and class default objects that objects destroyed on worker threads may still access (~UObjectBase reads ClassPrivate), destroyed once the workers are done */
+	TArray<UObject*> DeferredClassObjects;
+	/** Completes when all ConcurrentlyDestroyedObjects have been destroyed */
+	UE::Tasks::FTask ConcurrentDestroyTask;
+	/** Time spent by all worker threads destroying ConcurrentlyDestroyedObjects */
+	std::atomic<uint64> ConcurrentDestroyCycles = 0;
+
+	/** Destroys ConcurrentlyDestroyedObjects in parallel batches on background worker threads */
+	void LaunchConcurrentDestroy()
+	{
+		const int32 BatchSize = FMath::Max(GConcurrentPurgeBatchSize, 1);
+		const int32 NumBatches = FMath::DivideAndRoundUp(ConcurrentlyDestroyedObjects.Num(), BatchSize);
+		ConcurrentDestroyCycles.store(0, std::memory_order_relaxed);
+
+		ConcurrentDestroyTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, BatchSize, NumBatches]
+		{
+			ParallelFor(TEXT("GC.ConcurrentPurge"), NumBatches, 1, [this, BatchSize](int32 BatchIndex)
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(FObjectPurge::ConcurrentDestroyBatch);
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+
+				const int32 FirstIndex = BatchIndex * BatchSize;
+				const int32 LastIndex = FMath::Min(FirstIndex + BatchSize, ConcurrentlyDestroyedObjects.Num());
+				for (int32 Index = FirstIndex; Index < LastIndex; ++Index)
+				{
+					UObject* Object = ConcurrentlyDestroyedObjects[Index];
+					Object->~UObject();
+					GUObjectAllocator.FreeUObject(Object);
+				}
+
+				ConcurrentDestroyCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+			}, EParallelForFlags::BackgroundPriority);
+		}, UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+
+	/** Destroys the classes and class default objects held back while objects were destroyed on worker threads */
+	void DestroyDeferredClassObjects()
+	{
+		check(!ConcurrentDestroyTask.IsValid());
+		for (UObject* Object : DeferredClassObjects)
+		{
+			Object->~UObject();
+			GUObjectAllocator.FreeUObject(Object);
+		}
+		ObjectsDestroyedSinceLastMarkPhase += DeferredClassObjects.Num();
+		DeferredClassObjects.Reset();
+	}
+
+	/**
+	 * Checks if the background destruction is done, waits for it when not using a time limit
+	 * @return true if there are no objects left to destroy on background worker threads
+	 */
+	bool FinishConcurrentDestroy(bool bUseTimeLimit)
+	{
+		if (ConcurrentDestroyTask.IsValid())
+		{
+			if (bUseTimeLimit && !ConcurrentDestroyTask.IsCompleted())
+			{
+				return false;
+			}
+
+			TRACE_CPUPROFILER_EVENT_SCOPE(FObjectPurge::WaitForConcurrentDestroy);
+			ConcurrentDestroyTask.Wait();
+			ConcurrentDestroyTask = {};
+
+			GGCStats.NumObjectsDestroyedConcurrently += ConcurrentlyDestroyedObjects.Num();
+			const double ConcurrentDestroyTime = FPlatformTime::ToSeconds64(ConcurrentDestroyCycles.load(std::memory_order_relaxed));
+			GGCStats.ConcurrentDestroyGarbageTime += ConcurrentDestroyTime;
+			CSV_CUSTOM_STAT(GC, ConcurrentPurgeWorkerTime, ConcurrentDestroyTime * 1000.0, ECsvCustomStatOp::Accumulate);
+			ObjectsDestroyedSinceLastMarkPhase += ConcurrentlyDestroyedObjects.Num();
+			ConcurrentlyDestroyedObjects.Reset();
+		}
+		return true;
+	}
+
 public:
 
 	/** Returns true if the destruction process is finished */
@@ -801,6 +947,8 @@ public:
 		ObjCurrentFreeIndexObjectIndex = 0;
 		ObjCurrentPurgeObjectIndex = 0;
 		ObjectsDestroyedSinceLastMarkPhase = 0;
+		check(ConcurrentlyDestroyedObjects.Num() == 0);
+		check(DeferredClassObjects.Num() == 0);
 	}
 
 	/** 
@@ -815,6 +963,9 @@ public:
 		TRACE_CPUPROFILER_EVENT_SCOPE(FObjectPurge::DestroyObjects);
 		constexpr int32 TimeLimitEnforcementGranularityForDeletion = 100;
 		int32 ProcessedObjectsCount = 0;
+		// Objects are destroyed on the game thread during exit purge as the worker threads may already be gone
+		const bool bConcurrentDestroy = GConcurrentPurgeEnabled && !GExitPurge;
+		const bool bFreeingIndices = ObjCurrentFreeIndexObjectIndex < GUnreachableObjects.Num();
 
 		// Global UObject Array needs to be locked only when freeing UObject indices
 		GUObjectArray.LockInternalArray();
@@ -836,9 +987,24 @@ public:
 
 				GUObjectArray.FreeUObjectIndex(Object);
 
-				// Replace the entry in GUnreachableObjects with the actual UObject so that we can iterate over the same array when 
-				// we call UObject destructors and free their memory in the loop below
-				UnreachableObject.Object = Object;
+				if (bConcurrentDestroy && Object->IsDestructionThreadSafe())
+				{
+					// Destroyed on a background worker thread once all indices have been freed, the game thread skips null entries
+					ConcurrentlyDestroyedObjects.Add(Object);
+					UnreachableObject.Object = nullptr;
+				}
+				else if (bConcurrentDestroy && (Object->IsA<UStruct>() || Object->HasAnyFlags(RF_ClassDefaultObject)))
+				{
+					// Classes are not destroyed until the worker threads are done with the instances that may still reference them
+					DeferredClassObjects.Add(Object);
+					UnreachableObject.Object = nullptr;
+				}
+				else
+				{
+					// Replace the entry in GUnreachableObjects with the actual UObject so that we can iterate over the same array when 
+					// we call UObject destructors and free their memory in the loop below
+					UnreachableObject.Object = Object;
+				}
 
 				++ProcessedObjectsCount;
 				++ObjCurrentFreeIndexObjectIndex;
@@ -858,11 +1024,21 @@ public:
 
 		if (ObjCurrentFreeIndexObjectIndex == GUnreachableObjects.Num())
 		{
+			if (bFreeingIndices && ConcurrentlyDestroyedObjects.Num())
+			{
+				LaunchConcurrentDestroy();
+			}
+
 			// At this point all entires in GUnreachableObjects point at UObject memory instead of FUObjectItems
 			while (ObjCurrentPurgeObjectIndex < GUnreachableObjects.Num())
 			{
-				UE::GC::FUnreachableObject& UnreachableObject = GUnreachableObjects[ObjCurrentPurgeObjectIndex];
+				UE::GC::FUnreachableObject& UnreachableObject = GUnreachableObjects[ObjCurrentPurgeObjectIndex++];
 				UObject* Object = UnreachableObject.Object;
+				if (!Object)
+				{
+					// Destroyed on a background worker thread
+					continue;
+				}
 
 				Object->~UObject();
 				GUObjectAllocator.FreeUObject(Object);
@@ -870,7 +1046,6 @@ public:
 
 				++ProcessedObjectsCount;
 				++ObjectsDestroyedSinceLastMarkPhase;
-				++ObjCurrentPurgeObjectIndex;
 
 				// Time slicing when running on the game thread
 				if (bUseTimeLimit && (ProcessedObjectsCount == TimeLimitEnforcementGranularityForDeletion) && (ObjCurrentPurgeObjectIndex < GUnreachableObjects.Num()))
@@ -884,7 +1059,11 @@ public:
 			}
 		}
 
-		bFinishedDestroyingObjects = (ObjCurrentPurgeObjectIndex == GUnreachableObjects.Num());
+		bFinishedDestroyingObjects = (ObjCurrentPurgeObjectIndex == GUnreachableObjects.Num()) && FinishConcurrentDestroy(bUseTimeLimit);
+		if (bFinishedDestroyingObjects)
+		{
+			DestroyDeferredClassObjects();
+		}
 		return bFinishedDestroyingObjects;
 	}
 
@@ -3432,11 +3611,19 @@ public:
 	FORCEINLINE void BeginTimingObject(UObject* CurrentObject)
 	{
 		UE::GC::GDetailedStats.BeginTimingObject(CurrentObject);
+		if (bTrackClassCosts)
+		{
+			Private::FClassCostTracker::BeginObject(CurrentObject);
+		}
 	}
 
 	FORCEINLINE void UpdateDetailedStats(UObject* CurrentObject)
 	{
 		UE::GC::GDetailedStats.UpdateDetailedStats(CurrentObject);
+		if (bTrackClassCosts)
+		{
+			Private::FClassCostTracker::EndObject();
+		}
 	}
 
 	FORCEINLINE void LogDetailedStatsSummary()
@@ -3461,15 +3648,21 @@ public:
 	: bTrackGarbage(GGarbageReferenceTrackingEnabled != 0)
 	, bTrackHistory(FGCHistory::Get().IsActive())
 	, bForceEnable(GForceEnableDebugGCProcessor  != 0)
+	, bTrackClassCosts(Private::FClassCostTracker::IsTracking())
 	{}
 	
 	bool TracksHistory() const { return bTrackHistory; }
 	bool TracksGarbage() const { return bTrackGarbage; }
+	bool TracksClassCosts() const { return bTrackClassCosts; }
 	bool IsForceEnabled() const { return bForceEnable; }
 
 	FORCENOINLINE void HandleTokenStreamObjectReference(FWorkerContext& Context, const UObject* ReferencingObject, UObject*& Object, FMemberId MemberId, EOrigin Origin, bool bAllowReferenceElimination)
 	{
 		UE::GC::GDetailedStats.IncreaseObjectRefStats(Object);
+		if (bTrackClassCosts)
+		{
+			Private::FClassCostTracker::AddReference();
+		}
 		if (ValidateReference(Object, PermanentPool, FReferenceToken(ReferencingObject), MemberId))
 		{
 			FReferenceMetadata Metadata(GUObjectArray.ObjectToIndex(Object));
@@ -3538,6 +3731,7 @@ private:
 	const bool bTrackGarbage;
 	const bool bTrackHistory;
 	const bool bForceEnable;
+	const bool bTrackClassCosts;
 
 	FORCENOINLINE static void HandleGarbageReference(FWorkerContext& Context, const UObject* ReferencingObject, UObject*& Object, FMemberId MemberId)
 	{
@@ -4042,6 +4236,7 @@ class FRealtimeGC : public FGarbageCollectionTracer
 		TDebugReachabilityProcessor<Options> DebugProcessor;
 		if (DebugProcessor.IsForceEnabled() | //-V792
 			DebugProcessor.TracksHistory() | 
+			DebugProcessor.TracksClassCosts() |
 			DebugProcessor.TracksGarbage() & Stats.bFoundGarbageRef)
 		{
 			CollectReferencesForGC<TDebugReachabilityCollector<Options>>(DebugProcessor, Context);
@@ -4307,6 +4502,82 @@ public:
 		MarkObjectsState.Finish(Unused);
 	}
 
+	/**
+	 * Nursery version of MarkObjectsAsUnreachable: only objects created since the previous collection are marked as MaybeUnreachable.
+	 * Old objects keep the reachable flag from the previous collection so reference traversal stops as soon as it reaches one of them.
+	 */
+	FORCENOINLINE void MarkNurseryObjectsAsUnreachable(const EObjectFlags KeepFlags)
+	{
+		using namespace UE::GC;
+		using namespace UE::GC::Private;
+
+		FGCNursery& Nursery = FGCNursery::Get();
+		const bool bWithGarbageElimination = UObject::IsGarbageEliminationEnabled();
+		int32 NumRememberedObjects = 0;
+
+		GObjectCountDuringLastMarkPhase.Set(GUObjectArray.GetObjectArrayNumMinusAvailable() - GUObjectArray.GetFirstGCIndex());
+
+		// Old roots are traversed too: they (and GGCObjectReferencer which reports all FGCObject references) may reference young objects
+		// without going through TObjectPtr. Traversal stops at their old referenced objects since those are still marked as reachable.
+		MarkRootObjectsAsReachable(GetObjectGatherOptions(), RF_NoFlags, InitialObjects);
+		if (!InitialObjects.Contains(FGCObject::GGCObjectReferencer))
+		{
+			InitialObjects.Add(FGCObject::GGCObjectReferencer);
+		}
+
+		// Old objects with raw pointer properties or AddReferencedObjects overrides can reference young objects the barrier never saw.
+		// They're still marked as reachable from the previous collection so only their references get traversed.
+		Nursery.ForEachExtraRoot([this](int32 ObjectIndex)
+		{
+			FUObjectItem* ObjectItem = &GUObjectArray.GetObjectItemArrayUnsafe()[ObjectIndex];
+			if (UObject* Object = static_cast<UObject*>(ObjectItem->GetObject()); Object && !ObjectItem->HasAnyFlags(EInternalObjectFlags_RootFlags))
+			{
+				InitialObjects.Add(Object);
+			}
+		});
+
+		Nursery.ForEachYoungObject([this, &Nursery, &NumRememberedObjects, KeepFlags, bWithGarbageElimination](int32 ObjectIndex)
+		{
+			FUObjectItem* ObjectItem = &GUObjectArray.GetObjectItemArrayUnsafe()[ObjectIndex];
+			UObject* Object = static_cast<UObject*>(ObjectItem->GetObject());
+			if (!Object || ObjectItem->GetOwnerIndex() > 0)
+			{
+				// Clustered objects are never marked as MaybeUnreachable, their cluster root decides whether they're kept
+				return;
+			}
+
+			if (ObjectItem->HasAnyFlags(EInternalObjectFlags_RootFlags))
+			{
+				// Already marked and added with the other roots
+				return;
+			}
+
+			const bool bRemembered = Nursery.IsRemembered(ObjectIndex);
+			NumRememberedObjects += bRemembered ? 1 : 0;
+
+			// Remembered objects may be referenced by old objects which are not traversed so they're treated as roots
+			if (bRemembered ||
+				ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot) ||
+				(KeepFlags != RF_NoFlags && Object->HasAnyFlags(KeepFlags) && !(bWithGarbageElimination && ObjectItem->IsGarbage())))
+			{
+				FGCFlags::FastMarkAsReachableInterlocked_ForGC(ObjectItem);
+				InitialObjects.Add(Object);
+				if (ObjectItem->HasAnyFlags(EInternalObjectFlags::ClusterRoot))
+				{
+					MarkReferencedClustersAsReachable<EGCOptions::None>(ObjectItem->GetClusterIndex(), InitialObjects);
+				}
+			}
+			else
+			{
+				FGCFlags::SetMaybeUnreachable_ForGC(ObjectItem);
+			}
+		});
+
+		GGCStats.NumYoungObjects = Nursery.GetNumYoung();
+		GGCStats.NumRememberedObjects = NumRememberedObjects;
+		GGCStats.NumRoots = InitialObjects.Num();
+	}
+
 	/**
 	 * Marks all objects that don't have KeepFlags and EInternalObjectFlags_GarbageCollectionKeepFlags as MaybeUnreachable
 	 */
@@ -4315,6 +4586,14 @@ public:
 		using namespace UE::GC;
 		using namespace UE::GC::Private;
 
+		if (GIsNurseryCollection)
+		{
+			MarkNurseryObjectsAsUnreachable(KeepFlags);
+			// Everything that survives this collection is old from now on
+			FGCNursery::Get().PromoteAll();
+			return;
+		}
+
 		EGatherOptions GatherOptions = GetObjectGatherOptions();
 
 		// Don't swap the flags if we're re-entering this function to track garbage references
@@ -4337,6 +4616,12 @@ public:
 		// This could be considered as initial part of reachability analysis and could be made incremental.
 		MarkClusteredObjectsAsReachable(GatherOptions, InitialObjects);
 		MarkRootObjectsAsReachable(GatherOptions, KeepFlags, InitialObjects);
+
+		if (FGCNursery::Get().IsTracking())
+		{
+			GGCStats.NumYoungObjects = FGCNursery::Get().GetNumYoung();
+			FGCNursery::Get().PromoteAll();
+		}
 	}
 
 private:
@@ -4683,6 +4968,7 @@ void IncrementalPurgeGarbage(bool bUseTimeLimit, double TimeLimit)
 	{
 		// If this was incremental purge then its completion marks the completion of the entire GC cycle (otherwise see PostCollectGarbageImpl)		
 		FCoreUObjectDelegates::GarbageCollectComplete.Broadcast();
+		FGCPhaseHistograms::Get().RecordCollection(GGCStats);
 		if (GDumpGCAnalyticsToLog)
 		{
 			GGCStats.DumpToLog();
@@ -5018,10 +5304,12 @@ bool IncrementalDestroyGarbage(bool bUseTimeLimit, double TimeLimit)
 
 			// Log status information.
 			const int32 PurgedObjectCountSinceLastMarkPhase = GUObjectPurge.GetObjectsDestroyedSinceLastMarkPhase();
-			UE_LOG(LogGarbage, Log, TEXT("GC purged %i objects (%i -> %i) in %.3fms"), PurgedObjectCountSinceLastMarkPhase, 
+			UE_LOG(LogGarbage, Log, TEXT("GC purged %i objects (%i -> %i) in %.3fms (%i objects destroyed on worker threads in %.3fms)"), PurgedObjectCountSinceLastMarkPhase, 
 				GObjectCountDuringLastMarkPhase.GetValue(), 
 				GObjectCountDuringLastMarkPhase.GetValue() - PurgedObjectCountSinceLastMarkPhase,
-				(FPlatformTime::Seconds() - IncrementalDestroyGarbageStartTime) * 1000);
+				(FPlatformTime::Seconds() - IncrementalDestroyGarbageStartTime) * 1000,
+				GGCStats.NumObjectsDestroyedConcurrently,
+				GGCStats.ConcurrentDestroyGarbageTime * 1000);
 			UE::GC::GDetailedStats.LogPurgeStats(PurgedObjectCountSinceLastMarkPhase);
 			GUObjectPurge.ResetObjectsDestroyedSinceLastMarkPhase();
 		}
@@ -5463,7 +5751,17 @@ FORCEINLINE void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFul
 
 	GTimingInfo.LastGCDuration = FPlatformTime::Seconds() - StartTime;
 
+	if (Private::FGCNursery::Get().IsTracking())
+	{
+		Private::FGCNursery::Get().RecordCollection(Private::GIsNurseryCollection, GTimingInfo.LastGCDuration, GGCStats.NumUnreachableObjects);
+	}
+
 	CSV_CUSTOM_STAT(GC, Count, 1, ECsvCustomStatOp::Accumulate);
+	if (Private::GIsNurseryCollection)
+	{
+		CSV_CUSTOM_STAT(GC, NurseryCount, 1, ECsvCustomStatOp::Accumulate);
+		Private::GIsNurseryCollection = false;
+	}
 }
 
 EGCOptions GetReferenceCollectorOptions(bool bPerformFullPurge)
@@ -5475,7 +5773,7 @@ EGCOptions GetReferenceCollectorOptions(bool bPerformFullPurge)
 		// Toggle between Garbage Eliination enabled or disabled
 		(UObjectBaseUtility::IsGarbageEliminationEnabled() ? EGCOptions::EliminateGarbage : EGCOptions::None) |
 		// Toggle between Incremental Reachability enabled or disabled
-		((GAllowIncrementalReachability && !bPerformFullPurge) ? EGCOptions::IncrementalReachability : EGCOptions::None);
+		((GAllowIncrementalReachability && !bPerformFullPurge && !Private::GIsNurseryCollection) ? EGCOptions::IncrementalReachability : EGCOptions::None);
 }
 
 EGatherOptions GetObjectGatherOptions()
@@ -5742,6 +6040,7 @@ void PostCollectGarbageImpl(EObjectFlags KeepFlags)
 	{
 		// If this was a full purge then PostCollectGarbageImpl completion marks the completion of the entire GC cycle (otherwise see IncrementalPurgeGarbage)
 		FCoreUObjectDelegates::GarbageCollectComplete.Broadcast();
+		FGCPhaseHistograms::Get().RecordCollection(GGCStats);
 		if (GDumpGCAnalyticsToLog)
 		{
 			GGCStats.DumpToLog();
@@ -5750,6 +6049,50 @@ void PostCollectGarbageImpl(EObjectFlags KeepFlags)
 	}
 }
 
+/** Nursery collections are only safe when references from old to young objects are reported by the TObjectPtr GC barrier */
+static bool CanEnableNurseryCollection()
+{
+#if UE_OBJECT_PTR_GC_BARRIER
+	if (!GAllowIncrementalReachability)
+	{
+		ensureMsgf(false, TEXT("gc.Nursery requires gc.AllowIncrementalReachability: nursery collections rely on the same TObjectPtr reference rules as incremental reachability analysis"));
+		UE_LOG(LogGarbage, Warning, TEXT("gc.Nursery was disabled because gc.AllowIncrementalReachability is not enabled"));
+		return false;
+	}
+	return true;
+#else
+	ensureMsgf(false, TEXT("gc.Nursery requires the TObjectPtr GC barrier which was compiled out (UE_OBJECT_PTR_GC_BARRIER=0)"));
+	UE_LOG(LogGarbage, Warning, TEXT("gc.Nursery was disabled because the TObjectPtr GC barrier is compiled out"));
+	return false;
+#endif // UE_OBJECT_PTR_GC_BARRIER
+}
+
+/** Updates nursery tracking to match gc.Nursery and decides whether the next collection can be limited to young objects */
+static bool ShouldPerformNurseryCollection(bool bFullPurge)
+{
+	using namespace UE::GC::Private;
+
+	static int32 NumCollectionsSinceFullReachability = 0;
+
+	if (GNurseryCollection && !CanEnableNurseryCollection())
+	{
+		GNurseryCollection = 0;
+	}
+
+	FGCNursery& Nursery = FGCNursery::Get();
+	// Objects created before tracking started are considered old so tracking can start at any point
+	const bool bWasTracking = Nursery.IsTracking();
+	Nursery.SetTracking(GNurseryCollection != 0);
+
+	if (bWasTracking && Nursery.IsTracking() && !bFullPurge && ++NumCollectionsSinceFullReachability < FMath::Max(1, GNurseryFullCollectionInterval))
+	{
+		return true;
+	}
+
+	NumCollectionsSinceFullReachability = 0;
+	return false;
+}
+
 void FReachabilityAnalysisState::CollectGarbage(EObjectFlags KeepFlags, bool bFullPurge)
 {
 	using namespace UE::GC::Private;
@@ -5770,7 +6113,9 @@ void FReachabilityAnalysisState::CollectGarbage(EObjectFlags KeepFlags, bool bFu
 	ObjectKeepFlags = KeepFlags;
 	bPerformFullPurge = bFullPurge;
 
-	const bool bReachabilityUsingTimeLimit = !bFullPurge && GAllowIncrementalReachability;
+	GIsNurseryCollection = ShouldPerformNurseryCollection(bFullPurge);
+
+	const bool bReachabilityUsingTimeLimit = !bFullPurge && GAllowIncrementalReachability && !GIsNurseryCollection;
 	PerformReachabilityAnalysisAndConditionallyPurgeGarbage(bReachabilityUsingTimeLimit);
 }
 
@@ -5785,9 +6130,11 @@ void FReachabilityAnalysisState::PerformReachabilityAnalysisAndConditionallyPurg
 		GGCStats = UE::GC::Private::FStats();
 		GGCStats.bInProgress = true;
 		GGCStats.bStartedAsFullPurge = bPerformFullPurge;
+		GGCStats.bNurseryCollection = GIsNurseryCollection;
 		GGCStats.NumObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - GUObjectArray.GetFirstGCIndex();
 		GGCStats.NumClusters = GUObjectClusters.GetNumAllocatedClusters();
 		GGCStats.ReachabilityTimeLimit = GetReachabilityAnalysisTimeLimit();
+		FClassCostTracker::Get().BeginCollection();
 	}
 	GGCStats.bFinishedAsFullPurge = bPerformFullPurge;
 
@@ -5842,6 +6189,10 @@ void FReachabilityAnalysisState::PerformReachabilityAnalysisAndConditionallyPurg
 		}
 
 		GIsIncrementalReachabilityPending = GReachabilityState.IsSuspended();
+		if (!GIsIncrementalReachabilityPending)
+		{
+			FClassCostTracker::Get().EndCollection();
+		}
 
 		const double CurrentTime = FPlatformTime::Seconds();
 		const double ReferenceProcessingElapsedTime = CurrentTime - ReferenceProcessingStartTime;
@@ -6076,9 +6427,12 @@ bool UnhashUnreachableObjects(bool bUseTimeLimit, double TimeLimit)
 		TRACE_CPUPROFILER_EVENT_SCOPE(ConditionalBeginDestroy);
 		while (GUnrechableObjectIndex < GUnreachableObjects.Num())
 		{
-			//@todo UE - A prefetch was removed here. Re-add it. It wasn't right anyway, since it was ten items ahead and the consoles on have 8 prefetch slots
-
 			FUObjectItem* ObjectItem = GUnreachableObjects[GUnrechableObjectIndex++].ObjectItem;
+			if (GUnrechableObjectIndex < GUnreachableObjects.Num())
+			{
+				// BeginDestroy touches most of the object so start fetching the next one while this one is being destroyed
+				FPlatformMisc::Prefetch(GUnreachableObjects[GUnrechableObjectIndex].ObjectItem->GetObject());
+			}
 			{
 				UObject* Object = static_cast<UObject*>(ObjectItem->GetObject());
 				FScopedCBDProfile Profile(Object);
@@ -0,0 +1,267 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	GarbageCollectionNursery.cpp: Young generation tracking for nursery garbage collections
+=============================================================================*/
+
+#include "UObject/GarbageCollectionNursery.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/GarbageCollectionGlobals.h"
+#include "UObject/GarbageCollectionProfiling.h"
+#include "UObject/GarbageCollectionSchema.h"
+#include "UObject/PropertyOptional.h"
+#include "UObject/UnrealType.h"
+#include "Misc/OutputDevice.h"
+
+namespace UE::GC
+{
+	bool GIsNurseryWriteBarrierEnabled = false;
+}
+
+namespace UE::GC::Private
+{
+
+bool GIsNurseryCollection = false;
+
+static bool HasReferencesHiddenFromBarrier(const UStruct* Struct, TMap<const UStruct*, bool>& Cache);
+
+/** true if Property can hold an object reference that isn't stored in a TObjectPtr */
+static bool HasReferencesHiddenFromBarrier(const FProperty* Property, TMap<const UStruct*, bool>& Cache)
+{
+	if (Property->IsA<FObjectProperty>())
+	{
+		return !Property->HasAnyPropertyFlags(CPF_TObjectPtr);
+	}
+	if (Property->IsA<FInterfaceProperty>())
+	{
+		return true;
+	}
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		return HasReferencesHiddenFromBarrier(StructProperty->Struct, Cache);
+	}
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		return HasReferencesHiddenFromBarrier(ArrayProperty->Inner, Cache);
+	}
+	if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		return HasReferencesHiddenFromBarrier(SetProperty->ElementProp, Cache);
+	}
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		return HasReferencesHiddenFromBarrier(MapProperty->KeyProp, Cache) || HasReferencesHiddenFromBarrier(MapProperty->ValueProp, Cache);
+	}
+	if (const FOptionalProperty* OptionalProperty = CastField<FOptionalProperty>(Property))
+	{
+		return HasReferencesHiddenFromBarrier(OptionalProperty->GetValueProperty(), Cache);
+	}
+	return false;
+}
+
+/** true if instances of Struct can reference objects without going through the TObjectPtr GC barrier */
+static bool HasReferencesHiddenFromBarrier(const UStruct* Struct, TMap<const UStruct*, bool>& Cache)
+{
+	if (const bool* bCached = Cache.Find(Struct))
+	{
+		return *bCached;
+	}
+	// Structs can contain themselves through containers, assume they don't while their properties are being visited
+	Cache.Add(Struct, false);
+
+	bool bHidden = false;
+	if (const UClass* Class = Cast<UClass>(Struct))
+	{
+		bHidden = Class->CppClassStaticFunctions.GetAddReferencedObjects() != &UObject::AddReferencedObjects;
+		for (const UClass* IntrinsicClass = Class; IntrinsicClass && !bHidden; IntrinsicClass = IntrinsicClass->GetSuperClass())
+		{
+			// Members declared with UE_GC_MEMBER may be raw pointers
+			bHidden = IntrinsicClass->HasAnyClassFlags(CLASS_Intrinsic) && !GetIntrinsicSchema(const_cast<UClass*>(IntrinsicClass)).IsEmpty();
+		}
+	}
+	else if (const UScriptStruct* ScriptStruct = Cast<UScriptStruct>(Struct))
+	{
+		bHidden = (ScriptStruct->StructFlags & STRUCT_AddStructReferencedObjects) != 0;
+	}
+
+	for (const FProperty* Property = Struct->RefLink; Property && !bHidden; Property = Property->NextRef)
+	{
+		bHidden = HasReferencesHiddenFromBarrier(Property, Cache);
+	}
+
+	Cache.Add(Struct, bHidden);
+	return bHidden;
+}
+
+FGCNursery& FGCNursery::Get()
+{
+	static FGCNursery Nursery;
+	return Nursery;
+}
+
+FGCNursery::FGCNursery()
+{
+	InitPauseHistogram(NurseryPauses);
+	InitPauseHistogram(FullPauses);
+}
+
+void FGCNursery::SetTracking(bool bEnable)
+{
+	if (bEnable == bTracking)
+	{
+		return;
+	}
+
+	if (bEnable)
+	{
+		// GUObjectArray never grows past its capacity so the bit arrays are allocated once and never need to be reallocated.
+		// They're also never freed: threads that saw the barrier enabled may still be reading them after tracking stops.
+		if (!YoungBits.IsValid())
+		{
+			NumWords = FMath::DivideAndRoundUp(GUObjectArray.GetObjectArrayCapacity(), 64);
+			YoungBits = MakeUnique<std::atomic<uint64>[]>(NumWords);
+			RememberedBits = MakeUnique<std::atomic<uint64>[]>(NumWords);
+			ExtraRootBits = MakeUnique<std::atomic<uint64>[]>(NumWords);
+		}
+		else
+		{
+			// Bits left over from a previous tracking period
+			for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+			{
+				YoungBits[WordIndex].store(0, std::memory_order_relaxed);
+				RememberedBits[WordIndex].store(0, std::memory_order_relaxed);
+				ExtraRootBits[WordIndex].store(0, std::memory_order_relaxed);
+			}
+		}
+		NumYoung.store(0, std::memory_order_relaxed);
+		NumExtraRoots.store(0, std::memory_order_relaxed);
+
+		// Objects created before tracking started are old, find the ones nursery collections have to traverse
+		TMap<const UStruct*, bool> ClassCache;
+		for (int32 Index = GUObjectArray.GetFirstGCIndex(); Index < GUObjectArray.GetObjectArrayNum(); ++Index)
+		{
+			ClassifyOldObject(Index, ClassCache);
+		}
+
+		GUObjectArray.AddUObjectCreateListener(this);
+		GUObjectArray.AddUObjectDeleteListener(this);
+
+		bTracking = true;
+		GIsNurseryWriteBarrierEnabled = true;
+	}
+	else
+	{
+		// Stop the barrier first, stores in flight on other threads can only set bits in arrays that stay allocated
+		GIsNurseryWriteBarrierEnabled = false;
+		bTracking = false;
+
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		GUObjectArray.RemoveUObjectDeleteListener(this);
+		NumYoung.store(0, std::memory_order_relaxed);
+	}
+}
+
+void FGCNursery::PromoteAll()
+{
+	NumYoungAtLastCollection = GetNumYoung();
+
+	TMap<const UStruct*, bool> ClassCache;
+	ForEachYoungObject([this, &ClassCache](int32 Index)
+	{
+		ClassifyOldObject(Index, ClassCache);
+	});
+
+	for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+	{
+		YoungBits[WordIndex].store(0, std::memory_order_relaxed);
+		RememberedBits[WordIndex].store(0, std::memory_order_relaxed);
+	}
+	NumYoung.store(0, std::memory_order_relaxed);
+}
+
+void FGCNursery::ClassifyOldObject(int32 Index, TMap<const UStruct*, bool>& ClassCache)
+{
+	const UObjectBase* Object = GUObjectArray.IndexToObjectUnsafeForGC(Index)->GetObject();
+	if (Object && Index < NumWords * 64 && HasReferencesHiddenFromBarrier(Object->GetClass(), ClassCache))
+	{
+		const uint64 Bit = 1ull << (Index % 64);
+		if (!(ExtraRootBits[Index / 64].fetch_or(Bit, std::memory_order_relaxed) & Bit))
+		{
+			NumExtraRoots.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+void FGCNursery::RecordCollection(bool bNurseryCollection, double PauseSeconds, int32 NumUnreachableObjects)
+{
+	if (bNurseryCollection)
+	{
+		NurseryPauses.AddMeasurement(PauseSeconds * 1000.0);
+		// Only young objects can be found unreachable by a nursery collection
+		NumYoungObjectsFreed += NumUnreachableObjects;
+		NumYoungObjectsPromoted += FMath::Max(0, NumYoungAtLastCollection - NumUnreachableObjects);
+	}
+	else
+	{
+		FullPauses.AddMeasurement(PauseSeconds * 1000.0);
+	}
+}
+
+void FGCNursery::ResetStats()
+{
+	NurseryPauses.Reset();
+	FullPauses.Reset();
+	NumYoungObjectsFreed = 0;
+	NumYoungObjectsPromoted = 0;
+}
+
+void FGCNursery::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("GC nursery: %s, %d young objects, %d extra roots, %") INT64_FMT TEXT(" young objects freed and %") INT64_FMT TEXT(" promoted by nursery collections"),
+		bTracking ? TEXT("tracking") : TEXT("not tracking"), GetNumYoung(), GetNumExtraRoots(), NumYoungObjectsFreed, NumYoungObjectsPromoted);
+	DumpPauseHistogram(Ar, TEXT("Nursery collection pauses"), NurseryPauses);
+	DumpPauseHistogram(Ar, TEXT("Full collection pauses"), FullPauses);
+}
+
+void FGCNursery::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// Objects in the disregard for GC pool are never collected
+	if (Index >= GUObjectArray.GetFirstGCIndex() && Index < NumWords * 64)
+	{
+		const uint64 Bit = 1ull << (Index % 64);
+		RememberedBits[Index / 64].fetch_and(~Bit, std::memory_order_relaxed);
+		if (!(YoungBits[Index / 64].fetch_or(Bit, std::memory_order_relaxed) & Bit))
+		{
+			NumYoung.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+void FGCNursery::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+	if (Index < NumWords * 64)
+	{
+		const uint64 Bit = 1ull << (Index % 64);
+		RememberedBits[Index / 64].fetch_and(~Bit, std::memory_order_relaxed);
+		if (YoungBits[Index / 64].fetch_and(~Bit, std::memory_order_relaxed) & Bit)
+		{
+			NumYoung.fetch_sub(1, std::memory_order_relaxed);
+		}
+		if (ExtraRootBits[Index / 64].fetch_and(~Bit, std::memory_order_relaxed) & Bit)
+		{
+			NumExtraRoots.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+void FGCNursery::OnUObjectArrayShutdown()
+{
+	SetTracking(false);
+}
+
+SIZE_T FGCNursery::GetAllocatedSize() const
+{
+	return 3 * NumWords * sizeof(std::atomic<uint64>);
+}
+
+} // namespace UE::GC::Private
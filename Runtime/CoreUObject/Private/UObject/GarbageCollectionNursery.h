@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	GarbageCollectionNursery.h: Young generation tracking for nursery garbage collections
+=============================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/Histogram.h"
+#include "UObject/UObjectArray.h"
+#include <atomic>
+
+namespace UE::GC::Private
+{
+
+/**
+ * Tracks the objects created since the last garbage collection (the nursery) and the young objects that were stored in a TObjectPtr
+ * (the remembered set). A nursery collection only resets the reachability of young objects, old objects keep the reachable state
+ * from the previous collection, so reachability analysis stops as soon as it reaches an old object.
+ * Young objects referenced by old objects must be in the remembered set which means nursery collections rely on the TObjectPtr
+ * GC barrier the same way incremental reachability analysis does: references from old objects have to be stored in TObjectPtrs.
+ * Old objects whose class can hold references the barrier never sees (raw pointer properties, intrinsic members or an
+ * AddReferencedObjects override) are tracked as extra roots and traversed by every nursery collection.
+ */
+class FGCNursery final : public FUObjectArray::FUObjectCreateListener, public FUObjectArray::FUObjectDeleteListener
+{
+public:
+	static FGCNursery& Get();
+
+	/** Starts or stops tracking young objects and enables or disables the nursery write barrier */
+	void SetTracking(bool bEnable);
+
+	FORCEINLINE bool IsTracking() const
+	{
+		return bTracking;
+	}
+
+	FORCEINLINE bool IsYoung(int32 Index) const
+	{
+		return IsBitSet(YoungBits.Get(), Index);
+	}
+
+	FORCEINLINE bool IsRemembered(int32 Index) const
+	{
+		return IsBitSet(RememberedBits.Get(), Index);
+	}
+
+	FORCEINLINE bool IsExtraRoot(int32 Index) const
+	{
+		return IsBitSet(ExtraRootBits.Get(), Index);
+	}
+
+	/** Nursery write barrier, called for every raw object pointer stored in a TObjectPtr while tracking */
+	FORCEINLINE void Remember(const UObjectBase* Object)
+	{
+		const int32 Index = GUObjectArray.ObjectToIndex(Object);
+		if (IsYoung(Index) && !IsRemembered(Index))
+		{
+			RememberedBits[Index / 64].fetch_or(1ull << (Index % 64), std::memory_order_relaxed);
+		}
+	}
+
+	FORCEINLINE int32 GetNumYoung() const
+	{
+		return NumYoung.load(std::memory_order_relaxed);
+	}
+
+	FORCEINLINE int32 GetNumExtraRoots() const
+	{
+		return NumExtraRoots.load(std::memory_order_relaxed);
+	}
+
+	/** Calls Visitor with the index of every young object */
+	template<typename VisitorType>
+	void ForEachYoungObject(VisitorType&& Visitor) const
+	{
+		ForEachSetBit(YoungBits.Get(), Forward<VisitorType>(Visitor));
+	}
+
+	/** Calls Visitor with the index of every old object that holds references the nursery write barrier can't see */
+	template<typename VisitorType>
+	void ForEachExtraRoot(VisitorType&& Visitor) const
+	{
+		ForEachSetBit(ExtraRootBits.Get(), Forward<VisitorType>(Visitor));
+	}
+
+	/**
+	 * Promotes all young objects to the old generation, called once a collection has marked every object it's going to keep.
+	 * Promoted objects whose class may reference young objects without going through TObjectPtr become extra roots.
+	 */
+	void PromoteAll();
+
+	/** Records the pause time of a collection and how many objects it found unreachable */
+	void RecordCollection(bool bNurseryCollection, double PauseSeconds, int32 NumUnreachableObjects);
+
+	/** Prints collection counts and the pause time histograms of nursery and full collections */
+	void DumpStats(FOutputDevice& Ar) const;
+
+	void ResetStats();
+
+	//~ Begin FUObjectCreateListener / FUObjectDeleteListener Interface.
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+	virtual SIZE_T GetAllocatedSize() const override;
+	//~ End FUObjectCreateListener / FUObjectDeleteListener Interface.
+
+private:
+	FGCNursery();
+
+	FORCEINLINE bool IsBitSet(const std::atomic<uint64>* Bits, int32 Index) const
+	{
+		return Index < NumWords * 64 && (Bits[Index / 64].load(std::memory_order_relaxed) & (1ull << (Index % 64)));
+	}
+
+	template<typename VisitorType>
+	void ForEachSetBit(const std::atomic<uint64>* Bits, VisitorType&& Visitor) const
+	{
+		for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			for (uint64 Word = Bits[WordIndex].load(std::memory_order_relaxed); Word; Word &= Word - 1)
+			{
+				Visitor(WordIndex * 64 + (int32)FMath::CountTrailingZeros64(Word));
+			}
+		}
+	}
+
+	/** Sets the extra root bit of an old object if its class holds references the nursery write barrier can't see */
+	void ClassifyOldObject(int32 Index, TMap<const UStruct*, bool>& ClassCache);
+
+	/** One bit per GUObjectArray slot, set for objects created since the last collection */
+	TUniquePtr<std::atomic<uint64>[]> YoungBits;
+	/** One bit per GUObjectArray slot, set for young objects that were stored in a TObjectPtr. Never freed, see SetTracking */
+	TUniquePtr<std::atomic<uint64>[]> RememberedBits;
+	/** One bit per GUObjectArray slot, set for old objects that are traversed by every nursery collection */
+	TUniquePtr<std::atomic<uint64>[]> ExtraRootBits;
+	int32 NumWords = 0;
+	std::atomic<int32> NumYoung = 0;
+	int32 NumYoungAtLastCollection = 0;
+	std::atomic<int32> NumExtraRoots = 0;
+	bool bTracking = false;
+
+	FHistogram NurseryPauses;
+	FHistogram FullPauses;
+	int64 NumYoungObjectsFreed = 0;
+	int64 NumYoungObjectsPromoted = 0;
+};
+
+/** true while the current collection is a nursery collection */
+extern bool GIsNurseryCollection;
+
+} // namespace UE::GC::Private
@@ -0,0 +1,294 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	GarbageCollectionProfiling.cpp: Per class reachability cost and GC phase time tracking
+=============================================================================*/
+
+#include "UObject/GarbageCollectionProfiling.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+#include "Trace/Trace.inl"
+#include "UObject/Class.h"
+#include "UObject/ReachabilityAnalysis.h"
+
+static int32 GClassCostTracking = 0;
+static FAutoConsoleVariableRef CVarClassCostTracking(
+	TEXT("gc.ClassCostTracking"),
+	GClassCostTracking,
+	TEXT("If true, reachability analysis records the number of objects visited, references traversed and time spent per class (see gc.DumpClassCosts). ")
+	TEXT("Uses the slower debug reachability processor and is not available in shipping builds."),
+	ECVF_Default
+);
+
+static FAutoConsoleCommandWithArgsAndOutputDevice GDumpClassCostsCmd(
+	TEXT("gc.DumpClassCosts"),
+	TEXT("Prints the classes with the highest reachability analysis cost recorded with gc.ClassCostTracking. Optional argument: number of classes (default 30)."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		int32 NumClasses = 30;
+		if (Args.Num() > 0)
+		{
+			LexFromString(NumClasses, *Args[0]);
+		}
+		UE::GC::Private::FClassCostTracker::Get().DumpReport(Ar, FMath::Max(NumClasses, 1));
+	}));
+
+static FAutoConsoleCommandWithOutputDevice GDumpPhaseHistogramsCmd(
+	TEXT("gc.DumpPhaseHistograms"),
+	TEXT("Prints the pause time histograms of the mark, sweep and purge phases of garbage collection"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		UE::GC::Private::FGCPhaseHistograms::Get().DumpReport(Ar);
+	}));
+
+static FAutoConsoleCommand GResetProfilingStatsCmd(
+	TEXT("gc.ResetProfilingStats"),
+	TEXT("Resets the class costs and phase histograms printed by gc.DumpClassCosts and gc.DumpPhaseHistograms"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		UE::GC::Private::FClassCostTracker::Get().Reset();
+		UE::GC::Private::FGCPhaseHistograms::Get().Reset();
+	}));
+
+UE_TRACE_CHANNEL_DEFINE(GCChannel);
+
+UE_TRACE_EVENT_BEGIN(GC, ClassCost)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, ClassName)
+	UE_TRACE_EVENT_FIELD(uint64, NumObjects)
+	UE_TRACE_EVENT_FIELD(uint64, NumReferences)
+	UE_TRACE_EVENT_FIELD(uint64, Cycles)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(GC, Collection)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(double, MarkTime)
+	UE_TRACE_EVENT_FIELD(double, SweepTime)
+	UE_TRACE_EVENT_FIELD(double, PurgeTime)
+	UE_TRACE_EVENT_FIELD(double, TotalTime)
+	UE_TRACE_EVENT_FIELD(int32, NumObjects)
+	UE_TRACE_EVENT_FIELD(int32, NumUnreachableObjects)
+	UE_TRACE_EVENT_FIELD(bool, FullPurge)
+	UE_TRACE_EVENT_FIELD(bool, NurseryCollection)
+UE_TRACE_EVENT_END()
+
+namespace UE::GC::Private
+{
+
+void InitPauseHistogram(FHistogram& Histogram)
+{
+	Histogram.InitFromArray({ 0.0, 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0 });
+}
+
+void DumpPauseHistogram(FOutputDevice& Ar, const TCHAR* Name, const FHistogram& Histogram)
+{
+	Ar.Logf(TEXT("%s: %") INT64_FMT TEXT(" collections, avg %.2f ms, min %.2f ms, max %.2f ms"), Name, Histogram.GetNumMeasurements(),
+		Histogram.GetAverageOfAllMeasures(), Histogram.GetMinOfAllMeasures(), Histogram.GetMaxOfAllMeasures());
+
+	for (int32 BinIndex = 0; BinIndex < Histogram.GetNumBins(); ++BinIndex)
+	{
+		const int32 Count = Histogram.GetBinObservationsCount(BinIndex);
+		if (Count > 0)
+		{
+			// The last bin extends to infinity
+			if (BinIndex == Histogram.GetNumBins() - 1)
+			{
+				Ar.Logf(TEXT("  [%7.1f ms ...      ) %6d"), Histogram.GetBinLowerBound(BinIndex), Count);
+			}
+			else
+			{
+				Ar.Logf(TEXT("  [%7.1f ms %7.1f ms) %6d"), Histogram.GetBinLowerBound(BinIndex), Histogram.GetBinUpperBound(BinIndex), Count);
+			}
+		}
+	}
+}
+
+bool FClassCostTracker::bTracking = false;
+
+FClassCostTracker& FClassCostTracker::Get()
+{
+	static FClassCostTracker Tracker;
+	return Tracker;
+}
+
+FClassCostTracker::FThreadCosts& FClassCostTracker::GetThreadCosts()
+{
+	static thread_local FThreadCosts* ThreadCosts = nullptr;
+	if (!ThreadCosts)
+	{
+		FClassCostTracker& Tracker = Get();
+		FScopeLock Lock(&Tracker.ThreadCostsCritical);
+		ThreadCosts = Tracker.AllThreadCosts.Add_GetRef(MakeUnique<FThreadCosts>()).Get();
+	}
+	return *ThreadCosts;
+}
+
+void FClassCostTracker::BeginCollection()
+{
+	check(IsInGameThread());
+#if UE_BUILD_SHIPPING
+	bTracking = false;
+#else
+	bTracking = !!GClassCostTracking;
+#endif
+	if (bTracking)
+	{
+		// Worker threads don't touch their maps outside of reachability analysis
+		FScopeLock Lock(&ThreadCostsCritical);
+		for (TUniquePtr<FThreadCosts>& ThreadCosts : AllThreadCosts)
+		{
+			ThreadCosts->Costs.Reset();
+			ThreadCosts->Current = nullptr;
+		}
+	}
+}
+
+void FClassCostTracker::EndCollection()
+{
+	check(IsInGameThread());
+	if (!bTracking)
+	{
+		return;
+	}
+	bTracking = false;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FClassCostTracker::EndCollection);
+
+	TMap<const UClass*, FClassCost> MergedCosts;
+	{
+		FScopeLock Lock(&ThreadCostsCritical);
+		for (TUniquePtr<FThreadCosts>& ThreadCosts : AllThreadCosts)
+		{
+			for (const TPair<const UClass*, FClassCost>& Pair : ThreadCosts->Costs)
+			{
+				MergedCosts.FindOrAdd(Pair.Key).Add(Pair.Value);
+			}
+			ThreadCosts->Costs.Reset();
+		}
+	}
+
+	// Classes are keyed by path name from here on as they may be destroyed before the report is printed.
+	// Short names are not unique, e.g. generated classes with the same name in different packages.
+	LastCollectionCosts.Reset();
+	for (const TPair<const UClass*, FClassCost>& Pair : MergedCosts)
+	{
+		const FString ClassPath = Pair.Key->GetPathName();
+		LastCollectionCosts.FindOrAdd(ClassPath).Add(Pair.Value);
+		TotalCosts.FindOrAdd(ClassPath).Add(Pair.Value);
+
+		UE_TRACE_LOG(GC, ClassCost, GCChannel)
+			<< ClassCost.ClassName(*ClassPath)
+			<< ClassCost.NumObjects(Pair.Value.NumObjects)
+			<< ClassCost.NumReferences(Pair.Value.NumReferences)
+			<< ClassCost.Cycles(Pair.Value.Cycles);
+	}
+	NumTrackedCollections++;
+}
+
+static void DumpClassCosts(FOutputDevice& Ar, const TCHAR* Name, const TMap<FString, FClassCost>& Costs, int32 NumClasses)
+{
+	TArray<TPair<FString, FClassCost>> SortedCosts = Costs.Array();
+	SortedCosts.Sort([](const TPair<FString, FClassCost>& A, const TPair<FString, FClassCost>& B) { return A.Value.Cycles > B.Value.Cycles; });
+
+	FClassCost TotalCost;
+	for (const TPair<FString, FClassCost>& Pair : SortedCosts)
+	{
+		TotalCost.Add(Pair.Value);
+	}
+
+	Ar.Logf(TEXT("%s: %d classes, %") UINT64_FMT TEXT(" objects, %") UINT64_FMT TEXT(" references, %.2f ms"), Name, SortedCosts.Num(),
+		TotalCost.NumObjects, TotalCost.NumReferences, FPlatformTime::ToMilliseconds64(TotalCost.Cycles));
+	Ar.Logf(TEXT("  %10s %7s %12s %12s  %s"), TEXT("Time (ms)"), TEXT("Time %"), TEXT("Objects"), TEXT("References"), TEXT("Class"));
+
+	for (int32 Index = 0; Index < FMath::Min(NumClasses, SortedCosts.Num()); ++Index)
+	{
+		const FClassCost& Cost = SortedCosts[Index].Value;
+		const double Percent = TotalCost.Cycles ? 100.0 * Cost.Cycles / TotalCost.Cycles : 0.0;
+		Ar.Logf(TEXT("  %10.3f %6.2f%% %12") UINT64_FMT TEXT(" %12") UINT64_FMT TEXT("  %s"), FPlatformTime::ToMilliseconds64(Cost.Cycles), Percent,
+			Cost.NumObjects, Cost.NumReferences, *SortedCosts[Index].Key);
+	}
+}
+
+void FClassCostTracker::DumpReport(FOutputDevice& Ar, int32 NumClasses)
+{
+#if UE_BUILD_SHIPPING
+	Ar.Logf(TEXT("GC class cost tracking is not available in shipping builds"));
+#else
+	if (NumTrackedCollections == 0)
+	{
+		Ar.Logf(TEXT("No GC class costs recorded, enable gc.ClassCostTracking and collect garbage first"));
+		return;
+	}
+
+	DumpClassCosts(Ar, TEXT("Last collection"), LastCollectionCosts, NumClasses);
+	DumpClassCosts(Ar, *FString::Printf(TEXT("All %d tracked collections"), NumTrackedCollections), TotalCosts, NumClasses);
+#endif
+}
+
+void FClassCostTracker::Reset()
+{
+	LastCollectionCosts.Reset();
+	TotalCosts.Reset();
+	NumTrackedCollections = 0;
+}
+
+FGCPhaseHistograms& FGCPhaseHistograms::Get()
+{
+	static FGCPhaseHistograms Histograms;
+	return Histograms;
+}
+
+FGCPhaseHistograms::FGCPhaseHistograms()
+{
+	InitPauseHistogram(Mark);
+	InitPauseHistogram(Sweep);
+	InitPauseHistogram(Purge);
+	InitPauseHistogram(Total);
+	InitPauseHistogram(LongestStep);
+}
+
+void FGCPhaseHistograms::RecordCollection(const FStats& Stats)
+{
+	const double MarkTime = Stats.ReachabilityTime.Total;
+	const double SweepTime = Stats.GatherUnreachableTime.Total + Stats.UnhashingTime.Total;
+	const double PurgeTime = Stats.DestroyGarbageTime.Total;
+	const double LongestStepTime = FMath::Max(FMath::Max(Stats.ReachabilityTime.Max, Stats.GatherUnreachableTime.Max),
+		FMath::Max(Stats.UnhashingTime.Max, Stats.DestroyGarbageTime.Max));
+
+	Mark.AddMeasurement(MarkTime * 1000.0);
+	Sweep.AddMeasurement(SweepTime * 1000.0);
+	Purge.AddMeasurement(PurgeTime * 1000.0);
+	Total.AddMeasurement(Stats.TotalTime * 1000.0);
+	LongestStep.AddMeasurement(LongestStepTime * 1000.0);
+
+	UE_TRACE_LOG(GC, Collection, GCChannel)
+		<< Collection.Cycle(FPlatformTime::Cycles64())
+		<< Collection.MarkTime(MarkTime)
+		<< Collection.SweepTime(SweepTime)
+		<< Collection.PurgeTime(PurgeTime)
+		<< Collection.TotalTime(Stats.TotalTime)
+		<< Collection.NumObjects(Stats.NumObjects)
+		<< Collection.NumUnreachableObjects(Stats.NumUnreachableObjects)
+		<< Collection.FullPurge(Stats.bFinishedAsFullPurge)
+		<< Collection.NurseryCollection(Stats.bNurseryCollection);
+}
+
+void FGCPhaseHistograms::DumpReport(FOutputDevice& Ar) const
+{
+	DumpPauseHistogram(Ar, TEXT("Mark (reachability analysis)"), Mark);
+	DumpPauseHistogram(Ar, TEXT("Sweep (gather unreachable and BeginDestroy)"), Sweep);
+	DumpPauseHistogram(Ar, TEXT("Purge (FinishDestroy and free)"), Purge);
+	DumpPauseHistogram(Ar, TEXT("Total"), Total);
+	DumpPauseHistogram(Ar, TEXT("Longest time sliced step"), LongestStep);
+}
+
+void FGCPhaseHistograms::Reset()
+{
+	Mark.Reset();
+	Sweep.Reset();
+	Purge.Reset();
+	Total.Reset();
+	LongestStep.Reset();
+}
+
+} // namespace UE::GC::Private
@@ -0,0 +1,141 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	GarbageCollectionProfiling.h: Per class reachability cost and GC phase time tracking
+=============================================================================*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "ProfilingDebugging/Histogram.h"
+
+namespace UE::GC::Private
+{
+
+struct FStats;
+
+/** Initializes a histogram with the pause time buckets (in milliseconds) used by DumpPauseHistogram */
+void InitPauseHistogram(FHistogram& Histogram);
+
+/** Prints a pause time histogram with values in milliseconds */
+void DumpPauseHistogram(FOutputDevice& Ar, const TCHAR* Name, const FHistogram& Histogram);
+
+/** Reachability analysis cost of all instances of a class */
+struct FClassCost
+{
+	uint64 NumObjects = 0;
+	uint64 NumReferences = 0;
+	uint64 Cycles = 0;
+
+	void Add(const FClassCost& Other)
+	{
+		NumObjects += Other.NumObjects;
+		NumReferences += Other.NumReferences;
+		Cycles += Other.Cycles;
+	}
+};
+
+/**
+ * Records how many objects of each class reachability analysis visited, how many references it traversed through their schemas
+ * and how long that took. Tracking is enabled with gc.ClassCostTracking and forces the debug reachability processor which handles
+ * references one at a time so that they can be attributed to the referencing object, which makes tracked collections slower.
+ * Every worker thread accumulates into its own map, the maps are merged on the game thread once reachability analysis is done.
+ */
+class FClassCostTracker
+{
+public:
+	static FClassCostTracker& Get();
+
+	/** True while the current reachability analysis is tracking class costs */
+	static FORCEINLINE bool IsTracking()
+	{
+		return bTracking;
+	}
+
+	/** Called before the first reachability analysis iteration, starts tracking if gc.ClassCostTracking is set */
+	void BeginCollection();
+
+	/** Called after the last reachability analysis iteration, merges the costs recorded by all worker threads */
+	void EndCollection();
+
+	/** Counts Object and starts attributing its traversed references, including the class and outer, to its class */
+	static FORCEINLINE void BeginObject(const UObject* Object)
+	{
+		FThreadCosts& ThreadCosts = GetThreadCosts();
+		ThreadCosts.Current = &ThreadCosts.Costs.FindOrAdd(Object->GetClass());
+		ThreadCosts.Current->NumObjects++;
+		ThreadCosts.StartCycles = FPlatformTime::Cycles64();
+	}
+
+	static FORCEINLINE void AddReference()
+	{
+		if (FClassCost* Current = GetThreadCosts().Current)
+		{
+			Current->NumReferences++;
+		}
+	}
+
+	static FORCEINLINE void EndObject()
+	{
+		FThreadCosts& ThreadCosts = GetThreadCosts();
+		ThreadCosts.Current->Cycles += FPlatformTime::Cycles64() - ThreadCosts.StartCycles;
+		ThreadCosts.Current = nullptr;
+	}
+
+	/** Prints the NumClasses most expensive classes of the last tracked collection and of all tracked collections */
+	void DumpReport(FOutputDevice& Ar, int32 NumClasses);
+
+	void Reset();
+
+private:
+	struct FThreadCosts
+	{
+		TMap<const UClass*, FClassCost> Costs;
+		FClassCost* Current = nullptr;
+		uint64 StartCycles = 0;
+	};
+
+	static FThreadCosts& GetThreadCosts();
+
+	static bool bTracking;
+
+	FCriticalSection ThreadCostsCritical;
+	/** Costs of every thread that ran reachability analysis, never freed as worker threads live as long as the process */
+	TArray<TUniquePtr<FThreadCosts>> AllThreadCosts;
+
+	/** Merged costs of the last tracked collection, keyed by class path name */
+	TMap<FString, FClassCost> LastCollectionCosts;
+	/** Merged costs of all tracked collections since the last reset, keyed by class path name */
+	TMap<FString, FClassCost> TotalCosts;
+	int32 NumTrackedCollections = 0;
+};
+
+/** Pause time histograms of the mark, sweep and purge phases of every garbage collection */
+class FGCPhaseHistograms
+{
+public:
+	static FGCPhaseHistograms& Get();
+
+	/** Called when a garbage collection cycle, including the purge phase, has completed */
+	void RecordCollection(const FStats& Stats);
+
+	void DumpReport(FOutputDevice& Ar) const;
+
+	void Reset();
+
+private:
+	FGCPhaseHistograms();
+
+	/** Reachability analysis */
+	FHistogram Mark;
+	/** Gathering unreachable objects and routing BeginDestroy */
+	FHistogram Sweep;
+	/** Routing FinishDestroy and freeing objects */
+	FHistogram Purge;
+	FHistogram Total;
+	/** Longest single time sliced step of any phase */
+	FHistogram LongestStep;
+};
+
+} // namespace UE::GC::Private
@@ -1,6 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GarbageCollectionTesting.h"
+#include "GarbageCollectionNursery.h"
+#include "GarbageCollectionProfiling.h"
+#include "HAL/IConsoleManager.h"
 #include "UObject/GarbageCollectionSchema.h"
 #include "UObject/UnrealType.h"
 
@@ -85,7 +88,87 @@ void UnlinkReachabilityStressData(TArray<UObjectReachabilityStressData*>& Data)
 	}
 }
 
+static void RunNurseryChurnFrames(int32 NumFrames, UObjectNurseryChurnHolder* Holder, FHistogram& OutPauses)
+{
+	// 256 trees of 15 objects each per frame, one tree in 64 outlives the frame
+	const int32 NumTreesPerFrame = 256;
+	const int32 TreeLevels = 3;
+	const int32 SurvivorInterval = 64;
+
+	for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+	{
+		for (int32 TreeIndex = 0; TreeIndex < NumTreesPerFrame; ++TreeIndex)
+		{
+			UObjectReachabilityStressData* Tree = ConditionallyAllocateNewStressDataObject();
+			if (!Tree)
+			{
+				break;
+			}
+
+			GenerateReachabilityStressData(TreeLevels, Tree);
+			if (TreeIndex % SurvivorInterval == 0)
+			{
+				Holder->Survivors.Add(Tree);
+			}
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false);
+		OutPauses.AddMeasurement((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+}
+
+void BenchmarkNurseryChurn(int32 NumFrames, FOutputDevice& Ar)
+{
+	using namespace UE::GC::Private;
+
+	IConsoleVariable* NurseryCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.Nursery"));
+	check(NurseryCVar);
+	const int32 PreviousNurseryValue = NurseryCVar->GetInt();
+	// Nursery collections are refused unless the project follows the incremental reachability reference rules
+	IConsoleVariable* IncrementalReachabilityCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("gc.AllowIncrementalReachability"));
+	check(IncrementalReachabilityCVar);
+	const int32 PreviousIncrementalReachabilityValue = IncrementalReachabilityCVar->GetInt();
+	IncrementalReachabilityCVar->Set(1, ECVF_SetByCode);
+
+	// Long lived objects that every full reachability analysis has to traverse
+	TArray<UObjectReachabilityStressData*> LongLivedData;
+	GenerateReachabilityStressData(LongLivedData);
+
+	UObjectNurseryChurnHolder* Holder = NewObject<UObjectNurseryChurnHolder>();
+	Holder->AddToRoot();
+
+	FHistogram Pauses[2];
+	for (int32 NurseryValue = 0; NurseryValue < 2; ++NurseryValue)
+	{
+		NurseryCVar->Set(NurseryValue, ECVF_SetByCode);
+		// Starts or stops nursery tracking and makes everything allocated so far old
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		FGCNursery::Get().ResetStats();
+
+		InitPauseHistogram(Pauses[NurseryValue]);
+		RunNurseryChurnFrames(NumFrames, Holder, Pauses[NurseryValue]);
+		Holder->Survivors.Reset();
+	}
+
+	Ar.Logf(TEXT("Nursery churn benchmark: %d frames, %d objects"), NumFrames, GUObjectArray.GetObjectArrayNumMinusAvailable());
+	DumpPauseHistogram(Ar, TEXT("gc.Nursery=0 pauses"), Pauses[0]);
+	DumpPauseHistogram(Ar, TEXT("gc.Nursery=1 pauses"), Pauses[1]);
+	FGCNursery::Get().DumpStats(Ar);
+
+	NurseryCVar->Set(PreviousNurseryValue, ECVF_SetByCode);
+	IncrementalReachabilityCVar->Set(PreviousIncrementalReachabilityValue, ECVF_SetByCode);
+	Holder->RemoveFromRoot();
+	UnlinkReachabilityStressData(LongLivedData);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+}
+
 IMPLEMENT_CORE_INTRINSIC_CLASS(UObjectReachabilityStressData, UObject,
 	{
 		UE::GC::DeclareIntrinsicMembers(Class, { UE_GC_MEMBER(UObjectReachabilityStressData, Children) });
 	});
+
+IMPLEMENT_CORE_INTRINSIC_CLASS(UObjectNurseryChurnHolder, UObject,
+	{
+		UE::GC::DeclareIntrinsicMembers(Class, { UE_GC_MEMBER(UObjectNurseryChurnHolder, Survivors) });
+	});
@@ -16,7 +16,30 @@ class UObjectReachabilityStressData : public UObject
 
 public:
 	TArray<UObjectReachabilityStressData*> Children;
+
+	virtual bool IsDestructionThreadSafe() const override
+	{
+		return true;
+	}
+};
+
+class UObjectNurseryChurnHolder : public UObject
+{
+	DECLARE_CLASS_INTRINSIC(UObjectNurseryChurnHolder,
+		UObject,
+		CLASS_Transient,
+		TEXT("/Script/CoreUObject"));
+
+public:
+	/** Short lived objects that outlived their frame, stored in TObjectPtrs so that nursery collections remember them */
+	TArray<TObjectPtr<UObject>> Survivors;
 };
 
 void GenerateReachabilityStressData(TArray<UObjectReachabilityStressData*>& Data);
 void UnlinkReachabilityStressData(TArray<UObjectReachabilityStressData*>& Data);
+
+/**
+ * Simulates short lived object churn on top of the reachability stress data: every frame creates small object trees,
+ * keeps a few of them alive and collects garbage. Logs the pause time histograms with gc.Nursery disabled and enabled.
+ */
+void BenchmarkNurseryChurn(int32 NumFrames, FOutputDevice& Ar);
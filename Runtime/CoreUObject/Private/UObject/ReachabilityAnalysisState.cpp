@@ -95,11 +95,13 @@ void FStats::DumpToLog()
 	UE_LOG(LogGarbage, Log, TEXT("  VerifyNoUnreachable     %7.3fms"), VerifyNoUnreachableTime * 1000);	
 	UE_LOG(LogGarbage, Log, TEXT("  Unhashing               %s"), *UnhashingTime.ToString());
 	UE_LOG(LogGarbage, Log, TEXT("  DestroyGarbage          %s"), *DestroyGarbageTime.ToString());
+	UE_LOG(LogGarbage, Log, TEXT("  ConcurrentDestroy       %7.3fms (worker threads, %d objects)"), ConcurrentDestroyGarbageTime * 1000, NumObjectsDestroyedConcurrently);
 
 	UE_LOG(LogGarbage, Log, TEXT("Pre GC:     Objects: %7d, Roots : %7d, Clusters : %7d, Clustered Objects : %7d"), NumObjects, NumRoots, NumClusters, NumClusteredObjects);
 	UE_LOG(LogGarbage, Log, TEXT("Destroyed:  Objects: %7d, including        Clusters : %7d, Clustered Objects : %7d"), NumUnreachableObjects, NumDissolvedClusters, NumUnreachableClusteredObjects);
 	UE_LOG(LogGarbage, Log, TEXT("Number of barrier objects: %d"), NumBarrierObjects);
 	UE_LOG(LogGarbage, Log, TEXT("Number of weak references for clearing %d and objects that need weak reference clearing: %d"), NumWeakReferencesForClearing, NumObjectsThatNeedWeakReferenceClearing);
+	UE_LOG(LogGarbage, Log, TEXT("Nursery collection: %s, young objects: %d, remembered objects: %d"), UE_TRUE_FALSE(bNurseryCollection), NumYoungObjects, NumRememberedObjects);
 	UE_LOG(LogGarbage, Log, TEXT("Started as full purge: %s, finished as full purge: %s"), UE_TRUE_FALSE(bStartedAsFullPurge), UE_TRUE_FALSE(bFinishedAsFullPurge));
 	UE_LOG(LogGarbage, Log, TEXT("Flushed async loading: %s"), UE_TRUE_FALSE(bFlushedAsyncLoading));
 	UE_LOG(LogGarbage, Log, TEXT("Purged previous GC objects: %s"), UE_TRUE_FALSE(bPurgedPreviousGCObjects));
@@ -990,6 +990,9 @@ private:
 			FSchemaView Schema = Class->ReferenceSchema.Get();
 			Dispatcher.Context.ReferencingObject = CurrentObject;
 
+			// Time every object, including those with empty schemas that only emit base references
+			Processor.BeginTimingObject(CurrentObject);
+
 			// Emit base references
 			Dispatcher.HandleImmutableReference(Class, EMemberlessId::Class, EOrigin::Other);
 			Dispatcher.HandleImmutableReference(Outer, EMemberlessId::Outer, EOrigin::Other);
@@ -1001,10 +1004,9 @@ private:
 			if (!Schema.IsEmpty())
 			{
 				typename DispatcherType::SchemaStackScopeType SchemaStack(Dispatcher.Context, Schema);
-				Processor.BeginTimingObject(CurrentObject);
 				Private::VisitMembers(Dispatcher, Schema, CurrentObject);
-				Processor.UpdateDetailedStats(CurrentObject);
 			}
+			Processor.UpdateDetailedStats(CurrentObject);
 		}
 	}
 
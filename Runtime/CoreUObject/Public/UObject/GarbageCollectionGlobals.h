@@ -24,4 +24,7 @@ namespace UE::GC
 
 	/** true if incremental reachability analysis is in progress (global for faster access in low level structs and functions otherwise use IsIncrementalReachabilityAnalisysPending()) */
 	extern COREUOBJECT_API bool GIsIncrementalReachabilityPending;
+
+	/** true if nursery garbage collection is enabled and raw pointers stored in TObjectPtrs need to be reported to the GC barrier (gc.Nursery) */
+	extern COREUOBJECT_API bool GIsNurseryWriteBarrierEnabled;
 }
@@ -618,12 +618,24 @@ public:
 		return false;
 	}
 
+	/**
+	* Called during async load to determine if Serialize can be called on a worker thread, concurrently with the serialization of other
+	* exports of the same package. Only used when s.ParallelExportSerialization is enabled. Serialize must not create or rename objects
+	* and must not modify state shared with other objects without synchronization.
+	*
+	* @return	true if this object's Serialize is thread safe
+	*/
+	virtual bool IsSerializeThreadSafe() const
+	{
+		return false;
+	}
+
 	/**
 	* Called during garbage collection to determine if an object can have its destructor called on a worker thread.
+	* Only used when gc.ConcurrentPurge is enabled. BeginDestroy and FinishDestroy are always called on the game thread.
 	*
 	* @return	true if this object's destructor is thread safe
 	*/
-	UE_DEPRECATED(5.5, "Multithreaded destruction of UObjects is no longer supported.")
 	COREUOBJECT_API virtual bool IsDestructionThreadSafe() const;
 
 	/**
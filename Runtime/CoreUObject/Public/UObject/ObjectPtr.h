@@ -95,7 +95,7 @@ public:
 		: Handle(Handle)
 	{
 #if UE_OBJECT_PTR_GC_BARRIER
-		ConditionallyMarkAsReachable(*this);
+		ConditionallyMarkAsReachable(*this, true /* bNewReference */);
 #endif // UE_OBJECT_PTR_GC_BARRIER
 	}
 #endif
@@ -309,9 +309,11 @@ private:
 	};
 
 #if UE_OBJECT_PTR_GC_BARRIER
-	FORCEINLINE void ConditionallyMarkAsReachable(const FObjectPtr& InPtr) const
+	// Copies and moves between object pointers only need the incremental reachability barrier. A young object first enters an object pointer
+	// through a raw pointer or handle store which already reported it to the nursery, so the nursery barrier only runs for new references.
+	FORCEINLINE void ConditionallyMarkAsReachable(const FObjectPtr& InPtr, bool bNewReference = false) const
 	{
-		if (UE::GC::GIsIncrementalReachabilityPending && InPtr.IsResolved())
+		if ((UE::GC::GIsIncrementalReachabilityPending | (bNewReference & UE::GC::GIsNurseryWriteBarrierEnabled)) && InPtr.IsResolved())
 		{
 			if (UObject* Obj = UE::CoreUObject::Private::ReadObjectHandlePointerNoCheck(InPtr.GetHandleRef()))
 			{
@@ -321,7 +323,7 @@ private:
 	}
 	FORCEINLINE void ConditionallyMarkAsReachable(const UObject* InObj) const
 	{
-		if (UE::GC::GIsIncrementalReachabilityPending && InObj)
+		if ((UE::GC::GIsIncrementalReachabilityPending | UE::GC::GIsNurseryWriteBarrierEnabled) && InObj)
 		{
 			UE::GC::MarkAsReachable(InObj);
 		}
@@ -1517,7 +1519,7 @@ namespace UE::Core::Private // private facilities; not for direct use
 		static void Close(ViewType& View)
 		{
 #if UE_OBJECT_PTR_GC_BARRIER
-			if (UE::GC::GIsIncrementalReachabilityPending && View)
+			if ((UE::GC::GIsIncrementalReachabilityPending | UE::GC::GIsNurseryWriteBarrierEnabled) && View)
 			{
 				UE::GC::MarkAsReachable(View);
 			}
@@ -1531,7 +1533,7 @@ namespace UE::Core::Private // private facilities; not for direct use
 		static void Close(ViewType& View)
 		{
 #if UE_OBJECT_PTR_GC_BARRIER
-			if (UE::GC::GIsIncrementalReachabilityPending)
+			if (UE::GC::GIsIncrementalReachabilityPending | UE::GC::GIsNurseryWriteBarrierEnabled)
 			{
 				const UObject* const* Data = reinterpret_cast<const UObject* const*>(View.GetData());
 				for (int32 Index = 0; Index < View.Num(); ++Index)
@@ -1552,7 +1554,7 @@ namespace UE::Core::Private // private facilities; not for direct use
 		static void Close(ViewType& View)
 		{
 #if UE_OBJECT_PTR_GC_BARRIER
-			if (UE::GC::GIsIncrementalReachabilityPending)
+			if (UE::GC::GIsIncrementalReachabilityPending | UE::GC::GIsNurseryWriteBarrierEnabled)
 			{
 				for (const typename ViewType::ElementType& Element : View)
 				{
@@ -1575,7 +1577,7 @@ namespace UE::Core::Private // private facilities; not for direct use
 			static constexpr bool bKeyReference = TIsTObjectPtr_V<K>;
 			static constexpr bool bValueReference = TIsTObjectPtr_V<V>;
 			static_assert(bKeyReference || bValueReference);
-			if (UE::GC::GIsIncrementalReachabilityPending)
+			if (UE::GC::GIsIncrementalReachabilityPending | UE::GC::GIsNurseryWriteBarrierEnabled)
 			{
 				for (const typename ViewType::ElementType& Pair : View)
 				{
@@ -1645,22 +1647,26 @@ namespace UE::Core::Private // private facilities; not for direct use
 		explicit TMaybeObjectPtr(T* P)
 			: Ptr{P}
 		{
-			ConditionallyMarkAsReachable();
+			ConditionallyMarkAsReachable(true /* bNewReference */);
 		}
 
 		TMaybeObjectPtr(const TMaybeObjectPtr& Other)
-			: TMaybeObjectPtr{Other.Ptr}
+			: Ptr{Other.Ptr}
 		{
+			ConditionallyMarkAsReachable(false /* bNewReference */);
 		}
 
 		TMaybeObjectPtr(TMaybeObjectPtr&& Other)
-			: TMaybeObjectPtr{Other.Ptr}
+			: Ptr{Other.Ptr}
 		{
+			ConditionallyMarkAsReachable(false /* bNewReference */);
 		}
 
 		TMaybeObjectPtr& operator=(const TMaybeObjectPtr& Other)
 		{
-			return *this = Other.Ptr;
+			Ptr = Other.Ptr;
+			ConditionallyMarkAsReachable(false /* bNewReference */);
+			return *this;
 		}
 
 		TMaybeObjectPtr& operator=(TMaybeObjectPtr&& Other)
@@ -1671,7 +1677,7 @@ namespace UE::Core::Private // private facilities; not for direct use
 		TMaybeObjectPtr& operator=(T* P)
 		{
 			Ptr = P;
-			ConditionallyMarkAsReachable();
+			ConditionallyMarkAsReachable(true /* bNewReference */);
 			return *this;
 		}
 		
@@ -1694,9 +1700,10 @@ namespace UE::Core::Private // private facilities; not for direct use
 		}
 
 	private:
-		FORCEINLINE void ConditionallyMarkAsReachable() const
+		// Same as FObjectPtr, copies only need the incremental reachability barrier
+		FORCEINLINE void ConditionallyMarkAsReachable(bool bNewReference) const
 		{
-			if (const UObject* Obj = Cast<UObject>(Ptr); Obj && UE::GC::GIsIncrementalReachabilityPending)
+			if (const UObject* Obj = Cast<UObject>(Ptr); Obj && (UE::GC::GIsIncrementalReachabilityPending | (bNewReference & UE::GC::GIsNurseryWriteBarrierEnabled)))
 			{
 				UE::GC::MarkAsReachable(Obj);
 			}
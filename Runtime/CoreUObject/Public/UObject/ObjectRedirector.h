@@ -34,6 +34,7 @@ class UObjectRedirector : public UObject
 	void Serialize(FArchive& Ar) override;
 	void Serialize(FStructuredArchive::FRecord Record) override;
 	virtual bool NeedsLoadForEditorGame() const override;
+	virtual bool IsDestructionThreadSafe() const override { return true; }
 	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
 	UE_DEPRECATED(5.4, "Implement the version that takes FAssetRegistryTagsContext instead.")
 	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
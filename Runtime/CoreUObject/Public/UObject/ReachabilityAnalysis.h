@@ -94,6 +94,8 @@ struct FStats
 	double TraceExternalRootsTime = 0.0;
 	double NotifyUnreachableTime = 0.0;
 	double DissolveUnreachableClustersTime = 0.0;
+	/** Time spent by all worker threads destroying objects with gc.ConcurrentPurge, overlaps with the game thread */
+	double ConcurrentDestroyGarbageTime = 0.0;
 
 	FIterationTimerStat ReachabilityTime;
 	FIterationTimerStat ReferenceCollectionTime;
@@ -111,7 +113,11 @@ struct FStats
 	int32 NumBarrierObjects = 0;
 	int32 NumWeakReferencesForClearing = 0;
 	int32 NumObjectsThatNeedWeakReferenceClearing = 0;
+	int32 NumYoungObjects = 0;
+	int32 NumRememberedObjects = 0;
+	int32 NumObjectsDestroyedConcurrently = 0;
 
+	bool bNurseryCollection = false;
 	bool bStartedAsFullPurge = false;
 	bool bFinishedAsFullPurge = false;
 	bool bFlushedAsyncLoading = false;
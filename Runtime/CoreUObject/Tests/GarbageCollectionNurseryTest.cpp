@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_LOW_LEVEL_TESTS
+
+#include "ObjectPtrTestClass.h"
+#include "HAL/IConsoleManager.h"
+#include "TestHarness.h"
+#include "UObject/GCObject.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/WeakObjectPtr.h"
+
+//test class that only reports its reference to the GC through AddReferencedObjects
+class UObjectNurseryTestAROHolder : public UObject
+{
+	DECLARE_CLASS_INTRINSIC(UObjectNurseryTestAROHolder, UObject, CLASS_MatchedSerializers, TEXT("/Script/CoreUObject"))
+
+public:
+	UObject* Young = nullptr;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+	{
+		Collector.AddReferencedObject(static_cast<UObjectNurseryTestAROHolder*>(InThis)->Young, InThis);
+		Super::AddReferencedObjects(InThis, Collector);
+	}
+};
+
+IMPLEMENT_CORE_INTRINSIC_CLASS(UObjectNurseryTestAROHolder, UObject, {});
+
+namespace UE::CoreObject::Private::Tests
+{
+
+struct FScopedNurseryCollection
+{
+	FScopedNurseryCollection()
+	{
+		for (int32 Index = 0; Index < NumCVars; ++Index)
+		{
+			CVars[Index] = IConsoleManager::Get().FindConsoleVariable(Names[Index]);
+			check(CVars[Index]);
+			PreviousValues[Index] = CVars[Index]->GetInt();
+			CVars[Index]->Set(Values[Index], ECVF_SetByCode);
+		}
+		// Starts tracking, everything allocated so far is old
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	}
+
+	~FScopedNurseryCollection()
+	{
+		for (int32 Index = 0; Index < NumCVars; ++Index)
+		{
+			CVars[Index]->Set(PreviousValues[Index], ECVF_SetByCode);
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	}
+
+	static constexpr int32 NumCVars = 3;
+	// Full collections are only run for full purges so that every non-purging collection below is a nursery collection
+	const TCHAR* Names[NumCVars] = { TEXT("gc.AllowIncrementalReachability"), TEXT("gc.Nursery"), TEXT("gc.Nursery.FullCollectionInterval") };
+	const int32 Values[NumCVars] = { 1, 1, 1000 };
+	IConsoleVariable* CVars[NumCVars] = {};
+	int32 PreviousValues[NumCVars] = {};
+};
+
+// The holders are kept alive by TStrongObjectPtr rather than the root set: nursery collections traverse old roots but
+// only reach non-root old objects through references, and the traversal stops there since they're still marked reachable.
+template<typename HolderType, typename SetYoungType>
+void TestYoungObjectSurvivesThroughOldHolder(SetYoungType SetYoung)
+{
+	FScopedNurseryCollection ScopedNursery;
+
+	TStrongObjectPtr<HolderType> Holder(NewObject<HolderType>());
+	// Promotes the holder to the old generation
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false);
+
+	UObjectPtrTestClass* Young = NewObject<UObjectPtrTestClass>();
+	FWeakObjectPtr WeakYoung(Young);
+	FWeakObjectPtr WeakGarbage(NewObject<UObjectPtrTestClass>());
+	SetYoung(*Holder, Young);
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false);
+	CHECK(!WeakGarbage.IsValid());
+	CHECK(WeakYoung.IsValid());
+
+	SetYoung(*Holder, nullptr);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	CHECK(!WeakYoung.IsValid());
+}
+
+TEST_CASE("CoreUObject::GarbageCollection::Nursery::Old raw UPROPERTY keeps young object alive", "[CoreUObject][GarbageCollection]")
+{
+	FGCObject::StaticInit();
+
+	TestYoungObjectSurvivesThroughOldHolder<UObjectWithRawProperty>([](UObjectWithRawProperty& Holder, UObjectPtrTestClass* Young)
+	{
+		Holder.ObjectPtr = Young;
+	});
+}
+
+TEST_CASE("CoreUObject::GarbageCollection::Nursery::Old AddReferencedObjects keeps young object alive", "[CoreUObject][GarbageCollection]")
+{
+	FGCObject::StaticInit();
+
+	TestYoungObjectSurvivesThroughOldHolder<UObjectNurseryTestAROHolder>([](UObjectNurseryTestAROHolder& Holder, UObjectPtrTestClass* Young)
+	{
+		Holder.Young = Young;
+	});
+}
+
+} // namespace UE::CoreObject::Private::Tests
+
+#endif // WITH_LOW_LEVEL_TESTS
@@ -48,6 +48,9 @@ class UCurveFloat : public UCurveBase
 	ENGINE_API virtual TArray<FRichCurveEditInfo> GetCurves() override;
 	ENGINE_API virtual bool IsValidCurve( FRichCurveEditInfo CurveInfo ) override;
 
+	// Only frees keyframe memory. Subclasses (including Blueprint ones) may have non trivial destructors so they're destroyed on the game thread
+	virtual bool IsDestructionThreadSafe() const override { return GetClass() == StaticClass(); }
+
 	/** Determine if Curve is the same */
 	ENGINE_API bool operator == (const UCurveFloat& Curve) const;
 };
@@ -47,4 +47,7 @@ class UCurveVector : public UCurveBase
 	ENGINE_API bool operator == (const UCurveVector& Curve) const;
 
 	virtual bool IsValidCurve( FRichCurveEditInfo CurveInfo ) override;
+
+	// Only frees keyframe memory. Subclasses (including Blueprint ones) may have non trivial destructors so they're destroyed on the game thread
+	virtual bool IsDestructionThreadSafe() const override { return GetClass() == StaticClass(); }
 };
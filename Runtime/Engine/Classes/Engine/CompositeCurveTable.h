@@ -17,6 +17,8 @@ class UCompositeCurveTable
 	//~ Begin UObject Interface.
 	ENGINE_API virtual void GetPreloadDependencies(TArray<UObject*>& OutDeps) override;
 	ENGINE_API virtual void Serialize(FArchive& Ar) override;
+	/** Loading preloads the parent tables through their linkers, which must happen on the loading thread */
+	virtual bool IsSerializeThreadSafe() const override { return false; }
 	ENGINE_API virtual void PostLoad() override;
 	//~ End UObject Interface
 
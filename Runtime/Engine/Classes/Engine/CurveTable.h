@@ -81,6 +81,8 @@ public:
 	//~ Begin UObject Interface.
 	virtual void FinishDestroy() override;
 	virtual void Serialize( FArchive& Ar ) override;
+	/** Loading reads rows without the change lock, swaps them in under it and posts OnCurveTableChanged to the game thread */
+	virtual bool IsSerializeThreadSafe() const override { return true; }
 
 #if WITH_EDITORONLY_DATA
 	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
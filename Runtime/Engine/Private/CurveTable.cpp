@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Engine/CurveTable.h"
+#include "Async/Async.h"
 #include "Misc/TransactionallySafeCriticalSection.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/Csv/CsvParser.h"
@@ -107,27 +108,25 @@ void UCurveTable::Serialize(FArchive& Ar)
 
 	if (Ar.IsLoading())
 	{
-		CURVETABLE_CHANGE_SCOPE();
-
 		int32 NumRows;
 		Ar << NumRows;
 
+		// Rows are read into a local map without holding the change lock as this may run on a worker thread (see IsSerializeThreadSafe)
+		ECurveTableMode NewCurveTableMode;
 		const bool bUpgradingCurveTable = (Ar.CustomVer(FFortniteMainBranchObjectVersion::GUID) < FFortniteMainBranchObjectVersion::ShrinkCurveTableSize);
 		if (bUpgradingCurveTable)
 		{
-			CurveTableMode = (NumRows > 0 ? ECurveTableMode::RichCurves : ECurveTableMode::Empty);
+			NewCurveTableMode = (NumRows > 0 ? ECurveTableMode::RichCurves : ECurveTableMode::Empty);
 		}
 		else
 		{
-			Ar << CurveTableMode;
+			Ar << NewCurveTableMode;
 		}
 
 		bool bCouldConvertToSimpleCurves = bUpgradingCurveTable;
 
-		// copy any previous curves to free after replacing.
-		TMap<FName, FRealCurve*> TempMap(RowMap);
-
-		RowMap.Empty(NumRows);
+		TMap<FName, FRealCurve*> NewRowMap;
+		NewRowMap.Reserve(NumRows);
 		for (int32 RowIdx = 0; RowIdx < NumRows; RowIdx++)
 		{
 			// Load row name
@@ -135,13 +134,13 @@ void UCurveTable::Serialize(FArchive& Ar)
 			Ar << RowName;
 
 			// Load row data
-			if (CurveTableMode == ECurveTableMode::SimpleCurves)
+			if (NewCurveTableMode == ECurveTableMode::SimpleCurves)
 			{
 				FSimpleCurve* NewCurve = new FSimpleCurve();
 				FSimpleCurve::StaticStruct()->SerializeTaggedProperties(Ar, (uint8*)NewCurve, FSimpleCurve::StaticStruct(), nullptr);
 
 				// Add to map
-				RowMap.Add(RowName, NewCurve);
+				NewRowMap.Add(RowName, NewCurve);
 			}
 			else
 			{
@@ -149,7 +148,7 @@ void UCurveTable::Serialize(FArchive& Ar)
 				FRichCurve::StaticStruct()->SerializeTaggedProperties(Ar, (uint8*)NewCurve, FRichCurve::StaticStruct(), nullptr);
 
 				// Add to map
-				RowMap.Add(RowName, NewCurve);
+				NewRowMap.Add(RowName, NewCurve);
 
 				if (bCouldConvertToSimpleCurves)
 				{
@@ -172,8 +171,8 @@ void UCurveTable::Serialize(FArchive& Ar)
 
 		if (bCouldConvertToSimpleCurves)
 		{
-			CurveTableMode = (RowMap.Num() > 0  ? ECurveTableMode::SimpleCurves : ECurveTableMode::Empty);
-			for (TPair<FName, FRealCurve*>& Curve : RowMap)
+			NewCurveTableMode = (NewRowMap.Num() > 0  ? ECurveTableMode::SimpleCurves : ECurveTableMode::Empty);
+			for (TPair<FName, FRealCurve*>& Curve : NewRowMap)
 			{
 				FSimpleCurve* NewCurve = new FSimpleCurve();
 				FRichCurve* OldCurve = (FRichCurve*)Curve.Value;
@@ -193,6 +192,34 @@ void UCurveTable::Serialize(FArchive& Ar)
 			}
 		}
 
+		// Swap in the new rows and keep any previous curves to free after replacing
+		TMap<FName, FRealCurve*> TempMap;
+		if (IsInGameThread())
+		{
+			CURVETABLE_CHANGE_SCOPE();
+			TempMap = MoveTemp(RowMap);
+			RowMap = MoveTemp(NewRowMap);
+			CurveTableMode = NewCurveTableMode;
+		}
+		else
+		{
+			{
+				UE::TScopeLock ScopeLock(GetCurveTableChangeCriticalSection());
+				TempMap = MoveTemp(RowMap);
+				RowMap = MoveTemp(NewRowMap);
+				CurveTableMode = NewCurveTableMode;
+			}
+
+			// Delegate bindings are game thread only
+			AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UCurveTable>(this)]()
+			{
+				if (UCurveTable* Table = WeakThis.Get())
+				{
+					Table->OnCurveTableChanged().Broadcast();
+				}
+			});
+		}
+
 		for (TPair<FName, FRealCurve*>& Curve : TempMap)
 		{
 			delete Curve.Value;
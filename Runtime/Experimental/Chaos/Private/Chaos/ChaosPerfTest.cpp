@@ -5,4 +5,11 @@
 #if CHAOS_PERF_TEST_ENABLED
 const TCHAR* FChaosScopedDurationTimeLogger::GlobalLabel = nullptr;
 EChaosPerfUnits FChaosScopedDurationTimeLogger::GlobalUnits = EChaosPerfUnits::S;
+
+FChaosPerfTestPhaseTimes*& FChaosPerfTestPhaseTimes::GetThreadPhaseTimes()
+{
+	// Thread local data can't be exported from a module, hence the accessor
+	static thread_local FChaosPerfTestPhaseTimes* PhaseTimes = nullptr;
+	return PhaseTimes;
+}
 #endif
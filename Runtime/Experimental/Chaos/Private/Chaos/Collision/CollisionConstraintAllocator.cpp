@@ -205,6 +205,14 @@ namespace Chaos
 			bInCollisionDetectionPhase = false;
 
 			ProcessNewItems();
+
+			ManifoldReuseStats.Reset();
+			for (const TUniquePtr<FCollisionContextAllocator>& ContextAllocator : ContextAllocators)
+			{
+				ManifoldReuseStats.Accumulate(ContextAllocator->GetManifoldReuseStats());
+			}
+			PHYSICS_CSV_CUSTOM_EXPENSIVE(PhysicsCounters, NumNarrowPhaseUpdates, ManifoldReuseStats.NumNarrowPhaseUpdates, ECsvCustomStatOp::Set);
+			PHYSICS_CSV_CUSTOM_EXPENSIVE(PhysicsCounters, NumManifoldRestores, ManifoldReuseStats.NumManifoldRestores, ECsvCustomStatOp::Set);
 		}
 
 		void FCollisionConstraintAllocator::ResetActiveConstraints()
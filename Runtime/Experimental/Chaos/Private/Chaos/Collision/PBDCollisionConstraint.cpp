@@ -100,6 +100,27 @@ namespace Chaos
 	// @todo(chaos): tune the tolerances used in FPBDCollisionConstraint::TryRestoreManifold
 	FCollisionTolerances Chaos_Manifold_Tolerances;
 
+	// Persistent manifold mode for resting contacts. A manifold with points may be restored after more relative shape movement than
+	// the default tolerances allow, but only if every point survives the projection with tighter per-point limits. The narrow phase
+	// is also forced to run after a number of restores in a row, so the error from the projected points cannot build up indefinitely.
+	bool bChaos_Collision_PersistentManifold = false;
+	FAutoConsoleVariableRef CVarChaos_Collision_PersistentManifold(TEXT("p.Chaos.Collision.PersistentManifold"), bChaos_Collision_PersistentManifold, TEXT("Restore manifolds under larger relative shape movement, as long as all of the contact points remain valid when projected to the new transforms."));
+
+	FRealSingle Chaos_Collision_PersistentManifold_ShapePositionToleranceScale = 0.5f;
+	FAutoConsoleVariableRef CVarChaos_Collision_PersistentManifold_ShapePositionToleranceScale(TEXT("p.Chaos.Collision.PersistentManifold.ShapePositionToleranceScale"), Chaos_Collision_PersistentManifold_ShapePositionToleranceScale, TEXT("Relative shape movement since the last narrow phase that still allows a persistent manifold restore, as a multiple of the collision tolerance."));
+
+	FRealSingle Chaos_Collision_PersistentManifold_ShapeRotationThreshold = 0.9997f;
+	FAutoConsoleVariableRef CVarChaos_Collision_PersistentManifold_ShapeRotationThreshold(TEXT("p.Chaos.Collision.PersistentManifold.ShapeRotationThreshold"), Chaos_Collision_PersistentManifold_ShapeRotationThreshold, TEXT("Minimum dot product between the current and last narrow phase relative shape rotations for a persistent manifold restore."));
+
+	FRealSingle Chaos_Collision_PersistentManifold_PointPositionToleranceScale = 0.4f;
+	FAutoConsoleVariableRef CVarChaos_Collision_PersistentManifold_PointPositionToleranceScale(TEXT("p.Chaos.Collision.PersistentManifold.PointPositionToleranceScale"), Chaos_Collision_PersistentManifold_PointPositionToleranceScale, TEXT("Maximum lateral drift of a projected contact point, as a multiple of the collision tolerance. Any point beyond this rejects the whole manifold."));
+
+	FRealSingle Chaos_Collision_PersistentManifold_PointPhiToleranceScale = 0.1f;
+	FAutoConsoleVariableRef CVarChaos_Collision_PersistentManifold_PointPhiToleranceScale(TEXT("p.Chaos.Collision.PersistentManifold.PointPhiToleranceScale"), Chaos_Collision_PersistentManifold_PointPhiToleranceScale, TEXT("Maximum change in a projected contact point's separation in one tick, as a multiple of the collision tolerance. Any point beyond this rejects the whole manifold."));
+
+	int32 Chaos_Collision_PersistentManifold_MaxRestores = 8;
+	FAutoConsoleVariableRef CVarChaos_Collision_PersistentManifold_MaxRestores(TEXT("p.Chaos.Collision.PersistentManifold.MaxRestores"), Chaos_Collision_PersistentManifold_MaxRestores, TEXT("Maximum number of ticks in a row that a persistent manifold can be restored before the narrow phase must run again."));
+
 	FString FPBDCollisionConstraint::ToString() const
 	{
 		return FString::Printf(TEXT("Particle:%s, Levelset:%s, AccumulatedImpulse:%s"), *Particle[0]->ToString(), *Particle[1]->ToString(), *AccumulatedImpulse.ToString());
@@ -217,6 +238,7 @@ namespace Chaos
 		, ClosestManifoldPointIndex(INDEX_NONE)
 		, ShapeWorldTransforms{ FRigidTransform3(), FRigidTransform3() }
 		, ExpectedNumManifoldPoints(0)
+		, NumManifoldRestores(0)
 		, LastShapeWorldPositionDelta()
 		, LastShapeWorldRotationDelta()
 		, GJKWarmStartData()
@@ -258,6 +280,7 @@ namespace Chaos
 		, ClosestManifoldPointIndex(INDEX_NONE)
 		, ShapeWorldTransforms{ FRigidTransform3(), FRigidTransform3() }
 		, ExpectedNumManifoldPoints(0)
+		, NumManifoldRestores(0)
 		, LastShapeWorldPositionDelta()
 		, LastShapeWorldRotationDelta()
 		, GJKWarmStartData()
@@ -790,16 +813,28 @@ namespace Chaos
 		ManifoldPoints.Reset();
 		ManifoldPointResults.Reset();
 		ExpectedNumManifoldPoints = 0;
+		NumManifoldRestores = 0;
 		Flags.bWasManifoldRestored = false;
 		Flags.bCanRestoreManifold = false;
 	}
 
 	bool FPBDCollisionConstraint::TryRestoreManifold()
 	{
+		// Zero point manifolds are always handled with the default tolerances
+		const bool bPersistentManifold = bChaos_Collision_PersistentManifold && (ManifoldPoints.Num() > 0);
+
 		const FCollisionTolerances Tolerances = FCollisionTolerances();//Chaos_Manifold_Tolerances;
-		const FReal ContactPositionTolerance = Tolerances.ContactPositionToleranceScale * CollisionTolerance;
-		const FReal ShapePositionTolerance = (ManifoldPoints.Num() > 0) ? Tolerances.ShapePositionToleranceScaleN * CollisionTolerance : Tolerances.ShapePositionToleranceScale0 * CollisionTolerance;
-		const FReal ShapeRotationThreshold = (ManifoldPoints.Num() > 0) ? Tolerances.ShapeRotationThresholdN : Tolerances.ShapeRotationThreshold0;
+		FReal ContactPositionTolerance = Tolerances.ContactPositionToleranceScale * CollisionTolerance;
+		FReal ShapePositionTolerance = (ManifoldPoints.Num() > 0) ? Tolerances.ShapePositionToleranceScaleN * CollisionTolerance : Tolerances.ShapePositionToleranceScale0 * CollisionTolerance;
+		FReal ShapeRotationThreshold = (ManifoldPoints.Num() > 0) ? Tolerances.ShapeRotationThresholdN : Tolerances.ShapeRotationThreshold0;
+		FReal ContactPhiTolerance = TNumericLimits<FReal>::Max();
+		if (bPersistentManifold)
+		{
+			ContactPositionTolerance = FReal(Chaos_Collision_PersistentManifold_PointPositionToleranceScale) * CollisionTolerance;
+			ShapePositionTolerance = FReal(Chaos_Collision_PersistentManifold_ShapePositionToleranceScale) * CollisionTolerance;
+			ShapeRotationThreshold = FReal(Chaos_Collision_PersistentManifold_ShapeRotationThreshold);
+			ContactPhiTolerance = FReal(Chaos_Collision_PersistentManifold_PointPhiToleranceScale) * CollisionTolerance;
+		}
 		const FReal ContactPositionToleranceSq = FMath::Square(ContactPositionTolerance);
 
 		// Reset current closest point
@@ -811,6 +846,11 @@ namespace Chaos
 			return false;
 		}
 
+		if (bPersistentManifold && (NumManifoldRestores >= Chaos_Collision_PersistentManifold_MaxRestores))
+		{
+			return false;
+		}
+
 		// If we have not moved or rotated much we may reuse some of the manifold points, as long as they have not moved far as well (see below)
 		bool bMovedBeyondTolerance = true;
 		if ((ShapePositionTolerance > 0) && (ShapeRotationThreshold > 0))
@@ -868,7 +908,7 @@ namespace Chaos
 				const FReal ContactLateralDistanceSq = ContactLateralDeltaIn1.SizeSquared();
 
 				// Either update the point or flag it for removal
-				if (ContactLateralDistanceSq < ContactPositionToleranceSq)
+				if ((ContactLateralDistanceSq < ContactPositionToleranceSq) && (FMath::Abs(ContactPhi - FReal(ManifoldPoint.ContactPoint.Phi)) < ContactPhiTolerance))
 				{
 					// Recalculate the contact points at the new location
 					// @todo(chaos): we should reproject the contact on the plane owner
@@ -887,6 +927,12 @@ namespace Chaos
 				}
 				else
 				{
+					// A persistent manifold is only reused if all of its points are still valid
+					if (bPersistentManifold)
+					{
+						return false;
+					}
+
 					// This point moved too far - disable it
 					ManifoldPoint.Flags.bDisabled = true;
 					ManifoldPoint.Flags.bWasRestored = false;
@@ -909,6 +955,7 @@ namespace Chaos
 		}
 
 		Flags.bWasManifoldRestored = true;
+		++NumManifoldRestores;
 		return true;
 	}
 
@@ -7,6 +7,7 @@
 #include "Chaos/CollisionResolution.h"
 #include "Chaos/DebugDrawQueue.h"
 #include "Chaos/Evolution/SolverBodyContainer.h"
+#include "Chaos/Framework/Parallel.h"
 #include "Chaos/Island/IslandManager.h"
 #include "Chaos/Particle/ParticleUtilities.h"
 #include "Chaos/PBDCollisionConstraints.h"
@@ -61,6 +62,10 @@ namespace Chaos
 		// Whether to enable the experimental soft collisions
 		bool bChaos_Collision_EnableSoftCollisions = true;
 		FAutoConsoleVariableRef CVarChaosCollisionEnableSoftCollisions(TEXT("p.Chaos.PBDCollisionSolver.EnableSoftCollisions"), bChaos_Collision_EnableSoftCollisions, TEXT(""));
+
+		// The minimum number of collisions per task when solving a color in parallel (see ColorConstraints)
+		int32 Chaos_Collision_ColorMinBatchSize = 64;
+		FAutoConsoleVariableRef CVarChaosCollisionColorMinBatchSize(TEXT("p.Chaos.PBDCollisionSolver.ColorMinBatchSize"), Chaos_Collision_ColorMinBatchSize, TEXT("The minimum number of collisions per task when solving a color of a large island in parallel"));
 	}
 
 
@@ -404,6 +409,8 @@ namespace Chaos
 		, MaxCollisionSolverManifoldPoints(0)
 		, bCollisionConstraintPerIterationCollisionDetection()
 		, bPerIterationCollisionDetection(false)
+		, ColorOffsets()
+		, NumParallelColors(0)
 	{
 	}
 
@@ -428,6 +435,9 @@ namespace Chaos
 		MaxCollisionSolverManifoldPoints = 0;
 		CollisionSolvers = nullptr;
 		CollisionSolverManifoldPoints = nullptr;
+
+		ColorOffsets.Reset();
+		NumParallelColors = 0;
 	}
 
 	size_t FPBDCollisionContainerSolver::CalculateCollisionBufferSize(const size_t InTightFittingNum, const size_t InCurrentBufferNum) const
@@ -558,6 +568,89 @@ namespace Chaos
 		CollisionConstraints.Add(&Constraint);
 	}
 
+	void FPBDCollisionContainerSolver::ColorConstraints(FSolverBodyContainer& SolverBodyContainer)
+	{
+		ColorOffsets.Reset();
+		NumParallelColors = 0;
+
+		const int32 NumConstraints = CollisionConstraints.Num();
+		if (NumConstraints < 2)
+		{
+			return;
+		}
+
+		// Greedy coloring in the current constraint order so that the result is deterministic. Each dynamic body holds
+		// a mask of the colors it is already used in, indexed by its solver body index (adding the bodies here only changes
+		// the order in which AddBodies finds them). Kinematics are not written to by the solver so they do not restrict the color.
+		// Constraints that do not fit in the first 64 colors go into a final color that is solved serially.
+		constexpr int32 MaxParallelColors = 64;
+		BodyColorMasks.Reset();
+		ConstraintColors.SetNumUninitialized(NumConstraints, EAllowShrinking::No);
+
+		int32 NumColors = 0;
+		for (int32 ConstraintIndex = 0; ConstraintIndex < NumConstraints; ++ConstraintIndex)
+		{
+			const FPBDCollisionConstraint* Constraint = CollisionConstraints[ConstraintIndex];
+			FGenericParticleHandle Particle0 = Constraint->GetParticle0();
+			FGenericParticleHandle Particle1 = Constraint->GetParticle1();
+			const int32 BodyIndex0 = Particle0->IsDynamic() ? SolverBodyContainer.FindOrAddIndex(Particle0) : INDEX_NONE;
+			const int32 BodyIndex1 = Particle1->IsDynamic() ? SolverBodyContainer.FindOrAddIndex(Particle1) : INDEX_NONE;
+			if (BodyColorMasks.Num() < SolverBodyContainer.Num())
+			{
+				BodyColorMasks.SetNumZeroed(SolverBodyContainer.Num(), EAllowShrinking::No);
+			}
+
+			uint64* ColorMask0 = (BodyIndex0 != INDEX_NONE) ? &BodyColorMasks[BodyIndex0] : nullptr;
+			uint64* ColorMask1 = (BodyIndex1 != INDEX_NONE) ? &BodyColorMasks[BodyIndex1] : nullptr;
+			const uint64 UsedColors = (ColorMask0 ? *ColorMask0 : 0) | (ColorMask1 ? *ColorMask1 : 0);
+
+			int32 Color = MaxParallelColors;
+			if (UsedColors != TNumericLimits<uint64>::Max())
+			{
+				Color = int32(FMath::CountTrailingZeros64(~UsedColors));
+
+				const uint64 ColorBit = uint64(1) << Color;
+				if (ColorMask0)
+				{
+					*ColorMask0 |= ColorBit;
+				}
+				if (ColorMask1)
+				{
+					*ColorMask1 |= ColorBit;
+				}
+			}
+
+			ConstraintColors[ConstraintIndex] = Color;
+			NumColors = FMath::Max(NumColors, Color + 1);
+		}
+
+		// Sort the constraints by color (counting sort to preserve the order within each color)
+		ColorOffsets.SetNumZeroed(NumColors + 1);
+		for (const int32 Color : ConstraintColors)
+		{
+			++ColorOffsets[Color + 1];
+		}
+		for (int32 ColorIndex = 0; ColorIndex < NumColors; ++ColorIndex)
+		{
+			ColorOffsets[ColorIndex + 1] += ColorOffsets[ColorIndex];
+		}
+
+		TArray<int32> ColorWriteIndices(ColorOffsets.GetData(), NumColors);
+		TArray<FPBDCollisionConstraint*> SortedConstraints;
+		SortedConstraints.SetNumUninitialized(NumConstraints);
+		for (int32 ConstraintIndex = 0; ConstraintIndex < NumConstraints; ++ConstraintIndex)
+		{
+			SortedConstraints[ColorWriteIndices[ConstraintColors[ConstraintIndex]]++] = CollisionConstraints[ConstraintIndex];
+		}
+		for (int32 ConstraintIndex = 0; ConstraintIndex < NumConstraints; ++ConstraintIndex)
+		{
+			CollisionConstraints[ConstraintIndex] = SortedConstraints[ConstraintIndex];
+		}
+
+		// Colors are dense. Only the overflow color (if present) must be solved serially.
+		NumParallelColors = FMath::Min(NumColors, MaxParallelColors);
+	}
+
 	void FPBDCollisionContainerSolver::AddBodies(FSolverBodyContainer& SolverBodyContainer)
 	{
 		// All constarints are now added. We can allocate the solver buffers.
@@ -695,6 +788,95 @@ namespace Chaos
 		// Not supported for collisions
 	}
 
+	bool FPBDCollisionContainerSolver::CanSolveColorsInParallel() const
+	{
+		// Collision detection in the solver loop is not thread safe, so we need to solve serially if we need it
+		return (ColorOffsets.Num() > 1)
+			&& !bPerIterationCollisionDetection
+			&& !ConstraintContainer.GetDetectorSettings().bDeferNarrowPhase;
+	}
+
+	template<typename LambdaType>
+	void FPBDCollisionContainerSolver::ApplyToColors(const LambdaType& Lambda)
+	{
+		for (int32 ColorIndex = 0; ColorIndex < ColorOffsets.Num() - 1; ++ColorIndex)
+		{
+			// Handle the case where we dropped some constraints because there were too many
+			const int32 ColorBeginIndex = FMath::Min(ColorOffsets[ColorIndex], NumSolvers());
+			const int32 ColorEndIndex = FMath::Min(ColorOffsets[ColorIndex + 1], NumSolvers());
+			if (ColorEndIndex <= ColorBeginIndex)
+			{
+				break;
+			}
+
+			if (ColorIndex < NumParallelColors)
+			{
+				PhysicsParallelForRange(ColorEndIndex - ColorBeginIndex,
+					[&Lambda, ColorBeginIndex](const int32 BeginIndex, const int32 EndIndex)
+					{
+						Lambda(ColorBeginIndex + BeginIndex, ColorBeginIndex + EndIndex);
+					}, 
+					CVars::Chaos_Collision_ColorMinBatchSize);
+			}
+			else
+			{
+				Lambda(ColorBeginIndex, ColorEndIndex);
+			}
+		}
+	}
+
+	void FPBDCollisionContainerSolver::ApplyPositionConstraintsParallel(const FReal Dt, const int32 It, const int32 NumIts)
+	{
+		if (!CanSolveColorsInParallel())
+		{
+			ApplyPositionConstraints(Dt, It, NumIts);
+			return;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_Collisions_Apply);
+		if (!CVars::bChaos_PBDCollisionSolver_Position_SolveEnabled)
+		{
+			return;
+		}
+
+		const FPBDCollisionSolverSettings& SolverSettings = ConstraintContainer.GetSolverSettings();
+
+		// Shock propagation touches every solver so must be done before going wide
+		UpdatePositionShockPropagation(Dt, It, NumIts, 0, NumSolvers(), SolverSettings);
+
+		ApplyToColors(
+			[this, Dt, It, NumIts, &SolverSettings](const int32 BeginIndex, const int32 EndIndex)
+			{
+				SolvePositionRange(Dt, It, NumIts, BeginIndex, EndIndex, SolverSettings);
+			});
+	}
+
+	void FPBDCollisionContainerSolver::ApplyVelocityConstraintsParallel(const FReal Dt, const int32 It, const int32 NumIts)
+	{
+		if (!CanSolveColorsInParallel())
+		{
+			ApplyVelocityConstraints(Dt, It, NumIts);
+			return;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_Collisions_ApplyPushOut);
+		if (!CVars::bChaos_PBDCollisionSolver_Velocity_SolveEnabled)
+		{
+			return;
+		}
+
+		const FPBDCollisionSolverSettings& SolverSettings = ConstraintContainer.GetSolverSettings();
+
+		// Shock propagation touches every solver so must be done before going wide
+		UpdateVelocityShockPropagation(Dt, It, NumIts, 0, NumSolvers(), SolverSettings);
+
+		ApplyToColors(
+			[this, Dt, It, NumIts, &SolverSettings](const int32 BeginIndex, const int32 EndIndex)
+			{
+				SolveVelocityRange(Dt, It, NumIts, BeginIndex, EndIndex, SolverSettings);
+			});
+	}
+
 	void FPBDCollisionContainerSolver::ApplyShockPropagation(const FSolverReal ShockPropagation)
 	{
 		// @todo(chaos): cache the mass scales so we don't have to look in the constraint again
@@ -761,6 +943,13 @@ namespace Chaos
 			UpdateCollisions(InDt, BeginIndex, EndIndex);
 		}
 
+		SolvePositionRange(InDt, It, NumIts, BeginIndex, EndIndex, SolverSettings);
+	}
+
+	void FPBDCollisionContainerSolver::SolvePositionRange(const FReal InDt, const int32 It, const int32 NumIts, const int32 BeginIndex, const int32 EndIndex, const FPBDCollisionSolverSettings& SolverSettings)
+	{
+		// NOTE: may be called in parallel for constraint ranges that do not share dynamic bodies (see ColorConstraints)
+
 		// Only apply friction for the last few (tunable) iterations
 		// Adjust max pushout to attempt to make it iteration count independent
 		const FSolverReal Dt = FSolverReal(InDt);
@@ -770,14 +959,14 @@ namespace Chaos
 		// Apply the position correction
 		if (bApplyStaticFriction)
 		{
-			for (int32 SolverIndex = 0; SolverIndex < NumSolvers(); ++SolverIndex)
+			for (int32 SolverIndex = BeginIndex; SolverIndex < EndIndex; ++SolverIndex)
 			{
 				CollisionSolvers[SolverIndex].SolvePositionWithFriction(Dt, MaxPushOut);
 			}
 		}
 		else
 		{
-			for (int32 SolverIndex = 0; SolverIndex < NumSolvers(); ++SolverIndex)
+			for (int32 SolverIndex = BeginIndex; SolverIndex < EndIndex; ++SolverIndex)
 			{
 				CollisionSolvers[SolverIndex].SolvePositionNoFriction(Dt, MaxPushOut);
 			}
@@ -799,10 +988,17 @@ namespace Chaos
 
 		UpdateVelocityShockPropagation(InDt, It, NumIts, BeginIndex, EndIndex, SolverSettings);
 
+		SolveVelocityRange(InDt, It, NumIts, BeginIndex, EndIndex, SolverSettings);
+	}
+
+	void FPBDCollisionContainerSolver::SolveVelocityRange(const FReal InDt, const int32 It, const int32 NumIts, const int32 BeginIndex, const int32 EndIndex, const FPBDCollisionSolverSettings& SolverSettings)
+	{
+		// NOTE: may be called in parallel for constraint ranges that do not share dynamic bodies (see ColorConstraints)
+
 		const FSolverReal Dt = FSolverReal(InDt);
 		const bool bApplyDynamicFriction = (It >= NumIts - SolverSettings.NumVelocityFrictionIterations);
 
-		for (int32 SolverIndex = 0; SolverIndex < NumSolvers(); ++SolverIndex)
+		for (int32 SolverIndex = BeginIndex; SolverIndex < EndIndex; ++SolverIndex)
 		{
 			CollisionSolvers[SolverIndex].SolveVelocity(Dt, bApplyDynamicFriction);
 		}
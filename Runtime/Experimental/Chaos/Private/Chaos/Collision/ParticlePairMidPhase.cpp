@@ -9,6 +9,8 @@
 #include "Chaos/Collision/ContactTriangles.h"
 #include "Chaos/Collision/PBDCollisionConstraint.h"
 #include "Chaos/CollisionResolution.h"
+#include "Chaos/Convex.h"
+#include "Chaos/GJKBatch.h"
 #include "Chaos/HeightField.h"
 #include "Chaos/ImplicitObject.h"
 #include "Chaos/ImplicitObjectBVH.h"
@@ -63,6 +65,14 @@ namespace Chaos
 		FAutoConsoleVariableRef CVarChaos_Collision_EnableShapePairs(TEXT("p.Chaos.Collision.EnableShapePairs"), bChaos_Collision_MidPhase_EnableShapePairs, TEXT(""));
 		FAutoConsoleVariableRef CVarChaos_Collision_MaxShapePairs(TEXT("p.Chaos.Collision.MaxShapePairs"), Chaos_Collision_MidPhase_MaxShapePairs, TEXT(""));
 
+		// Whether the shape pair midphase runs GJK on its overlapping convex pairs in batches before the narrow phase, so that pairs
+		// whose bounds overlap but whose shapes are further apart than the cull distance skip the narrow phase. Only used when the
+		// particle pair has at least ConvexBatchCullMinPairs shape pairs, i.e., for compound convex bodies.
+		bool bChaos_Collision_MidPhase_EnableConvexBatchCull = false;
+		int32 Chaos_Collision_MidPhase_ConvexBatchCullMinPairs = 8;
+		FAutoConsoleVariableRef CVarChaos_Collision_MidPhase_EnableConvexBatchCull(TEXT("p.Chaos.Collision.MidPhase.EnableConvexBatchCull"), bChaos_Collision_MidPhase_EnableConvexBatchCull, TEXT("Run batched GJK on the overlapping convex shape pairs of a particle pair and skip the narrow phase for pairs beyond the cull distance"));
+		FAutoConsoleVariableRef CVarChaos_Collision_MidPhase_ConvexBatchCullMinPairs(TEXT("p.Chaos.Collision.MidPhase.ConvexBatchCullMinPairs"), Chaos_Collision_MidPhase_ConvexBatchCullMinPairs, TEXT("The minimum number of shape pairs in a particle pair for p.Chaos.Collision.MidPhase.EnableConvexBatchCull to apply"));
+
 		// This should be enabled but it exposes a bug that must be fixed first: collisions with 
 		// invalid particle pointers are being activated causing a crash in CCDUtilities::ApplyCorrections
 		bool bChaosMidPhaseActivateWakingConstraints = true;
@@ -512,7 +522,11 @@ namespace Chaos
 				bWasManifoldRestored = Constraint->TryRestoreManifold();
 			}
 
-			if (!bWasManifoldRestored)
+			if (bWasManifoldRestored)
+			{
+				++Context.GetAllocator()->GetManifoldReuseStats().NumManifoldRestores;
+			}
+			else
 			{
 				// We are not trying to (or chose not to) reuse manifold points, so reset them but leave stored data intact (for friction)
 				Constraint->ResetActiveManifoldContacts();
@@ -523,6 +537,7 @@ namespace Chaos
 
 					// Run the narrow phase
 					Collisions::UpdateConstraint(*Constraint.Get(), ShapeWorldTransform0, ShapeWorldTransform1, Dt);
+					++Context.GetAllocator()->GetManifoldReuseStats().NumNarrowPhaseUpdates;
 				}
 
 				// We will be updating the manifold so update transforms used to check for movement in UpdateAndTryRestoreManifold on future ticks
@@ -645,6 +660,7 @@ namespace Chaos
 			{
 				// @todo(chaos): should we use a reduced cull distance if we get here? The cull distance will have been set based on movement speed...
 				Collisions::UpdateConstraint(*Constraint.Get(), Constraint->GetShapeWorldTransform0(), Constraint->GetShapeWorldTransform1(), Dt);
+				++Context.GetAllocator()->GetManifoldReuseStats().NumNarrowPhaseUpdates;
 				Constraint->SetCCDSweepEnabled(false);
 				bShouldActivate = (Constraint->GetPhi() <= CullDistance);
 			}
@@ -1190,6 +1206,10 @@ namespace Chaos
 				NumActive += ShapePair.GenerateCollisionCCD(Dt, CullDistance, RelativeMovement, Flags.bUseSweep, Context);
 			}
 		}
+		else if (bChaos_Collision_MidPhase_EnableConvexBatchCull && !Context.GetSettings().bDeferNarrowPhase && (ShapePairDetectors.Num() >= Chaos_Collision_MidPhase_ConvexBatchCullMinPairs))
+		{
+			NumActive = GenerateCollisionsConvexBatchCull(Dt, CullDistance, RelativeMovement, Context);
+		}
 		else
 		{
 			for (FSingleShapePairCollisionDetector& ShapePair : ShapePairDetectors)
@@ -1200,6 +1220,83 @@ namespace Chaos
 		return NumActive;
 	}
 
+	int32 FShapePairParticlePairMidPhase::GenerateCollisionsConvexBatchCull(
+		const FRealSingle Dt,
+		const FRealSingle CullDistance,
+		const FVec3f& RelativeMovement,
+		const FCollisionContext& Context)
+	{
+		CHAOS_MIDPHASE_SCOPE_CYCLE_TIMER(FShapePairParticlePairMidPhase_GenerateCollisionsConvexBatchCull);
+
+		using FConvexPair = TGJKDistanceBatchPair<TGJKShape<FImplicitConvex3>, TGJKShapeTransformed<FImplicitConvex3>>;
+
+		const int32 CurrentEpoch = Context.GetAllocator()->GetCurrentEpoch();
+		const int32 LastEpoch = CurrentEpoch - 1;
+
+		// The shape pairs that passed the bounds test, with the index of their GJK pair (or INDEX_NONE if they were not queued)
+		TArray<int32, TInlineAllocator<32>> OverlappingDetectorIndices;
+		TArray<int32, TInlineAllocator<32>> ConvexPairIndices;
+		TArray<FConvexPair, TInlineAllocator<16>> ConvexPairs;
+
+		for (int32 DetectorIndex = 0; DetectorIndex < ShapePairDetectors.Num(); ++DetectorIndex)
+		{
+			FSingleShapePairCollisionDetector& ShapePair = ShapePairDetectors[DetectorIndex];
+			if (!ShapePair.DoBoundsOverlap(CullDistance, RelativeMovement, CurrentEpoch))
+			{
+				continue;
+			}
+
+			// Only plain convexes are queued (scaled and instanced ones take the usual path). Pairs that were in contact last
+			// tick are not queued either: they are most likely still in contact and may restore their manifold without GJK.
+			int32 ConvexPairIndex = INDEX_NONE;
+			const FImplicitObject* Implicit0 = ShapePair.Shape0->GetLeafGeometry();
+			const FImplicitObject* Implicit1 = ShapePair.Shape1->GetLeafGeometry();
+			if (!ShapePair.BoundsTestFlags.bIsProbe
+				&& !ShapePair.IsUsedSince(LastEpoch)
+				&& (Implicit0->GetType() == FImplicitConvex3::StaticType())
+				&& (Implicit1->GetType() == FImplicitConvex3::StaticType()))
+			{
+				const FImplicitConvex3& Convex0 = Implicit0->GetObjectChecked<FImplicitConvex3>();
+				const FImplicitConvex3& Convex1 = Implicit1->GetObjectChecked<FImplicitConvex3>();
+				const FRigidTransform3 ShapeWorldTransform0 = ShapePair.Shape0->GetLeafWorldTransform(ShapePair.GetParticle0());
+				const FRigidTransform3 ShapeWorldTransform1 = ShapePair.Shape1->GetLeafWorldTransform(ShapePair.GetParticle1());
+				const FRigidTransform3 Transform1To0 = ShapeWorldTransform1.GetRelativeTransform(ShapeWorldTransform0);
+
+				const TGJKShape<FImplicitConvex3> GJKConvex0(Convex0);
+				const TGJKShapeTransformed<FImplicitConvex3> GJKConvex1(Convex1, Transform1To0);
+				const FVec3 InitialDir = Transform1To0.TransformPositionNoScale(Convex1.GetCenterOfMass()) - Convex0.GetCenterOfMass();
+				ConvexPairIndex = ConvexPairs.Emplace(GJKConvex0, GJKConvex1, GJKDistanceInitialVFromDirection(GJKConvex0, GJKConvex1, InitialDir));
+			}
+
+			OverlappingDetectorIndices.Add(DetectorIndex);
+			ConvexPairIndices.Add(ConvexPairIndex);
+		}
+
+		if (ConvexPairs.Num() > 0)
+		{
+			GJKDistanceBatch<4>(MakeArrayView(ConvexPairs));
+		}
+
+		int32 NumActive = 0;
+		for (int32 OverlapIndex = 0; OverlapIndex < OverlappingDetectorIndices.Num(); ++OverlapIndex)
+		{
+			// GJK only gives us a distance, not a manifold, so pairs that may be within CullDistance still run the narrow phase.
+			// The lower bound is never more than the true separation, so a culled pair could not have produced an active contact.
+			const int32 ConvexPairIndex = ConvexPairIndices[OverlapIndex];
+			if (ConvexPairIndex != INDEX_NONE)
+			{
+				const FConvexPair& ConvexPair = ConvexPairs[ConvexPairIndex];
+				if ((ConvexPair.Result == EGJKDistanceResult::Separated) && (ConvexPair.DistanceLowerBound > CullDistance))
+				{
+					continue;
+				}
+			}
+
+			NumActive += ShapePairDetectors[OverlappingDetectorIndices[OverlapIndex]].GenerateCollisionImpl(Dt, CullDistance, RelativeMovement, Context);
+		}
+		return NumActive;
+	}
+
 	void FShapePairParticlePairMidPhase::WakeCollisionsImpl(const int32 CurrentEpoch)
 	{
 		for (FSingleShapePairCollisionDetector& ShapePair : ShapePairDetectors)
@@ -1965,11 +2062,16 @@ namespace Chaos
 			Constraint->ResetActiveManifoldContacts();
 		}
 
-		if (!bWasManifoldRestored)
+		if (bWasManifoldRestored)
+		{
+			++Context.GetAllocator()->GetManifoldReuseStats().NumManifoldRestores;
+		}
+		else
 		{
 			if (!Context.GetSettings().bDeferNarrowPhase)
 			{
 				Collisions::UpdateConstraint(*Constraint, Constraint->GetShapeWorldTransform0(), Constraint->GetShapeWorldTransform1(), Dt);
+				++Context.GetAllocator()->GetManifoldReuseStats().NumNarrowPhaseUpdates;
 			}
 
 			// We will be updating the manifold so update transforms used to check for movement in UpdateAndTryRestoreManifold on future ticks
@@ -2053,6 +2155,7 @@ namespace Chaos
 		if ((!bDidSweep) || (Constraint->GetCCDTimeOfImpact() >= FReal(1)))
 		{
 			Collisions::UpdateConstraint(*Constraint, Constraint->GetShapeWorldTransform0(), Constraint->GetShapeWorldTransform1(), Dt);
+			++Context.GetAllocator()->GetManifoldReuseStats().NumNarrowPhaseUpdates;
 			Constraint->SetCCDSweepEnabled(false);
 			bShouldActivate = Constraint->GetPhi() < CullDistance;
 		}
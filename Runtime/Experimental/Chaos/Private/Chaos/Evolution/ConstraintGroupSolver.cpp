@@ -10,6 +10,7 @@ namespace Chaos
 	{
 		FPBDConstraintGroupSolver::FPBDConstraintGroupSolver()
 			: TotalNumConstraints(0)
+			, bColoringEnabled(false)
 		{
 		}
 
@@ -74,6 +75,7 @@ namespace Chaos
 			}
 
 			TotalNumConstraints = 0;
+			bColoringEnabled = false;
 
 			ResetImpl();
 		}
@@ -82,6 +84,18 @@ namespace Chaos
 		{
 			AddConstraintsImpl();
 
+			// Colors must be built before AddBodies creates the solvers because it reorders the constraints
+			if (bColoringEnabled)
+			{
+				for (int32 ContainerIndex = 0; ContainerIndex < ConstraintContainerSolvers.Num(); ++ContainerIndex)
+				{
+					if (ConstraintContainerSolvers[ContainerIndex] != nullptr)
+					{
+						ConstraintContainerSolvers[ContainerIndex]->ColorConstraints(SolverBodyContainer);
+					}
+				}
+			}
+
 			for (int32 ContainerIndex = 0; ContainerIndex < ConstraintContainerSolvers.Num(); ++ContainerIndex)
 			{
 				if (ConstraintContainerSolvers[ContainerIndex] != nullptr)
@@ -215,7 +229,14 @@ namespace Chaos
 				{
 					if (PrioritizedConstraintContainerSolvers[ContainerIndex] != nullptr)
 					{
-						PrioritizedConstraintContainerSolvers[ContainerIndex]->ApplyPositionConstraints(Dt, It, NumIts);
+						if (bColoringEnabled)
+						{
+							PrioritizedConstraintContainerSolvers[ContainerIndex]->ApplyPositionConstraintsParallel(Dt, It, NumIts);
+						}
+						else
+						{
+							PrioritizedConstraintContainerSolvers[ContainerIndex]->ApplyPositionConstraints(Dt, It, NumIts);
+						}
 					}
 				}
 			}
@@ -246,7 +267,14 @@ namespace Chaos
 				{
 					if (PrioritizedConstraintContainerSolvers[ContainerIndex] != nullptr)
 					{
-						PrioritizedConstraintContainerSolvers[ContainerIndex]->ApplyVelocityConstraints(Dt, It, NumIts);
+						if (bColoringEnabled)
+						{
+							PrioritizedConstraintContainerSolvers[ContainerIndex]->ApplyVelocityConstraintsParallel(Dt, It, NumIts);
+						}
+						else
+						{
+							PrioritizedConstraintContainerSolvers[ContainerIndex]->ApplyVelocityConstraints(Dt, It, NumIts);
+						}
 					}
 				}
 			}
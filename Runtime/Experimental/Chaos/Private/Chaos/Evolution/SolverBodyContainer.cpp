@@ -103,6 +103,11 @@ namespace Chaos
 	}
 
 	FSolverBody* FSolverBodyContainer::FindOrAdd(FGenericParticleHandle InParticle)
+	{
+		return &SolverBodies[FindOrAddIndex(InParticle)];
+	}
+
+	int32 FSolverBodyContainer::FindOrAddIndex(FGenericParticleHandle InParticle)
 	{
 		// For dynamic bodies, we store a cookie on the Particle that holds the solver body index
 		// For kinematics we cannot do this because the kinematic may be in multiple islands and 
@@ -140,10 +145,8 @@ namespace Chaos
 	
 		check(ItemIndex != INDEX_NONE);
 		check(ItemIndex < SolverBodies.Num());
-		
-		FSolverBody* SolverBody = &SolverBodies[ItemIndex];
 
-		return SolverBody;
+		return ItemIndex;
 	}
 
 	void FSolverBodyContainer::GatherInput(const FReal Dt, const int32 BeginIndex, const int32 EndIndex)
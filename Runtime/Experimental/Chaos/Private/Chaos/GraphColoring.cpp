@@ -5,6 +5,20 @@
 #include "Chaos/Framework/Parallel.h"
 #include "Containers/BitArray.h"
 #include "Chaos/SoftsSolverParticlesRange.h"
+#include "HAL/IConsoleManager.h"
+
+namespace Chaos
+{
+	// Off by default since the parallel colouring is valid but different to the serial one, which changes the constraint solve order
+	bool bChaos_GraphColoring_Parallel = false;
+	FAutoConsoleVariableRef CVarChaos_GraphColoring_Parallel(TEXT("p.Chaos.GraphColoring.Parallel"), bChaos_GraphColoring_Parallel, TEXT("Use the parallel Jones-Plassmann graph colouring for deformable constraint graphs with more than p.Chaos.GraphColoring.ParallelConstraintCount constraints."));
+
+	int32 Chaos_GraphColoring_ParallelConstraintCount = 10000;
+	FAutoConsoleVariableRef CVarChaos_GraphColoring_ParallelConstraintCount(TEXT("p.Chaos.GraphColoring.ParallelConstraintCount"), Chaos_GraphColoring_ParallelConstraintCount, TEXT("Minimum number of constraints before the parallel graph colouring is used, when p.Chaos.GraphColoring.Parallel is enabled."));
+
+	int32 Chaos_GraphColoring_BalanceBatchSize = 0;
+	FAutoConsoleVariableRef CVarChaos_GraphColoring_BalanceBatchSize(TEXT("p.Chaos.GraphColoring.BalanceBatchSize"), Chaos_GraphColoring_BalanceBatchSize, TEXT("If greater than zero, rebalance deformable constraint colours towards equal sizes that are a multiple of this batch size (e.g. the ISPC gang width). 0 disables."));
+}
 
 template<typename DynamicParticlesType, int32 N, bool bAllDynamic>
 static bool VerifyGraph(const TArray<TArray<int32>>& ColorGraph, const TArray<Chaos::TVector<int32, N>>& Graph, const DynamicParticlesType& InParticles)
@@ -395,11 +409,9 @@ static bool VerifyExtraNodalColoring(const Chaos::TDynamicParticles<T, 3>& InPar
 }
 
 template<typename DynamicParticlesType, int32 N, bool bAllDynamic>
-TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParticlesOrRange(const TArray<TVector<int32, N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd)
+static TArray<TArray<int32>> ComputeGraphColoringSerial(const TArray<Chaos::TVector<int32, N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FGraphColoring_ComputeGraphColoringN);
-	checkSlow(GraphParticlesStart <= GraphParticlesEnd);
-	checkSlow(GraphParticlesEnd <= (int32)InParticles.Size());
+	typedef TArray<int32, TInlineAllocator<8>> FColorSet;
 
 	TArray<TArray<int32>> ColorGraph;
 
@@ -456,6 +468,302 @@ TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParticlesOrRang
 	return ColorGraph;
 }
 
+// Edges sharing a dynamic node, stored per node in a compact array so that each edge can visit its neighbours from any thread
+template<typename DynamicParticlesType, int32 N, bool bAllDynamic>
+static void BuildNodeIncidentEdges(const TArray<Chaos::TVector<int32, N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd, TArray<int32>& NodeEdgesStart, TArray<int32>& NodeEdges)
+{
+	NodeEdgesStart.Reset();
+	NodeEdgesStart.SetNumZeroed(GraphParticlesEnd - GraphParticlesStart + 1);
+	for (const Chaos::TVector<int32, N>& Edge : Graph)
+	{
+		for (int32 NIndex = 0; NIndex < N; ++NIndex)
+		{
+			const int32 NodeIndex = Edge[NIndex];
+			if (bAllDynamic || InParticles.InvM(NodeIndex) != (decltype(InParticles.InvM(NodeIndex)))0.)
+			{
+				++NodeEdgesStart[NodeIndex - GraphParticlesStart + 1];
+			}
+		}
+	}
+	for (int32 Index = 1; Index < NodeEdgesStart.Num(); ++Index)
+	{
+		NodeEdgesStart[Index] += NodeEdgesStart[Index - 1];
+	}
+
+	TArray<int32> NodeEdgesEnd(NodeEdgesStart.GetData(), NodeEdgesStart.Num() - 1);
+	NodeEdges.SetNumUninitialized(NodeEdgesStart.Last());
+	for (int32 EdgeIndex = 0; EdgeIndex < Graph.Num(); ++EdgeIndex)
+	{
+		for (int32 NIndex = 0; NIndex < N; ++NIndex)
+		{
+			const int32 NodeIndex = Graph[EdgeIndex][NIndex];
+			if (bAllDynamic || InParticles.InvM(NodeIndex) != (decltype(InParticles.InvM(NodeIndex)))0.)
+			{
+				NodeEdges[NodeEdgesEnd[NodeIndex - GraphParticlesStart]++] = EdgeIndex;
+			}
+		}
+	}
+}
+
+// Fixed pseudo random priority per edge, so that the Jones-Plassmann rounds do not depend on the scheduling
+static uint32 GetGraphColoringPriority(uint32 EdgeIndex)
+{
+	EdgeIndex ^= EdgeIndex >> 16;
+	EdgeIndex *= 0x7feb352du;
+	EdgeIndex ^= EdgeIndex >> 15;
+	EdgeIndex *= 0x846ca68bu;
+	EdgeIndex ^= EdgeIndex >> 16;
+	return EdgeIndex;
+}
+
+static bool GraphColoringPriorityGreater(int32 EdgeIndex, int32 OtherEdgeIndex)
+{
+	const uint32 Priority = GetGraphColoringPriority((uint32)EdgeIndex);
+	const uint32 OtherPriority = GetGraphColoringPriority((uint32)OtherEdgeIndex);
+	return Priority > OtherPriority || (Priority == OtherPriority && EdgeIndex > OtherEdgeIndex);
+}
+
+template<typename DynamicParticlesType, int32 N, bool bAllDynamic>
+TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParallelParticlesOrRange(const TArray<TVector<int32, N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FGraphColoring_ComputeGraphColoringParallelN);
+	checkSlow(GraphParticlesStart <= GraphParticlesEnd);
+	checkSlow(GraphParticlesEnd <= (int32)InParticles.Size());
+
+	TArray<int32> NodeEdgesStart;
+	TArray<int32> NodeEdges;
+	BuildNodeIncidentEdges<DynamicParticlesType, N, bAllDynamic>(Graph, InParticles, GraphParticlesStart, GraphParticlesEnd, NodeEdgesStart, NodeEdges);
+
+	TArray<int32> EdgeColors;
+	EdgeColors.Init(INDEX_NONE, Graph.Num());
+
+	TArray<int32> UncoloredEdges;
+	UncoloredEdges.SetNumUninitialized(Graph.Num());
+	for (int32 EdgeIndex = 0; EdgeIndex < Graph.Num(); ++EdgeIndex)
+	{
+		UncoloredEdges[EdgeIndex] = EdgeIndex;
+	}
+
+	// Colours picked this round are written per work item and only applied once the round is over, so every edge sees the colours of the previous rounds.
+	// Two edges colored in the same round are never neighbours, since only one of them can have the highest priority.
+	constexpr int32 MinParallelBatchSize = 1024;
+	TArray<int32> RoundColors;
+	int32 MaxColor = -1;
+	while (UncoloredEdges.Num())
+	{
+		RoundColors.SetNumUninitialized(UncoloredEdges.Num(), EAllowShrinking::No);
+		PhysicsParallelFor(UncoloredEdges.Num(), [&Graph, &InParticles, &NodeEdgesStart, &NodeEdges, &EdgeColors, &UncoloredEdges, &RoundColors, GraphParticlesStart](int32 WorkIndex)
+		{
+			const int32 EdgeIndex = UncoloredEdges[WorkIndex];
+			RoundColors[WorkIndex] = INDEX_NONE;
+
+			uint64 UsedColorsMask = 0;
+			TArray<int32, TInlineAllocator<8>> UsedHighColors;
+			for (int32 NIndex = 0; NIndex < N; ++NIndex)
+			{
+				const int32 NodeIndex = Graph[EdgeIndex][NIndex];
+				if constexpr (!bAllDynamic)
+				{
+					if (InParticles.InvM(NodeIndex) == (decltype(InParticles.InvM(NodeIndex)))0.)
+					{
+						continue;
+					}
+				}
+				const int32 LocalNodeIndex = NodeIndex - GraphParticlesStart;
+				for (int32 Index = NodeEdgesStart[LocalNodeIndex]; Index < NodeEdgesStart[LocalNodeIndex + 1]; ++Index)
+				{
+					const int32 OtherEdgeIndex = NodeEdges[Index];
+					if (OtherEdgeIndex == EdgeIndex)
+					{
+						continue;
+					}
+					const int32 OtherColor = EdgeColors[OtherEdgeIndex];
+					if (OtherColor == INDEX_NONE)
+					{
+						if (GraphColoringPriorityGreater(OtherEdgeIndex, EdgeIndex))
+						{
+							// A neighbour with a higher priority has to be colored first
+							return;
+						}
+					}
+					else if (OtherColor < 64)
+					{
+						UsedColorsMask |= (uint64)1 << OtherColor;
+					}
+					else
+					{
+						UsedHighColors.AddUnique(OtherColor);
+					}
+				}
+			}
+
+			if (UsedColorsMask != ~(uint64)0)
+			{
+				RoundColors[WorkIndex] = (int32)FMath::CountTrailingZeros64(~UsedColorsMask);
+			}
+			else
+			{
+				int32 FirstFreeColor = 64;
+				while (UsedHighColors.Contains(FirstFreeColor))
+				{
+					++FirstFreeColor;
+				}
+				RoundColors[WorkIndex] = FirstFreeColor;
+			}
+		}, UncoloredEdges.Num() < MinParallelBatchSize);
+
+		int32 NumUncolored = 0;
+		for (int32 WorkIndex = 0; WorkIndex < UncoloredEdges.Num(); ++WorkIndex)
+		{
+			const int32 EdgeIndex = UncoloredEdges[WorkIndex];
+			const int32 Color = RoundColors[WorkIndex];
+			if (Color == INDEX_NONE)
+			{
+				UncoloredEdges[NumUncolored++] = EdgeIndex;
+			}
+			else
+			{
+				EdgeColors[EdgeIndex] = Color;
+				MaxColor = FMath::Max(MaxColor, Color);
+			}
+		}
+		// The edge with the highest priority in the remaining graph always gets colored, so every round makes progress
+		check(NumUncolored < UncoloredEdges.Num());
+		UncoloredEdges.SetNum(NumUncolored, EAllowShrinking::No);
+	}
+
+	TArray<TArray<int32>> ColorGraph;
+	ColorGraph.SetNum(MaxColor + 1);
+	for (int32 EdgeIndex = 0; EdgeIndex < Graph.Num(); ++EdgeIndex)
+	{
+		ColorGraph[EdgeColors[EdgeIndex]].Add(EdgeIndex);
+	}
+#if DO_GUARD_SLOW
+	const bool bVerifyGraphResult = VerifyGraph<DynamicParticlesType, N, bAllDynamic>(ColorGraph, Graph, InParticles);
+	checkSlow(bVerifyGraphResult);
+#endif
+	return ColorGraph;
+}
+
+template<typename DynamicParticlesType, int32 N, bool bAllDynamic>
+void Chaos::FGraphColoring::BalanceGraphColoring(TArray<TArray<int32>>& ColorGraph, const TArray<TVector<int32, N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd, const int32 BatchSize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FGraphColoring_BalanceGraphColoring);
+	const int32 NumColors = ColorGraph.Num();
+	if (NumColors < 2 || BatchSize <= 0)
+	{
+		return;
+	}
+
+	int32 NumEdges = 0;
+	for (const TArray<int32>& ColorEdges : ColorGraph)
+	{
+		NumEdges += ColorEdges.Num();
+	}
+	const int32 TargetColorSize = FMath::DivideAndRoundUp(FMath::DivideAndRoundUp(NumEdges, NumColors), BatchSize) * BatchSize;
+
+	auto IsNodeDynamic = [&InParticles](int32 NodeIndex)
+	{
+		return bAllDynamic || InParticles.InvM(NodeIndex) != (decltype(InParticles.InvM(NodeIndex)))0.;
+	};
+
+	TArray<FColorSet> NodeUsedColorsSubArray;
+	NodeUsedColorsSubArray.SetNum(GraphParticlesEnd - GraphParticlesStart);
+	TArrayView<FColorSet> NodeUsedColors(NodeUsedColorsSubArray.GetData() - GraphParticlesStart, GraphParticlesEnd); // Only nodes starting with GraphParticlesStart are valid to access
+	for (int32 Color = 0; Color < NumColors; ++Color)
+	{
+		for (const int32 EdgeIndex : ColorGraph[Color])
+		{
+			for (int32 NIndex = 0; NIndex < N; ++NIndex)
+			{
+				const int32 NodeIndex = Graph[EdgeIndex][NIndex];
+				if (IsNodeDynamic(NodeIndex))
+				{
+					NodeUsedColors[NodeIndex].Add(Color);
+				}
+			}
+		}
+	}
+
+	bool bMovedEdges = false;
+	for (int32 Color = 0; Color < NumColors; ++Color)
+	{
+		TArray<int32>& ColorEdges = ColorGraph[Color];
+		for (int32 Index = ColorEdges.Num() - 1; Index >= 0 && ColorEdges.Num() > TargetColorSize; --Index)
+		{
+			const int32 EdgeIndex = ColorEdges[Index];
+			for (int32 OtherColor = 0; OtherColor < NumColors; ++OtherColor)
+			{
+				if (ColorGraph[OtherColor].Num() >= TargetColorSize)
+				{
+					continue;
+				}
+
+				bool bColorUsed = false;
+				for (int32 NIndex = 0; NIndex < N && !bColorUsed; ++NIndex)
+				{
+					const int32 NodeIndex = Graph[EdgeIndex][NIndex];
+					bColorUsed = IsNodeDynamic(NodeIndex) && NodeUsedColors[NodeIndex].Contains(OtherColor);
+				}
+				if (bColorUsed)
+				{
+					continue;
+				}
+
+				for (int32 NIndex = 0; NIndex < N; ++NIndex)
+				{
+					const int32 NodeIndex = Graph[EdgeIndex][NIndex];
+					if (IsNodeDynamic(NodeIndex))
+					{
+						NodeUsedColors[NodeIndex].RemoveSingleSwap(Color, EAllowShrinking::No);
+						NodeUsedColors[NodeIndex].Add(OtherColor);
+					}
+				}
+				ColorGraph[OtherColor].Add(EdgeIndex);
+				ColorEdges.RemoveAtSwap(Index, EAllowShrinking::No);
+				bMovedEdges = true;
+				break;
+			}
+		}
+	}
+
+	if (bMovedEdges)
+	{
+		// Keep the edges in their original order within each colour, as produced by the colouring
+		for (TArray<int32>& ColorEdges : ColorGraph)
+		{
+			ColorEdges.Sort();
+		}
+	}
+#if DO_GUARD_SLOW
+	const bool bVerifyGraphResult = VerifyGraph<DynamicParticlesType, N, bAllDynamic>(ColorGraph, Graph, InParticles);
+	checkSlow(bVerifyGraphResult);
+#endif
+}
+template<typename DynamicParticlesType, int32 N, bool bAllDynamic>
+TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParticlesOrRange(const TArray<TVector<int32, N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FGraphColoring_ComputeGraphColoringN);
+	checkSlow(GraphParticlesStart <= GraphParticlesEnd);
+	checkSlow(GraphParticlesEnd <= (int32)InParticles.Size());
+
+	TArray<TArray<int32>> ColorGraph;
+	if (bChaos_GraphColoring_Parallel && Graph.Num() > Chaos_GraphColoring_ParallelConstraintCount)
+	{
+		ColorGraph = ComputeGraphColoringParallelParticlesOrRange<DynamicParticlesType, N, bAllDynamic>(Graph, InParticles, GraphParticlesStart, GraphParticlesEnd);
+	}
+	else
+	{
+		ColorGraph = ComputeGraphColoringSerial<DynamicParticlesType, N, bAllDynamic>(Graph, InParticles, GraphParticlesStart, GraphParticlesEnd);
+	}
+
+	if (Chaos_GraphColoring_BalanceBatchSize > 0)
+	{
+		BalanceGraphColoring<DynamicParticlesType, N, bAllDynamic>(ColorGraph, Graph, InParticles, GraphParticlesStart, GraphParticlesEnd, Chaos_GraphColoring_BalanceBatchSize);
+	}
+	return ColorGraph;
+}
+
 
 template<typename T>
 void Chaos::ComputeGridBasedGraphSubColoringPointer(const TArray<TArray<int32>>& ElementsPerColor, const TMPMGrid<T>& Grid, const int32 GridSize, TUniquePtr<TArray<TArray<int32>>>& PreviousColoring, const TArray<TArray<int32>>& ConstraintsNodesSet, TArray<TArray<TArray<int32>>>& ElementsPerSubColors) 
@@ -1114,7 +1422,15 @@ void Chaos::ComputeExtraNodalColoring(const TArray<TArray<int32>>& StaticGraph,
 template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParticlesOrRange<Chaos::TDynamicParticles<Chaos::FRealSingle, 3>, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::TDynamicParticles<Chaos::FRealSingle, 3>&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd); \
 template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParticlesOrRange<Chaos::TDynamicParticles<Chaos::FRealDouble, 3>, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::TDynamicParticles<Chaos::FRealDouble, 3>&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd); \
 template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParticlesOrRange<Chaos::Softs::FSolverParticles, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::Softs::FSolverParticles&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd); \
-template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParticlesOrRange<Chaos::Softs::FSolverParticlesRange, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::Softs::FSolverParticlesRange&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd);
+template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParticlesOrRange<Chaos::Softs::FSolverParticlesRange, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::Softs::FSolverParticlesRange&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd); \
+template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<Chaos::TDynamicParticles<Chaos::FRealSingle, 3>, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::TDynamicParticles<Chaos::FRealSingle, 3>&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd); \
+template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<Chaos::TDynamicParticles<Chaos::FRealDouble, 3>, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::TDynamicParticles<Chaos::FRealDouble, 3>&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd); \
+template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<Chaos::Softs::FSolverParticles, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::Softs::FSolverParticles&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd); \
+template CHAOS_API TArray<TArray<int32>> Chaos::FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<Chaos::Softs::FSolverParticlesRange, N, bAllDynamic>(const TArray<Chaos::TVector<int32, N>>&, const Chaos::Softs::FSolverParticlesRange&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd); \
+template CHAOS_API void Chaos::FGraphColoring::BalanceGraphColoring<Chaos::TDynamicParticles<Chaos::FRealSingle, 3>, N, bAllDynamic>(TArray<TArray<int32>>&, const TArray<Chaos::TVector<int32, N>>&, const Chaos::TDynamicParticles<Chaos::FRealSingle, 3>&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd, const int32 BatchSize); \
+template CHAOS_API void Chaos::FGraphColoring::BalanceGraphColoring<Chaos::TDynamicParticles<Chaos::FRealDouble, 3>, N, bAllDynamic>(TArray<TArray<int32>>&, const TArray<Chaos::TVector<int32, N>>&, const Chaos::TDynamicParticles<Chaos::FRealDouble, 3>&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd, const int32 BatchSize); \
+template CHAOS_API void Chaos::FGraphColoring::BalanceGraphColoring<Chaos::Softs::FSolverParticles, N, bAllDynamic>(TArray<TArray<int32>>&, const TArray<Chaos::TVector<int32, N>>&, const Chaos::Softs::FSolverParticles&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd, const int32 BatchSize); \
+template CHAOS_API void Chaos::FGraphColoring::BalanceGraphColoring<Chaos::Softs::FSolverParticlesRange, N, bAllDynamic>(TArray<TArray<int32>>&, const TArray<Chaos::TVector<int32, N>>&, const Chaos::Softs::FSolverParticlesRange&, const int32 GraphParticlesStart, const int32 GraphParticlesEnd, const int32 BatchSize);
 
 UE_COMPUTE_GRAPH_COLORING_PARTICLES_OR_RANGE_N_HELPER(2, false)
 UE_COMPUTE_GRAPH_COLORING_PARTICLES_OR_RANGE_N_HELPER(3, false)
@@ -32,6 +32,9 @@ namespace Chaos
 
 	extern bool bChaos_Collision_OneSidedHeightField;
 
+	bool bChaos_HeightField_UseMinMaxPyramid = true;
+	FAutoConsoleVariableRef CVarChaos_HeightField_UseMinMaxPyramid(TEXT("p.Chaos.HeightField.UseMinMaxPyramid"), bChaos_HeightField_UseMinMaxPyramid, TEXT("Raycasts and sweeps against heightfields skip empty space using the min/max height pyramid instead of walking every cell along the ray."));
+
 	class FHeightfieldRaycastVisitor
 	{
 	public:
@@ -257,6 +260,11 @@ namespace Chaos
 				bHit |= TestTriangle(Payload * 2, Points[0], Points[1], Points[3]);
 				bHit |= TestTriangle(Payload * 2 + 1, Points[0], Points[3], Points[2]);
 			}
+			if (bHit && OutTime == 0)
+			{
+				// Initial overlaps don't shorten the ray, but nothing can be closer
+				CurrentLength = 0;
+			}
 			const bool bShouldContinueVisiting = !bHit;
 			return bShouldContinueVisiting;
 		}
@@ -1299,6 +1307,135 @@ namespace Chaos
 		}
 	}
 	
+	FORCEINLINE void FHeightField::GetMinMaxPyramidNodeBoundsScaled(int32 Level, int32 NodeX, int32 NodeY, FAABB3& OutBounds) const
+	{
+		const FMinMaxPyramidLevel& PyramidLevel = MinMaxPyramidLevels[Level];
+		const FDataType::MinMaxHeights& NodeHeights = MinMaxPyramid[PyramidLevel.Offset + NodeY * PyramidLevel.NumX + NodeX];
+
+		// Level 0 nodes are 2x2 cells
+		const int32 Shift = Level + 1;
+		const FVec3 Min(static_cast<FReal>(NodeX << Shift), static_cast<FReal>(NodeY << Shift), GeomData.MinValue + NodeHeights.Min * GeomData.HeightPerUnit);
+		const FVec3 Max(
+			static_cast<FReal>(FMath::Min((NodeX + 1) << Shift, GeomData.NumCols - 1)),
+			static_cast<FReal>(FMath::Min((NodeY + 1) << Shift, GeomData.NumRows - 1)),
+			GeomData.MinValue + NodeHeights.Max * GeomData.HeightPerUnit);
+
+		OutBounds = FAABB3::FromPoints(Min * GeomData.Scale, Max * GeomData.Scale);
+	}
+
+	template<typename CellVisitorType>
+	bool FHeightField::PyramidCast(const FVec3& StartPoint, const FVec3& Dir, const FReal Length, const FVec3& InHalfExtents, CellVisitorType&& VisitCell) const
+	{
+		const int32 NumCellsX = GeomData.NumCols - 1;
+		const int32 NumCellsY = GeomData.NumRows - 1;
+
+		bool bParallel[3];
+		FVec3 InvDir;
+		for (int Axis = 0; Axis < 3; ++Axis)
+		{
+			bParallel[Axis] = FMath::IsNearlyZero(Dir[Axis], (FReal)1.e-8);
+			InvDir[Axis] = bParallel[Axis] ? 0 : 1 / Dir[Axis];
+		}
+
+		// Visitors cull cells in single precision, pad the nodes so we never reject a cell that they would accept
+		const FReal MaxCoordinate = FMath::Max((LocalBounds.Min() * GeomData.Scale).GetAbsMax(), (LocalBounds.Max() * GeomData.Scale).GetAbsMax());
+		const FVec3 Inflation = InHalfExtents.GetAbs() + FVec3((FReal)1.e-5 * (1 + MaxCoordinate));
+
+		FReal CurrentLength = Length;
+		auto RaycastNode = [&](int32 Level, int32 NodeX, int32 NodeY, FReal& OutEntryTime) -> bool
+		{
+			FAABB3 NodeBounds;
+			GetMinMaxPyramidNodeBoundsScaled(Level, NodeX, NodeY, NodeBounds);
+			NodeBounds.ThickenSymmetrically(Inflation);
+
+			FReal ExitTime;
+			const FReal InvCurrentLength = CurrentLength > 0 ? 1 / CurrentLength : 0;
+			return NodeBounds.RaycastFast(StartPoint, Dir, InvDir, bParallel, CurrentLength, InvCurrentLength, OutEntryTime, ExitTime);
+		};
+
+		struct FStackEntry
+		{
+			int32 Level;
+			int32 NodeX;
+			int32 NodeY;
+			FReal EntryTime;
+		};
+		TArray<FStackEntry, TInlineAllocator<64>> Stack;
+
+		const int32 RootLevel = MinMaxPyramidLevels.Num() - 1;
+		FReal RootEntryTime;
+		if (RaycastNode(RootLevel, 0, 0, RootEntryTime))
+		{
+			Stack.Add({ RootLevel, 0, 0, RootEntryTime });
+		}
+
+		// Order of the cells in a level 0 node, along the ray in grid space
+		const int32 FirstCellX = Dir[0] * GeomData.Scale[0] < 0 ? 1 : 0;
+		const int32 FirstCellY = Dir[1] * GeomData.Scale[1] < 0 ? 1 : 0;
+
+		while (Stack.Num() > 0)
+		{
+			const FStackEntry Entry = Stack.Pop(EAllowShrinking::No);
+
+			// The ray may have been shortened by a hit since this node was pushed
+			if (Entry.EntryTime > CurrentLength)
+			{
+				continue;
+			}
+
+			if (Entry.Level == 0)
+			{
+				for (int32 IndexY = 0; IndexY < 2; ++IndexY)
+				{
+					const int32 CellY = Entry.NodeY * 2 + (IndexY ^ FirstCellY);
+					if (CellY >= NumCellsY)
+					{
+						continue;
+					}
+
+					for (int32 IndexX = 0; IndexX < 2; ++IndexX)
+					{
+						const int32 CellX = Entry.NodeX * 2 + (IndexX ^ FirstCellX);
+						if (CellX < NumCellsX && !VisitCell(CellY * NumCellsX + CellX, CurrentLength))
+						{
+							return true;
+						}
+					}
+				}
+				continue;
+			}
+
+			// Push the children that the ray hits, farthest first so the nearest one is visited next
+			const int32 ChildLevel = Entry.Level - 1;
+			const FMinMaxPyramidLevel& Children = MinMaxPyramidLevels[ChildLevel];
+			const int32 EndChildX = FMath::Min(Entry.NodeX * 2 + 2, Children.NumX);
+			const int32 EndChildY = FMath::Min(Entry.NodeY * 2 + 2, Children.NumY);
+
+			FStackEntry Hits[4];
+			int32 NumHits = 0;
+			for (int32 ChildY = Entry.NodeY * 2; ChildY < EndChildY; ++ChildY)
+			{
+				for (int32 ChildX = Entry.NodeX * 2; ChildX < EndChildX; ++ChildX)
+				{
+					FReal EntryTime;
+					if (RaycastNode(ChildLevel, ChildX, ChildY, EntryTime))
+					{
+						int32 HitIndex = NumHits++;
+						while (HitIndex > 0 && Hits[HitIndex - 1].EntryTime < EntryTime)
+						{
+							Hits[HitIndex] = Hits[HitIndex - 1];
+							--HitIndex;
+						}
+						Hits[HitIndex] = { ChildLevel, ChildX, ChildY, EntryTime };
+					}
+				}
+			}
+			Stack.Append(Hits, NumHits);
+		}
+
+		return false;
+	}
+
 	FORCEINLINE bool FHeightField::GridCast(const FVec3& StartPoint, const FVec3& Dir, const FReal Length, FHeightfieldRaycastVisitor& Visitor) const
 	{
 		//Is this check needed?
@@ -1307,6 +1444,20 @@ namespace Chaos
 			return false;
 		}
 
+		if (bChaos_HeightField_UseMinMaxPyramid && MinMaxPyramidLevels.Num() > 0)
+		{
+			PyramidCast(StartPoint, Dir, Length, FVec3(0), [&Visitor](int32 CellIndex, FReal& CurrentLength)
+			{
+				// VisitRaycast stops at the first hit, keep going with the ray shortened to it in case a closer cell comes later
+				if (!Visitor.VisitRaycast(CellIndex, CurrentLength))
+				{
+					CurrentLength = Visitor.OutTime;
+				}
+				return CurrentLength > 0;
+			});
+			return false;
+		}
+
 		FWalkingData WalkingData(Visitor);
 		WalkingData.Dir = Dir;
 		WalkingData.CurrentLength = Length;
@@ -1400,6 +1551,16 @@ namespace Chaos
 	template<typename SQVisitor>
 	bool FHeightField::GridSweep(const FVec3& StartPoint, const FVec3& Dir, const FReal Length, const FVec3 InHalfExtents, SQVisitor& Visitor) const
 	{
+		if (bChaos_HeightField_UseMinMaxPyramid && MinMaxPyramidLevels.Num() > 0)
+		{
+			return PyramidCast(StartPoint, Dir, Length, InHalfExtents, [&Visitor](int32 CellIndex, FReal& CurrentLength)
+			{
+				// Visitors that stop at their first hit have shortened the ray to it, so the remaining cells can only improve on
+				// that hit and are culled by the shorter ray. Only stop once nothing can be closer.
+				return Visitor.VisitSweep(CellIndex, CurrentLength) || CurrentLength > 0;
+			});
+		}
+
 		// Take the 2D portion of the extent and inflate the grid query bounds for checking against the 2D height field grid
 		// to account for the thickness when querying outside but near to the edge of the grid.
 		const FVec2 Inflation2D(InHalfExtents[0], InHalfExtents[1]);
@@ -2483,6 +2644,91 @@ namespace Chaos
 		//MaxCorner *= {GeomData.Scale[0], GeomData.Scale[1]};
 
 		FlatGrid = TUniformGrid<FReal, 2>(MinCorner, MaxCorner, Cells);
+
+		BuildMinMaxPyramid();
+	}
+
+	void FHeightField::BuildMinMaxPyramid()
+	{
+		MinMaxPyramidLevels.Reset();
+		MinMaxPyramid.Reset();
+
+		const int32 NumCellsX = GeomData.NumCols - 1;
+		const int32 NumCellsY = GeomData.NumRows - 1;
+		if (NumCellsX <= 0 || NumCellsY <= 0 || GeomData.Heights.Num() < GeomData.NumCols * GeomData.NumRows)
+		{
+			return;
+		}
+
+		int32 NumX = (NumCellsX + 1) / 2;
+		int32 NumY = (NumCellsY + 1) / 2;
+		int32 NumNodes = 0;
+		while (true)
+		{
+			MinMaxPyramidLevels.Add({ NumNodes, NumX, NumY });
+			NumNodes += NumX * NumY;
+			if (NumX == 1 && NumY == 1)
+			{
+				break;
+			}
+			NumX = (NumX + 1) / 2;
+			NumY = (NumY + 1) / 2;
+		}
+		MinMaxPyramid.SetNumUninitialized(NumNodes);
+
+		// Level 0 from the heights of the vertices around each 2x2 block of cells
+		const FMinMaxPyramidLevel& BaseLevel = MinMaxPyramidLevels[0];
+		for (int32 NodeY = 0; NodeY < BaseLevel.NumY; ++NodeY)
+		{
+			const int32 LastRow = FMath::Min(NodeY * 2 + 2, NumCellsY);
+			for (int32 NodeX = 0; NodeX < BaseLevel.NumX; ++NodeX)
+			{
+				const int32 LastCol = FMath::Min(NodeX * 2 + 2, NumCellsX);
+
+				FDataType::StorageType MinHeight = TNumericLimits<FDataType::StorageType>::Max();
+				FDataType::StorageType MaxHeight = TNumericLimits<FDataType::StorageType>::Min();
+				for (int32 Row = NodeY * 2; Row <= LastRow; ++Row)
+				{
+					for (int32 Col = NodeX * 2; Col <= LastCol; ++Col)
+					{
+						const FDataType::StorageType Height = GeomData.Heights[Row * GeomData.NumCols + Col];
+						MinHeight = FMath::Min(MinHeight, Height);
+						MaxHeight = FMath::Max(MaxHeight, Height);
+					}
+				}
+
+				FDataType::MinMaxHeights& Node = MinMaxPyramid[BaseLevel.Offset + NodeY * BaseLevel.NumX + NodeX];
+				Node.Min = MinHeight;
+				Node.Max = MaxHeight;
+			}
+		}
+
+		// Every other level from the 2x2 nodes below it
+		for (int32 LevelIndex = 1; LevelIndex < MinMaxPyramidLevels.Num(); ++LevelIndex)
+		{
+			const FMinMaxPyramidLevel& Level = MinMaxPyramidLevels[LevelIndex];
+			const FMinMaxPyramidLevel& Children = MinMaxPyramidLevels[LevelIndex - 1];
+			for (int32 NodeY = 0; NodeY < Level.NumY; ++NodeY)
+			{
+				const int32 EndChildY = FMath::Min(NodeY * 2 + 2, Children.NumY);
+				for (int32 NodeX = 0; NodeX < Level.NumX; ++NodeX)
+				{
+					const int32 EndChildX = FMath::Min(NodeX * 2 + 2, Children.NumX);
+
+					FDataType::MinMaxHeights Node = MinMaxPyramid[Children.Offset + NodeY * 2 * Children.NumX + NodeX * 2];
+					for (int32 ChildY = NodeY * 2; ChildY < EndChildY; ++ChildY)
+					{
+						for (int32 ChildX = NodeX * 2; ChildX < EndChildX; ++ChildX)
+						{
+							const FDataType::MinMaxHeights& Child = MinMaxPyramid[Children.Offset + ChildY * Children.NumX + ChildX];
+							Node.Min = FMath::Min(Node.Min, Child.Min);
+							Node.Max = FMath::Max(Node.Max, Child.Max);
+						}
+					}
+					MinMaxPyramid[Level.Offset + NodeY * Level.NumX + NodeX] = Node;
+				}
+			}
+		}
 	}
 
 	Chaos::FReal FHeightField::PhiWithNormal(const FVec3& x, FVec3& Normal) const
@@ -50,6 +50,14 @@ namespace Chaos
 		int32 GIslandGroupsMinBodiesPerWorker = 50;
 		FAutoConsoleVariableRef GCVarIslandGroupsMinBodiesPerWorker(TEXT("p.Chaos.Solver.IslandGroups.MinBodiesPerWorker"), GIslandGroupsMinBodiesPerWorker, TEXT("The minimum number of bodies we want per worker thread"));
 
+		// Whether to color the constraints of islands that are too large for one worker so that each color can be solved on multiple threads
+		bool GIslandGroupsColoringEnabled = false;
+		FAutoConsoleVariableRef GCVarIslandGroupsColoringEnabled(TEXT("p.Chaos.Solver.IslandGroups.Coloring"), GIslandGroupsColoringEnabled, TEXT("Split islands with more constraints than a worker's share into colors that are solved in parallel"));
+
+		// Islands smaller than this are never colored, even if they are larger than a worker's share of the constraints
+		int32 GIslandGroupsColoringMinConstraints = 1000;
+		FAutoConsoleVariableRef GCVarIslandGroupsColoringMinConstraints(TEXT("p.Chaos.Solver.IslandGroups.ColoringMinConstraints"), GIslandGroupsColoringMinConstraints, TEXT("The minimum number of constraints in an island before it is colored (see p.Chaos.Solver.IslandGroups.Coloring)"));
+
 	}
 
 	namespace Private
@@ -63,6 +71,7 @@ namespace Chaos
 			, TargetNumBodiesPerTask(0)
 			, TargetNumConstraintsPerTask(0)
 			, Iterations(0, 0, 0)
+			, GroupSolveTimes()
 		{
 			// Check for use of the "-onethread" command line arg, and physics threading disabled (GetNumWorkerThreads() is not affected by these)
 			// @todo(chaos): is the number of worker threads a good indicator of how many threads we get in the solver loop? (Currently uses ParallelFor)
@@ -75,6 +84,8 @@ namespace Chaos
 			{
 				IslandGroups.Emplace(MakeUnique<FPBDIslandConstraintGroupSolver>(IslandManager));
 			}
+
+			GroupSolveTimes.SetNumZeroed(NumIslandGroups);
 		}
 
 		FPBDIslandGroupManager::~FPBDIslandGroupManager()
@@ -171,6 +182,11 @@ namespace Chaos
 			}
 			NumActiveGroups = 0;
 
+			// Islands with more constraints than a worker's share would leave the other workers idle while they are solved.
+			// If enabled, the groups containing these islands color their constraints and solve each color on multiple threads.
+			const bool bColoringEnabled = CVars::GIslandGroupsColoringEnabled && (NumWorkerThreads > 0);
+			const int32 MinColoringConstraints = FMath::Max(TargetNumConstraintsPerTask, CVars::GIslandGroupsColoringMinConstraints);
+
 			// Add each Island to the first group with enough space, or the group with the fewest constraint if none have enough space
 			// @todo(chaos): optimize - when a group is full we should move it to the back so we don't keep visiting it
 			for (FPBDIsland* Island : Islands)
@@ -199,6 +215,11 @@ namespace Chaos
 				check(InsertGroupIndex != INDEX_NONE);
 				IslandGroups[InsertGroupIndex]->AddIsland(Island);
 
+				if (bColoringEnabled && (NumIslandConstraints >= MinColoringConstraints))
+				{
+					IslandGroups[InsertGroupIndex]->SetColoringEnabled(true);
+				}
+
 				NumActiveGroups = FMath::Max(NumActiveGroups, InsertGroupIndex + 1);
 			}
 
@@ -254,6 +275,8 @@ namespace Chaos
 
 			FPBDIslandConstraintGroupSolver* IslandGroup = GetGroup(GroupIndex);
 
+			const double SolveStartTime = FPlatformTime::Seconds();
+
 			{
 				SCOPE_CYCLE_COUNTER(STAT_Evolution_ApplyConstraintsPhase1);
 				CSV_SCOPED_ISLANDGROUP_TIMING_STAT(PerIslandSolve_ApplyTotalSerialized, GroupIndex);
@@ -275,6 +298,25 @@ namespace Chaos
 				IslandGroup->PreApplyProjectionConstraints(Dt);
 				IslandGroup->ApplyProjectionConstraints(Dt);
 			}
+
+			GroupSolveTimes[GroupIndex] = FPlatformTime::Seconds() - SolveStartTime;
+		}
+
+		double FPBDIslandGroupManager::GetGroupSolveImbalance() const
+		{
+			double MaxSolveTime = 0;
+			double TotalSolveTime = 0;
+			for (int32 GroupIndex = 0; GroupIndex < NumActiveGroups; ++GroupIndex)
+			{
+				MaxSolveTime = FMath::Max(MaxSolveTime, GroupSolveTimes[GroupIndex]);
+				TotalSolveTime += GroupSolveTimes[GroupIndex];
+			}
+
+			if (TotalSolveTime > 0)
+			{
+				return MaxSolveTime * double(NumActiveGroups) / TotalSolveTime;
+			}
+			return 1.0;
 		}
 
 		void FPBDIslandGroupManager::SolveSerial(const FReal Dt)
@@ -477,8 +519,8 @@ namespace Chaos
 						// Wait for Gather Constraints
 						FGraphEventRef GatherConstraintsCompletionEvent = TGraphTask<FNullGraphTask>::CreateTask(&GatherConstraintEvents).ConstructAndDispatchWhenReady(TStatId(), ENamedThreads::AnyThread);
 
-						// Solve Constraints after gathering is complete. Single task - no further parallelization (without coloring)
-						// @todo(chaos): add coloring support
+						// Solve Constraints after gathering is complete. Single task - no further parallelization unless the group
+						// has coloring enabled, in which case each color is solved with a parallel-for from within this task
 						FGraphEventRef SolveConstraintsCompletionEvent = FFunctionGraphTask::CreateAndDispatchWhenReady(
 							[this, GroupIndex, Dt]()
 							{
@@ -552,6 +594,11 @@ namespace Chaos
 			GroupStats.AddDefaulted(IslandGroups.Num());
 	#endif
 
+			for (double& GroupSolveTime : GroupSolveTimes)
+			{
+				GroupSolveTime = 0;
+			}
+
 			// @todo(chaos): Remove SolveParallelFor when SolveParallelTasks has been thoroughly tested
 			const bool bSingleThreaded = GSingleThreadedPhysics || (IslandGroups.Num() == 1);
 			const int32 ParallelMode = bSingleThreaded ? 0 : CVars::GIslandGroupsParallelMode;
@@ -571,6 +618,8 @@ namespace Chaos
 	#if CSV_PROFILER_STATS
 			FIslandGroupStats FlattenedStats = FIslandGroupStats::Flatten(GroupStats);
 			FlattenedStats.ReportStats();
+
+			CSV_CUSTOM_STAT(PhysicsVerbose, IslandGroupSolveImbalance, GetGroupSolveImbalance(), ECsvCustomStatOp::Set);
 	#endif
 		}
 	}	// namespace Private
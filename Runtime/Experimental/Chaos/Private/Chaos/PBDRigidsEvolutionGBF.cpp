@@ -575,6 +575,7 @@ void FPBDRigidsEvolutionGBF::AdvanceOneTimeStepImpl(const FReal Dt, const FSubSt
 
 		{
 			CVD_SCOPE_TRACE_SOLVER_STEP(CVDDC_CollisionDetectionBroadPhase, TEXT("Collision Detection Broad Phase"));
+			CHAOS_SCOPED_TIMER(BroadPhase);
 			CollisionDetector.RunBroadPhase(Dt, GetCurrentStepResimCache());
 		}
 
@@ -586,6 +587,7 @@ void FPBDRigidsEvolutionGBF::AdvanceOneTimeStepImpl(const FReal Dt, const FSubSt
 
 		{
 			CVD_SCOPE_TRACE_SOLVER_STEP(CVDDC_CollisionDetectionNarrowPhase, TEXT("Collision Detection Narrow Phase"));
+			CHAOS_SCOPED_TIMER(NarrowPhase);
 			CollisionDetector.RunNarrowPhase(Dt, GetCurrentStepResimCache());
 		}
 	}
@@ -633,11 +635,13 @@ void FPBDRigidsEvolutionGBF::AdvanceOneTimeStepImpl(const FReal Dt, const FSubSt
 	{
 		SCOPE_CYCLE_COUNTER(STAT_Evolution_CreateConstraintGraph);
 		CSV_SCOPED_TIMING_STAT(PhysicsVerbose, StepSolver_CreateConstraintGraph);
+		CHAOS_SCOPED_TIMER(CreateConstraintGraph);
 		CreateConstraintGraph();
 	}
 	{
 		SCOPE_CYCLE_COUNTER(STAT_Evolution_CreateIslands);
 		CSV_SCOPED_TIMING_STAT(PhysicsVerbose, StepSolver_CreateIslands);
+		CHAOS_SCOPED_TIMER(CreateIslands);
 		CreateIslands();
 	}
 	{
@@ -672,6 +676,7 @@ void FPBDRigidsEvolutionGBF::AdvanceOneTimeStepImpl(const FReal Dt, const FSubSt
 	{
 		SCOPE_CYCLE_COUNTER(STAT_Evolution_BuildGroups);
 		CSV_SCOPED_TIMING_STAT(PhysicsVerbose, StepSolver_BuildGroups);
+		CHAOS_SCOPED_TIMER(BuildGroups);
 
 		// If we are resimulating, only build island groups for islands that require to be simulated based of particles sync state and resim type
 		NumGroups = IslandGroupManager.BuildGroups(bIsResim);
@@ -688,6 +693,7 @@ void FPBDRigidsEvolutionGBF::AdvanceOneTimeStepImpl(const FReal Dt, const FSubSt
 		{
 			SCOPE_CYCLE_COUNTER(STAT_Evolution_ParallelSolve);
 			CSV_SCOPED_TIMING_STAT(PhysicsVerbose, StepSolver_PerIslandSolve);
+			CHAOS_SCOPED_TIMER(Solve);
 
 			IslandGroupManager.Solve(Dt);
 		}
@@ -29,6 +29,10 @@ namespace Chaos
 	bool TriMeshPerPolySupport = 1;
 	FAutoConsoleVariableRef CVarPerPolySupport(TEXT("p.Chaos.TriMeshPerPolySupport"), TriMeshPerPolySupport, TEXT("Disabling removes memory cost of vertex map on triangle mesh. Note: Changing at runtime will not work."));
 
+	// Only affects BVHs built after the change, cooked trimeshes keep the layout they were saved with
+	bool bChaos_TriMeshBVH_Quantize = false;
+	FAutoConsoleVariableRef CVarChaos_TriMeshBVH_Quantize(TEXT("p.Chaos.TriMeshBVH.Quantize"), bChaos_TriMeshBVH_Quantize, TEXT("Store triangle mesh BVH bounds as 16 bit values relative to their parent, reducing the BVH memory by more than half at a small decode cost per node visited."));
+
 	FReal GetWindingOrder(const FVec3& Scale)
 	{
 		const FVec3 SignVector = Scale.GetSignVector();
@@ -802,6 +806,164 @@ TArray<int32> FTrimeshBVH::FindAllIntersections (const FAABB3& Intersection) con
 	return Results;
 }
 
+void FTrimeshBVH::Reset()
+{
+	Nodes.Reset();
+	FaceBounds.Reset();
+	QuantizedRootBounds = FAABBVectorized();
+	QuantizedNodes.Reset();
+	QuantizedFaceBounds.Reset();
+	bQuantized = false;
+}
+
+namespace
+{
+	// Quantize Bounds against Frame, rounding outwards so that the decoded bounds contain Bounds. Only writes xyz.
+	void QuantizeBounds(const FTrimeshBVH::FQuantizedFrame& Frame, const FAABBVectorized& Bounds, uint16* OutMin, uint16* OutMax)
+	{
+		alignas(16) FRealSingle FrameMin[4];
+		alignas(16) FRealSingle FrameScale[4];
+		alignas(16) FRealSingle BoundsMin[4];
+		alignas(16) FRealSingle BoundsMax[4];
+		VectorStoreAligned(Frame.Min, FrameMin);
+		VectorStoreAligned(Frame.Scale, FrameScale);
+		VectorStoreAligned(Bounds.GetMin(), BoundsMin);
+		VectorStoreAligned(Bounds.GetMax(), BoundsMax);
+
+		constexpr int32 Range = FTrimeshBVH::QuantizedRange;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const FRealSingle InvScale = FrameScale[Axis] > 0 ? 1.0f / FrameScale[Axis] : 0.0f;
+			OutMin[Axis] = uint16(FMath::Clamp(FMath::FloorToInt32((BoundsMin[Axis] - FrameMin[Axis]) * InvScale), 0, Range));
+			OutMax[Axis] = uint16(FMath::Clamp(FMath::CeilToInt32((BoundsMax[Axis] - FrameMin[Axis]) * InvScale), 0, Range));
+		}
+
+		// Decoding rounds differently from the estimate above, step outwards until it contains the original bounds
+		for (int32 Iteration = 0; Iteration < 4; ++Iteration)
+		{
+			alignas(16) FRealSingle DecodedMin[4];
+			alignas(16) FRealSingle DecodedMax[4];
+			const FAABBVectorized Decoded = Frame.Decode(OutMin, OutMax);
+			VectorStoreAligned(Decoded.GetMin(), DecodedMin);
+			VectorStoreAligned(Decoded.GetMax(), DecodedMax);
+
+			bool bContained = true;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (DecodedMin[Axis] > BoundsMin[Axis] && OutMin[Axis] > 0)
+				{
+					--OutMin[Axis];
+					bContained = false;
+				}
+				if (DecodedMax[Axis] < BoundsMax[Axis] && OutMax[Axis] < Range)
+				{
+					++OutMax[Axis];
+					bContained = false;
+				}
+			}
+
+			if (bContained)
+			{
+				break;
+			}
+		}
+	}
+}
+
+bool FTrimeshBVH::Quantize()
+{
+	if (bQuantized)
+	{
+		return true;
+	}
+
+	// Check that every child fits the packed index
+	constexpr uint32 MaxPackedChildIndex = TNumericLimits<uint32>::Max() >> QuantizedFaceCountBits;
+	FAABBVectorized RootBounds;
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		for (int32 ChildIndex = 0; ChildIndex < 2; ++ChildIndex)
+		{
+			const FChildData& ChildData = Nodes[NodeIndex].Children;
+			const int32 ChildOrFaceIndex = ChildData.GetChildOrFaceIndex(ChildIndex);
+			if (ChildOrFaceIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			if (uint32(ChildOrFaceIndex) >= MaxPackedChildIndex || uint32(ChildData.GetFaceCount(ChildIndex)) > QuantizedFaceCountMask)
+			{
+				return false;
+			}
+
+			if (NodeIndex == 0)
+			{
+				const FAABBVectorized& ChildBounds = ChildData.GetBounds(ChildIndex);
+				RootBounds = FAABBVectorized(VectorMin(RootBounds.GetMin(), ChildBounds.GetMin()), VectorMax(RootBounds.GetMax(), ChildBounds.GetMax()));
+			}
+		}
+	}
+
+	QuantizedRootBounds = RootBounds;
+	QuantizedNodes.SetNumZeroed(Nodes.Num());
+	QuantizedFaceBounds.SetNumZeroed(FaceBounds.Num() * QuantizedFaceStride + 2);
+
+	if (Nodes.Num() > 0)
+	{
+		// Top down, so that every child is quantized against its parent's bounds as traversal will decode them
+		struct FStackEntry
+		{
+			FQuantizedFrame Frame;
+			int32 NodeIndex;
+		};
+		TArray<FStackEntry> NodeStack;
+		NodeStack.Push({ FQuantizedFrame(QuantizedRootBounds), 0 });
+		while (NodeStack.Num())
+		{
+			const FStackEntry Entry = NodeStack.Pop(EAllowShrinking::No);
+			const FChildData& ChildData = Nodes[Entry.NodeIndex].Children;
+			for (int32 ChildIndex = 0; ChildIndex < 2; ++ChildIndex)
+			{
+				FQuantizedChildData& QuantizedChild = QuantizedNodes[Entry.NodeIndex].Children[ChildIndex];
+				const int32 ChildOrFaceIndex = ChildData.GetChildOrFaceIndex(ChildIndex);
+				if (ChildOrFaceIndex == INDEX_NONE)
+				{
+					QuantizedChild.SetPackedIndex(QuantizedEmptyChild);
+					continue;
+				}
+
+				const int32 FaceCount = ChildData.GetFaceCount(ChildIndex);
+				QuantizeBounds(Entry.Frame, ChildData.GetBounds(ChildIndex), QuantizedChild.Min, QuantizedChild.Max);
+				QuantizedChild.SetPackedIndex((uint32(ChildOrFaceIndex) << QuantizedFaceCountBits) | uint32(FaceCount));
+
+				const FQuantizedFrame ChildFrame(Entry.Frame.Decode(QuantizedChild.Min, QuantizedChild.Max));
+				if (FaceCount > 0)
+				{
+					for (int32 FaceIndex = ChildOrFaceIndex; FaceIndex < ChildOrFaceIndex + FaceCount; ++FaceIndex)
+					{
+						uint16* QuantizedBounds = &QuantizedFaceBounds[FaceIndex * QuantizedFaceStride];
+						QuantizeBounds(ChildFrame, FaceBounds[FaceIndex], QuantizedBounds, QuantizedBounds + 3);
+					}
+				}
+				else
+				{
+					NodeStack.Push({ ChildFrame, ChildOrFaceIndex });
+				}
+			}
+		}
+	}
+
+	Nodes.Empty();
+	FaceBounds.Empty();
+	bQuantized = true;
+	return true;
+}
+
+SIZE_T FTrimeshBVH::GetAllocatedSize() const
+{
+	return Nodes.GetAllocatedSize() + FaceBounds.GetAllocatedSize() + QuantizedNodes.GetAllocatedSize() + QuantizedFaceBounds.GetAllocatedSize();
+}
+
 
 FReal FTriangleMeshImplicitObject::PhiWithNormal(const FVec3& x, FVec3& Normal) const
 {
@@ -2144,8 +2306,7 @@ void FTriangleMeshImplicitObject::RebuildFastBVHFromTree(const BVHType& TreeBVH)
 	const TArray<NodeType>& Nodes = TreeBVH.GetNodes();
 	const TArray<LeafType>& Leaves = TreeBVH.GetLeaves();
 
-	FastBVH.Nodes.Reset();
-	FastBVH.FaceBounds.Reset();
+	FastBVH.Reset();
 
 	int32 FaceNum = 0;
 	TArray<TVec3<FTrimeshIndexBuffer::LargeIdxType>> LargeIndices;
@@ -2209,6 +2370,10 @@ void FTriangleMeshImplicitObject::RebuildFastBVHFromTree(const BVHType& TreeBVH)
 		{
 			MElements.Reinitialize(MoveTemp(SmallIndices));
 		}
+		if (bChaos_TriMeshBVH_Quantize)
+		{
+			FastBVH.Quantize();
+		}
 		return;
 	}
 	
@@ -2325,6 +2490,11 @@ void FTriangleMeshImplicitObject::RebuildFastBVHFromTree(const BVHType& TreeBVH)
 	{
 		MElements.Reinitialize(MoveTemp(SmallIndices));
 	}
+
+	if (bChaos_TriMeshBVH_Quantize)
+	{
+		FastBVH.Quantize();
+	}
 }
 	
 }
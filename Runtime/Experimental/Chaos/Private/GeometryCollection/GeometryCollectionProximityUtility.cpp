@@ -8,6 +8,7 @@
 #include "GeometryCollection/GeometryCollectionConvexUtility.h"
 #include "Chaos/Convex.h"
 #include "Chaos/GJK.h"
+#include "Chaos/GJKBatch.h"
 #include "CompGeom/ConvexHull3.h"
 #include "VectorUtil.h"
 
@@ -462,10 +463,18 @@ void BuildProximityFromConvexHulls(FGeometryCollection* Collection, const UE::Ge
 		}
 	}
 
+	// Hull pairs that pass the bounds test are queued per geometry and run through GJK together, batched when there are enough of them
+	using FHullPair = Chaos::TGJKDistanceBatchPair<Chaos::TGJKShape<Chaos::FConvex>, Chaos::TGJKShape<Chaos::FConvex>>;
+	constexpr int32 MinBatchedHullPairs = 4;
+	TArray<FHullPair> HullPairs;
+	TArray<int32> HullPairOtherGeoIdx;
+
 	TArray<int32> HullIndices;
 	for (int32 GeoIdx = 0; GeoIdx < NumGeometry; ++GeoIdx)
 	{
 		int32 TransformIdx = Collection->TransformIndex[GeoIdx];
+		HullPairs.Reset();
+		HullPairOtherGeoIdx.Reset();
 		for (int32 HullIdx : HullData.TransformToHullsIndices[TransformIdx])
 		{
 			const Chaos::FConvex& Hull = *HullData.Hulls[HullIdx];
@@ -486,22 +495,39 @@ void BuildProximityFromConvexHulls(FGeometryCollection* Collection, const UE::Ge
 					//	const VectorRegister4Float InitialDirSimd = MakeVectorRegisterFloat(1.f, 0.f, 0.f, 0.f);
 					//	if (GJKIntersectionSameSpaceSimd(Hull, CandidateHull, DistanceThreshold, InitialDirSimd))
 
-					Chaos::FReal Distance;
-					Chaos::TVec3<Chaos::FReal> NearestA, NearestB, Normal; // All unused
-					Chaos::EGJKDistanceResult Result = Chaos::GJKDistance<Chaos::FReal>(
+					HullPairs.Emplace(
 						Chaos::TGJKShape(Hull),
 						Chaos::TGJKShape(CandidateHull),
-						Chaos::GJKDistanceInitialVFromDirection(Hull, CandidateHull, CandidateHull.GetCenterOfMass() - Hull.GetCenterOfMass()),
-						Distance, NearestA, NearestB, Normal);
-					if (Result == Chaos::EGJKDistanceResult::Contact || Result == Chaos::EGJKDistanceResult::DeepContact
-						|| (Result == Chaos::EGJKDistanceResult::Separated && Distance <= DistanceThreshold))
-					{
-						Proximity[GeoIdx].Add(OtherGeoIdx);
-						Proximity[OtherGeoIdx].Add(GeoIdx);
-					}
+						Chaos::GJKDistanceInitialVFromDirection(Hull, CandidateHull, CandidateHull.GetCenterOfMass() - Hull.GetCenterOfMass()));
+					HullPairOtherGeoIdx.Add(OtherGeoIdx);
 				}
 			}
 		}
+
+		if (HullPairs.Num() >= MinBatchedHullPairs)
+		{
+			Chaos::GJKDistanceBatch<4>(MakeArrayView(HullPairs));
+		}
+		else
+		{
+			for (FHullPair& HullPair : HullPairs)
+			{
+				HullPair.Result = Chaos::GJKDistance<Chaos::FReal>(HullPair.A, HullPair.B, HullPair.InitialV, HullPair.Distance, HullPair.NearestA, HullPair.NearestB, HullPair.NormalA);
+			}
+		}
+
+		for (int32 PairIdx = 0; PairIdx < HullPairs.Num(); ++PairIdx)
+		{
+			const FHullPair& HullPair = HullPairs[PairIdx];
+			if (HullPair.Result == Chaos::EGJKDistanceResult::Contact || HullPair.Result == Chaos::EGJKDistanceResult::DeepContact
+				|| (HullPair.Result == Chaos::EGJKDistanceResult::Separated && HullPair.Distance <= DistanceThreshold))
+			{
+				const int32 OtherGeoIdx = HullPairOtherGeoIdx[PairIdx];
+				Proximity[GeoIdx].Add(OtherGeoIdx);
+				Proximity[OtherGeoIdx].Add(GeoIdx);
+			}
+		}
+
 		// add all the hulls for a given geometry after intersection-testing them with the hulls already in the octree
 		for (int32 HullIdx : HullData.TransformToHullsIndices[TransformIdx])
 		{
@@ -144,6 +144,14 @@ bool FJointStateBase::IsInSync(const FPBDJointConstraintHandle& Handle, const FF
 bool bCVarRewindDataOptimization = true;
 FAutoConsoleVariableRef CVarRewindDataOptimization(TEXT("p.Resim.RewindDataOptimization"), bCVarRewindDataOptimization, TEXT("Default value for RewinData optimization, note that this can be overridden at runtime by API calls. Effect: Only alter the minimum required properties during a resim for particles not marked for FullResim and only cache data during the PostPushData phase and lower memory allocation for the history cache to 1/3 of non-optimized flow."));
 
+bool bResimDeltaCompressHistory = false;
+FAutoConsoleVariableRef CVarResimDeltaCompressHistory(TEXT("p.Resim.DeltaCompressHistory"), bResimDeltaCompressHistory, TEXT("Store the position and velocity history of particles as lossless deltas from keyframes instead of full values. Lowers history memory at the cost of decoding on reads. Only affects particles that start recording history after the change."));
+
+bool ShouldDeltaCompressRewindHistory()
+{
+	return bResimDeltaCompressHistory;
+}
+
 FRewindData::FRewindData(FPBDRigidsSolver* InSolver, int32 NumFrames, bool InRewindDataOptimization, int32 InCurrentFrame)
 	: Managers(NumFrames + 1)	//give 1 extra for saving at head
 	, Solver(InSolver)
@@ -0,0 +1,390 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Chaos/AABBTree.h"
+#include "Chaos/ChaosArchive.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Chaos::AABBTreeQueryTests
+{
+	struct FBoxEntry
+	{
+		FAABB3 Bounds;
+
+		bool HasBoundingBox() const { return true; }
+		const FAABB3& BoundingBox() const { return Bounds; }
+
+		template <typename TPayloadType>
+		int32 GetPayload(int32 Idx) const { return Idx; }
+	};
+
+	using FBoxTree = TAABBTree<int32, TAABBTreeLeafArray<int32>>;
+
+	struct FClosestHit
+	{
+		FReal TOI = TNumericLimits<FReal>::Max();
+		int32 BoxIndex = INDEX_NONE;
+	};
+
+	/** Keeps the closest box hit by each query. Single queries use it through TSpatialBatchQueryVisitor so both paths do the same work per hit. */
+	struct FClosestHitVisitor
+	{
+		FClosestHitVisitor(const TArray<FBoxEntry>& InBoxes, TArrayView<const FAABBTreeBatchQuery> InQueries)
+			: Boxes(InBoxes)
+			, Queries(InQueries)
+		{
+			Hits.SetNum(Queries.Num());
+		}
+
+		bool VisitRaycast(int32 QueryIndex, const TSpatialVisitorData<int32>& Instance, FQueryFastData& CurData)
+		{
+			return Visit(QueryIndex, Instance.Payload, Boxes[Instance.Payload].Bounds, CurData);
+		}
+
+		bool VisitSweep(int32 QueryIndex, const TSpatialVisitorData<int32>& Instance, FQueryFastData& CurData)
+		{
+			const FAABB3& Bounds = Boxes[Instance.Payload].Bounds;
+			const FVec3& HalfExtents = Queries[QueryIndex].HalfExtents;
+			return Visit(QueryIndex, Instance.Payload, FAABB3(Bounds.Min() - HalfExtents, Bounds.Max() + HalfExtents), CurData);
+		}
+
+		bool ShouldIgnore(int32 QueryIndex, const TSpatialVisitorData<int32>& Instance) const { return false; }
+		const void* GetQueryData() const { return nullptr; }
+		const void* GetSimData() const { return nullptr; }
+
+		bool Visit(int32 QueryIndex, int32 BoxIndex, const FAABB3& Bounds, FQueryFastData& CurData)
+		{
+			FReal EntryTime, ExitTime;
+			if (Bounds.RaycastFast(Queries[QueryIndex].Start, CurData.Dir, CurData.InvDir, CurData.bParallel, CurData.CurrentLength, CurData.InvCurrentLength, EntryTime, ExitTime)
+				&& EntryTime < Hits[QueryIndex].TOI)
+			{
+				Hits[QueryIndex] = FClosestHit{ EntryTime, BoxIndex };
+
+				// Only look for closer hits from now on
+				CurData.SetLength(FMath::Max(EntryTime, (FReal)UE_KINDA_SMALL_NUMBER));
+			}
+			return true;
+		}
+
+		const TArray<FBoxEntry>& Boxes;
+		TArrayView<const FAABBTreeBatchQuery> Queries;
+		TArray<FClosestHit> Hits;
+	};
+
+	/** Props scattered over a 20km square */
+	static TArray<FBoxEntry> MakeScene(FRandomStream& Random, int32 NumBoxes)
+	{
+		TArray<FBoxEntry> Boxes;
+		Boxes.Reserve(NumBoxes);
+		for (int32 Index = 0; Index < NumBoxes; ++Index)
+		{
+			const FVec3 Center(Random.FRandRange(-10000, 10000), Random.FRandRange(-10000, 10000), Random.FRandRange(0, 500));
+			const FVec3 HalfSize(Random.FRandRange(25, 200), Random.FRandRange(25, 200), Random.FRandRange(25, 300));
+			Boxes.Add(FBoxEntry{ FAABB3(Center - HalfSize, Center + HalfSize) });
+		}
+		return Boxes;
+	}
+
+	/** Line of sight checks from agents to targets up to 5000 units away */
+	static TArray<FAABBTreeBatchQuery> MakeQueries(FRandomStream& Random, int32 NumQueries, const FVec3& HalfExtents)
+	{
+		TArray<FAABBTreeBatchQuery> Queries;
+		Queries.Reserve(NumQueries);
+		for (int32 Index = 0; Index < NumQueries; ++Index)
+		{
+			FAABBTreeBatchQuery& Query = Queries.AddDefaulted_GetRef();
+			Query.Start = FVec3(Random.FRandRange(-10000, 10000), Random.FRandRange(-10000, 10000), 150);
+			const FVec3 Delta(Random.FRandRange(-5000, 5000), Random.FRandRange(-5000, 5000), Random.FRandRange(-100, 100));
+			Query.Length = Delta.Size();
+			Query.Dir = Delta / Query.Length;
+			Query.HalfExtents = HalfExtents;
+		}
+		return Queries;
+	}
+
+	static void RunSingleQueries(const FBoxTree& Tree, TArrayView<const FAABBTreeBatchQuery> Queries, FClosestHitVisitor& Visitor, bool bSweep)
+	{
+		for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); ++QueryIndex)
+		{
+			const FAABBTreeBatchQuery& Query = Queries[QueryIndex];
+			TSpatialBatchQueryVisitor<int32, FClosestHitVisitor> QueryVisitor(Visitor, QueryIndex);
+			if (bSweep)
+			{
+				Tree.Sweep(Query.Start, Query.Dir, Query.Length, Query.HalfExtents, QueryVisitor);
+			}
+			else
+			{
+				Tree.Raycast(Query.Start, Query.Dir, Query.Length, QueryVisitor);
+			}
+		}
+	}
+
+	static void RunBatchQueries(const FBoxTree& Tree, TArrayView<const FAABBTreeBatchQuery> Queries, FClosestHitVisitor& Visitor, bool bSweep)
+	{
+		if (bSweep)
+		{
+			Tree.SweepBatch(Queries, Visitor);
+		}
+		else
+		{
+			Tree.RaycastBatch(Queries, Visitor);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAABBTreeBatchQueryTest, "Physics.AABBTree.BatchQuery", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FAABBTreeBatchQueryTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::AABBTreeQueryTests;
+
+	FRandomStream Random(1234);
+	const TArray<FBoxEntry> Boxes = MakeScene(Random, 4096);
+
+	for (const bool bDynamicTree : { false, true })
+	{
+		const FBoxTree Tree(Boxes, FBoxTree::DefaultMaxChildrenInLeaf, FBoxTree::DefaultMaxTreeDepth, FBoxTree::DefaultMaxPayloadBounds, FBoxTree::DefaultMaxNumToProcess, bDynamicTree);
+
+		for (const bool bSweep : { false, true })
+		{
+			// Not a multiple of the packet size, so the last packet has unused lanes
+			const TArray<FAABBTreeBatchQuery> Queries = MakeQueries(Random, 1027, bSweep ? FVec3(30, 30, 90) : FVec3(0));
+
+			FClosestHitVisitor SingleVisitor(Boxes, Queries);
+			RunSingleQueries(Tree, Queries, SingleVisitor, bSweep);
+
+			FClosestHitVisitor BatchVisitor(Boxes, Queries);
+			RunBatchQueries(Tree, Queries, BatchVisitor, bSweep);
+
+			// Boxes hit at the same time can be reported in either order, compare the times of the closest hits
+			int32 NumHits = 0;
+			int32 NumMismatches = 0;
+			for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); ++QueryIndex)
+			{
+				const FClosestHit& Single = SingleVisitor.Hits[QueryIndex];
+				const FClosestHit& Batch = BatchVisitor.Hits[QueryIndex];
+				NumHits += Single.BoxIndex != INDEX_NONE;
+				if ((Single.BoxIndex != INDEX_NONE) != (Batch.BoxIndex != INDEX_NONE) || !FMath::IsNearlyEqual(Single.TOI, Batch.TOI, (FReal)UE_KINDA_SMALL_NUMBER))
+				{
+					++NumMismatches;
+				}
+			}
+
+			const FString Context = FString::Printf(TEXT("%s %s"), bDynamicTree ? TEXT("Dynamic tree") : TEXT("Static tree"), bSweep ? TEXT("sweeps") : TEXT("raycasts"));
+			TestTrue(FString::Printf(TEXT("%s hit some boxes"), *Context), NumHits > 0 && NumHits < Queries.Num());
+			TestEqual(FString::Printf(TEXT("%s batch hits match single hits"), *Context), NumMismatches, 0);
+		}
+	}
+
+	// Empty batches and empty trees
+	const FBoxTree EmptyTree(TArray<FBoxEntry>{});
+	const TArray<FAABBTreeBatchQuery> Queries = MakeQueries(Random, 3, FVec3(0));
+	FClosestHitVisitor Visitor(Boxes, Queries);
+	EmptyTree.RaycastBatch(Queries, Visitor);
+	EmptyTree.RaycastBatch({}, Visitor);
+	TestEqual(TEXT("Empty tree has no hits"), Visitor.Hits[0].BoxIndex, INDEX_NONE);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAABBTreeBatchQueryPerfTest, "Physics.AABBTree.BatchQueryPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FAABBTreeBatchQueryPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::AABBTreeQueryTests;
+
+	const int32 NumBoxes = 65536;
+	const int32 NumQueries = 16384;
+	const int32 NumIterations = 10;
+
+	FRandomStream Random(1234);
+	const TArray<FBoxEntry> Boxes = MakeScene(Random, NumBoxes);
+	const FBoxTree Tree(Boxes);
+
+	for (const bool bSweep : { false, true })
+	{
+		const TArray<FAABBTreeBatchQuery> Queries = MakeQueries(Random, NumQueries, bSweep ? FVec3(30, 30, 90) : FVec3(0));
+
+		auto Measure = [this, &Tree, &Queries, &Boxes, bSweep, NumIterations](const TCHAR* Name, decltype(&RunSingleQueries) Run)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				FClosestHitVisitor Visitor(Boxes, Queries);
+				Run(Tree, Queries, Visitor, bSweep);
+			}
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+			AddInfo(FString::Printf(TEXT("%s %s: %.2f M queries/s"), bSweep ? TEXT("Sweep") : TEXT("Raycast"), Name, double(Queries.Num()) * NumIterations / Seconds / 1.0e6));
+		};
+
+		Measure(TEXT("per query"), &RunSingleQueries);
+		Measure(TEXT("packets"), &RunBatchQueries);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAABBTreeWideNodeTest, "Physics.AABBTree.WideNodes", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FAABBTreeWideNodeTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::AABBTreeQueryTests;
+
+	FRandomStream Random(4321);
+	const TArray<FBoxEntry> Boxes = MakeScene(Random, 4096);
+
+	const FBoxTree BinaryTree(Boxes);
+	FBoxTree WideTree(Boxes);
+	WideTree.SetUseWideNodes(true);
+
+	// Copies keep the wide nodes
+	const FBoxTree CopiedTree(WideTree);
+	TestTrue(TEXT("Copy uses wide nodes"), CopiedTree.GetUseWideNodes());
+
+	// So do saved and loaded trees
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	{
+		FChaosArchive WriterAr(Writer);
+		WriterAr << WideTree;
+	}
+
+	FBoxTree LoadedTree;
+	FMemoryReader Reader(Data);
+	Reader.SetCustomVersions(Writer.GetCustomVersions());
+	{
+		FChaosArchive ReaderAr(Reader);
+		ReaderAr << LoadedTree;
+	}
+	TestTrue(TEXT("Loaded tree uses wide nodes"), LoadedTree.GetUseWideNodes());
+
+	for (const bool bSweep : { false, true })
+	{
+		const TArray<FAABBTreeBatchQuery> Queries = MakeQueries(Random, 1024, bSweep ? FVec3(30, 30, 90) : FVec3(0));
+
+		FClosestHitVisitor BinaryVisitor(Boxes, Queries);
+		RunSingleQueries(BinaryTree, Queries, BinaryVisitor, bSweep);
+
+		for (const FBoxTree* Tree : { &WideTree, &CopiedTree, &LoadedTree })
+		{
+			FClosestHitVisitor WideVisitor(Boxes, Queries);
+			RunSingleQueries(*Tree, Queries, WideVisitor, bSweep);
+
+			int32 NumMismatches = 0;
+			for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); ++QueryIndex)
+			{
+				const FClosestHit& Binary = BinaryVisitor.Hits[QueryIndex];
+				const FClosestHit& Wide = WideVisitor.Hits[QueryIndex];
+				if ((Binary.BoxIndex != INDEX_NONE) != (Wide.BoxIndex != INDEX_NONE) || !FMath::IsNearlyEqual(Binary.TOI, Wide.TOI, (FReal)UE_KINDA_SMALL_NUMBER))
+				{
+					++NumMismatches;
+				}
+			}
+			TestEqual(FString::Printf(TEXT("Wide node %s match binary nodes"), bSweep ? TEXT("sweeps") : TEXT("raycasts")), NumMismatches, 0);
+		}
+	}
+
+	int32 NumMismatches = 0;
+	for (int32 Index = 0; Index < 256; ++Index)
+	{
+		const FVec3 Center(Random.FRandRange(-10000, 10000), Random.FRandRange(-10000, 10000), Random.FRandRange(0, 500));
+		const FAABB3 QueryBounds(Center - FVec3(500), Center + FVec3(500));
+
+		TArray<int32> BinaryHits = BinaryTree.FindAllIntersections(QueryBounds);
+		TArray<int32> WideHits = WideTree.FindAllIntersections(QueryBounds);
+		BinaryHits.Sort();
+		WideHits.Sort();
+		NumMismatches += BinaryHits != WideHits;
+	}
+	TestEqual(TEXT("Wide node overlaps match binary nodes"), NumMismatches, 0);
+
+	// Turning the wide nodes off goes back to the binary nodes
+	WideTree.SetUseWideNodes(false);
+	TestFalse(TEXT("Wide nodes disabled"), WideTree.GetUseWideNodes());
+	TestEqual(TEXT("Binary overlap after disabling wide nodes"), WideTree.FindAllIntersections(FAABB3(FVec3(-20000), FVec3(20000))).Num(), Boxes.Num());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAABBTreeWideNodePerfTest, "Physics.AABBTree.WideNodesPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FAABBTreeWideNodePerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::AABBTreeQueryTests;
+
+	const int32 NumBoxes = 65536;
+	const int32 NumQueries = 16384;
+	const int32 NumIterations = 10;
+
+	FRandomStream Random(4321);
+	const TArray<FBoxEntry> Boxes = MakeScene(Random, NumBoxes);
+	const TArray<FAABBTreeBatchQuery> Raycasts = MakeQueries(Random, NumQueries, FVec3(0));
+	const TArray<FAABBTreeBatchQuery> Sweeps = MakeQueries(Random, NumQueries, FVec3(30, 30, 90));
+
+	// Broadphase style overlaps, the bounds of a moving body
+	TArray<FAABB3> Overlaps;
+	Overlaps.Reserve(NumQueries);
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		const FVec3 Center(Random.FRandRange(-10000, 10000), Random.FRandRange(-10000, 10000), Random.FRandRange(0, 500));
+		Overlaps.Add(FAABB3(Center - FVec3(100), Center + FVec3(100)));
+	}
+
+	for (const bool bWideNodes : { false, true })
+	{
+		FBoxTree Tree(Boxes);
+		Tree.SetUseWideNodes(bWideNodes);
+
+		auto Measure = [this, bWideNodes, NumIterations, NumQueries](const TCHAR* Name, TFunctionRef<void()> Run)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				Run();
+			}
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+			AddInfo(FString::Printf(TEXT("%s %s: %.2f M queries/s"), bWideNodes ? TEXT("Wide nodes") : TEXT("Binary nodes"), Name, double(NumQueries) * NumIterations / Seconds / 1.0e6));
+		};
+
+		Measure(TEXT("raycast"), [&Tree, &Boxes, &Raycasts]()
+		{
+			FClosestHitVisitor Visitor(Boxes, Raycasts);
+			RunSingleQueries(Tree, Raycasts, Visitor, false);
+		});
+
+		Measure(TEXT("sweep"), [&Tree, &Boxes, &Sweeps]()
+		{
+			FClosestHitVisitor Visitor(Boxes, Sweeps);
+			RunSingleQueries(Tree, Sweeps, Visitor, true);
+		});
+
+		Measure(TEXT("overlap"), [&Tree, &Overlaps]()
+		{
+			for (const FAABB3& Bounds : Overlaps)
+			{
+				Tree.FindAllIntersections(Bounds);
+			}
+		});
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
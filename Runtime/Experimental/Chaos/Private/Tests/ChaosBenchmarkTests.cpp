@@ -0,0 +1,947 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Async/Fundamental/Scheduler.h"
+#include "Chaos/Box.h"
+#include "Chaos/Capsule.h"
+#include "Chaos/ChaosPerfTest.h"
+#include "Chaos/Collision/CollisionConstraintAllocator.h"
+#include "Chaos/Collision/PBDCollisionContainerSolver.h"
+#include "Chaos/Convex.h"
+#include "Chaos/Evolution/SolverBodyContainer.h"
+#include "Chaos/Framework/Parallel.h"
+#include "Chaos/HeightField.h"
+#include "Chaos/ImplicitObjectUnion.h"
+#include "Chaos/PBDJointConstraints.h"
+#include "Chaos/PBDRigidsEvolutionGBF.h"
+#include "Chaos/Sphere.h"
+#include "Chaos/TriangleMeshImplicitObject.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Chaos
+{
+	extern bool bChaos_Collision_PersistentManifold;
+	extern int32 Chaos_Collision_PersistentManifold_MaxRestores;
+}
+
+namespace Chaos::CVars
+{
+	extern bool GIslandGroupsColoringEnabled;
+	extern int32 GIslandGroupsColoringMinConstraints;
+	extern bool bChaos_Collision_MidPhase_EnableConvexBatchCull;
+	extern int32 Chaos_Collision_MidPhase_ConvexBatchCullMinPairs;
+}
+
+namespace Chaos::BenchmarkTests
+{
+	/** An evolution with its particles and a single material, stepped directly without a solver or game thread */
+	struct FBenchmarkScene
+	{
+		FParticleUniqueIndicesMultithreaded UniqueIndices;
+		FPBDRigidsSOAs Particles;
+		THandleArray<FChaosPhysicsMaterial> PhysicsMaterials;
+		TUniquePtr<FChaosPhysicsMaterial> Material;
+		FPBDRigidsEvolutionGBF Evolution;
+		TArray<FPBDRigidParticleHandle*> Dynamics;
+
+		FBenchmarkScene()
+			: Particles(UniqueIndices)
+			, Material(MakeUnique<FChaosPhysicsMaterial>())
+			, Evolution(Particles, PhysicsMaterials)
+		{
+			// Nothing sleeps, so every measured step does the full amount of work
+			Material->SleepingLinearThreshold = 0;
+			Material->SleepingAngularThreshold = 0;
+		}
+
+		static void EnableSimCollision(FGeometryParticleHandle* Particle, bool bComplex)
+		{
+			// Collide with every channel
+			FCollisionFilterData SimData;
+			SimData.Word1 = 0xFFFF;
+			SimData.Word3 = 0xFFFF;
+
+			for (const TUniquePtr<FPerShapeData>& Shape : Particle->ShapesArray())
+			{
+				Shape->SetSimData(SimData);
+				if (bComplex)
+				{
+					Shape->SetCollisionTraceType(EChaosCollisionTraceFlag::Chaos_CTF_UseComplexAsSimple);
+				}
+			}
+		}
+
+		void AddStatic(const FImplicitObjectPtr& Geometry, const FRigidTransform3& Transform, bool bComplex = false)
+		{
+			FGeometryParticleHandle* Particle = Evolution.CreateStaticParticles(1)[0];
+			Particle->SetX(Transform.GetTranslation());
+			Particle->SetR(Transform.GetRotation());
+			Particle->SetGeometry(Geometry);
+			EnableSimCollision(Particle, bComplex);
+			Evolution.SetPhysicsMaterial(Particle, MakeSerializable(Material));
+			Evolution.RegisterParticle(Particle);
+		}
+
+		/** Adds a body with the density of water. Inertia is the diagonal for a unit mass */
+		FPBDRigidParticleHandle* AddDynamic(const FImplicitObjectPtr& Geometry, FReal Volume, const FVec3& UnitInertia, const FRigidTransform3& Transform)
+		{
+			const FReal Mass = Volume * 0.001;
+
+			FPBDRigidParticleHandle* Particle = Evolution.CreateDynamicParticles(1)[0];
+			Particle->SetX(Transform.GetTranslation());
+			Particle->SetP(Transform.GetTranslation());
+			Particle->SetR(Transform.GetRotation());
+			Particle->SetQ(Transform.GetRotation());
+			Particle->SetV(FVec3(0));
+			Particle->SetW(FVec3(0));
+			Particle->SetM(Mass);
+			Particle->SetInvM(1 / Mass);
+			Particle->SetI(FVec3f(UnitInertia * Mass));
+			Particle->SetInvI(FVec3f(FVec3(1) / (UnitInertia * Mass)));
+			Particle->SetGeometry(Geometry);
+			EnableSimCollision(Particle, false);
+			Evolution.SetPhysicsMaterial(Particle, MakeSerializable(Material));
+			Evolution.RegisterParticle(Particle);
+			Dynamics.Add(Particle);
+			return Particle;
+		}
+
+		FPBDRigidParticleHandle* AddBox(const FVec3& HalfSize, const FRigidTransform3& Transform)
+		{
+			const FImplicitObjectPtr Box = MakeImplicitObjectPtr<FImplicitBox3>(-HalfSize, HalfSize);
+			return AddDynamic(Box, 8 * HalfSize.X * HalfSize.Y * HalfSize.Z, FImplicitBox3::GetInertiaTensor(1, 2 * HalfSize).GetDiagonal(), Transform);
+		}
+
+		FPBDRigidParticleHandle* AddSphere(FReal Radius, const FRigidTransform3& Transform)
+		{
+			const FImplicitObjectPtr Sphere = MakeImplicitObjectPtr<FImplicitSphere3>(FVec3(0), Radius);
+			return AddDynamic(Sphere, FImplicitSphere3::GetVolume(Radius), FImplicitSphere3::GetInertiaTensor(1, Radius).GetDiagonal(), Transform);
+		}
+
+		/** A capsule along the local Z axis, with HalfLength to the end of the caps */
+		FPBDRigidParticleHandle* AddCapsule(FReal HalfLength, FReal Radius, const FRigidTransform3& Transform)
+		{
+			const FReal Height = 2 * (HalfLength - Radius);
+			const FImplicitObjectPtr Capsule = MakeImplicitObjectPtr<FImplicitCapsule3>(FVec3(0, 0, -Height / 2), FVec3(0, 0, Height / 2), Radius);
+			return AddDynamic(Capsule, FImplicitCapsule3::GetVolume(Height, Radius), FImplicitCapsule3::GetInertiaTensor(1, Height, Radius).GetDiagonal(), Transform);
+		}
+
+		void AddGround(FReal HalfSize)
+		{
+			AddStatic(MakeImplicitObjectPtr<FImplicitBox3>(FVec3(-HalfSize, -HalfSize, -100), FVec3(HalfSize, HalfSize, 0)), FRigidTransform3::Identity);
+		}
+
+		void Step(FReal Dt)
+		{
+			Evolution.AdvanceOneTimeStep(Dt);
+			Evolution.EndFrame(Dt);
+		}
+
+		FReal GetLowestZ() const
+		{
+			FReal LowestZ = TNumericLimits<FReal>::Max();
+			for (const FPBDRigidParticleHandle* Particle : Dynamics)
+			{
+				LowestZ = FMath::Min(LowestZ, Particle->GetX().Z);
+			}
+			return LowestZ;
+		}
+	};
+
+	/** Towers of unit boxes, the classic stacking stability case */
+	static void BuildBoxStacks(FBenchmarkScene& Scene, int32 NumStacks, int32 StackHeight)
+	{
+		Scene.AddGround(10000);
+
+		const int32 NumPerRow = FMath::CeilToInt32(FMath::Sqrt(FReal(NumStacks)));
+		for (int32 StackIndex = 0; StackIndex < NumStacks; ++StackIndex)
+		{
+			const FVec3 Base(FReal(StackIndex % NumPerRow) * 300, FReal(StackIndex / NumPerRow) * 300, 0);
+			for (int32 Level = 0; Level < StackHeight; ++Level)
+			{
+				Scene.AddBox(FVec3(50), FRigidTransform3(Base + FVec3(0, 0, 50 + Level * 101), FRotation3::Identity));
+			}
+		}
+	}
+
+	/** Mixed small boxes, spheres and capsules dropped in a column so they collapse into one large pile */
+	static void BuildDebrisPile(FBenchmarkScene& Scene, int32 NumDebris)
+	{
+		Scene.AddGround(10000);
+
+		FRandomStream Random(1234);
+		const int32 NumPerSide = 24;
+		for (int32 Index = 0; Index < NumDebris; ++Index)
+		{
+			const int32 Layer = Index / (NumPerSide * NumPerSide);
+			const int32 Cell = Index % (NumPerSide * NumPerSide);
+			const FVec3 Position(FReal(Cell % NumPerSide - NumPerSide / 2) * 60, FReal(Cell / NumPerSide - NumPerSide / 2) * 60, 40 + Layer * 60);
+			const FRigidTransform3 Transform(Position, FRotation3::FromAxisAngle(FVec3(Random.GetUnitVector()), Random.FRandRange(0, UE_PI)));
+
+			switch (Index % 3)
+			{
+			case 0:
+				Scene.AddBox(FVec3(Random.FRandRange(8, 25), Random.FRandRange(8, 25), Random.FRandRange(8, 25)), Transform);
+				break;
+			case 1:
+				Scene.AddSphere(Random.FRandRange(10, 25), Transform);
+				break;
+			default:
+				Scene.AddCapsule(Random.FRandRange(18, 28), Random.FRandRange(6, 12), Transform);
+				break;
+			}
+		}
+	}
+
+	/** Chains of capsules joined by limited ball joints, falling across each other like a heap of ragdolls */
+	static void BuildRagdollChains(FBenchmarkScene& Scene, int32 NumChains, int32 ChainLength)
+	{
+		Scene.AddGround(10000);
+
+		const FReal HalfLength = 25;
+		const FReal Radius = 10;
+
+		// Capsules are along local Z, the chains along world X or Y
+		const FRotation3 CapsuleToJoint = FRotation3::FromRotatedVector(FVec3(1, 0, 0), FVec3(0, 0, 1));
+
+		FPBDJointSettings Settings;
+		Settings.bCollisionEnabled = false;
+		Settings.AngularMotionTypes = { EJointMotionType::Limited, EJointMotionType::Limited, EJointMotionType::Limited };
+		Settings.AngularLimits = FVec3(FMath::DegreesToRadians(20.0), FMath::DegreesToRadians(45.0), FMath::DegreesToRadians(45.0));
+		Settings.ConnectorTransforms[0] = FRigidTransform3(FVec3(0, 0, HalfLength), CapsuleToJoint);
+		Settings.ConnectorTransforms[1] = FRigidTransform3(FVec3(0, 0, -HalfLength), CapsuleToJoint);
+		Settings.Sanitize();
+
+		for (int32 ChainIndex = 0; ChainIndex < NumChains; ++ChainIndex)
+		{
+			// Alternate the chain direction per layer so the layers fall across each other
+			const bool bAlongX = (ChainIndex / 8) % 2 == 0;
+			const FVec3 Direction = bAlongX ? FVec3(1, 0, 0) : FVec3(0, 1, 0);
+			const FVec3 Across = bAlongX ? FVec3(0, 1, 0) : FVec3(1, 0, 0);
+			const FRotation3 Rotation = FRotation3::FromRotatedVector(FVec3(0, 0, 1), Direction);
+			const FVec3 Start = Across * FReal((ChainIndex % 8) * 80 - 280) - Direction * (ChainLength * HalfLength) + FVec3(0, 0, 50 + (ChainIndex / 8) * 40);
+
+			FPBDRigidParticleHandle* Parent = nullptr;
+			for (int32 LinkIndex = 0; LinkIndex < ChainLength; ++LinkIndex)
+			{
+				const FVec3 Position = Start + Direction * (HalfLength + LinkIndex * 2 * HalfLength);
+				FPBDRigidParticleHandle* Link = Scene.AddCapsule(HalfLength, Radius, FRigidTransform3(Position, Rotation));
+				if (Parent)
+				{
+					Scene.Evolution.GetJointConstraints().AddConstraint(FParticlePair(Parent, Link), Settings);
+				}
+				Parent = Link;
+			}
+		}
+	}
+
+	/** Rolling heightfield with triangle mesh ramps on top, bodies dropped over the whole area */
+	static void BuildTerrain(FBenchmarkScene& Scene, int32 NumBodies)
+	{
+		const int32 NumVertsPerSide = 129;
+		const FReal CellSize = 100;
+		const FReal HalfSize = (NumVertsPerSide - 1) * CellSize / 2;
+
+		TArray<FReal> Heights;
+		Heights.SetNumUninitialized(NumVertsPerSide * NumVertsPerSide);
+		for (int32 Row = 0; Row < NumVertsPerSide; ++Row)
+		{
+			for (int32 Col = 0; Col < NumVertsPerSide; ++Col)
+			{
+				Heights[Row * NumVertsPerSide + Col] = 150 * (FMath::Sin(Row * 0.15) + FMath::Cos(Col * 0.11));
+			}
+		}
+		TArray<uint8> MaterialIndices = { 0 };
+		Scene.AddStatic(MakeImplicitObjectPtr<FHeightField>(MoveTemp(Heights), MoveTemp(MaterialIndices), NumVertsPerSide, NumVertsPerSide, FVec3(CellSize, CellSize, 1)),
+			FRigidTransform3(FVec3(-HalfSize, -HalfSize, 0), FRotation3::Identity));
+
+		// Tilted ramps, tessellated so the midphase has many triangles to filter
+		const int32 NumRampQuads = 16;
+		const FReal RampSize = 1600;
+		for (int32 RampIndex = 0; RampIndex < 8; ++RampIndex)
+		{
+			TArray<FVec3f> Vertices;
+			for (int32 Y = 0; Y <= NumRampQuads; ++Y)
+			{
+				for (int32 X = 0; X <= NumRampQuads; ++X)
+				{
+					const FReal U = FReal(X) / NumRampQuads;
+					const FReal V = FReal(Y) / NumRampQuads;
+					Vertices.Add(FVec3f(FVec3(U * RampSize, V * RampSize, U * 400 + 50 * FMath::Sin(V * 6))));
+				}
+			}
+
+			TArray<TVec3<int32>> Triangles;
+			for (int32 Y = 0; Y < NumRampQuads; ++Y)
+			{
+				for (int32 X = 0; X < NumRampQuads; ++X)
+				{
+					const int32 V0 = Y * (NumRampQuads + 1) + X;
+					const int32 V1 = V0 + 1;
+					const int32 V2 = V0 + NumRampQuads + 1;
+					const int32 V3 = V2 + 1;
+					Triangles.Add(TVec3<int32>(V0, V1, V3));
+					Triangles.Add(TVec3<int32>(V0, V3, V2));
+				}
+			}
+
+			TArray<uint16> TriangleMaterials;
+			TriangleMaterials.SetNumZeroed(Triangles.Num());
+			const FVec3 Offset(FReal(RampIndex % 4) * 3000 - 6000, FReal(RampIndex / 4) * 6000 - 4500, 400);
+			Scene.AddStatic(MakeImplicitObjectPtr<FTriangleMeshImplicitObject>(FTriangleMeshImplicitObject::ParticlesType(MoveTemp(Vertices)), MoveTemp(Triangles), MoveTemp(TriangleMaterials)),
+				FRigidTransform3(Offset, FRotation3::Identity), true);
+		}
+
+		FRandomStream Random(5678);
+		for (int32 Index = 0; Index < NumBodies; ++Index)
+		{
+			const FVec3 Position(Random.FRandRange(-HalfSize + 500, HalfSize - 500), Random.FRandRange(-HalfSize + 500, HalfSize - 500), Random.FRandRange(1200, 2000));
+			const FRigidTransform3 Transform(Position, FRotation3::FromAxisAngle(FVec3(Random.GetUnitVector()), Random.FRandRange(0, UE_PI)));
+			if (Index % 2 == 0)
+			{
+				Scene.AddBox(FVec3(Random.FRandRange(15, 40)), Transform);
+			}
+			else
+			{
+				Scene.AddSphere(Random.FRandRange(15, 40), Transform);
+			}
+		}
+	}
+
+	/** Rods made of a union of four random hulls, dropped in a column so they collapse into one pile. Each pair of touching rods has 16 convex shape pairs. */
+	static void BuildConvexCompoundPile(FBenchmarkScene& Scene, int32 NumBodies)
+	{
+		Scene.AddGround(10000);
+
+		const int32 NumHulls = 4;
+		const FVec3 HullHalfSize(15, 12, 12);
+		const FReal Volume = NumHulls * 8 * HullHalfSize.X * HullHalfSize.Y * HullHalfSize.Z;
+		const FVec3 UnitInertia = FImplicitBox3::GetInertiaTensor(1, FVec3(2 * NumHulls * HullHalfSize.X, 2 * HullHalfSize.Y, 2 * HullHalfSize.Z)).GetDiagonal();
+
+		// At least four layers, so the rods fall across each other. The spacing is more than the rod length so none start overlapping.
+		FRandomStream Random(4321);
+		const int32 NumPerSide = FMath::Clamp(FMath::CeilToInt32(FMath::Sqrt(FReal(NumBodies) / 4)), 1, 24);
+		const FReal Spacing = 2 * NumHulls * HullHalfSize.X + 10;
+		for (int32 Index = 0; Index < NumBodies; ++Index)
+		{
+			TArray<FImplicitObjectPtr> Hulls;
+			for (int32 HullIndex = 0; HullIndex < NumHulls; ++HullIndex)
+			{
+				const FVec3 Center(FReal(2 * HullIndex - (NumHulls - 1)) * HullHalfSize.X, 0, 0);
+				TArray<FConvex::FVec3Type> Vertices;
+				for (int32 Corner = 0; Corner < 8; ++Corner)
+				{
+					const FVec3 Sign((Corner & 1) ? FReal(1) : FReal(-1), (Corner & 2) ? FReal(1) : FReal(-1), (Corner & 4) ? FReal(1) : FReal(-1));
+					Vertices.Add(FConvex::FVec3Type(Center + Sign * HullHalfSize * Random.FRandRange(0.8, 1.0)));
+				}
+				Hulls.Add(MakeImplicitObjectPtr<FConvex>(Vertices, FReal(0)));
+			}
+
+			const int32 Layer = Index / (NumPerSide * NumPerSide);
+			const int32 Cell = Index % (NumPerSide * NumPerSide);
+			const FVec3 Position(FReal(Cell % NumPerSide - NumPerSide / 2) * Spacing, FReal(Cell / NumPerSide - NumPerSide / 2) * Spacing, Spacing / 2 + Layer * Spacing);
+			const FRigidTransform3 Transform(Position, FRotation3::FromAxisAngle(FVec3(Random.GetUnitVector()), Random.FRandRange(0, UE_PI)));
+			Scene.AddDynamic(MakeImplicitObjectPtr<FImplicitObjectUnion>(MoveTemp(Hulls)), Volume, UnitInertia, Transform);
+		}
+	}
+
+	struct FBenchmarkSceneDesc
+	{
+		const TCHAR* Name;
+		TFunction<void(FBenchmarkScene&)> Build;
+	};
+
+	/** Phases reported by the benchmark, each the sum of the CHAOS_SCOPED_TIMER labels inside it */
+	struct FBenchmarkPhase
+	{
+		const TCHAR* Name;
+		TArray<const TCHAR*> Labels;
+	};
+
+	static const TArray<FBenchmarkPhase>& GetBenchmarkPhases()
+	{
+		static const TArray<FBenchmarkPhase> Phases =
+		{
+			{ TEXT("Broadphase"), { TEXT("ComputeIntermediateSpatialAcceleration"), TEXT("BroadPhase") } },
+			{ TEXT("Narrowphase"), { TEXT("NarrowPhase") } },
+			{ TEXT("Islands"), { TEXT("CreateConstraintGraph"), TEXT("CreateIslands"), TEXT("BuildGroups") } },
+			{ TEXT("Solve"), { TEXT("Solve") } },
+			{ TEXT("Integrate"), { TEXT("Integrate") } },
+		};
+		return Phases;
+	}
+
+	static const FReal BenchmarkDt = 1.0 / 60.0;
+
+	/** Builds the scene, lets it settle for NumWarmupSteps and returns the seconds of NumSteps steps, with the per label totals in PhaseTimes */
+	static double RunBenchmark(const FBenchmarkSceneDesc& Desc, int32 NumWarmupSteps, int32 NumSteps, FChaosPerfTestPhaseTimes& PhaseTimes)
+	{
+		FBenchmarkScene Scene;
+		Desc.Build(Scene);
+
+		for (int32 Step = 0; Step < NumWarmupSteps; ++Step)
+		{
+			Scene.Step(BenchmarkDt);
+		}
+
+		PhaseTimes.Reset();
+		FScopedChaosPerfPhaseTimes PhaseTimesScope(PhaseTimes);
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			Scene.Step(BenchmarkDt);
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	/** Limits the physics parallel fors to NumWorkers for the lifetime of the scope, 1 runs single threaded */
+	struct FScopedPhysicsWorkerLimit
+	{
+		explicit FScopedPhysicsWorkerLimit(int32 NumWorkers)
+			: PrevMaxNumWorkers(MaxNumWorkers)
+			, bPrevDisablePhysicsParallelFor(bDisablePhysicsParallelFor)
+		{
+			MaxNumWorkers = NumWorkers;
+			bDisablePhysicsParallelFor = (NumWorkers <= 1);
+		}
+
+		~FScopedPhysicsWorkerLimit()
+		{
+			MaxNumWorkers = PrevMaxNumWorkers;
+			bDisablePhysicsParallelFor = bPrevDisablePhysicsParallelFor;
+		}
+
+		int32 PrevMaxNumWorkers;
+		bool bPrevDisablePhysicsParallelFor;
+	};
+
+	/** Sum of the per-group solve times from the last step */
+	static double GetTotalGroupSolveTime(const FBenchmarkScene& Scene)
+	{
+		const Private::FPBDIslandGroupManager& GroupManager = Scene.Evolution.GetIslandGroupManager();
+
+		double Seconds = 0;
+		for (int32 GroupIndex = 0; GroupIndex < GroupManager.GetNumGroups(); ++GroupIndex)
+		{
+			Seconds += GroupManager.GetGroupSolveTime(GroupIndex);
+		}
+		return Seconds;
+	}
+
+	/** The most colors used by the collision solver of any colored island group in the last step, 0 if no group was colored */
+	static int32 GetMaxCollisionColors(const FBenchmarkScene& Scene)
+	{
+		const Private::FPBDIslandGroupManager& GroupManager = Scene.Evolution.GetIslandGroupManager();
+		const int32 CollisionContainerId = Scene.Evolution.GetCollisionConstraints().GetContainerId();
+
+		int32 MaxColors = 0;
+		for (int32 GroupIndex = 0; GroupIndex < GroupManager.GetNumGroups(); ++GroupIndex)
+		{
+			const Private::FPBDIslandConstraintGroupSolver* Group = GroupManager.GetGroup(GroupIndex);
+			if (Group->IsColoringEnabled())
+			{
+				if (const FConstraintContainerSolver* ContainerSolver = Group->GetConstraintSolver(CollisionContainerId))
+				{
+					MaxColors = FMath::Max(MaxColors, static_cast<const FPBDCollisionContainerSolver*>(ContainerSolver)->GetNumColors());
+				}
+			}
+		}
+		return MaxColors;
+	}
+
+	/** Whether no two constraints in a color that is solved in parallel share a dynamic particle */
+	static bool AreParallelColorsIndependent(const FPBDCollisionContainerSolver& Solver)
+	{
+		for (int32 ColorIndex = 0; ColorIndex < Solver.GetNumParallelColors(); ++ColorIndex)
+		{
+			TSet<const FGeometryParticleHandle*> ColorParticles;
+			for (int32 ConstraintIndex = Solver.GetColorOffset(ColorIndex); ConstraintIndex < Solver.GetColorOffset(ColorIndex + 1); ++ConstraintIndex)
+			{
+				const FPBDCollisionConstraint& Constraint = Solver.GetCollisionConstraint(ConstraintIndex);
+				for (const FGeometryParticleHandle* Particle : { Constraint.GetParticle0(), Constraint.GetParticle1() })
+				{
+					bool bAlreadyInColor = false;
+					if (FConstGenericParticleHandle(Particle)->IsDynamic())
+					{
+						ColorParticles.Add(Particle, &bAlreadyInColor);
+					}
+					if (bAlreadyInColor)
+					{
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	/** The most ticks in a row that any current collision has restored its manifold without running the narrow phase */
+	static int32 GetMaxConsecutiveManifoldRestores(const FBenchmarkScene& Scene)
+	{
+		int32 MaxRestores = 0;
+		for (const FPBDCollisionConstraint* Constraint : Scene.Evolution.GetCollisionConstraints().GetConstConstraintHandles())
+		{
+			MaxRestores = FMath::Max(MaxRestores, Constraint->GetNumManifoldRestores());
+		}
+		return MaxRestores;
+	}
+
+	/**
+	 * Steps the scene and returns the narrow phase and manifold restore counts summed over all the steps.
+	 * OutMaxConsecutiveRestores, if set, receives the largest GetMaxConsecutiveManifoldRestores seen after any of the steps.
+	 */
+	static Private::FCollisionManifoldReuseStats StepAndCountManifoldReuse(FBenchmarkScene& Scene, int32 NumSteps, int32* OutMaxConsecutiveRestores = nullptr)
+	{
+		Private::FCollisionManifoldReuseStats Stats;
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			Scene.Step(BenchmarkDt);
+			Stats.Accumulate(Scene.Evolution.GetCollisionConstraints().GetConstraintAllocator().GetManifoldReuseStats());
+			if (OutMaxConsecutiveRestores)
+			{
+				*OutMaxConsecutiveRestores = FMath::Max(*OutMaxConsecutiveRestores, GetMaxConsecutiveManifoldRestores(Scene));
+			}
+		}
+		return Stats;
+	}
+
+	static FReal GetHighestZ(const FBenchmarkScene& Scene)
+	{
+		FReal HighestZ = -TNumericLimits<FReal>::Max();
+		for (const FPBDRigidParticleHandle* Particle : Scene.Dynamics)
+		{
+			HighestZ = FMath::Max(HighestZ, Particle->GetX().Z);
+		}
+		return HighestZ;
+	}
+
+	/** Manifold reuse counts of the two phases of SettleAndTestAtRest */
+	struct FSettleStats
+	{
+		Private::FCollisionManifoldReuseStats Settling;
+		Private::FCollisionManifoldReuseStats AtRest;
+		int32 MaxConsecutiveRestores = 0;
+	};
+
+	/** Builds the scene and lets it settle for 90 steps, then tests that it stays above the ground and at rest for 60 more steps */
+	static FSettleStats SettleAndTestAtRest(FAutomationTestBase& Test, FBenchmarkScene& Scene, const FBenchmarkSceneDesc& Desc, const TCHAR* ModeName)
+	{
+		Desc.Build(Scene);
+
+		FSettleStats Stats;
+		Stats.Settling = StepAndCountManifoldReuse(Scene, 90, &Stats.MaxConsecutiveRestores);
+		const FReal SettledHighestZ = GetHighestZ(Scene);
+		Stats.AtRest = StepAndCountManifoldReuse(Scene, 60, &Stats.MaxConsecutiveRestores);
+
+		Test.TestTrue(FString::Printf(TEXT("%s %s stays above the ground"), Desc.Name, ModeName), Scene.GetLowestZ() > -10);
+		Test.TestTrue(FString::Printf(TEXT("%s %s stays at rest"), Desc.Name, ModeName), FMath::Abs(GetHighestZ(Scene) - SettledHighestZ) < 5);
+		return Stats;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkScenesTest, "Physics.Benchmark.Scenes", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkScenesTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	// Small versions of the benchmark scenes, to catch a scene that explodes or falls through the world
+	const FBenchmarkSceneDesc Scenes[] =
+	{
+		{ TEXT("BoxStacks"), [](FBenchmarkScene& Scene) { BuildBoxStacks(Scene, 4, 5); } },
+		{ TEXT("DebrisPile"), [](FBenchmarkScene& Scene) { BuildDebrisPile(Scene, 300); } },
+		{ TEXT("RagdollChains"), [](FBenchmarkScene& Scene) { BuildRagdollChains(Scene, 8, 8); } },
+		{ TEXT("Terrain"), [](FBenchmarkScene& Scene) { BuildTerrain(Scene, 200); } },
+	};
+
+	for (const FBenchmarkSceneDesc& Desc : Scenes)
+	{
+		FBenchmarkScene Scene;
+		Desc.Build(Scene);
+		TestTrue(FString::Printf(TEXT("%s has bodies"), Desc.Name), Scene.Dynamics.Num() > 0);
+
+		FChaosPerfTestPhaseTimes PhaseTimes;
+		{
+			FScopedChaosPerfPhaseTimes PhaseTimesScope(PhaseTimes);
+			for (int32 Step = 0; Step < 120; ++Step)
+			{
+				Scene.Step(BenchmarkDt);
+			}
+		}
+
+		// The terrain dips to -300, everything else rests on the ground at 0
+		TestTrue(FString::Printf(TEXT("%s stays above the ground"), Desc.Name), Scene.GetLowestZ() > -400);
+		for (const FBenchmarkPhase& Phase : GetBenchmarkPhases())
+		{
+			FReal Seconds = 0;
+			for (const TCHAR* Label : Phase.Labels)
+			{
+				Seconds += PhaseTimes.Get(Label);
+			}
+			TestTrue(FString::Printf(TEXT("%s timed %s"), Desc.Name, Phase.Name), Seconds > 0);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkPerfTest, "Physics.Benchmark.Perf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	const int32 NumWarmupSteps = 30;
+	const int32 NumSteps = 60;
+
+	const FBenchmarkSceneDesc Scenes[] =
+	{
+		{ TEXT("BoxStacks"), [](FBenchmarkScene& Scene) { BuildBoxStacks(Scene, 36, 20); } },
+		{ TEXT("DebrisPile"), [](FBenchmarkScene& Scene) { BuildDebrisPile(Scene, 10000); } },
+		{ TEXT("RagdollChains"), [](FBenchmarkScene& Scene) { BuildRagdollChains(Scene, 128, 16); } },
+		{ TEXT("Terrain"), [](FBenchmarkScene& Scene) { BuildTerrain(Scene, 4096); } },
+	};
+
+	// The scheduler workers plus the thread running the test
+	const int32 MaxWorkers = int32(LowLevelTasks::FScheduler::Get().GetNumWorkers()) + 1;
+	TArray<int32> WorkerCounts;
+	for (int32 NumWorkers = 1; NumWorkers < MaxWorkers; NumWorkers *= 2)
+	{
+		WorkerCounts.Add(NumWorkers);
+	}
+	WorkerCounts.Add(MaxWorkers);
+
+	for (const FBenchmarkSceneDesc& Desc : Scenes)
+	{
+		for (const int32 NumWorkers : WorkerCounts)
+		{
+			FScopedPhysicsWorkerLimit WorkerLimit(NumWorkers);
+
+			FChaosPerfTestPhaseTimes PhaseTimes;
+			const double Seconds = RunBenchmark(Desc, NumWarmupSteps, NumSteps, PhaseTimes);
+
+			FString Phases;
+			double PhaseSeconds = 0;
+			for (const FBenchmarkPhase& Phase : GetBenchmarkPhases())
+			{
+				double Total = 0;
+				for (const TCHAR* Label : Phase.Labels)
+				{
+					Total += PhaseTimes.Get(Label);
+				}
+				PhaseSeconds += Total;
+				Phases += FString::Printf(TEXT(" %s %.3f"), Phase.Name, Total * 1000.0 / NumSteps);
+			}
+
+			AddInfo(FString::Printf(TEXT("%-14s %2d workers: %8.3f ms/step,%s Other %.3f"),
+				Desc.Name, NumWorkers, Seconds * 1000.0 / NumSteps, *Phases, (Seconds - PhaseSeconds) * 1000.0 / NumSteps));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkPersistentManifoldTest, "Physics.Benchmark.PersistentManifold", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkPersistentManifoldTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	const FBenchmarkSceneDesc Scenes[] =
+	{
+		{ TEXT("BoxStacks"), [](FBenchmarkScene& Scene) { BuildBoxStacks(Scene, 4, 5); } },
+		{ TEXT("DebrisPile"), [](FBenchmarkScene& Scene) { BuildDebrisPile(Scene, 300); } },
+	};
+
+	for (const FBenchmarkSceneDesc& Desc : Scenes)
+	{
+		FRealSingle RestoreRates[2] = {};
+		for (const bool bPersistent : { false, true })
+		{
+			TGuardValue<bool> ScopedPersistentManifold(bChaos_Collision_PersistentManifold, bPersistent);
+			const TCHAR* ModeName = bPersistent ? TEXT("persistent") : TEXT("default");
+
+			// Once settled, reusing the manifolds must not let the pile sink or the stacks topple
+			FBenchmarkScene Scene;
+			const FSettleStats SettleStats = SettleAndTestAtRest(*this, Scene, Desc, ModeName);
+			const Private::FCollisionManifoldReuseStats& Stats = SettleStats.AtRest;
+			RestoreRates[bPersistent ? 1 : 0] = Stats.GetRestoreRate();
+
+			TestTrue(FString::Printf(TEXT("%s %s runs the narrow phase"), Desc.Name, ModeName), Stats.NumNarrowPhaseUpdates > 0);
+			if (bPersistent)
+			{
+				// The narrow phase is forced to run again after MaxRestores restores in a row
+				TestTrue(FString::Printf(TEXT("%s %s restores at most %d times in a row"), Desc.Name, ModeName, Chaos_Collision_PersistentManifold_MaxRestores),
+					SettleStats.MaxConsecutiveRestores <= Chaos_Collision_PersistentManifold_MaxRestores);
+			}
+			AddInfo(FString::Printf(TEXT("%s %s: %.1f%% of manifolds restored"), Desc.Name, ModeName, Stats.GetRestoreRate() * 100.0f));
+		}
+
+		// Persistent manifolds are restored under larger movements, so once settled they must skip the narrow phase at least as often
+		TestTrue(FString::Printf(TEXT("%s persistent restores at least as often as default"), Desc.Name), RestoreRates[1] >= RestoreRates[0]);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkPersistentManifoldPerfTest, "Physics.Benchmark.PersistentManifoldPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkPersistentManifoldPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	const int32 NumWarmupSteps = 120;
+	const int32 NumSteps = 60;
+
+	// Large piles that have come to rest, where most contacts barely move from one tick to the next
+	const FBenchmarkSceneDesc Scenes[] =
+	{
+		{ TEXT("BoxStacks"), [](FBenchmarkScene& Scene) { BuildBoxStacks(Scene, 36, 20); } },
+		{ TEXT("DebrisPile"), [](FBenchmarkScene& Scene) { BuildDebrisPile(Scene, 10000); } },
+	};
+
+	for (const FBenchmarkSceneDesc& Desc : Scenes)
+	{
+		for (const bool bPersistent : { false, true })
+		{
+			TGuardValue<bool> ScopedPersistentManifold(bChaos_Collision_PersistentManifold, bPersistent);
+
+			FBenchmarkScene Scene;
+			Desc.Build(Scene);
+			StepAndCountManifoldReuse(Scene, NumWarmupSteps);
+
+			FChaosPerfTestPhaseTimes PhaseTimes;
+			Private::FCollisionManifoldReuseStats Stats;
+			double Seconds = 0;
+			{
+				FScopedChaosPerfPhaseTimes PhaseTimesScope(PhaseTimes);
+				const double StartTime = FPlatformTime::Seconds();
+				Stats = StepAndCountManifoldReuse(Scene, NumSteps);
+				Seconds = FPlatformTime::Seconds() - StartTime;
+			}
+
+			AddInfo(FString::Printf(TEXT("%-10s %-10s: %8.3f ms/step, NarrowPhase %.3f ms, %.1f%% restored, %d narrow phase calls/tick"),
+				Desc.Name, bPersistent ? TEXT("persistent") : TEXT("default"), Seconds * 1000.0 / NumSteps, PhaseTimes.Get(TEXT("NarrowPhase")) * 1000.0 / NumSteps,
+				Stats.GetRestoreRate() * 100.0f, Stats.NumNarrowPhaseUpdates / NumSteps));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkIslandColoringTest, "Physics.Benchmark.IslandColoring", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkIslandColoringTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	// A single pile is one island, so with coloring enabled its collisions are solved across all the workers.
+	// The small stacks are separate islands below the minimum worker share, so they are never colored.
+	const FBenchmarkSceneDesc Scenes[] =
+	{
+		{ TEXT("BoxStacks"), [](FBenchmarkScene& Scene) { BuildBoxStacks(Scene, 4, 5); } },
+		{ TEXT("DebrisPile"), [](FBenchmarkScene& Scene) { BuildDebrisPile(Scene, 300); } },
+	};
+	const bool bHasLargeIsland[] = { false, true };
+
+	for (int32 SceneIndex = 0; SceneIndex < int32(UE_ARRAY_COUNT(Scenes)); ++SceneIndex)
+	{
+		const FBenchmarkSceneDesc& Desc = Scenes[SceneIndex];
+		for (const bool bColoring : { false, true })
+		{
+			TGuardValue<bool> ScopedColoringEnabled(CVars::GIslandGroupsColoringEnabled, bColoring);
+			TGuardValue<int32> ScopedColoringMinConstraints(CVars::GIslandGroupsColoringMinConstraints, 0);
+			const TCHAR* ModeName = bColoring ? TEXT("colored") : TEXT("default");
+
+			FBenchmarkScene Scene;
+			SettleAndTestAtRest(*this, Scene, Desc, ModeName);
+
+			const Private::FPBDIslandGroupManager& GroupManager = Scene.Evolution.GetIslandGroupManager();
+			TestTrue(FString::Printf(TEXT("%s %s times the group solve"), Desc.Name, ModeName), GetTotalGroupSolveTime(Scene) > 0);
+			TestTrue(FString::Printf(TEXT("%s %s has a valid imbalance"), Desc.Name, ModeName), GroupManager.GetGroupSolveImbalance() >= 1.0);
+
+			// Coloring needs worker threads to solve the colors on
+			const bool bExpectColors = bColoring && bHasLargeIsland[SceneIndex] && (GroupManager.GetNumWorkerThreads() > 0);
+			TestEqual(FString::Printf(TEXT("%s %s colors the collisions"), Desc.Name, ModeName), GetMaxCollisionColors(Scene) > 0, bExpectColors);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkColorConstraintsTest, "Physics.Benchmark.ColorConstraints", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkColorConstraintsTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	// Color all the collisions of a settled pile directly, independent of the island group and worker settings
+	const FBenchmarkSceneDesc Desc = { TEXT("DebrisPile"), [](FBenchmarkScene& Scene) { BuildDebrisPile(Scene, 300); } };
+	FBenchmarkScene Scene;
+	SettleAndTestAtRest(*this, Scene, Desc, TEXT("default"));
+
+	FPBDCollisionConstraints& CollisionConstraints = Scene.Evolution.GetCollisionConstraints();
+	TUniquePtr<FConstraintContainerSolver> ContainerSolver = CollisionConstraints.CreateGroupSolver(0);
+	FPBDCollisionContainerSolver& Solver = static_cast<FPBDCollisionContainerSolver&>(*ContainerSolver);
+	Solver.AddConstraints();
+
+	FSolverBodyContainer SolverBodyContainer;
+	SolverBodyContainer.Reset(Scene.Dynamics.Num() + 1);
+	Solver.ColorConstraints(SolverBodyContainer);
+
+	TestTrue(TEXT("DebrisPile has collisions to color"), Solver.GetNumConstraints() > 1);
+	TestTrue(TEXT("DebrisPile collisions use several colors"), Solver.GetNumColors() > 1);
+	TestTrue(TEXT("DebrisPile fits in the parallel colors"), Solver.GetNumParallelColors() == Solver.GetNumColors());
+	TestEqual(TEXT("Every collision has a color"), Solver.GetColorOffset(Solver.GetNumColors()), Solver.GetNumConstraints());
+	TestTrue(TEXT("No parallel color shares a dynamic particle"), AreParallelColorsIndependent(Solver));
+
+	// Coloring left solver body indices on the particles, which are only cleared when a group scatters its results
+	for (int32 BodyIndex = 0; BodyIndex < SolverBodyContainer.Num(); ++BodyIndex)
+	{
+		FGenericParticleHandle(SolverBodyContainer.GetParticle(BodyIndex))->SetSolverBodyIndex(INDEX_NONE);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkIslandColoringPerfTest, "Physics.Benchmark.IslandColoringPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkIslandColoringPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	const int32 NumWarmupSteps = 60;
+	const int32 NumSteps = 60;
+
+	// One very large island next to many small ones. Without coloring the large island is solved by one worker while the others wait.
+	const FBenchmarkSceneDesc Scenes[] =
+	{
+		{ TEXT("DebrisPile"), [](FBenchmarkScene& Scene) { BuildDebrisPile(Scene, 10000); } },
+		{ TEXT("BoxStacks"), [](FBenchmarkScene& Scene) { BuildBoxStacks(Scene, 36, 20); } },
+	};
+
+	for (const FBenchmarkSceneDesc& Desc : Scenes)
+	{
+		for (const bool bColoring : { false, true })
+		{
+			TGuardValue<bool> ScopedColoringEnabled(CVars::GIslandGroupsColoringEnabled, bColoring);
+			TGuardValue<int32> ScopedColoringMinConstraints(CVars::GIslandGroupsColoringMinConstraints, 1000);
+
+			FBenchmarkScene Scene;
+			Desc.Build(Scene);
+			for (int32 Step = 0; Step < NumWarmupSteps; ++Step)
+			{
+				Scene.Step(BenchmarkDt);
+			}
+
+			double GroupSolveSeconds = 0;
+			double Imbalance = 0;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				Scene.Step(BenchmarkDt);
+				GroupSolveSeconds += GetTotalGroupSolveTime(Scene);
+				Imbalance += Scene.Evolution.GetIslandGroupManager().GetGroupSolveImbalance();
+			}
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+			AddInfo(FString::Printf(TEXT("%-10s %-8s: %8.3f ms/step, group solve %.3f ms/step, imbalance %.2f"),
+				Desc.Name, bColoring ? TEXT("colored") : TEXT("default"), Seconds * 1000.0 / NumSteps, GroupSolveSeconds * 1000.0 / NumSteps, Imbalance / NumSteps));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkConvexBatchCullTest, "Physics.Benchmark.ConvexBatchCull", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkConvexBatchCullTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	// Culling only skips narrow phase calls that could not have produced a contact, so the pile must behave the same
+	const FBenchmarkSceneDesc Desc = { TEXT("ConvexCompoundPile"), [](FBenchmarkScene& Scene) { BuildConvexCompoundPile(Scene, 200); } };
+	int32 NumNarrowPhaseUpdates[2] = {};
+	for (const bool bCull : { false, true })
+	{
+		TGuardValue<bool> ScopedBatchCullEnabled(CVars::bChaos_Collision_MidPhase_EnableConvexBatchCull, bCull);
+		TGuardValue<int32> ScopedBatchCullMinPairs(CVars::Chaos_Collision_MidPhase_ConvexBatchCullMinPairs, 8);
+		const TCHAR* ModeName = bCull ? TEXT("batch cull") : TEXT("default");
+
+		FBenchmarkScene Scene;
+		NumNarrowPhaseUpdates[bCull ? 1 : 0] = SettleAndTestAtRest(*this, Scene, Desc, ModeName).Settling.NumNarrowPhaseUpdates;
+	}
+
+	TestTrue(TEXT("ConvexCompoundPile batch cull skips narrow phase calls"), NumNarrowPhaseUpdates[1] < NumNarrowPhaseUpdates[0]);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChaosBenchmarkConvexBatchCullPerfTest, "Physics.Benchmark.ConvexBatchCullPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FChaosBenchmarkConvexBatchCullPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::BenchmarkTests;
+
+	const int32 NumWarmupSteps = 120;
+	const int32 NumSteps = 60;
+
+	// A large pile of compound bodies, where most shape pairs of touching bodies have overlapping bounds but are not in contact
+	for (const bool bCull : { false, true })
+	{
+		TGuardValue<bool> ScopedBatchCullEnabled(CVars::bChaos_Collision_MidPhase_EnableConvexBatchCull, bCull);
+		TGuardValue<int32> ScopedBatchCullMinPairs(CVars::Chaos_Collision_MidPhase_ConvexBatchCullMinPairs, 8);
+
+		FBenchmarkScene Scene;
+		BuildConvexCompoundPile(Scene, 4096);
+		StepAndCountManifoldReuse(Scene, NumWarmupSteps);
+
+		FChaosPerfTestPhaseTimes PhaseTimes;
+		Private::FCollisionManifoldReuseStats Stats;
+		double Seconds = 0;
+		{
+			FScopedChaosPerfPhaseTimes PhaseTimesScope(PhaseTimes);
+			const double StartTime = FPlatformTime::Seconds();
+			Stats = StepAndCountManifoldReuse(Scene, NumSteps);
+			Seconds = FPlatformTime::Seconds() - StartTime;
+		}
+
+		AddInfo(FString::Printf(TEXT("ConvexCompoundPile %-10s: %8.3f ms/step, NarrowPhase %.3f ms, %d narrow phase calls/tick"),
+			bCull ? TEXT("batch cull") : TEXT("default"), Seconds * 1000.0 / NumSteps, PhaseTimes.Get(TEXT("NarrowPhase")) * 1000.0 / NumSteps,
+			Stats.NumNarrowPhaseUpdates / NumSteps));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Chaos/Convex.h"
+#include "Chaos/GJK.h"
+#include "Chaos/GJKBatch.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Chaos::GJKBatchTests
+{
+	using FConvexPair = TGJKDistanceBatchPair<TGJKShape<FConvex>, TGJKShape<FConvex>>;
+
+	/** Random hull around Center: a jittered box that always contains a ball of radius 40, plus some random points out to 60 */
+	static TUniquePtr<FConvex> MakeRandomHull(FRandomStream& Random, const FVec3& Center)
+	{
+		TArray<FConvex::FVec3Type> Vertices;
+		for (int32 Corner = 0; Corner < 8; ++Corner)
+		{
+			const FVec3 Sign((Corner & 1) ? FReal(1) : FReal(-1), (Corner & 2) ? FReal(1) : FReal(-1), (Corner & 4) ? FReal(1) : FReal(-1));
+			Vertices.Add(FConvex::FVec3Type(Center + Sign * FVec3(Random.FRandRange(40, 50), Random.FRandRange(40, 50), Random.FRandRange(40, 50))));
+		}
+		for (int32 Point = 0; Point < 12; ++Point)
+		{
+			Vertices.Add(FConvex::FVec3Type(Center + FVec3(Random.FRandRange(-60, 60), Random.FRandRange(-60, 60), Random.FRandRange(-60, 60))));
+		}
+		return MakeUnique<FConvex>(Vertices, FReal(0));
+	}
+
+	/** Pairs of hulls at random positions. The first half are separated by at least 250 - 2 * 104 and the second half overlap by at least 40. */
+	static void MakeHullPairs(FRandomStream& Random, const int32 NumPairs, TArray<TUniquePtr<FConvex>>& OutHulls, TArray<FConvexPair>& OutPairs)
+	{
+		for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+		{
+			const FReal Separation = (PairIndex < NumPairs / 2) ? Random.FRandRange(250, 400) : Random.FRandRange(0, 35);
+			const FVec3 CenterA(Random.FRandRange(-1000, 1000), Random.FRandRange(-1000, 1000), Random.FRandRange(-1000, 1000));
+			const FVec3 CenterB = CenterA + Separation * FVec3(Random.GetUnitVector());
+
+			const FConvex& HullA = *OutHulls.Add_GetRef(MakeRandomHull(Random, CenterA));
+			const FConvex& HullB = *OutHulls.Add_GetRef(MakeRandomHull(Random, CenterB));
+			OutPairs.Emplace(TGJKShape(HullA), TGJKShape(HullB), GJKDistanceInitialVFromDirection(HullA, HullB, HullB.GetCenterOfMass() - HullA.GetCenterOfMass()));
+		}
+	}
+
+	static void RunScalar(TArray<FConvexPair>& Pairs)
+	{
+		for (FConvexPair& Pair : Pairs)
+		{
+			Pair.Result = GJKDistance<FReal>(Pair.A, Pair.B, Pair.InitialV, Pair.Distance, Pair.NearestA, Pair.NearestB, Pair.NormalA);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGJKBatchDistanceTest, "Physics.GJK.BatchDistance", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FGJKBatchDistanceTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::GJKBatchTests;
+
+	FRandomStream Random(1234);
+	TArray<TUniquePtr<FConvex>> Hulls;
+	TArray<FConvexPair> ScalarPairs;
+	MakeHullPairs(Random, 203, Hulls, ScalarPairs);
+	TArray<FConvexPair> Batch4Pairs = ScalarPairs;
+	TArray<FConvexPair> Batch8Pairs = ScalarPairs;
+
+	RunScalar(ScalarPairs);
+	GJKDistanceBatch<4>(MakeArrayView(Batch4Pairs));
+	GJKDistanceBatch<8>(MakeArrayView(Batch8Pairs));
+
+	// The closest points are not unique when features are parallel, but the separating vector is
+	const FReal DistanceTolerance = FReal(0.05);
+	for (const TArray<FConvexPair>* BatchPairs : { &Batch4Pairs, &Batch8Pairs })
+	{
+		const int32 BatchSize = (BatchPairs == &Batch4Pairs) ? 4 : 8;
+		int32 NumMismatches = 0;
+		for (int32 PairIndex = 0; PairIndex < ScalarPairs.Num(); ++PairIndex)
+		{
+			const FConvexPair& Expected = ScalarPairs[PairIndex];
+			const FConvexPair& Actual = (*BatchPairs)[PairIndex];
+			bool bMatch = (Actual.Result == Expected.Result);
+			if (bMatch && (Expected.Result == EGJKDistanceResult::Separated))
+			{
+				bMatch = (FMath::Abs(Actual.Distance - Expected.Distance) < DistanceTolerance)
+					&& (FVec3::DotProduct(Actual.NormalA, Expected.NormalA) > FReal(0.999))
+					&& (FMath::Abs((Actual.NearestA - Actual.NearestB).Size() - Actual.Distance) < DistanceTolerance);
+			}
+			NumMismatches += bMatch ? 0 : 1;
+		}
+		TestEqual(FString::Printf(TEXT("Batch %d results match GJKDistance"), BatchSize), NumMismatches, 0);
+	}
+
+	// The midphase culls on the lower bound, so it must never exceed the true distance
+	int32 NumSeparated = 0;
+	int32 NumBadLowerBounds = 0;
+	for (int32 PairIndex = 0; PairIndex < ScalarPairs.Num(); ++PairIndex)
+	{
+		const FConvexPair& Pair = Batch4Pairs[PairIndex];
+		if (Pair.Result == EGJKDistanceResult::Separated)
+		{
+			++NumSeparated;
+			NumBadLowerBounds += (Pair.DistanceLowerBound > ScalarPairs[PairIndex].Distance + DistanceTolerance) ? 1 : 0;
+		}
+	}
+	TestEqual(TEXT("Batch separated pairs"), NumSeparated, ScalarPairs.Num() / 2);
+	TestEqual(TEXT("Batch distance lower bounds"), NumBadLowerBounds, 0);
+
+	// Fewer pairs than lanes
+	TArray<FConvexPair> FewPairs;
+	FewPairs.Emplace(ScalarPairs[0].A, ScalarPairs[0].B, ScalarPairs[0].InitialV);
+	GJKDistanceBatch<8>(MakeArrayView(FewPairs));
+	TestTrue(TEXT("Single pair batch result"), FewPairs[0].Result == ScalarPairs[0].Result);
+	TestTrue(TEXT("Single pair batch distance"), FMath::Abs(FewPairs[0].Distance - ScalarPairs[0].Distance) < DistanceTolerance);
+
+	TArray<FConvexPair> NoPairs;
+	GJKDistanceBatch<4>(MakeArrayView(NoPairs));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGJKBatchDistancePerfTest, "Physics.GJK.BatchDistancePerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FGJKBatchDistancePerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::GJKBatchTests;
+
+	constexpr int32 NumPairs = 20000;
+	constexpr int32 NumRuns = 10;
+
+	FRandomStream Random(5678);
+	TArray<TUniquePtr<FConvex>> Hulls;
+	TArray<FConvexPair> ScalarPairs;
+	MakeHullPairs(Random, NumPairs, Hulls, ScalarPairs);
+	TArray<FConvexPair> Batch4Pairs = ScalarPairs;
+	TArray<FConvexPair> Batch8Pairs = ScalarPairs;
+
+	double ScalarSeconds = 0, Batch4Seconds = 0, Batch8Seconds = 0;
+	for (int32 Run = 0; Run < NumRuns; ++Run)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		RunScalar(ScalarPairs);
+		ScalarSeconds += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		GJKDistanceBatch<4>(MakeArrayView(Batch4Pairs));
+		Batch4Seconds += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		GJKDistanceBatch<8>(MakeArrayView(Batch8Pairs));
+		Batch8Seconds += FPlatformTime::Seconds() - StartTime;
+	}
+
+	AddInfo(FString::Printf(TEXT("%d convex pairs x %d runs: scalar %.2f ms, batch 4 %.2f ms (%.2fx), batch 8 %.2f ms (%.2fx)"),
+		NumPairs, NumRuns, ScalarSeconds * 1000.0, Batch4Seconds * 1000.0, ScalarSeconds / Batch4Seconds, Batch8Seconds * 1000.0, ScalarSeconds / Batch8Seconds));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
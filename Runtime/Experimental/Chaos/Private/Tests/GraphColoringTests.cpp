@@ -0,0 +1,230 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Chaos/DynamicParticles.h"
+#include "Chaos/GraphColoring.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Chaos::GraphColoringTests
+{
+	/** Square cloth grid appended after any existing particles, with the top row pinned, along with its stretch/shear/bend springs and its quads as 4 node elements */
+	struct FClothGrid
+	{
+		TDynamicParticles<FRealSingle, 3> Particles;
+		TArray<TVec2<int32>> Springs;
+		TArray<TVec4<int32>> Quads;
+	};
+
+	static void MakeClothGrid(FClothGrid& Cloth, int32 Size)
+	{
+		const int32 FirstParticle = (int32)Cloth.Particles.Size();
+		auto Index = [Size, FirstParticle](int32 Row, int32 Col) { return FirstParticle + Row * Size + Col; };
+
+		Cloth.Particles.AddParticles(Size * Size);
+		for (int32 Row = 0; Row < Size; ++Row)
+		{
+			for (int32 Col = 0; Col < Size; ++Col)
+			{
+				Cloth.Particles.SetX(Index(Row, Col), TVec3<FRealSingle>((FRealSingle)Col, (FRealSingle)Row, 0.f));
+				Cloth.Particles.InvM(Index(Row, Col)) = Row == 0 ? 0.f : 1.f;
+			}
+		}
+
+		for (int32 Row = 0; Row < Size; ++Row)
+		{
+			for (int32 Col = 0; Col < Size; ++Col)
+			{
+				if (Col + 1 < Size)
+				{
+					Cloth.Springs.Add(TVec2<int32>(Index(Row, Col), Index(Row, Col + 1)));
+				}
+				if (Row + 1 < Size)
+				{
+					Cloth.Springs.Add(TVec2<int32>(Index(Row, Col), Index(Row + 1, Col)));
+				}
+				if (Row + 1 < Size && Col + 1 < Size)
+				{
+					Cloth.Springs.Add(TVec2<int32>(Index(Row, Col), Index(Row + 1, Col + 1)));
+					Cloth.Springs.Add(TVec2<int32>(Index(Row, Col + 1), Index(Row + 1, Col)));
+					Cloth.Quads.Add(TVec4<int32>(Index(Row, Col), Index(Row, Col + 1), Index(Row + 1, Col), Index(Row + 1, Col + 1)));
+				}
+				if (Col + 2 < Size)
+				{
+					Cloth.Springs.Add(TVec2<int32>(Index(Row, Col), Index(Row, Col + 2)));
+				}
+				if (Row + 2 < Size)
+				{
+					Cloth.Springs.Add(TVec2<int32>(Index(Row, Col), Index(Row + 2, Col)));
+				}
+			}
+		}
+	}
+
+	/** Every constraint appears in exactly one colour, and no dynamic particle is shared by two constraints of the same colour */
+	template<int32 N, bool bAllDynamic = false>
+	static bool IsValidColoring(const TArray<TArray<int32>>& ColorGraph, const TArray<TVector<int32, N>>& Graph, const TDynamicParticles<FRealSingle, 3>& Particles)
+	{
+		TArray<int32> EdgeColorCounts;
+		EdgeColorCounts.SetNumZeroed(Graph.Num());
+		TArray<int32> NodeColors;
+		NodeColors.Init(INDEX_NONE, (int32)Particles.Size());
+		for (int32 Color = 0; Color < ColorGraph.Num(); ++Color)
+		{
+			for (const int32 EdgeIndex : ColorGraph[Color])
+			{
+				++EdgeColorCounts[EdgeIndex];
+				for (int32 NIndex = 0; NIndex < N; ++NIndex)
+				{
+					const int32 NodeIndex = Graph[EdgeIndex][NIndex];
+					if (bAllDynamic || Particles.InvM(NodeIndex) != 0.f)
+					{
+						if (NodeColors[NodeIndex] == Color)
+						{
+							return false;
+						}
+						NodeColors[NodeIndex] = Color;
+					}
+				}
+			}
+		}
+		for (const int32 Count : EdgeColorCounts)
+		{
+			if (Count != 1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	struct FColoringStats
+	{
+		int32 NumColors = 0;
+		int32 MinColorSize = 0;
+		int32 MaxColorSize = 0;
+		int32 NumPartialBatches = 0;
+	};
+
+	static FColoringStats GetColoringStats(const TArray<TArray<int32>>& ColorGraph, int32 BatchSize)
+	{
+		FColoringStats Stats;
+		Stats.NumColors = ColorGraph.Num();
+		Stats.MinColorSize = TNumericLimits<int32>::Max();
+		for (const TArray<int32>& ColorEdges : ColorGraph)
+		{
+			Stats.MinColorSize = FMath::Min(Stats.MinColorSize, ColorEdges.Num());
+			Stats.MaxColorSize = FMath::Max(Stats.MaxColorSize, ColorEdges.Num());
+			Stats.NumPartialBatches += (ColorEdges.Num() % BatchSize) != 0;
+		}
+		return Stats;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphColoringParallelTest, "Physics.GraphColoring.Parallel", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FGraphColoringParallelTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::GraphColoringTests;
+
+	FClothGrid Cloth;
+	MakeClothGrid(Cloth, 61);
+	const int32 NumParticles = (int32)Cloth.Particles.Size();
+
+	const TArray<TArray<int32>> SerialSprings = FGraphColoring::ComputeGraphColoringParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 2>(Cloth.Springs, Cloth.Particles, 0, NumParticles);
+	TArray<TArray<int32>> ParallelSprings = FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 2>(Cloth.Springs, Cloth.Particles, 0, NumParticles);
+	TestTrue(TEXT("Serial spring colouring is valid"), IsValidColoring<2>(SerialSprings, Cloth.Springs, Cloth.Particles));
+	TestTrue(TEXT("Parallel spring colouring is valid"), IsValidColoring<2>(ParallelSprings, Cloth.Springs, Cloth.Particles));
+
+	// Priorities only depend on the constraint index, so the colouring is the same however the rounds are scheduled
+	const TArray<TArray<int32>> ParallelSpringsAgain = FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 2>(Cloth.Springs, Cloth.Particles, 0, NumParticles);
+	TestTrue(TEXT("Parallel spring colouring is deterministic"), ParallelSprings == ParallelSpringsAgain);
+
+	constexpr int32 BatchSize = 8;
+	const FColoringStats Unbalanced = GetColoringStats(ParallelSprings, BatchSize);
+	FGraphColoring::BalanceGraphColoring<TDynamicParticles<FRealSingle, 3>, 2>(ParallelSprings, Cloth.Springs, Cloth.Particles, 0, NumParticles, BatchSize);
+	const FColoringStats Balanced = GetColoringStats(ParallelSprings, BatchSize);
+	TestTrue(TEXT("Balanced spring colouring is valid"), IsValidColoring<2>(ParallelSprings, Cloth.Springs, Cloth.Particles));
+	TestEqual(TEXT("Balancing keeps the number of colours"), Balanced.NumColors, Unbalanced.NumColors);
+	TestTrue(TEXT("Balancing does not grow the largest colour"), Balanced.MaxColorSize <= Unbalanced.MaxColorSize);
+	TestTrue(TEXT("Balancing does not shrink the smallest colour"), Balanced.MinColorSize >= Unbalanced.MinColorSize);
+
+	const TArray<TArray<int32>> ParallelQuads = FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 4>(Cloth.Quads, Cloth.Particles, 0, NumParticles);
+	TestTrue(TEXT("Parallel quad colouring is valid"), IsValidColoring<4>(ParallelQuads, Cloth.Quads, Cloth.Particles));
+	TArray<TArray<int32>> ParallelQuadsAllDynamic = FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 4, true>(Cloth.Quads, Cloth.Particles, 0, NumParticles);
+	FGraphColoring::BalanceGraphColoring<TDynamicParticles<FRealSingle, 3>, 4, true>(ParallelQuadsAllDynamic, Cloth.Quads, Cloth.Particles, 0, NumParticles, BatchSize);
+	TestTrue(TEXT("Balanced all dynamic quad colouring is valid"), (IsValidColoring<4, true>(ParallelQuadsAllDynamic, Cloth.Quads, Cloth.Particles)));
+
+	// Colour a sub range of the particles, as the solver does per cloth
+	FClothGrid Offset;
+	Offset.Particles.AddParticles(100);
+	MakeClothGrid(Offset, 21);
+	const TArray<TArray<int32>> RangeSprings = FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 2>(Offset.Springs, Offset.Particles, 100, (int32)Offset.Particles.Size());
+	TestTrue(TEXT("Parallel spring colouring of a particle range is valid"), IsValidColoring<2>(RangeSprings, Offset.Springs, Offset.Particles));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphColoringParallelPerfTest, "Physics.GraphColoring.ParallelPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FGraphColoringParallelPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::GraphColoringTests;
+
+	constexpr int32 BatchSize = 8;
+
+	// 10k, 50k, 100k and 200k particle cloths
+	for (const int32 Size : { 100, 224, 317, 448 })
+	{
+		FClothGrid Cloth;
+		MakeClothGrid(Cloth, Size);
+		const int32 NumParticles = (int32)Cloth.Particles.Size();
+
+		double StartTime = FPlatformTime::Seconds();
+		const TArray<TArray<int32>> SerialSprings = FGraphColoring::ComputeGraphColoringParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 2>(Cloth.Springs, Cloth.Particles, 0, NumParticles);
+		const double SerialSpringSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		TArray<TArray<int32>> ParallelSprings = FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 2>(Cloth.Springs, Cloth.Particles, 0, NumParticles);
+		const double ParallelSpringSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		const TArray<TArray<int32>> SerialQuads = FGraphColoring::ComputeGraphColoringParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 4>(Cloth.Quads, Cloth.Particles, 0, NumParticles);
+		const double SerialQuadSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		const TArray<TArray<int32>> ParallelQuads = FGraphColoring::ComputeGraphColoringParallelParticlesOrRange<TDynamicParticles<FRealSingle, 3>, 4>(Cloth.Quads, Cloth.Particles, 0, NumParticles);
+		const double ParallelQuadSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const FColoringStats SerialStats = GetColoringStats(SerialSprings, BatchSize);
+		const FColoringStats ParallelStats = GetColoringStats(ParallelSprings, BatchSize);
+
+		StartTime = FPlatformTime::Seconds();
+		FGraphColoring::BalanceGraphColoring<TDynamicParticles<FRealSingle, 3>, 2>(ParallelSprings, Cloth.Springs, Cloth.Particles, 0, NumParticles, BatchSize);
+		const double BalanceSeconds = FPlatformTime::Seconds() - StartTime;
+		const FColoringStats BalancedStats = GetColoringStats(ParallelSprings, BatchSize);
+
+		AddInfo(FString::Printf(TEXT("%d particles, %d springs: serial %.2f ms (%d colours, sizes %d-%d), parallel %.2f ms (%d colours, sizes %d-%d), %.2fx"),
+			NumParticles, Cloth.Springs.Num(),
+			SerialSpringSeconds * 1000.0, SerialStats.NumColors, SerialStats.MinColorSize, SerialStats.MaxColorSize,
+			ParallelSpringSeconds * 1000.0, ParallelStats.NumColors, ParallelStats.MinColorSize, ParallelStats.MaxColorSize,
+			SerialSpringSeconds / ParallelSpringSeconds));
+		AddInfo(FString::Printf(TEXT("%d particles, %d quads: serial %.2f ms (%d colours), parallel %.2f ms (%d colours), %.2fx"),
+			NumParticles, Cloth.Quads.Num(), SerialQuadSeconds * 1000.0, SerialQuads.Num(), ParallelQuadSeconds * 1000.0, ParallelQuads.Num(), SerialQuadSeconds / ParallelQuadSeconds));
+		AddInfo(FString::Printf(TEXT("%d particles, balanced springs in %.2f ms: sizes %d-%d, %d of %d colours with a partial batch of %d (was %d)"),
+			NumParticles, BalanceSeconds * 1000.0, BalancedStats.MinColorSize, BalancedStats.MaxColorSize, BalancedStats.NumPartialBatches, BalancedStats.NumColors, BatchSize, ParallelStats.NumPartialBatches));
+
+		TestTrue(FString::Printf(TEXT("%d particles parallel spring colouring is valid"), NumParticles), IsValidColoring<2>(ParallelSprings, Cloth.Springs, Cloth.Particles));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,227 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Chaos/Box.h"
+#include "Chaos/HeightField.h"
+#include "Chaos/Sphere.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Chaos
+{
+	extern bool bChaos_HeightField_UseMinMaxPyramid;
+}
+
+namespace Chaos::HeightFieldQueryTests
+{
+	enum class EQueryType
+	{
+		Raycast,
+		ThickRaycast,
+		SphereSweep,
+		BoxSweep,
+	};
+
+	static const TCHAR* GetQueryTypeName(EQueryType Type)
+	{
+		switch (Type)
+		{
+		case EQueryType::Raycast:		return TEXT("Raycast");
+		case EQueryType::ThickRaycast:	return TEXT("Thick raycast");
+		case EQueryType::SphereSweep:	return TEXT("Sphere sweep");
+		case EQueryType::BoxSweep:		return TEXT("Box sweep");
+		}
+		return TEXT("");
+	}
+
+	struct FTrace
+	{
+		FVec3 Start;
+		FVec3 Dir;
+		FReal Length;
+	};
+
+	struct FTraceHit
+	{
+		bool bHit = false;
+		FReal Time = 0;
+		FVec3 Position = FVec3(0);
+	};
+
+	/** Rolling hills with some noise, so that the min/max pyramid has empty space above the valleys to skip */
+	static TUniquePtr<FHeightField> MakeHeightField(FRandomStream& Random, int32 NumRows, int32 NumCols, FReal CellSize, FReal HillHeight)
+	{
+		TArray<FReal> Heights;
+		Heights.SetNumUninitialized(NumRows * NumCols);
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			for (int32 Col = 0; Col < NumCols; ++Col)
+			{
+				Heights[Row * NumCols + Col] = HillHeight * (FMath::Sin(Row * 0.05) * FMath::Cos(Col * 0.037) + 0.05 * Random.FRand());
+			}
+		}
+
+		TArray<uint8> MaterialIndices = { 0 };
+		return MakeUnique<FHeightField>(MoveTemp(Heights), MoveTemp(MaterialIndices), NumRows, NumCols, FVec3(CellSize, CellSize, 1));
+	}
+
+	/** Long shallow traces that start above the terrain and cross a large part of it before reaching the ground, if they do */
+	static TArray<FTrace> MakeTraces(FRandomStream& Random, const FAABB3& Bounds, int32 NumTraces)
+	{
+		TArray<FTrace> Traces;
+		Traces.Reserve(NumTraces);
+		const FVec3 Extents = Bounds.Extents();
+		for (int32 TraceIndex = 0; TraceIndex < NumTraces; ++TraceIndex)
+		{
+			const FReal Angle = Random.FRandRange(0, UE_TWO_PI);
+			const FVec3 Dir = FVec3(FMath::Cos(Angle), FMath::Sin(Angle), -Random.FRandRange(0.0, 0.1)).GetSafeNormal();
+			const FVec3 Start(
+				Bounds.Min().X + Random.FRand() * Extents.X,
+				Bounds.Min().Y + Random.FRand() * Extents.Y,
+				Bounds.Max().Z + Random.FRand() * Extents.Z * 0.5);
+			Traces.Add({ Start, Dir, Extents.GetMax() * Random.FRandRange(0.25, 1.0) });
+		}
+		return Traces;
+	}
+
+	static FTraceHit RunTrace(const FHeightField& HeightField, const FTrace& Trace, EQueryType Type)
+	{
+		FTraceHit Hit;
+		FVec3 Normal;
+		FVec3 FaceNormal;
+		int32 FaceIndex;
+		switch (Type)
+		{
+		case EQueryType::Raycast:
+			Hit.bHit = HeightField.Raycast(Trace.Start, Trace.Dir, Trace.Length, 0, Hit.Time, Hit.Position, Normal, FaceIndex);
+			break;
+		case EQueryType::ThickRaycast:
+			Hit.bHit = HeightField.Raycast(Trace.Start, Trace.Dir, Trace.Length, 20, Hit.Time, Hit.Position, Normal, FaceIndex);
+			break;
+		case EQueryType::SphereSweep:
+			Hit.bHit = HeightField.SweepGeom(FSphere(FVec3(0), 30), FRigidTransform3(Trace.Start, FRotation3::Identity), Trace.Dir, Trace.Length, Hit.Time, Hit.Position, Normal, FaceIndex, FaceNormal);
+			break;
+		case EQueryType::BoxSweep:
+			Hit.bHit = HeightField.SweepGeom(TBox<FReal, 3>(FVec3(-25, -25, -40), FVec3(25, 25, 40)), FRigidTransform3(Trace.Start, FRotation3::Identity), Trace.Dir, Trace.Length, Hit.Time, Hit.Position, Normal, FaceIndex, FaceNormal);
+			break;
+		}
+		return Hit;
+	}
+
+	struct FScopedMinMaxPyramid
+	{
+		explicit FScopedMinMaxPyramid(bool bEnabled)
+			: bPrevious(bChaos_HeightField_UseMinMaxPyramid)
+		{
+			bChaos_HeightField_UseMinMaxPyramid = bEnabled;
+		}
+
+		~FScopedMinMaxPyramid()
+		{
+			bChaos_HeightField_UseMinMaxPyramid = bPrevious;
+		}
+
+		bool bPrevious;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHeightFieldMinMaxPyramidTest, "Physics.HeightField.MinMaxPyramid", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FHeightFieldMinMaxPyramidTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::HeightFieldQueryTests;
+
+	FRandomStream Random(1234);
+
+	// Not a power of two in either direction, so the pyramid has partial nodes along the edges
+	const TUniquePtr<FHeightField> HeightField = MakeHeightField(Random, 157, 203, 100, 500);
+	const TArray<FTrace> Traces = MakeTraces(Random, HeightField->BoundingBox(), 1000);
+
+	for (const EQueryType Type : { EQueryType::Raycast, EQueryType::ThickRaycast, EQueryType::SphereSweep, EQueryType::BoxSweep })
+	{
+		int32 NumHits = 0;
+		int32 NumMismatches = 0;
+		for (const FTrace& Trace : Traces)
+		{
+			FTraceHit CellWalkHit;
+			{
+				FScopedMinMaxPyramid ScopedPyramid(false);
+				CellWalkHit = RunTrace(*HeightField, Trace, Type);
+			}
+
+			FTraceHit PyramidHit;
+			{
+				FScopedMinMaxPyramid ScopedPyramid(true);
+				PyramidHit = RunTrace(*HeightField, Trace, Type);
+			}
+
+			NumHits += CellWalkHit.bHit;
+			if (CellWalkHit.bHit != PyramidHit.bHit || (CellWalkHit.bHit && (!FMath::IsNearlyEqual(CellWalkHit.Time, PyramidHit.Time, (FReal)0.1) || !FVec3::PointsAreNear(CellWalkHit.Position, PyramidHit.Position, (FReal)0.1))))
+			{
+				++NumMismatches;
+			}
+		}
+
+		TestTrue(FString::Printf(TEXT("%s hit the terrain"), GetQueryTypeName(Type)), NumHits > 0 && NumHits < Traces.Num());
+		TestEqual(FString::Printf(TEXT("%s pyramid hits match the cell walk"), GetQueryTypeName(Type)), NumMismatches, 0);
+	}
+
+	// Traces that start beside the terrain and traces that miss it entirely
+	const FTrace Outside[] =
+	{
+		{ FVec3(-1000, 5000, 0), FVec3(1, 0, 0), 30000 },
+		{ FVec3(-1000, 5000, 10000), FVec3(1, 0, 0), 30000 },
+		{ FVec3(5000, 5000, 10000), FVec3(0, 0, -1), 20000 },
+	};
+	FScopedMinMaxPyramid ScopedPyramid(true);
+	for (const EQueryType Type : { EQueryType::Raycast, EQueryType::SphereSweep })
+	{
+		TestTrue(FString::Printf(TEXT("%s from outside hits"), GetQueryTypeName(Type)), RunTrace(*HeightField, Outside[0], Type).bHit);
+		TestFalse(FString::Printf(TEXT("%s above the terrain misses"), GetQueryTypeName(Type)), RunTrace(*HeightField, Outside[1], Type).bHit);
+		TestTrue(FString::Printf(TEXT("%s straight down hits"), GetQueryTypeName(Type)), RunTrace(*HeightField, Outside[2], Type).bHit);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHeightFieldMinMaxPyramidPerfTest, "Physics.HeightField.MinMaxPyramidPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FHeightFieldMinMaxPyramidPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::HeightFieldQueryTests;
+
+	// 8km square at 4m per cell
+	FRandomStream Random(1234);
+	const TUniquePtr<FHeightField> HeightField = MakeHeightField(Random, 2049, 2049, 400, 20000);
+	const TArray<FTrace> Traces = MakeTraces(Random, HeightField->BoundingBox(), 2048);
+
+	for (const EQueryType Type : { EQueryType::Raycast, EQueryType::ThickRaycast, EQueryType::SphereSweep, EQueryType::BoxSweep })
+	{
+		double SecondsPerMode[2] = {};
+		for (const bool bPyramid : { false, true })
+		{
+			FScopedMinMaxPyramid ScopedPyramid(bPyramid);
+			const double StartTime = FPlatformTime::Seconds();
+			int32 NumHits = 0;
+			for (const FTrace& Trace : Traces)
+			{
+				NumHits += RunTrace(*HeightField, Trace, Type).bHit;
+			}
+			SecondsPerMode[bPyramid] = FPlatformTime::Seconds() - StartTime;
+			AddInfo(FString::Printf(TEXT("%s %s: %.3f ms per 1000 traces, %d hits"), GetQueryTypeName(Type), bPyramid ? TEXT("min/max pyramid") : TEXT("cell walk"), SecondsPerMode[bPyramid] * 1.0e6 / Traces.Num(), NumHits));
+		}
+		AddInfo(FString::Printf(TEXT("%s speedup: %.2fx"), GetQueryTypeName(Type), SecondsPerMode[0] / SecondsPerMode[1]));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
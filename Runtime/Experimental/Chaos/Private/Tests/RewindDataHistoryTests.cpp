@@ -0,0 +1,327 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "RewindData.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Chaos::RewindDataHistoryTests
+{
+	using FPositionBuffer = TParticlePropertyBuffer<FParticlePositionRotation, EChaosProperty::XR>;
+	using FVelocityBuffer = TParticlePropertyBuffer<FParticleVelocities, EChaosProperty::Velocities>;
+
+	/** Body falling and spinning, coming to rest on the ground after a while like most bodies in a scene */
+	struct FBodyMotion
+	{
+		FVec3 X;
+		FVec3 V;
+		FVec3 W;
+		FRotation3 R;
+
+		explicit FBodyMotion(FRandomStream& Random)
+			: X(Random.FRandRange(-50000, 50000), Random.FRandRange(-50000, 50000), Random.FRandRange(0, 2000))
+			, V(Random.FRandRange(-500, 500), Random.FRandRange(-500, 500), Random.FRandRange(0, 500))
+			, W(Random.FRandRange(-5, 5), Random.FRandRange(-5, 5), Random.FRandRange(-5, 5))
+			, R(FRotation3::FromAxisAngle(FVec3(0, 0, 1), Random.FRandRange(0, UE_TWO_PI)))
+		{
+		}
+
+		void Step(const FReal Dt)
+		{
+			if (X.Z <= 0)
+			{
+				X.Z = 0;
+				V = FVec3(0);
+				W = FVec3(0);
+				return;
+			}
+			V.Z -= 980 * Dt;
+			X += V * Dt;
+			R = FRotation3::IntegrateRotationWithAngularVelocity(R, W, Dt);
+		}
+
+		void Write(FPositionBuffer& Positions, FVelocityBuffer& Velocities, const FFrameAndPhase FrameAndPhase, FDirtyPropertiesPool& Pool) const
+		{
+			if (FParticlePositionRotation* XR = Positions.WriteAccessNonDecreasing(FrameAndPhase, Pool))
+			{
+				XR->SetX(X);
+				XR->SetR(R);
+			}
+			if (FParticleVelocities* VW = Velocities.WriteAccessNonDecreasing(FrameAndPhase, Pool))
+			{
+				VW->SetV(V);
+				VW->SetW(W);
+			}
+		}
+	};
+
+	struct FBodyHistory
+	{
+		FBodyHistory(int32 NumFrames, bool bDeltaCompress)
+			: Positions(NumFrames, bDeltaCompress)
+			, Velocities(NumFrames, bDeltaCompress)
+		{
+		}
+
+		void Release(FDirtyPropertiesPool& Pool)
+		{
+			Positions.Release(Pool);
+			Velocities.Release(Pool);
+		}
+
+		FPositionBuffer Positions;
+		FVelocityBuffer Velocities;
+	};
+
+	static FFrameAndPhase MakeFrameAndPhase(int32 Frame)
+	{
+		return FFrameAndPhase{ Frame, FFrameAndPhase::PostPushData };
+	}
+
+	/** Number of frames in [FirstFrame, LastFrame] where the two histories read differently */
+	static int32 CountMismatches(const FBodyHistory& Expected, const FBodyHistory& Actual, int32 FirstFrame, int32 LastFrame, const FDirtyPropertiesPool& Pool)
+	{
+		int32 NumMismatches = 0;
+		for (int32 Frame = FirstFrame; Frame <= LastFrame; ++Frame)
+		{
+			const FFrameAndPhase FrameAndPhase = MakeFrameAndPhase(Frame);
+			const FParticlePositionRotation* ExpectedXR = Expected.Positions.Read(FrameAndPhase, Pool);
+			const FParticlePositionRotation* ActualXR = Actual.Positions.Read(FrameAndPhase, Pool);
+			const FParticleVelocities* ExpectedVW = Expected.Velocities.Read(FrameAndPhase, Pool);
+			const FParticleVelocities* ActualVW = Actual.Velocities.Read(FrameAndPhase, Pool);
+			if ((ExpectedXR == nullptr) != (ActualXR == nullptr) || (ExpectedXR && !(*ExpectedXR == *ActualXR)))
+			{
+				++NumMismatches;
+			}
+			else if ((ExpectedVW == nullptr) != (ActualVW == nullptr) || (ExpectedVW && !(*ExpectedVW == *ActualVW)))
+			{
+				++NumMismatches;
+			}
+		}
+		return NumMismatches;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRewindDataDeltaHistoryTest, "Physics.RewindData.DeltaHistory", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FRewindDataDeltaHistoryTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::RewindDataHistoryTests;
+
+	constexpr int32 NumFrames = 60;
+	constexpr int32 NumBodies = 32;
+	constexpr FReal Dt = 1.0 / 60.0;
+
+	FDirtyPropertiesPool Pool;
+	FRandomStream Random(1234);
+	TArray<FBodyMotion> Bodies;
+	TArray<FBodyHistory> FullHistories;
+	TArray<FBodyHistory> DeltaHistories;
+	for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+	{
+		Bodies.Emplace(Random);
+		FullHistories.Emplace(NumFrames, false);
+		DeltaHistories.Emplace(NumFrames, true);
+	}
+	TestTrue(TEXT("Positions are delta compressed"), DeltaHistories[0].Positions.IsDeltaCompressed());
+	TestTrue(TEXT("Velocities are delta compressed"), DeltaHistories[0].Velocities.IsDeltaCompressed());
+
+	// Record past the capacity so that old blocks get evicted, with some bodies skipping frames like particles that aren't dirty
+	int32 Frame = 0;
+	int32 NumMismatches = 0;
+	for (; Frame < 3 * NumFrames; ++Frame)
+	{
+		for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+		{
+			Bodies[BodyIndex].Step(Dt);
+			if ((Frame + BodyIndex) % 7 != 0)
+			{
+				Bodies[BodyIndex].Write(FullHistories[BodyIndex].Positions, FullHistories[BodyIndex].Velocities, MakeFrameAndPhase(Frame), Pool);
+				Bodies[BodyIndex].Write(DeltaHistories[BodyIndex].Positions, DeltaHistories[BodyIndex].Velocities, MakeFrameAndPhase(Frame), Pool);
+			}
+		}
+
+		if (Frame % 13 == 0)
+		{
+			for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+			{
+				NumMismatches += CountMismatches(FullHistories[BodyIndex], DeltaHistories[BodyIndex], Frame - NumFrames - 5, Frame, Pool);
+			}
+		}
+	}
+	TestEqual(TEXT("Delta history reads match the full history"), NumMismatches, 0);
+
+	// Rewind, as a resim does, and record a different future
+	const int32 RewindFrame = Frame - NumFrames / 2;
+	for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+	{
+		FullHistories[BodyIndex].Positions.ClearEntryAndFuture(MakeFrameAndPhase(RewindFrame));
+		FullHistories[BodyIndex].Velocities.ClearEntryAndFuture(MakeFrameAndPhase(RewindFrame));
+		DeltaHistories[BodyIndex].Positions.ClearEntryAndFuture(MakeFrameAndPhase(RewindFrame));
+		DeltaHistories[BodyIndex].Velocities.ClearEntryAndFuture(MakeFrameAndPhase(RewindFrame));
+
+		FFrameAndPhase FullHead;
+		FFrameAndPhase DeltaHead;
+		const bool bFullHead = FullHistories[BodyIndex].Positions.GetHeadFrameAndPhase(FullHead);
+		const bool bDeltaHead = DeltaHistories[BodyIndex].Positions.GetHeadFrameAndPhase(DeltaHead);
+		if (bFullHead != bDeltaHead || (bFullHead && !(FullHead == DeltaHead)))
+		{
+			++NumMismatches;
+		}
+	}
+	TestEqual(TEXT("Heads match after clearing the future"), NumMismatches, 0);
+
+	for (Frame = RewindFrame; Frame < RewindFrame + NumFrames; ++Frame)
+	{
+		for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+		{
+			Bodies[BodyIndex].W += FVec3(0.1, 0, 0);
+			Bodies[BodyIndex].Step(Dt);
+			Bodies[BodyIndex].Write(FullHistories[BodyIndex].Positions, FullHistories[BodyIndex].Velocities, MakeFrameAndPhase(Frame), Pool);
+			Bodies[BodyIndex].Write(DeltaHistories[BodyIndex].Positions, DeltaHistories[BodyIndex].Velocities, MakeFrameAndPhase(Frame), Pool);
+		}
+	}
+	for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+	{
+		NumMismatches += CountMismatches(FullHistories[BodyIndex], DeltaHistories[BodyIndex], Frame - NumFrames - 5, Frame, Pool);
+		TestEqual(TEXT("Clean frames match"), DeltaHistories[BodyIndex].Positions.IsClean(MakeFrameAndPhase(Frame - NumFrames - 1)), FullHistories[BodyIndex].Positions.IsClean(MakeFrameAndPhase(Frame - NumFrames - 1)));
+	}
+	TestEqual(TEXT("Delta history reads match the full history after a resim"), NumMismatches, 0);
+
+	// Save the buffer states, record past the next eviction and restore them
+	struct FSavedState
+	{
+		int32 ValidCount[4];
+		int32 NextIterator[4];
+	};
+	TArray<FSavedState> SavedStates;
+	for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+	{
+		FSavedState& Saved = SavedStates.AddDefaulted_GetRef();
+		FullHistories[BodyIndex].Positions.ExtractBufferState(Saved.ValidCount[0], Saved.NextIterator[0]);
+		FullHistories[BodyIndex].Velocities.ExtractBufferState(Saved.ValidCount[1], Saved.NextIterator[1]);
+		DeltaHistories[BodyIndex].Positions.ExtractBufferState(Saved.ValidCount[2], Saved.NextIterator[2]);
+		DeltaHistories[BodyIndex].Velocities.ExtractBufferState(Saved.ValidCount[3], Saved.NextIterator[3]);
+	}
+	const int32 SavedFrame = Frame;
+	for (; Frame < SavedFrame + TDeltaPropertyHistory<FParticlePositionRotation>::KeyframeInterval + 4; ++Frame)
+	{
+		for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+		{
+			Bodies[BodyIndex].Step(Dt);
+			Bodies[BodyIndex].Write(FullHistories[BodyIndex].Positions, FullHistories[BodyIndex].Velocities, MakeFrameAndPhase(Frame), Pool);
+			Bodies[BodyIndex].Write(DeltaHistories[BodyIndex].Positions, DeltaHistories[BodyIndex].Velocities, MakeFrameAndPhase(Frame), Pool);
+		}
+	}
+	for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+	{
+		const FSavedState& Saved = SavedStates[BodyIndex];
+		FullHistories[BodyIndex].Positions.RestoreBufferState(Saved.ValidCount[0], Saved.NextIterator[0]);
+		FullHistories[BodyIndex].Velocities.RestoreBufferState(Saved.ValidCount[1], Saved.NextIterator[1]);
+		DeltaHistories[BodyIndex].Positions.RestoreBufferState(Saved.ValidCount[2], Saved.NextIterator[2]);
+		DeltaHistories[BodyIndex].Velocities.RestoreBufferState(Saved.ValidCount[3], Saved.NextIterator[3]);
+
+		FFrameAndPhase DeltaHead;
+		if (!DeltaHistories[BodyIndex].Positions.GetHeadFrameAndPhase(DeltaHead) || !(DeltaHead == MakeFrameAndPhase(SavedFrame - 1)))
+		{
+			++NumMismatches;
+		}
+		// The full history's ring buffer reused the slots of the oldest frames, only compare the ones it still has
+		NumMismatches += CountMismatches(FullHistories[BodyIndex], DeltaHistories[BodyIndex], SavedFrame - NumFrames / 2, SavedFrame - 1, Pool);
+	}
+	TestEqual(TEXT("Restoring a saved state after an eviction matches the full history"), NumMismatches, 0);
+
+	for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+	{
+		DeltaHistories[BodyIndex].Positions.Reset();
+		TestTrue(TEXT("Reset empties the history"), DeltaHistories[BodyIndex].Positions.IsEmpty());
+		FullHistories[BodyIndex].Release(Pool);
+		DeltaHistories[BodyIndex].Release(Pool);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRewindDataDeltaHistoryPerfTest, "Physics.RewindData.DeltaHistoryPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FRewindDataDeltaHistoryPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::RewindDataHistoryTests;
+
+	// 60 frame history of 5k dynamic bodies, recording every frame as with p.Resim.RewindDataOptimization
+	constexpr int32 NumFrames = 60;
+	constexpr int32 NumBodies = 5000;
+	constexpr FReal Dt = 1.0 / 60.0;
+
+	for (const bool bDeltaCompress : { false, true })
+	{
+		const TCHAR* LayoutName = bDeltaCompress ? TEXT("delta") : TEXT("full");
+		FDirtyPropertiesPool Pool;
+		FRandomStream Random(1234);
+		TArray<FBodyMotion> Bodies;
+		TArray<FBodyHistory> Histories;
+		Bodies.Reserve(NumBodies);
+		Histories.Reserve(NumBodies);
+		for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+		{
+			Bodies.Emplace(Random);
+			Histories.Emplace(NumFrames, bDeltaCompress);
+		}
+
+		const double RecordStartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < 2 * NumFrames; ++Frame)
+		{
+			for (int32 BodyIndex = 0; BodyIndex < NumBodies; ++BodyIndex)
+			{
+				Bodies[BodyIndex].Step(Dt);
+				Bodies[BodyIndex].Write(Histories[BodyIndex].Positions, Histories[BodyIndex].Velocities, MakeFrameAndPhase(Frame), Pool);
+			}
+		}
+		const double RecordSeconds = FPlatformTime::Seconds() - RecordStartTime;
+
+		SIZE_T NumBytes = 0;
+		for (const FBodyHistory& History : Histories)
+		{
+			NumBytes += sizeof(FBodyHistory) + History.Positions.GetAllocatedSize() + History.Velocities.GetAllocatedSize();
+		}
+
+		// Rewind to the oldest frame and read every frame forward, as the resim does for each body
+		const double ResimStartTime = FPlatformTime::Seconds();
+		FReal Checksum = 0;
+		for (int32 Frame = NumFrames; Frame < 2 * NumFrames; ++Frame)
+		{
+			for (const FBodyHistory& History : Histories)
+			{
+				if (const FParticlePositionRotation* XR = History.Positions.Read(MakeFrameAndPhase(Frame), Pool))
+				{
+					Checksum += XR->GetX().Z;
+				}
+				if (const FParticleVelocities* VW = History.Velocities.Read(MakeFrameAndPhase(Frame), Pool))
+				{
+					Checksum += VW->GetV().Z;
+				}
+			}
+		}
+		const double ResimSeconds = FPlatformTime::Seconds() - ResimStartTime;
+
+		AddInfo(FString::Printf(TEXT("%s history: %.2f MB, record %.3f ms per frame, resim reads %.3f ms per frame (checksum %f)"),
+			LayoutName, NumBytes / (1024.0 * 1024.0), RecordSeconds * 1000.0 / (2 * NumFrames), ResimSeconds * 1000.0 / NumFrames, Checksum));
+
+		for (FBodyHistory& History : Histories)
+		{
+			History.Release(Pool);
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
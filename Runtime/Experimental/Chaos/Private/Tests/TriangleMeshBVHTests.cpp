@@ -0,0 +1,312 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Algo/BinarySearch.h"
+#include "Chaos/ChaosArchive.h"
+#include "Chaos/Sphere.h"
+#include "Chaos/TriangleMeshImplicitObject.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Chaos
+{
+	extern bool bChaos_TriMeshBVH_Quantize;
+}
+
+namespace Chaos::TriangleMeshBVHTests
+{
+	enum class EQueryType
+	{
+		Raycast,
+		ThickRaycast,
+		SphereSweep,
+	};
+
+	static const TCHAR* GetQueryTypeName(EQueryType Type)
+	{
+		switch (Type)
+		{
+		case EQueryType::Raycast:		return TEXT("Raycast");
+		case EQueryType::ThickRaycast:	return TEXT("Thick raycast");
+		case EQueryType::SphereSweep:	return TEXT("Sphere sweep");
+		}
+		return TEXT("");
+	}
+
+	struct FTrace
+	{
+		FVec3 Start;
+		FVec3 Dir;
+		FReal Length;
+	};
+
+	struct FTraceHit
+	{
+		bool bHit = false;
+		FReal Time = 0;
+		FVec3 Position = FVec3(0);
+	};
+
+	struct FScopedQuantize
+	{
+		explicit FScopedQuantize(bool bEnabled)
+			: bPrevious(bChaos_TriMeshBVH_Quantize)
+		{
+			bChaos_TriMeshBVH_Quantize = bEnabled;
+		}
+
+		~FScopedQuantize()
+		{
+			bChaos_TriMeshBVH_Quantize = bPrevious;
+		}
+
+		bool bPrevious;
+	};
+
+	/** Noisy terrain patch, so that the triangle bounds overlap and vary in height */
+	static TUniquePtr<FTriangleMeshImplicitObject> MakeTerrainMesh(int32 NumQuads, FReal QuadSize, FReal HillHeight, bool bQuantize)
+	{
+		FRandomStream Random(1234);
+		TArray<FVec3f> Vertices;
+		Vertices.Reserve((NumQuads + 1) * (NumQuads + 1));
+		for (int32 Y = 0; Y <= NumQuads; ++Y)
+		{
+			for (int32 X = 0; X <= NumQuads; ++X)
+			{
+				const FReal Height = HillHeight * (FMath::Sin(X * 0.07) * FMath::Cos(Y * 0.05) + 0.1 * Random.FRand());
+				Vertices.Add(FVec3f(FVec3(X * QuadSize, Y * QuadSize, Height)));
+			}
+		}
+
+		TArray<TVec3<int32>> Triangles;
+		Triangles.Reserve(NumQuads * NumQuads * 2);
+		for (int32 Y = 0; Y < NumQuads; ++Y)
+		{
+			for (int32 X = 0; X < NumQuads; ++X)
+			{
+				const int32 V0 = Y * (NumQuads + 1) + X;
+				const int32 V1 = V0 + 1;
+				const int32 V2 = V0 + NumQuads + 1;
+				const int32 V3 = V2 + 1;
+				Triangles.Add(TVec3<int32>(V0, V1, V3));
+				Triangles.Add(TVec3<int32>(V0, V3, V2));
+			}
+		}
+
+		TArray<uint16> TriangleMaterials;
+		TriangleMaterials.SetNumZeroed(Triangles.Num());
+
+		FScopedQuantize ScopedQuantize(bQuantize);
+		return MakeUnique<FTriangleMeshImplicitObject>(FTriangleMeshImplicitObject::ParticlesType(MoveTemp(Vertices)), MoveTemp(Triangles), MoveTemp(TriangleMaterials));
+	}
+
+	static TArray<FTrace> MakeTraces(FRandomStream& Random, const FAABB3& Bounds, int32 NumTraces)
+	{
+		TArray<FTrace> Traces;
+		Traces.Reserve(NumTraces);
+		const FVec3 Extents = Bounds.Extents();
+		for (int32 TraceIndex = 0; TraceIndex < NumTraces; ++TraceIndex)
+		{
+			const FReal Angle = Random.FRandRange(0, UE_TWO_PI);
+			const FVec3 Dir = FVec3(FMath::Cos(Angle), FMath::Sin(Angle), -Random.FRandRange(0.05, 1.0)).GetSafeNormal();
+			const FVec3 Start(
+				Bounds.Min().X + Random.FRand() * Extents.X,
+				Bounds.Min().Y + Random.FRand() * Extents.Y,
+				Bounds.Max().Z + Random.FRand() * 1000);
+			Traces.Add({ Start, Dir, Extents.GetMax() * Random.FRandRange(0.1, 0.5) });
+		}
+		return Traces;
+	}
+
+	static TArray<FAABB3> MakeOverlapBounds(FRandomStream& Random, const FAABB3& Bounds, int32 NumQueries)
+	{
+		TArray<FAABB3> Queries;
+		Queries.Reserve(NumQueries);
+		const FVec3 Extents = Bounds.Extents();
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			const FVec3 Center = Bounds.Min() + FVec3(Random.FRand(), Random.FRand(), Random.FRand()) * Extents;
+			const FVec3 HalfExtents = FVec3(Random.FRandRange(10, 500), Random.FRandRange(10, 500), Random.FRandRange(10, 500));
+			Queries.Add(FAABB3(Center - HalfExtents, Center + HalfExtents));
+		}
+		return Queries;
+	}
+
+	static FTraceHit RunTrace(const FTriangleMeshImplicitObject& TriMesh, const FTrace& Trace, EQueryType Type)
+	{
+		FTraceHit Hit;
+		FVec3 Normal;
+		FVec3 FaceNormal;
+		int32 FaceIndex;
+		switch (Type)
+		{
+		case EQueryType::Raycast:
+			Hit.bHit = TriMesh.Raycast(Trace.Start, Trace.Dir, Trace.Length, 0, Hit.Time, Hit.Position, Normal, FaceIndex);
+			break;
+		case EQueryType::ThickRaycast:
+			Hit.bHit = TriMesh.Raycast(Trace.Start, Trace.Dir, Trace.Length, 20, Hit.Time, Hit.Position, Normal, FaceIndex);
+			break;
+		case EQueryType::SphereSweep:
+			Hit.bHit = TriMesh.SweepGeom(FSphere(FVec3(0), 30), FRigidTransform3(Trace.Start, FRotation3::Identity), Trace.Dir, Trace.Length, Hit.Time, Hit.Position, Normal, FaceIndex, FaceNormal);
+			break;
+		}
+		return Hit;
+	}
+
+	/** Number of faces in Expected that are missing from Actual */
+	static int32 CountMissingFaces(TArray<int32> Expected, TArray<int32> Actual)
+	{
+		Expected.Sort();
+		Actual.Sort();
+		int32 NumMissing = 0;
+		for (const int32 FaceIndex : Expected)
+		{
+			if (Algo::BinarySearch(Actual, FaceIndex) == INDEX_NONE)
+			{
+				++NumMissing;
+			}
+		}
+		return NumMissing;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTriangleMeshBVHQuantizedTest, "Physics.TriangleMeshBVH.Quantized", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FTriangleMeshBVHQuantizedTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::TriangleMeshBVHTests;
+
+	const TUniquePtr<FTriangleMeshImplicitObject> FullMesh = MakeTerrainMesh(64, 100, 800, false);
+	const TUniquePtr<FTriangleMeshImplicitObject> QuantizedMesh = MakeTerrainMesh(64, 100, 800, true);
+	const FTrimeshBVH& FullBVH = FullMesh->GetBVH();
+	const FTrimeshBVH& QuantizedBVH = QuantizedMesh->GetBVH();
+
+	TestFalse(TEXT("Default BVH is not quantized"), FullBVH.IsQuantized());
+	TestTrue(TEXT("BVH is quantized"), QuantizedBVH.IsQuantized());
+	TestTrue(TEXT("Quantized BVH is less than 60% of the size"), QuantizedBVH.GetAllocatedSize() < FullBVH.GetAllocatedSize() * 6 / 10);
+
+	FRandomStream Random(5678);
+	const TArray<FTrace> Traces = MakeTraces(Random, FullMesh->BoundingBox(), 1000);
+	for (const EQueryType Type : { EQueryType::Raycast, EQueryType::ThickRaycast, EQueryType::SphereSweep })
+	{
+		int32 NumHits = 0;
+		int32 NumMismatches = 0;
+		for (const FTrace& Trace : Traces)
+		{
+			const FTraceHit FullHit = RunTrace(*FullMesh, Trace, Type);
+			const FTraceHit QuantizedHit = RunTrace(*QuantizedMesh, Trace, Type);
+			NumHits += FullHit.bHit;
+			if (FullHit.bHit != QuantizedHit.bHit || (FullHit.bHit && (!FMath::IsNearlyEqual(FullHit.Time, QuantizedHit.Time, (FReal)0.1) || !FVec3::PointsAreNear(FullHit.Position, QuantizedHit.Position, (FReal)0.1))))
+			{
+				++NumMismatches;
+			}
+		}
+
+		TestTrue(FString::Printf(TEXT("%s hit the mesh"), GetQueryTypeName(Type)), NumHits > 0 && NumHits < Traces.Num());
+		TestEqual(FString::Printf(TEXT("%s quantized hits match full precision"), GetQueryTypeName(Type)), NumMismatches, 0);
+	}
+
+	// Quantized bounds only ever grow, so overlaps can return extra candidates but never miss one
+	const TArray<FAABB3> Overlaps = MakeOverlapBounds(Random, FullMesh->BoundingBox(), 500);
+	int32 NumMissingFaces = 0;
+	for (const FAABB3& Bounds : Overlaps)
+	{
+		NumMissingFaces += CountMissingFaces(FullBVH.FindAllIntersections(Bounds), QuantizedBVH.FindAllIntersections(Bounds));
+	}
+	TestEqual(TEXT("Quantized overlaps contain all full precision overlaps"), NumMissingFaces, 0);
+
+	// Round trip through the versioned archive path
+	FTrimeshBVH SavedBVH = QuantizedBVH;
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	{
+		FChaosArchive WriterAr(Writer);
+		WriterAr << SavedBVH;
+	}
+
+	FTrimeshBVH LoadedBVH;
+	FMemoryReader Reader(Data);
+	Reader.SetCustomVersions(Writer.GetCustomVersions());
+	{
+		FChaosArchive ReaderAr(Reader);
+		ReaderAr << LoadedBVH;
+	}
+
+	TestTrue(TEXT("Loaded BVH is quantized"), LoadedBVH.IsQuantized());
+	int32 NumLoadedMismatches = 0;
+	for (const FAABB3& Bounds : Overlaps)
+	{
+		NumLoadedMismatches += QuantizedBVH.FindAllIntersections(Bounds) != LoadedBVH.FindAllIntersections(Bounds);
+	}
+	TestEqual(TEXT("Loaded BVH matches the saved one"), NumLoadedMismatches, 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTriangleMeshBVHQuantizedPerfTest, "Physics.TriangleMeshBVH.QuantizedPerf", \
+	EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FTriangleMeshBVHQuantizedPerfTest::RunTest(const FString& Parameters)
+{
+	using namespace Chaos;
+	using namespace Chaos::TriangleMeshBVHTests;
+
+	// About 500k triangles over 5km
+	const TUniquePtr<FTriangleMeshImplicitObject> Meshes[2] =
+	{
+		MakeTerrainMesh(512, 1000, 5000, false),
+		MakeTerrainMesh(512, 1000, 5000, true),
+	};
+	const TCHAR* LayoutNames[2] = { TEXT("full precision"), TEXT("quantized") };
+
+	for (int32 Layout = 0; Layout < 2; ++Layout)
+	{
+		AddInfo(FString::Printf(TEXT("BVH memory %s: %.1f KB"), LayoutNames[Layout], Meshes[Layout]->GetBVH().GetAllocatedSize() / 1024.0));
+	}
+
+	FRandomStream Random(5678);
+	const TArray<FTrace> Traces = MakeTraces(Random, Meshes[0]->BoundingBox(), 4096);
+	for (const EQueryType Type : { EQueryType::Raycast, EQueryType::ThickRaycast, EQueryType::SphereSweep })
+	{
+		double SecondsPerLayout[2] = {};
+		for (int32 Layout = 0; Layout < 2; ++Layout)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			int32 NumHits = 0;
+			for (const FTrace& Trace : Traces)
+			{
+				NumHits += RunTrace(*Meshes[Layout], Trace, Type).bHit;
+			}
+			SecondsPerLayout[Layout] = FPlatformTime::Seconds() - StartTime;
+			AddInfo(FString::Printf(TEXT("%s %s: %.3f ms per 1000 traces, %d hits"), GetQueryTypeName(Type), LayoutNames[Layout], SecondsPerLayout[Layout] * 1.0e6 / Traces.Num(), NumHits));
+		}
+		AddInfo(FString::Printf(TEXT("%s quantized cost: %.2fx"), GetQueryTypeName(Type), SecondsPerLayout[1] / SecondsPerLayout[0]));
+	}
+
+	const TArray<FAABB3> Overlaps = MakeOverlapBounds(Random, Meshes[0]->BoundingBox(), 4096);
+	double SecondsPerLayout[2] = {};
+	for (int32 Layout = 0; Layout < 2; ++Layout)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		int32 NumFaces = 0;
+		for (const FAABB3& Bounds : Overlaps)
+		{
+			NumFaces += Meshes[Layout]->GetBVH().FindAllIntersections(Bounds).Num();
+		}
+		SecondsPerLayout[Layout] = FPlatformTime::Seconds() - StartTime;
+		AddInfo(FString::Printf(TEXT("Overlap %s: %.3f ms per 1000 queries, %d candidate faces"), LayoutNames[Layout], SecondsPerLayout[Layout] * 1.0e6 / Overlaps.Num(), NumFaces));
+	}
+	AddInfo(FString::Printf(TEXT("Overlap quantized cost: %.2fx"), SecondsPerLayout[1] / SecondsPerLayout[0]));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -781,6 +781,99 @@ struct TDefaultAABBTreeStorageTraits
 	{}
 };
 
+/**
+ * Up to four children of a static TAABBTree node, collapsed from the binary nodes below it, with the child bounds in SoA
+ * form so that one SIMD test covers all of them. See TAABBTree::SetUseWideNodes.
+ */
+struct FAABBTreeWideNode
+{
+	static constexpr int32 MaxChildren = 4;
+
+	/** Bounds of the children per axis, unused children have inverted bounds */
+	double Min[3][MaxChildren];
+	double Max[3][MaxChildren];
+
+	/** Index of the child wide node, or the leaf index encoded with MakeLeafChild */
+	int32 Children[MaxChildren];
+	int32 NumChildren;
+
+	static int32 MakeLeafChild(int32 LeafIdx) { return -2 - LeafIdx; }
+	static bool IsLeafChild(int32 Child) { return Child < INDEX_NONE; }
+	static int32 GetLeafIdx(int32 Child) { return -2 - Child; }
+};
+
+/** One ray or sweep of a batched query, see TAABBTree::RaycastBatch and TAABBTree::SweepBatch */
+struct FAABBTreeBatchQuery
+{
+	FVec3 Start;
+	FVec3 Dir;
+	FReal Length;
+
+	/** Only used by sweeps */
+	FVec3 HalfExtents = FVec3(0);
+};
+
+/**
+ * Presents one query of a batch as a regular spatial visitor, so the leaves and the elements outside of the nodes are
+ * visited with the same code as single queries. The batch visitor receives the index of the query with each callback.
+ */
+template <typename TPayloadType, typename TBatchVisitor>
+class TSpatialBatchQueryVisitor
+{
+public:
+	TSpatialBatchQueryVisitor(TBatchVisitor& InVisitor, int32 InQueryIndex)
+		: Visitor(InVisitor)
+		, QueryIndex(InQueryIndex)
+	{
+	}
+
+	FORCEINLINE bool VisitOverlap(const TSpatialVisitorData<TPayloadType>& Instance)
+	{
+		check(false);
+		return true;
+	}
+
+	FORCEINLINE bool VisitRaycast(const TSpatialVisitorData<TPayloadType>& Instance, FQueryFastData& CurData)
+	{
+		return Visitor.VisitRaycast(QueryIndex, Instance, CurData);
+	}
+
+	FORCEINLINE bool VisitSweep(const TSpatialVisitorData<TPayloadType>& Instance, FQueryFastData& CurData)
+	{
+		return Visitor.VisitSweep(QueryIndex, Instance, CurData);
+	}
+
+	FORCEINLINE const void* GetQueryData() const
+	{
+		return Visitor.GetQueryData();
+	}
+
+	FORCEINLINE const void* GetSimData() const
+	{
+		return Visitor.GetSimData();
+	}
+
+	FORCEINLINE bool ShouldIgnore(const TSpatialVisitorData<TPayloadType>& Instance) const
+	{
+		return Visitor.ShouldIgnore(QueryIndex, Instance);
+	}
+
+	/** Only used by overlaps */
+	FORCEINLINE const void* GetQueryPayload() const
+	{
+		return nullptr;
+	}
+
+	FORCEINLINE bool HasBlockingHit() const
+	{
+		return false;
+	}
+
+private:
+	TBatchVisitor& Visitor;
+	int32 QueryIndex;
+};
+
 template <typename TPayloadType, typename TLeafType, bool bMutable = true, typename T = FReal, typename StorageTraits = TDefaultAABBTreeStorageTraits<TPayloadType>>
 class TAABBTree final : public ISpatialAcceleration<TPayloadType, T, 3> 
 {
@@ -819,6 +912,7 @@ public:
 	virtual void Reset() override
 	{
 		Nodes.Reset();
+		WideNodes.Reset();
 		Leaves.Reset();
 		DirtyElements.Reset();
 		CellHashToFlatArray.Reset();
@@ -1011,6 +1105,29 @@ public:
 		return QueryImp<EAABBQueryType::Sweep>(Start,CurData, QueryHalfExtents, FAABB3(), Visitor, Dir, InvDir, bParallel);
 	}
 
+	/**
+	 * Raycasts many rays at once. The rays are grouped in packets of four with close origins and the same direction
+	 * signs, and each packet traverses the nodes once, testing its rays against the children bounds with SIMD slab tests.
+	 * The visitor is called with the index of the ray in Queries:
+	 *	bool VisitRaycast(int32 QueryIndex, const TSpatialVisitorData<TPayloadType>& Instance, FQueryFastData& CurData)
+	 *	bool ShouldIgnore(int32 QueryIndex, const TSpatialVisitorData<TPayloadType>& Instance) const
+	 *	const void* GetQueryData() const
+	 *	const void* GetSimData() const
+	 * Returning false from VisitRaycast stops that ray only, the other rays of the batch continue.
+	 */
+	template <typename TBatchVisitor>
+	void RaycastBatch(TArrayView<const FAABBTreeBatchQuery> Queries, TBatchVisitor& Visitor) const
+	{
+		BatchQueryImp<EAABBQueryType::Raycast>(Queries, Visitor);
+	}
+
+	/** Same as RaycastBatch for sweeps of boxes of FAABBTreeBatchQuery::HalfExtents, the visitor implements VisitSweep */
+	template <typename TBatchVisitor>
+	void SweepBatch(TArrayView<const FAABBTreeBatchQuery> Queries, TBatchVisitor& Visitor) const
+	{
+		BatchQueryImp<EAABBQueryType::Sweep>(Queries, Visitor);
+	}
+
 	void Overlap(const FAABB3& QueryBounds, ISpatialVisitor<TPayloadType, FReal>& Visitor) const override
 	{
 		TSpatialVisitor<TPayloadType, FReal> ProxyVisitor(Visitor);
@@ -2182,6 +2299,22 @@ public:
 	virtual bool IsTreeDynamic() const override { return bDynamicTree; }
 	void SetTreeToDynamic() { bDynamicTree = true; } // Tree cannot be changed back to static for now
 
+	/**
+	 * Static trees can be traversed through 4-wide nodes collapsed from the binary nodes once the build completes, each
+	 * step testing all the children with one SIMD test. The binary nodes are kept for updates and debug draw.
+	 * Dynamic trees ignore this, their nodes change with every update.
+	 */
+	void SetUseWideNodes(bool bInUseWideNodes)
+	{
+		bUseWideNodes = bInUseWideNodes;
+		if (WorkStack.Num() == 0)
+		{
+			BuildWideNodes();
+		}
+	}
+
+	bool GetUseWideNodes() const { return bUseWideNodes; }
+
 	virtual void PrepareCopyTimeSliced(const  ISpatialAcceleration<TPayloadType, T, 3>& InFrom) override
 	{
 		check(this != &InFrom);
@@ -2213,10 +2346,12 @@ public:
 		RootNode = From.RootNode;
 		FirstFreeInternalNode = From.FirstFreeInternalNode;
 		FirstFreeLeafNode = From.FirstFreeLeafNode;
+		bUseWideNodes = From.bUseWideNodes;
 
 		// Reserve sizes for arrays etc
 
 		Nodes.Reserve(From.Nodes.Num());
+		WideNodes.Reserve(From.WideNodes.Num());
 		Leaves.Reserve(From.Leaves.Num());
 		DirtyElements.Reserve(From.DirtyElements.Num());
 		CellHashToFlatArray.Reserve(From.CellHashToFlatArray.Num());
@@ -2307,6 +2442,10 @@ public:
 		{
 			return;
 		}
+		if (!ContinueTimeSliceCopy(From.WideNodes, WideNodes, SizeToCopyLeft, CanContinueCopyingDataCallback))
+		{
+			return;
+		}
 		if (!ContinueTimeSliceCopy(From.Leaves, Leaves, SizeToCopyLeft, CanContinueCopyingDataCallback))
 		{
 			return;
@@ -2428,6 +2567,12 @@ public:
 		Ar << MaxTreeDepth;
 		Ar << MaxPayloadBounds;
 
+		// Wide nodes are rebuilt on load rather than serialized
+		if (Ar.CustomVer(FExternalPhysicsCustomObjectVersion::GUID) >= FExternalPhysicsCustomObjectVersion::AABBTreeUseWideNodes)
+		{
+			Ar << bUseWideNodes;
+		}
+
 		if (Ar.IsLoading())
 		{
 			// Disable the Grid until it is rebuilt
@@ -2445,6 +2590,7 @@ public:
 			RootNode = INDEX_NONE;
 			FirstFreeInternalNode = INDEX_NONE;
 			FirstFreeLeafNode = INDEX_NONE;
+			BuildWideNodes();
 		}
 		else
 		{
@@ -2868,16 +3014,10 @@ private:
 		return bCouldUseCache;
 	}
 
+	/** Visits the global payloads and dirty elements, which are not part of the nodes. Returns false if the visitor stopped the query. */
 	template <EAABBQueryType Query, typename TQueryFastData, typename SQVisitor>
-	bool QueryImp(const FVec3& RESTRICT Start, TQueryFastData& CurData, const FVec3& QueryHalfExtents, const FAABB3& QueryBounds, SQVisitor& Visitor, const FVec3& Dir, const FVec3& InvDir, const bool bParallel[3]) const
+	bool QueryGlobalAndDirtyElements(const FVec3& RESTRICT Start, TQueryFastData& CurData, const FVec3& QueryHalfExtents, const FAABB3& QueryBounds, SQVisitor& Visitor, const FVec3& Dir, const FVec3& InvDir, const bool bParallel[3]) const
 	{
-		PHYSICS_CSV_CUSTOM_VERY_EXPENSIVE(PhysicsCounters, MaxDirtyElements, DirtyElements.Num(), ECsvCustomStatOp::Max);
-		PHYSICS_CSV_CUSTOM_VERY_EXPENSIVE(PhysicsCounters, MaxNumLeaves, Leaves.Num(), ECsvCustomStatOp::Max);
-		PHYSICS_CSV_SCOPED_VERY_EXPENSIVE(PhysicsVerbose, QueryImp);
-		//QUICK_SCOPE_CYCLE_COUNTER(AABBTreeQueryImp);
-#if !WITH_EDITOR
-		//CSV_SCOPED_TIMING_STAT(ChaosPhysicsTimers, AABBTreeQuery)
-#endif
 		FReal TOI = 0;
 		{
 			//QUICK_SCOPE_CYCLE_COUNTER(QueryGlobal);
@@ -3026,6 +3166,26 @@ private:
 			}
 		}
 
+		return true;
+	}
+
+	template <EAABBQueryType Query, typename TQueryFastData, typename SQVisitor>
+	bool QueryImp(const FVec3& RESTRICT Start, TQueryFastData& CurData, const FVec3& QueryHalfExtents, const FAABB3& QueryBounds, SQVisitor& Visitor, const FVec3& Dir, const FVec3& InvDir, const bool bParallel[3]) const
+	{
+		PHYSICS_CSV_CUSTOM_VERY_EXPENSIVE(PhysicsCounters, MaxDirtyElements, DirtyElements.Num(), ECsvCustomStatOp::Max);
+		PHYSICS_CSV_CUSTOM_VERY_EXPENSIVE(PhysicsCounters, MaxNumLeaves, Leaves.Num(), ECsvCustomStatOp::Max);
+		PHYSICS_CSV_SCOPED_VERY_EXPENSIVE(PhysicsVerbose, QueryImp);
+		//QUICK_SCOPE_CYCLE_COUNTER(AABBTreeQueryImp);
+#if !WITH_EDITOR
+		//CSV_SCOPED_TIMING_STAT(ChaosPhysicsTimers, AABBTreeQuery)
+#endif
+		if (!QueryGlobalAndDirtyElements<Query>(Start, CurData, QueryHalfExtents, QueryBounds, Visitor, Dir, InvDir, bParallel))
+		{
+			return false;
+		}
+
+		FReal TOI = 0;
+
 		struct FNodeQueueEntry
 		{
 			int32 NodeIdx;
@@ -3042,6 +3202,11 @@ private:
 				return bOverlapResult;
 			}
 		}
+
+		if (!WideNodes.IsEmpty())
+		{
+			return QueryWideNodes<Query>(Start, CurData, QueryHalfExtents, QueryBounds, Visitor, Dir, InvDir, bParallel);
+		}
 		
 		constexpr int32 MaxNodeStackNumOnSystemStack = 255;
 		TArray<FNodeQueueEntry, TSizedInlineAllocator<MaxNodeStackNumOnSystemStack,32> > NodeStack;
@@ -3194,6 +3359,534 @@ private:
 		return true;
 	}
 
+	/** Same as the node traversal of QueryImp over WideNodes, testing the query against the four children of a node at once */
+	template <EAABBQueryType Query, typename TQueryFastData, typename SQVisitor>
+	bool QueryWideNodes(const FVec3& RESTRICT Start, TQueryFastData& CurData, const FVec3& QueryHalfExtents, const FAABB3& QueryBounds, SQVisitor& Visitor, const FVec3& Dir, const FVec3& InvDir, const bool bParallel[3]) const
+	{
+		PHYSICS_CSV_SCOPED_VERY_EXPENSIVE(PhysicsVerbose, QueryImp_WideNodeTraverse);
+
+		struct FWideQueueEntry
+		{
+			int32 Child;
+			FReal TOI;
+		};
+
+		constexpr int32 MaxNodeStackNumOnSystemStack = 255;
+		TArray<FWideQueueEntry, TSizedInlineAllocator<MaxNodeStackNumOnSystemStack, 32> > NodeStack;
+		NodeStack.Emplace(FWideQueueEntry{ 0, 0 });
+
+		// The query replicated across the four lanes, one register per axis
+		VectorRegister4Double QueryMin[3];
+		VectorRegister4Double QueryMax[3];
+		VectorRegister4Double StartLanes[3];
+		VectorRegister4Double InvDirLanes[3];
+		VectorRegister4Double ParallelLanes[3];
+		VectorRegister4Double HalfExtentsLanes[3];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if constexpr (Query == EAABBQueryType::Overlap)
+			{
+				QueryMin[Axis] = VectorSetDouble1(QueryBounds.Min()[Axis]);
+				QueryMax[Axis] = VectorSetDouble1(QueryBounds.Max()[Axis]);
+			}
+			else
+			{
+				StartLanes[Axis] = VectorSetDouble1(Start[Axis]);
+				InvDirLanes[Axis] = VectorSetDouble1(InvDir[Axis]);
+				ParallelLanes[Axis] = bParallel[Axis] ? GlobalVectorConstants::DoubleAllMask() : VectorZeroDouble();
+				HalfExtentsLanes[Axis] = Query == EAABBQueryType::Sweep ? VectorSetDouble1(QueryHalfExtents[Axis]) : VectorZeroDouble();
+			}
+		}
+
+		// The leaves use the same tests as QueryImp
+		VectorRegister4Double StartSimd;
+		VectorRegister4Double DirSimd;
+		VectorRegister4Double Parallel;
+		VectorRegister4Double InvDirSimd;
+		VectorRegister4Double LengthSimd;
+
+		if constexpr (Query == EAABBQueryType::Raycast)
+		{
+			StartSimd = VectorLoadDouble3(&Start.X);
+			DirSimd = VectorLoadDouble3(&Dir.X);
+			Parallel = VectorCompareGT(GlobalVectorConstants::DoubleSmallNumber, VectorAbs(DirSimd));
+			InvDirSimd = VectorBitwiseNotAnd(Parallel, VectorDivide(VectorOne(), DirSimd));
+			LengthSimd = VectorSetDouble1(CurData.CurrentLength);
+		}
+
+		while (NodeStack.Num())
+		{
+			const FWideQueueEntry NodeEntry = NodeStack.Pop(EAllowShrinking::No);
+			if constexpr (Query != EAABBQueryType::Overlap)
+			{
+				if (NodeEntry.TOI > CurData.CurrentLength)
+				{
+					continue;
+				}
+			}
+
+			if (FAABBTreeWideNode::IsLeafChild(NodeEntry.Child))
+			{
+				PHYSICS_CSV_SCOPED_VERY_EXPENSIVE(PhysicsVerbose, NodeTraverse_Leaf);
+				const auto& Leaf = Leaves[FAABBTreeWideNode::GetLeafIdx(NodeEntry.Child)];
+				if constexpr (Query == EAABBQueryType::Overlap)
+				{
+					if (Leaf.OverlapFast(QueryBounds, Visitor) == false)
+					{
+						return false;
+					}
+				}
+				else if constexpr (Query == EAABBQueryType::Sweep)
+				{
+					if (Leaf.SweepFast(Start, CurData, QueryHalfExtents, Visitor, Dir, InvDir, bParallel) == false)
+					{
+						return false;
+					}
+				}
+				else if (Leaf.RaycastFastSimd(StartSimd, CurData, Visitor, DirSimd, InvDirSimd, Parallel, LengthSimd) == false)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const FAABBTreeWideNode& Node = WideNodes[NodeEntry.Child];
+			VectorRegister4Double ChildMin[3];
+			VectorRegister4Double ChildMax[3];
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				ChildMin[Axis] = VectorLoad(Node.Min[Axis]);
+				ChildMax[Axis] = VectorLoad(Node.Max[Axis]);
+			}
+
+			const int32 ValidMask = (1 << Node.NumChildren) - 1;
+			if constexpr (Query == EAABBQueryType::Overlap)
+			{
+				VectorRegister4Double IsFalse = VectorZeroDouble();
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					IsFalse = VectorBitwiseOr(IsFalse, VectorBitwiseOr(VectorCompareGT(ChildMin[Axis], QueryMax[Axis]), VectorCompareGT(QueryMin[Axis], ChildMax[Axis])));
+				}
+
+				const int32 HitMask = ~VectorMaskBits(IsFalse) & ValidMask;
+				for (int32 ChildIdx = 0; ChildIdx < Node.NumChildren; ++ChildIdx)
+				{
+					if (HitMask & (1 << ChildIdx))
+					{
+						NodeStack.Emplace(FWideQueueEntry{ Node.Children[ChildIdx], 0 });
+					}
+				}
+			}
+			else
+			{
+				// Sweeps test the center of the box against the bounds grown by the half extents
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					ChildMin[Axis] = VectorSubtract(ChildMin[Axis], HalfExtentsLanes[Axis]);
+					ChildMax[Axis] = VectorAdd(ChildMax[Axis], HalfExtentsLanes[Axis]);
+				}
+
+				VectorRegister4Double TOISimd;
+				const int32 HitMask = RaycastLanes(ChildMin, ChildMax, StartLanes, InvDirLanes, ParallelLanes, VectorSetDouble1(CurData.CurrentLength), TOISimd) & ValidMask;
+				if (HitMask == 0)
+				{
+					continue;
+				}
+
+				double TOIs[FAABBTreeWideNode::MaxChildren];
+				VectorStore(TOISimd, TOIs);
+
+				// Push the hit children from the farthest to the nearest so the nearest is visited first
+				FWideQueueEntry Hits[FAABBTreeWideNode::MaxChildren];
+				int32 NumHits = 0;
+				for (int32 ChildIdx = 0; ChildIdx < Node.NumChildren; ++ChildIdx)
+				{
+					if (HitMask & (1 << ChildIdx))
+					{
+						int32 InsertIdx = NumHits++;
+						for (; InsertIdx > 0 && Hits[InsertIdx - 1].TOI < TOIs[ChildIdx]; --InsertIdx)
+						{
+							Hits[InsertIdx] = Hits[InsertIdx - 1];
+						}
+						Hits[InsertIdx] = FWideQueueEntry{ Node.Children[ChildIdx], TOIs[ChildIdx] };
+					}
+				}
+
+				for (int32 HitIdx = 0; HitIdx < NumHits; ++HitIdx)
+				{
+					NodeStack.Emplace(Hits[HitIdx]);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	/** Collapses the binary nodes of a static tree into WideNodes, opening the largest internal children first */
+	void BuildWideNodes()
+	{
+		WideNodes.Reset();
+		if (!bUseWideNodes || bDynamicTree || Nodes.Num() == 0 || Nodes[0].bLeaf)
+		{
+			return;
+		}
+
+		// Each wide node replaces about three binary internal nodes
+		WideNodes.Reserve(Nodes.Num() / 6 + 1);
+
+		struct FCollapseEntry
+		{
+			int32 NodeIdx;
+			int32 WideNodeIdx;
+		};
+
+		TArray<FCollapseEntry> CollapseStack;
+		CollapseStack.Add(FCollapseEntry{ 0, WideNodes.AddUninitialized(1) });
+
+		while (CollapseStack.Num())
+		{
+			const FCollapseEntry Entry = CollapseStack.Pop(EAllowShrinking::No);
+
+			int32 ChildNodes[FAABBTreeWideNode::MaxChildren];
+			TAABB<T, 3> ChildBounds[FAABBTreeWideNode::MaxChildren];
+			int32 NumChildren = 2;
+			for (int32 ChildIdx = 0; ChildIdx < 2; ++ChildIdx)
+			{
+				ChildNodes[ChildIdx] = Nodes[Entry.NodeIdx].ChildrenNodes[ChildIdx];
+				ChildBounds[ChildIdx] = Nodes[Entry.NodeIdx].ChildrenBounds[ChildIdx];
+			}
+
+			while (NumChildren < FAABBTreeWideNode::MaxChildren)
+			{
+				int32 OpenIdx = INDEX_NONE;
+				T OpenArea = -1;
+				for (int32 ChildIdx = 0; ChildIdx < NumChildren; ++ChildIdx)
+				{
+					if (!Nodes[ChildNodes[ChildIdx]].bLeaf && ChildBounds[ChildIdx].GetArea() > OpenArea)
+					{
+						OpenIdx = ChildIdx;
+						OpenArea = ChildBounds[ChildIdx].GetArea();
+					}
+				}
+
+				if (OpenIdx == INDEX_NONE)
+				{
+					break;
+				}
+
+				const FNode& OpenNode = Nodes[ChildNodes[OpenIdx]];
+				ChildNodes[NumChildren] = OpenNode.ChildrenNodes[1];
+				ChildBounds[NumChildren] = OpenNode.ChildrenBounds[1];
+				ChildNodes[OpenIdx] = OpenNode.ChildrenNodes[0];
+				ChildBounds[OpenIdx] = OpenNode.ChildrenBounds[0];
+				++NumChildren;
+			}
+
+			FAABBTreeWideNode WideNode;
+			WideNode.NumChildren = NumChildren;
+			for (int32 ChildIdx = 0; ChildIdx < FAABBTreeWideNode::MaxChildren; ++ChildIdx)
+			{
+				if (ChildIdx >= NumChildren)
+				{
+					for (int32 Axis = 0; Axis < 3; ++Axis)
+					{
+						WideNode.Min[Axis][ChildIdx] = TNumericLimits<double>::Max();
+						WideNode.Max[Axis][ChildIdx] = TNumericLimits<double>::Lowest();
+					}
+					WideNode.Children[ChildIdx] = INDEX_NONE;
+					continue;
+				}
+
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					WideNode.Min[Axis][ChildIdx] = ChildBounds[ChildIdx].Min()[Axis];
+					WideNode.Max[Axis][ChildIdx] = ChildBounds[ChildIdx].Max()[Axis];
+				}
+
+				const FNode& ChildNode = Nodes[ChildNodes[ChildIdx]];
+				if (ChildNode.bLeaf)
+				{
+					WideNode.Children[ChildIdx] = FAABBTreeWideNode::MakeLeafChild(ChildNode.ChildrenNodes[0]);
+				}
+				else
+				{
+					WideNode.Children[ChildIdx] = WideNodes.AddUninitialized(1);
+					CollapseStack.Add(FCollapseEntry{ ChildNodes[ChildIdx], WideNode.Children[ChildIdx] });
+				}
+			}
+
+			WideNodes[Entry.WideNodeIdx] = WideNode;
+		}
+	}
+
+	/** Four queries of a batch in SoA form, lanes past the end of the batch repeat the last query */
+	struct FBatchQueryPacket
+	{
+		int32 QueryIndices[4];
+		VectorRegister4Double Start[3];
+		VectorRegister4Double InvDir[3];
+		VectorRegister4Double Parallel[3];
+		VectorRegister4Double HalfExtents[3];
+		VectorRegister4Double Length;
+	};
+
+	/**
+	 * Slab test of four rays against four boxes, one of each per lane. Returns the mask of the lanes that hit, OutTOI holds
+	 * the entry time of each lane. Parallel lanes have an all set mask in Parallel and a zero InvDir for that axis.
+	 */
+	static FORCEINLINE_DEBUGGABLE int32 RaycastLanes(const VectorRegister4Double Min[3], const VectorRegister4Double Max[3], const VectorRegister4Double Start[3],
+		const VectorRegister4Double InvDir[3], const VectorRegister4Double Parallel[3], const VectorRegister4Double& Length, VectorRegister4Double& OutTOI)
+	{
+		VectorRegister4Double IsFalse = VectorZeroDouble();
+		VectorRegister4Double LatestStartTime = VectorZeroDouble();
+		VectorRegister4Double EarliestEndTime = Length;
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			//parallel and outside
+			const VectorRegister4Double Outside = VectorBitwiseOr(VectorCompareGT(Min[Axis], Start[Axis]), VectorCompareGT(Start[Axis], Max[Axis]));
+			IsFalse = VectorBitwiseOr(IsFalse, VectorBitwiseAnd(Outside, Parallel[Axis]));
+
+			// Same as FAABBVectorizedDouble::RaycastFast, parallel lanes get [0, Length] which doesn't clip the interval
+			const VectorRegister4Double Time1 = VectorBitwiseNotAnd(Parallel[Axis], VectorMultiply(VectorSubtract(Min[Axis], Start[Axis]), InvDir[Axis]));
+			const VectorRegister4Double Time2 = VectorSelect(Parallel[Axis], Length, VectorMultiply(VectorSubtract(Max[Axis], Start[Axis]), InvDir[Axis]));
+			LatestStartTime = VectorMax(LatestStartTime, VectorMin(Time1, Time2));
+			EarliestEndTime = VectorMin(EarliestEndTime, VectorMax(Time1, Time2));
+		}
+
+		//Outside of slab before entering another
+		IsFalse = VectorBitwiseOr(IsFalse, VectorCompareGT(LatestStartTime, EarliestEndTime));
+
+		OutTOI = LatestStartTime;
+		return ~VectorMaskBits(IsFalse) & 0xF;
+	}
+
+	/** Slab test of the four queries of a packet against Bounds. Returns the mask of the lanes that hit, OutTOI holds the entry time of each lane. */
+	static FORCEINLINE_DEBUGGABLE int32 BatchPacketIntersects(const FBatchQueryPacket& Packet, const TAABB<T, 3>& Bounds, VectorRegister4Double& OutTOI)
+	{
+		// Sweeps test the center of the box against the bounds grown by the half extents
+		VectorRegister4Double Min[3];
+		VectorRegister4Double Max[3];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Min[Axis] = VectorSubtract(VectorSetDouble1(Bounds.Min()[Axis]), Packet.HalfExtents[Axis]);
+			Max[Axis] = VectorAdd(VectorSetDouble1(Bounds.Max()[Axis]), Packet.HalfExtents[Axis]);
+		}
+		return RaycastLanes(Min, Max, Packet.Start, Packet.InvDir, Packet.Parallel, Packet.Length, OutTOI);
+	}
+
+	template <EAABBQueryType Query, typename TBatchVisitor>
+	void BatchQueryImp(TArrayView<const FAABBTreeBatchQuery> Queries, TBatchVisitor& Visitor) const
+	{
+		static_assert(Query != EAABBQueryType::Overlap, "Batched overlaps are not supported");
+		using FBatchVisitor = TSpatialBatchQueryVisitor<TPayloadType, TBatchVisitor>;
+
+		const int32 NumQueries = Queries.Num();
+
+		// FQueryFastData references the direction of its query, it is constructed in place and never moved
+		TArray<FQueryFastData> QueryFastData;
+		QueryFastData.Reserve(NumQueries);
+		for (const FAABBTreeBatchQuery& BatchQuery : Queries)
+		{
+			QueryFastData.Emplace(BatchQuery.Dir, BatchQuery.Length);
+		}
+
+		// The global payloads and dirty elements are visited one query at a time, the queries that are not stopped
+		// by them go on to the nodes
+		TArray<uint64> SortKeys;
+		SortKeys.Reserve(NumQueries);
+		FAABB3 StartBounds = FAABB3::EmptyAABB();
+		for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+		{
+			const FAABBTreeBatchQuery& BatchQuery = Queries[QueryIndex];
+			FQueryFastData& CurData = QueryFastData[QueryIndex];
+			FBatchVisitor QueryVisitor(Visitor, QueryIndex);
+			if (QueryGlobalAndDirtyElements<Query>(BatchQuery.Start, CurData, BatchQuery.HalfExtents, FAABB3(), QueryVisitor, CurData.Dir, CurData.InvDir, CurData.bParallel))
+			{
+				SortKeys.Add(uint64(QueryIndex));
+				StartBounds.GrowToInclude(BatchQuery.Start);
+			}
+		}
+
+		int32 RootIdx = INDEX_NONE;
+		if (bDynamicTree)
+		{
+			RootIdx = RootNode;
+		}
+		else if (Nodes.Num())
+		{
+			RootIdx = 0;
+		}
+
+		if (RootIdx == INDEX_NONE || SortKeys.IsEmpty())
+		{
+			return;
+		}
+
+		// Sort the queries so that each packet holds rays with the same direction signs and close starts, which visit
+		// mostly the same nodes. The key is the direction octant, a 30 bit Morton code of the start, then the query index.
+		auto SpreadBits = [](uint64 Value)
+		{
+			Value = (Value | (Value << 16)) & 0x030000FF;
+			Value = (Value | (Value << 8)) & 0x0300F00F;
+			Value = (Value | (Value << 4)) & 0x030C30C3;
+			Value = (Value | (Value << 2)) & 0x09249249;
+			return Value;
+		};
+
+		for (uint64& Key : SortKeys)
+		{
+			const FAABBTreeBatchQuery& BatchQuery = Queries[int32(Key)];
+			uint64 Octant = 0;
+			uint64 Morton = 0;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				const FReal Extent = StartBounds.Max()[Axis] - StartBounds.Min()[Axis];
+				const uint64 Cell = Extent > UE_SMALL_NUMBER ? FMath::Min<uint64>(uint64((BatchQuery.Start[Axis] - StartBounds.Min()[Axis]) * (1023 / Extent)), 1023) : 0;
+				Octant |= uint64(BatchQuery.Dir[Axis] < 0) << Axis;
+				Morton |= SpreadBits(Cell) << Axis;
+			}
+			Key = (Octant << 61) | (Morton << 31) | Key;
+		}
+		SortKeys.Sort();
+
+		struct FPacketStackEntry
+		{
+			int32 NodeIdx;
+			int32 LaneMask;
+			double TOI[4];
+		};
+
+		constexpr int32 MaxNodeStackNumOnSystemStack = 128;
+		TArray<FPacketStackEntry, TSizedInlineAllocator<MaxNodeStackNumOnSystemStack, 32> > NodeStack;
+
+		for (int32 PacketStart = 0; PacketStart < SortKeys.Num(); PacketStart += 4)
+		{
+			const int32 NumLanes = FMath::Min(4, SortKeys.Num() - PacketStart);
+
+			FBatchQueryPacket Packet;
+			const FAABBTreeBatchQuery* LaneQueries[4];
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				Packet.QueryIndices[Lane] = int32(SortKeys[PacketStart + FMath::Min(Lane, NumLanes - 1)] & 0x7FFFFFFF);
+				LaneQueries[Lane] = &Queries[Packet.QueryIndices[Lane]];
+			}
+
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				const VectorRegister4Double Dir = MakeVectorRegisterDouble(LaneQueries[0]->Dir[Axis], LaneQueries[1]->Dir[Axis], LaneQueries[2]->Dir[Axis], LaneQueries[3]->Dir[Axis]);
+				Packet.Start[Axis] = MakeVectorRegisterDouble(LaneQueries[0]->Start[Axis], LaneQueries[1]->Start[Axis], LaneQueries[2]->Start[Axis], LaneQueries[3]->Start[Axis]);
+				Packet.Parallel[Axis] = VectorCompareGT(GlobalVectorConstants::DoubleSmallNumber, VectorAbs(Dir));
+				Packet.InvDir[Axis] = MakeVectorRegisterDouble(QueryFastData[Packet.QueryIndices[0]].InvDir[Axis], QueryFastData[Packet.QueryIndices[1]].InvDir[Axis],
+					QueryFastData[Packet.QueryIndices[2]].InvDir[Axis], QueryFastData[Packet.QueryIndices[3]].InvDir[Axis]);
+				if constexpr (Query == EAABBQueryType::Sweep)
+				{
+					Packet.HalfExtents[Axis] = MakeVectorRegisterDouble(LaneQueries[0]->HalfExtents[Axis], LaneQueries[1]->HalfExtents[Axis], LaneQueries[2]->HalfExtents[Axis], LaneQueries[3]->HalfExtents[Axis]);
+				}
+				else
+				{
+					Packet.HalfExtents[Axis] = VectorZeroDouble();
+				}
+			}
+
+			// Visitors shorten the queries when they find blocking hits
+			auto UpdateLength = [&Packet, &QueryFastData]()
+			{
+				Packet.Length = MakeVectorRegisterDouble(QueryFastData[Packet.QueryIndices[0]].CurrentLength, QueryFastData[Packet.QueryIndices[1]].CurrentLength,
+					QueryFastData[Packet.QueryIndices[2]].CurrentLength, QueryFastData[Packet.QueryIndices[3]].CurrentLength);
+			};
+			UpdateLength();
+
+			int32 ActiveLanes = (1 << NumLanes) - 1;
+			NodeStack.Reset();
+			NodeStack.Add(FPacketStackEntry{ RootIdx, ActiveLanes, {0, 0, 0, 0} });
+
+			while (NodeStack.Num() && ActiveLanes)
+			{
+				const FPacketStackEntry NodeEntry = NodeStack.Pop(EAllowShrinking::No);
+
+				// Drop the lanes that were stopped or got a hit closer than the node since it was pushed
+				int32 LaneMask = NodeEntry.LaneMask & ActiveLanes;
+				for (int32 Lane = 0; Lane < 4; ++Lane)
+				{
+					if ((LaneMask & (1 << Lane)) && NodeEntry.TOI[Lane] > QueryFastData[Packet.QueryIndices[Lane]].CurrentLength)
+					{
+						LaneMask &= ~(1 << Lane);
+					}
+				}
+
+				if (LaneMask == 0)
+				{
+					continue;
+				}
+
+				const FNode& Node = Nodes[NodeEntry.NodeIdx];
+				if (Node.bLeaf)
+				{
+					const auto& Leaf = Leaves[Node.ChildrenNodes[0]];
+					for (int32 Lane = 0; Lane < 4; ++Lane)
+					{
+						if ((LaneMask & (1 << Lane)) == 0)
+						{
+							continue;
+						}
+
+						const int32 QueryIndex = Packet.QueryIndices[Lane];
+						const FAABBTreeBatchQuery& BatchQuery = Queries[QueryIndex];
+						FQueryFastData& CurData = QueryFastData[QueryIndex];
+						FBatchVisitor QueryVisitor(Visitor, QueryIndex);
+
+						bool bContinue;
+						if constexpr (Query == EAABBQueryType::Sweep)
+						{
+							bContinue = Leaf.SweepFast(BatchQuery.Start, CurData, BatchQuery.HalfExtents, QueryVisitor, CurData.Dir, CurData.InvDir, CurData.bParallel);
+						}
+						else
+						{
+							bContinue = Leaf.RaycastFast(BatchQuery.Start, CurData, QueryVisitor, CurData.Dir, CurData.InvDir, CurData.bParallel);
+						}
+
+						if (!bContinue)
+						{
+							ActiveLanes &= ~(1 << Lane);
+						}
+					}
+					UpdateLength();
+				}
+				else
+				{
+					FPacketStackEntry Children[2];
+					double NearestTOI[2] = { TNumericLimits<double>::Max(), TNumericLimits<double>::Max() };
+					for (int32 Child = 0; Child < 2; ++Child)
+					{
+						VectorRegister4Double TOISimd;
+						Children[Child].NodeIdx = Node.ChildrenNodes[Child];
+						Children[Child].LaneMask = BatchPacketIntersects(Packet, Node.ChildrenBounds[Child], TOISimd) & LaneMask;
+						VectorStore(TOISimd, Children[Child].TOI);
+						for (int32 Lane = 0; Lane < 4; ++Lane)
+						{
+							if (Children[Child].LaneMask & (1 << Lane))
+							{
+								NearestTOI[Child] = FMath::Min(NearestTOI[Child], Children[Child].TOI[Lane]);
+							}
+						}
+					}
+
+					// The child the packet enters first is pushed last so it is visited first
+					const int32 NearChild = NearestTOI[1] < NearestTOI[0] ? 1 : 0;
+					if (Children[1 - NearChild].LaneMask)
+					{
+						NodeStack.Add(Children[1 - NearChild]);
+					}
+					if (Children[NearChild].LaneMask)
+					{
+						NodeStack.Add(Children[NearChild]);
+					}
+				}
+			}
+		}
+	}
+
 	int32 GetNewWorkSnapshot()
 	{
 		if(WorkPoolFreeList.Num())
@@ -3242,6 +3935,7 @@ private:
 		GlobalPayloads.Reset();
 		Leaves.Reset();
 		Nodes.Reset();
+		WideNodes.Reset();
 		RootNode = INDEX_NONE;
 		FirstFreeInternalNode = INDEX_NONE;
 		FirstFreeLeafNode = INDEX_NONE;
@@ -3711,6 +4405,8 @@ private:
 
 		check(WorkStack.Num() == 0);
 		//Stack is empty, clean up pool and mark task as complete
+
+		BuildWideNodes();
 		
 		this->SetAsyncTimeSlicingComplete(true);
 	}
@@ -3851,6 +4547,8 @@ private:
 		, Nodes(Other.Nodes)
 		, Leaves(Other.Leaves)
 		, DirtyElements(Other.DirtyElements)
+		, WideNodes(Other.WideNodes)
+		, bUseWideNodes(Other.bUseWideNodes)
 		, bDynamicTree(Other.bDynamicTree)
 		, RootNode(Other.RootNode)
 		, FirstFreeInternalNode(Other.FirstFreeInternalNode)
@@ -3910,6 +4608,8 @@ private:
 			Nodes = Rhs.Nodes;
 			Leaves = Rhs.Leaves;
 			DirtyElements = Rhs.DirtyElements;
+			WideNodes = Rhs.WideNodes;
+			bUseWideNodes = Rhs.bUseWideNodes;
 			bDynamicTree = Rhs.bDynamicTree;
 			RootNode = Rhs.RootNode;
 			FirstFreeInternalNode = Rhs.FirstFreeInternalNode;
@@ -3959,6 +4659,10 @@ private:
 	TLeafContainer<TLeafType> Leaves;
 	TArray<FElement> DirtyElements;
 
+	// Static trees only, the nodes collapsed into wide nodes when bUseWideNodes is set. Empty when queries traverse Nodes.
+	TArray<FAABBTreeWideNode> WideNodes;
+	bool bUseWideNodes = false;
+
 	// DynamicTree members
 	bool bDynamicTree = false;
 	int32 RootNode = INDEX_NONE;
@@ -1,7 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 #pragma once
+#include "Containers/Array.h"
+#include "Misc/CString.h"
 #include "Misc/OutputDevice.h"
 #include "ProfilingDebugging/ScopedTimers.h"
+#include "Templates/Tuple.h"
 
 #ifndef CHAOS_PERF_TEST_ENABLED
 #define CHAOS_PERF_TEST_ENABLED 1
@@ -16,6 +19,51 @@ enum class EChaosPerfUnits
 	Num
 };
 
+/**
+ * Totals the time spent under each CHAOS_SCOPED_TIMER label while it is the sink of the current thread. Used by
+ * benchmarks that run many steps, where logging every scope would swamp the timings. The sink is per thread so
+ * timers on worker threads, or evolutions advanced by other threads at the same time, are not recorded.
+ */
+class FChaosPerfTestPhaseTimes
+{
+public:
+	void Add(const TCHAR* Label, double Seconds)
+	{
+		for (TPair<const TCHAR*, double>& Phase : Phases)
+		{
+			if (FCString::Strcmp(Phase.Key, Label) == 0)
+			{
+				Phase.Value += Seconds;
+				return;
+			}
+		}
+		Phases.Emplace(Label, Seconds);
+	}
+
+	/** Total seconds spent under Label, 0 if it never ran */
+	double Get(const TCHAR* Label) const
+	{
+		for (const TPair<const TCHAR*, double>& Phase : Phases)
+		{
+			if (FCString::Strcmp(Phase.Key, Label) == 0)
+			{
+				return Phase.Value;
+			}
+		}
+		return 0.0;
+	}
+
+	void Reset() { Phases.Reset(); }
+
+	const TArray<TPair<const TCHAR*, double>>& GetPhases() const { return Phases; }
+
+	/** Sink of the calling thread, set with FScopedChaosPerfPhaseTimes */
+	static CHAOS_API FChaosPerfTestPhaseTimes*& GetThreadPhaseTimes();
+
+private:
+	TArray<TPair<const TCHAR*, double>> Phases;
+};
+
 class FChaosScopedDurationTimeLogger
 {
 public:
@@ -33,6 +81,10 @@ public:
 		static const float Multipliers[static_cast<int>(EChaosPerfUnits::Num)] = { 1.f, 1000.f, 1000000.f };
 		static const TCHAR* Units[static_cast<int>(EChaosPerfUnits::Num)] = { TEXT("s"), TEXT("ms"), TEXT("us") };
 		Timer.Stop();
+		if (FChaosPerfTestPhaseTimes* PhaseTimes = FChaosPerfTestPhaseTimes::GetThreadPhaseTimes())
+		{
+			PhaseTimes->Add(Label, Accumulator);
+		}
 		if (GlobalLabel)
 		{
 			//Device->Logf(TEXT("%s - %s: %4.fus"), GlobalLabel, Label, Accumulator * 1000000.f);
@@ -60,6 +112,12 @@ struct FScopedChaosPerfTest
 	~FScopedChaosPerfTest() { FChaosScopedDurationTimeLogger::GlobalLabel = nullptr; }
 };
 
+struct FScopedChaosPerfPhaseTimes
+{
+	explicit FScopedChaosPerfPhaseTimes(FChaosPerfTestPhaseTimes& PhaseTimes) { FChaosPerfTestPhaseTimes::GetThreadPhaseTimes() = &PhaseTimes; }
+	~FScopedChaosPerfPhaseTimes() { FChaosPerfTestPhaseTimes::GetThreadPhaseTimes() = nullptr; }
+};
+
 #define CHAOS_PERF_TEST(x, units) FScopedChaosPerfTest Scope_##x(TEXT(#x), units);
 #define CHAOS_SCOPED_TIMER(x) FChaosScopedDurationTimeLogger Timer_##x(TEXT(#x));
 #else
@@ -20,6 +20,35 @@ namespace Chaos
 
 	namespace Private
 	{
+		/**
+		 * Counts of how often a collision constraint ran the narrow phase or restored its manifold from the previous tick.
+		 * Gathered per collision context allocator and summed for the tick in FCollisionConstraintAllocator::EndDetectCollisions.
+		 */
+		struct FCollisionManifoldReuseStats
+		{
+			int32 NumNarrowPhaseUpdates = 0;
+			int32 NumManifoldRestores = 0;
+
+			void Reset()
+			{
+				NumNarrowPhaseUpdates = 0;
+				NumManifoldRestores = 0;
+			}
+
+			void Accumulate(const FCollisionManifoldReuseStats& Other)
+			{
+				NumNarrowPhaseUpdates += Other.NumNarrowPhaseUpdates;
+				NumManifoldRestores += Other.NumManifoldRestores;
+			}
+
+			// The fraction of constraint updates that skipped the narrow phase
+			FRealSingle GetRestoreRate() const
+			{
+				const int32 NumUpdates = NumNarrowPhaseUpdates + NumManifoldRestores;
+				return (NumUpdates > 0) ? FRealSingle(NumManifoldRestores) / FRealSingle(NumUpdates) : FRealSingle(0);
+			}
+		};
+
 		/**
 		 * Container the storage for the FCollisionConstraintAllocator, as well as the API to create new midphases and collision constraints.
 		 * We have one of these objects per thread on which collisions detection is performed to get lock-free allocations and lists.
@@ -104,6 +133,14 @@ namespace Chaos
 				return false;
 			}
 
+			/**
+			 * Manifold reuse counters for the collisions detected through this allocator this tick
+			 */
+			FCollisionManifoldReuseStats& GetManifoldReuseStats()
+			{
+				return ManifoldReuseStats;
+			}
+
 			/**
 			 * Return a midphase for a particle pair.
 			 * This wil create a new midphase if the particle pairs were not recently overlapping, or return an
@@ -153,6 +190,7 @@ namespace Chaos
 				check(NewMidPhases.IsEmpty());
 
 				CurrentEpoch = InEpoch;
+				ManifoldReuseStats.Reset();
 			}
 
 			// Find the midphase for the particle pair if it exists. Every particle holds a list of its midphases. We search "SearchParticle" which should be
@@ -188,6 +226,7 @@ namespace Chaos
 
 			TArray<FPBDCollisionConstraint*> NewActiveConstraints;
 			TArray<FParticlePairMidPhase*> NewMidPhases;
+			FCollisionManifoldReuseStats ManifoldReuseStats;
 
 #if CHAOS_COLLISION_OBJECTPOOL_ENABLED
 			FPBDCollisionConstraintPool ConstraintPool;
@@ -243,6 +282,7 @@ namespace Chaos
 				, ActiveConstraints()
 				, ActiveCCDConstraints()
 				, CurrentEpoch(0)
+				, ManifoldReuseStats()
 				, bIsDeteministic(false)
 				, bInCollisionDetectionPhase(false)
 			{
@@ -320,6 +360,14 @@ namespace Chaos
 				return CurrentEpoch;
 			}
 
+			/**
+			 * How many constraints ran the narrow phase or restored their manifold in the last collision detection phase
+			 */
+			const FCollisionManifoldReuseStats& GetManifoldReuseStats() const
+			{
+				return ManifoldReuseStats;
+			}
+
 			/**
 			* Has the constraint expired. An expired constraint is one that was not refreshed this tick.
 			* 
@@ -588,6 +636,9 @@ namespace Chaos
 			// older than the current Epoch at the end of the tick was not refreshed this tick.
 			int32 CurrentEpoch;
 
+			// Narrow phase and manifold restore counts summed over the context allocators in the last collision detection phase
+			FCollisionManifoldReuseStats ManifoldReuseStats;
+
 			// Whether we running a deterministic sim
 			bool bIsDeteministic;
 
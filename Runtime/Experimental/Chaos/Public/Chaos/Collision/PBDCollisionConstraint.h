@@ -679,9 +679,13 @@ namespace Chaos
 
 			// NOTE: BoundsTestFlags.bEnableManifoldUpdate is false if the shape pair does not support manifold reuse
 			Flags.bCanRestoreManifold = BoundsTestFlags.bEnableManifoldUpdate;
+			NumManifoldRestores = 0;
 		}
 
 		bool GetCanRestoreManifold() const { return Flags.bCanRestoreManifold; }
+
+		// The number of consecutive ticks the manifold has been restored without running the narrow phase
+		int32 GetNumManifoldRestores() const { return NumManifoldRestores; }
 		CHAOS_API bool TryRestoreManifold();
 		CHAOS_API void ResetActiveManifoldContacts();
 		CHAOS_API bool TryAddManifoldContact(const FContactPoint& ContactPoint);
@@ -989,6 +993,9 @@ namespace Chaos
 		// Used by manifold point injection to see how many points were in the manifold before TryRestoreManifold
 		int32 ExpectedNumManifoldPoints;
 
+		// How many ticks in a row TryRestoreManifold has succeeded since the narrow phase last ran
+		int32 NumManifoldRestores;
+
 		// Relative transform the last time we ran the narrow phase
 		// Used to detect when the bodies have moved too far to reues the manifold
 		FVec3f LastShapeWorldPositionDelta;
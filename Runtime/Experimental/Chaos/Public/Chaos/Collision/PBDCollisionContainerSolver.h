@@ -46,9 +46,16 @@ namespace Chaos
 		virtual void ApplyPositionConstraints(const FReal Dt, const int32 It, const int32 NumIts) override final;
 		virtual void ApplyVelocityConstraints(const FReal Dt, const int32 It, const int32 NumIts) override final;
 		virtual void ApplyProjectionConstraints(const FReal Dt, const int32 It, const int32 NumIts) override final;
+		virtual void ColorConstraints(FSolverBodyContainer& SolverBodyContainer) override final;
+		virtual void ApplyPositionConstraintsParallel(const FReal Dt, const int32 It, const int32 NumIts) override final;
+		virtual void ApplyVelocityConstraintsParallel(const FReal Dt, const int32 It, const int32 NumIts) override final;
 
 		// For testing
 		const Private::FPBDCollisionSolver& GetConstraintSolver(const int32 ConstraintIndex) const { return GetSolver(ConstraintIndex); }
+		int32 GetNumColors() const { return FMath::Max(ColorOffsets.Num() - 1, 0); }
+		int32 GetNumParallelColors() const { return NumParallelColors; }
+		int32 GetColorOffset(const int32 ColorIndex) const { return ColorOffsets[ColorIndex]; }
+		const FPBDCollisionConstraint& GetCollisionConstraint(const int32 ConstraintIndex) const { return *GetConstraint(ConstraintIndex); }
 
 	private:
 		FPBDCollisionConstraint* GetConstraint(const int32 Index) { return CollisionConstraints[Index]; }
@@ -66,6 +73,10 @@ namespace Chaos
 		void ApplyShockPropagation(const FSolverReal ShockPropagation);
 		void SolvePositionImpl(const FReal Dt, const int32 It, const int32 NumIts, const int32 BeginIndex, const int32 EndIndex, const FPBDCollisionSolverSettings& SolverSettings);
 		void SolveVelocityImpl(const FReal Dt, const int32 It, const int32 NumIts, const int32 BeginIndex, const int32 EndIndex, const FPBDCollisionSolverSettings& SolverSettings);
+		void SolvePositionRange(const FReal Dt, const int32 It, const int32 NumIts, const int32 BeginIndex, const int32 EndIndex, const FPBDCollisionSolverSettings& SolverSettings);
+		void SolveVelocityRange(const FReal Dt, const int32 It, const int32 NumIts, const int32 BeginIndex, const int32 EndIndex, const FPBDCollisionSolverSettings& SolverSettings);
+		bool CanSolveColorsInParallel() const;
+		template<typename LambdaType> void ApplyToColors(const LambdaType& Lambda);
 		void UpdateCollisions(const FReal InDt, const int32 BeginIndex, const int32 EndIndex);
 
 		// The constraints we are solving and the container to which they belong
@@ -91,5 +102,14 @@ namespace Chaos
 		TArray<bool> bCollisionConstraintPerIterationCollisionDetection;
 		bool bPerIterationCollisionDetection;
 
+		// The first constraint index of each color plus the end index, after ColorConstraints. Empty if not colored.
+		// Colors [0, NumParallelColors) do not share any dynamic bodies. Any remaining color is solved serially.
+		TArray<int32> ColorOffsets;
+		int32 NumParallelColors;
+
+		// Scratch for ColorConstraints, kept between ticks to avoid reallocating: the colors used by each solver body and the color of each constraint
+		TArray<uint64> BodyColorMasks;
+		TArray<int32> ConstraintColors;
+
 	};
 }
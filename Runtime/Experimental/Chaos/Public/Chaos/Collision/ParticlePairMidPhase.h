@@ -126,6 +126,8 @@ namespace Chaos
 			const FCollisionContext& Context);
 
 	private:
+		friend class FShapePairParticlePairMidPhase;
+
 		CHAOS_API int32 GenerateCollisionImpl(
 			const FRealSingle Dt,
 			const FRealSingle CullDistance,
@@ -487,6 +489,17 @@ namespace Chaos
 			const FPerShapeData* Shape1, 
 			const int32 ShapeIndex1);
 
+		/**
+		 * @brief Generate collisions for all shape pairs, first running GJK on the overlapping convex pairs in batches and
+		 * skipping the narrow phase for pairs that are certainly more than CullDistance apart.
+		 * See p.Chaos.Collision.MidPhase.EnableConvexBatchCull
+		*/
+		CHAOS_API int32 GenerateCollisionsConvexBatchCull(
+			const FRealSingle Dt,
+			const FRealSingle CullDistance,
+			const FVec3f& RelativeMovement,
+			const FCollisionContext& Context);
+
 		TArray<FSingleShapePairCollisionDetector, TInlineAllocator<1>> ShapePairDetectors;	// 88 bytes
 	};
 
@@ -60,11 +60,33 @@ namespace Chaos
 				return TotalNumConstraints;
 			}
 
+			/**
+			 * Whether the constraints in this group are sorted into colors and each color solved on multiple threads. Used for
+			 * groups that contain an island too large to solve on one thread. Must be set before AddConstraintsAndBodies and is cleared by Reset.
+			*/
+			void SetColoringEnabled(const bool bInColoringEnabled)
+			{
+				bColoringEnabled = bInColoringEnabled;
+			}
+
+			inline bool IsColoringEnabled() const
+			{
+				return bColoringEnabled;
+			}
+
 			/**
 			 * Attach a constraint solver to the specified ContainerId. This must be for the same constraint type as the container with that Id.
 			*/
 			CHAOS_API void SetConstraintSolver(const int32 ContainerId, TUniquePtr<FConstraintContainerSolver>&& Solver);
 
+			/**
+			 * Get the constraint solver attached to the specified ContainerId, or null if there is none
+			*/
+			const FConstraintContainerSolver* GetConstraintSolver(const int32 ContainerId) const
+			{
+				return ConstraintContainerSolvers.IsValidIndex(ContainerId) ? ConstraintContainerSolvers[ContainerId].Get() : nullptr;
+			}
+
 			/**
 			 * Set the solver priority of the specified constraint type
 			*/
@@ -180,6 +202,9 @@ namespace Chaos
 			TArray<FConstraintContainerSolver*> PrioritizedConstraintContainerSolvers;
 
 			FIterationSettings Iterations;
+
+			// Whether to color the constraints and solve each color in parallel (see SetColoringEnabled)
+			bool bColoringEnabled;
 		};
 
 
@@ -95,6 +95,9 @@ namespace Chaos
 		// GatherInput for that to happen (GatherInput is highly parallizable but FindOrAdd is not)
 		FSolverBody* FindOrAdd(FGenericParticleHandle InParticle);
 
+		// Same as FindOrAdd but returns the index of the solver body
+		int32 FindOrAddIndex(FGenericParticleHandle InParticle);
+
 		// Collect all the data we need from the particles represented by our SolverBodies
 		void GatherInput(const FReal Dt, const int32 BeginIndex, const int32 EndIndex);
 
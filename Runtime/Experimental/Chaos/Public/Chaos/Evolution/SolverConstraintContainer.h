@@ -107,6 +107,20 @@ namespace Chaos
 		*/
 		virtual void ApplyProjectionConstraints(const FReal Dt, const int32 It, const int32 NumIts) = 0;
 
+		/**
+		 * Sort the constraints into colors so that no two constraints in a color share a dynamic body. Called after AddConstraints
+		 * and before AddBodies for groups containing an island that is too large to solve on one thread. Optional.
+		 * May add the bodies to SolverBodyContainer to identify them by solver body index.
+		*/
+		virtual void ColorConstraints(FSolverBodyContainer& SolverBodyContainer) {}
+
+		/**
+		 * Apply the position or velocity solve to all constraints, solving each color (see ColorConstraints) on multiple threads.
+		 * Containers that do not support coloring solve serially.
+		*/
+		virtual void ApplyPositionConstraintsParallel(const FReal Dt, const int32 It, const int32 NumIts) { ApplyPositionConstraints(Dt, It, NumIts); }
+		virtual void ApplyVelocityConstraintsParallel(const FReal Dt, const int32 It, const int32 NumIts) { ApplyVelocityConstraints(Dt, It, NumIts); }
+
 	private:
 		int32 Priority;
 	};
@@ -0,0 +1,518 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Chaos/GJK.h"
+#include "Containers/ArrayView.h"
+#include "Math/VectorRegister.h"
+
+namespace Chaos
+{
+	/**
+	 * One shape pair for GJKDistanceBatch. The shapes and InitialV are the same as the inputs to GJKDistance (usually TGJKShape and
+	 * TGJKShapeTransformed) and the outputs are set the same way GJKDistance sets them. Outputs are unchanged for DeepContact.
+	 */
+	template<typename GJKShapeTypeA, typename GJKShapeTypeB>
+	struct TGJKDistanceBatchPair
+	{
+		TGJKDistanceBatchPair(const GJKShapeTypeA& InA, const GJKShapeTypeB& InB, const FVec3& InInitialV)
+			: A(InA)
+			, B(InB)
+			, InitialV(InInitialV)
+			, Result(EGJKDistanceResult::DeepContact)
+			, Distance(0)
+			, DistanceLowerBound(0)
+			, NearestA(0)
+			, NearestB(0)
+			, NormalA(0)
+		{
+		}
+
+		GJKShapeTypeA A;
+		GJKShapeTypeB B;
+		FVec3 InitialV;
+
+		EGJKDistanceResult Result;
+		FReal Distance;
+		/** A distance the shapes are known to be at least apart, from the best support plane found. Only set with Distance. */
+		FReal DistanceLowerBound;
+		FVec3 NearestA;
+		FVec3 NearestB;
+		FVec3 NormalA;
+	};
+
+	namespace Private
+	{
+		// One 3D vector per lane for 4 lanes, stored as a register per component
+		struct FGJKBatchVec3
+		{
+			VectorRegister4Float X;
+			VectorRegister4Float Y;
+			VectorRegister4Float Z;
+		};
+
+		FORCEINLINE FGJKBatchVec3 GJKBatchSubtract(const FGJKBatchVec3& L, const FGJKBatchVec3& R)
+		{
+			return { VectorSubtract(L.X, R.X), VectorSubtract(L.Y, R.Y), VectorSubtract(L.Z, R.Z) };
+		}
+
+		FORCEINLINE VectorRegister4Float GJKBatchDot(const FGJKBatchVec3& L, const FGJKBatchVec3& R)
+		{
+			return VectorMultiplyAdd(L.X, R.X, VectorMultiplyAdd(L.Y, R.Y, VectorMultiply(L.Z, R.Z)));
+		}
+
+		FORCEINLINE FGJKBatchVec3 GJKBatchCross(const FGJKBatchVec3& L, const FGJKBatchVec3& R)
+		{
+			return
+			{
+				VectorSubtract(VectorMultiply(L.Y, R.Z), VectorMultiply(L.Z, R.Y)),
+				VectorSubtract(VectorMultiply(L.Z, R.X), VectorMultiply(L.X, R.Z)),
+				VectorSubtract(VectorMultiply(L.X, R.Y), VectorMultiply(L.Y, R.X)),
+			};
+		}
+
+		// Returns Scale * V + Acc
+		FORCEINLINE FGJKBatchVec3 GJKBatchMultiplyAdd(const VectorRegister4Float& Scale, const FGJKBatchVec3& V, const FGJKBatchVec3& Acc)
+		{
+			return { VectorMultiplyAdd(Scale, V.X, Acc.X), VectorMultiplyAdd(Scale, V.Y, Acc.Y), VectorMultiplyAdd(Scale, V.Z, Acc.Z) };
+		}
+
+		// N / D, or zero where D is (nearly) zero
+		FORCEINLINE VectorRegister4Float GJKBatchSafeDivide(const VectorRegister4Float& N, const VectorRegister4Float& D)
+		{
+			const VectorRegister4Float IsSmall = VectorCompareLE(VectorAbs(D), VectorSetFloat1(UE_SMALL_NUMBER));
+			return VectorSelect(IsSmall, VectorZeroFloat(), VectorDivide(N, VectorSelect(IsSmall, VectorOneFloat(), D)));
+		}
+
+		// Squared distance to the origin of the point with the given barycentric weights on triangle ABC
+		FORCEINLINE VectorRegister4Float GJKBatchTriangleDistanceSquared(const FGJKBatchVec3& A, const FGJKBatchVec3& B, const FGJKBatchVec3& C, const VectorRegister4Float& WA, const VectorRegister4Float& WB, const VectorRegister4Float& WC)
+		{
+			const FGJKBatchVec3 Zero = { VectorZeroFloat(), VectorZeroFloat(), VectorZeroFloat() };
+			const FGJKBatchVec3 Closest = GJKBatchMultiplyAdd(WA, A, GJKBatchMultiplyAdd(WB, B, GJKBatchMultiplyAdd(WC, C, Zero)));
+			return GJKBatchDot(Closest, Closest);
+		}
+
+		// Barycentric weights of the point on segment AB closest to the origin. Degenerate segments use A.
+		FORCEINLINE void GJKBatchClosestOnSegment(const FGJKBatchVec3& A, const FGJKBatchVec3& B, VectorRegister4Float& OutWA, VectorRegister4Float& OutWB)
+		{
+			const FGJKBatchVec3 AB = GJKBatchSubtract(B, A);
+			const VectorRegister4Float T = GJKBatchSafeDivide(VectorNegate(GJKBatchDot(A, AB)), GJKBatchDot(AB, AB));
+			OutWB = VectorMin(VectorMax(T, VectorZeroFloat()), VectorOneFloat());
+			OutWA = VectorSubtract(VectorOneFloat(), OutWB);
+		}
+
+		// Barycentric weights of the point on triangle ABC closest to the origin.
+		// Branch-free version of ClosestPtPointTriangle from Ericson, Real-Time Collision Detection, 5.1.5
+		FORCEINLINE void GJKBatchClosestOnTriangle(const FGJKBatchVec3& A, const FGJKBatchVec3& B, const FGJKBatchVec3& C, VectorRegister4Float& OutWA, VectorRegister4Float& OutWB, VectorRegister4Float& OutWC)
+		{
+			const VectorRegister4Float Zero = VectorZeroFloat();
+			const VectorRegister4Float One = VectorOneFloat();
+
+			const FGJKBatchVec3 AB = GJKBatchSubtract(B, A);
+			const FGJKBatchVec3 AC = GJKBatchSubtract(C, A);
+
+			// The query point is the origin, so AP = -A, BP = -B, CP = -C
+			const VectorRegister4Float D1 = VectorNegate(GJKBatchDot(AB, A));
+			const VectorRegister4Float D2 = VectorNegate(GJKBatchDot(AC, A));
+			const VectorRegister4Float D3 = VectorNegate(GJKBatchDot(AB, B));
+			const VectorRegister4Float D4 = VectorNegate(GJKBatchDot(AC, B));
+			const VectorRegister4Float D5 = VectorNegate(GJKBatchDot(AB, C));
+			const VectorRegister4Float D6 = VectorNegate(GJKBatchDot(AC, C));
+
+			const VectorRegister4Float VA = VectorSubtract(VectorMultiply(D3, D6), VectorMultiply(D5, D4));
+			const VectorRegister4Float VB = VectorSubtract(VectorMultiply(D5, D2), VectorMultiply(D1, D6));
+			const VectorRegister4Float VC = VectorSubtract(VectorMultiply(D1, D4), VectorMultiply(D3, D2));
+
+			// Face region
+			const VectorRegister4Float Denom = VectorAdd(VA, VectorAdd(VB, VC));
+			VectorRegister4Float WB = GJKBatchSafeDivide(VB, Denom);
+			VectorRegister4Float WC = GJKBatchSafeDivide(VC, Denom);
+			VectorRegister4Float WA = VectorSubtract(VectorSubtract(One, WB), WC);
+
+			// Edge and vertex regions, applied from lowest to highest priority so that the first match in the scalar algorithm wins
+			// Edge BC
+			const VectorRegister4Float D4MinusD3 = VectorSubtract(D4, D3);
+			const VectorRegister4Float D5MinusD6 = VectorSubtract(D5, D6);
+			const VectorRegister4Float IsBC = VectorBitwiseAnd(VectorCompareLE(VA, Zero), VectorBitwiseAnd(VectorCompareGE(D4MinusD3, Zero), VectorCompareGE(D5MinusD6, Zero)));
+			const VectorRegister4Float TBC = GJKBatchSafeDivide(D4MinusD3, VectorAdd(D4MinusD3, D5MinusD6));
+			WA = VectorSelect(IsBC, Zero, WA);
+			WB = VectorSelect(IsBC, VectorSubtract(One, TBC), WB);
+			WC = VectorSelect(IsBC, TBC, WC);
+
+			// Edge AC
+			const VectorRegister4Float IsAC = VectorBitwiseAnd(VectorCompareLE(VB, Zero), VectorBitwiseAnd(VectorCompareGE(D2, Zero), VectorCompareLE(D6, Zero)));
+			const VectorRegister4Float TAC = GJKBatchSafeDivide(D2, VectorSubtract(D2, D6));
+			WA = VectorSelect(IsAC, VectorSubtract(One, TAC), WA);
+			WB = VectorSelect(IsAC, Zero, WB);
+			WC = VectorSelect(IsAC, TAC, WC);
+
+			// Vertex C
+			const VectorRegister4Float IsC = VectorBitwiseAnd(VectorCompareGE(D6, Zero), VectorCompareLE(D5, D6));
+			WA = VectorSelect(IsC, Zero, WA);
+			WB = VectorSelect(IsC, Zero, WB);
+			WC = VectorSelect(IsC, One, WC);
+
+			// Edge AB
+			const VectorRegister4Float IsAB = VectorBitwiseAnd(VectorCompareLE(VC, Zero), VectorBitwiseAnd(VectorCompareGE(D1, Zero), VectorCompareLE(D3, Zero)));
+			const VectorRegister4Float TAB = GJKBatchSafeDivide(D1, VectorSubtract(D1, D3));
+			WA = VectorSelect(IsAB, VectorSubtract(One, TAB), WA);
+			WB = VectorSelect(IsAB, TAB, WB);
+			WC = VectorSelect(IsAB, Zero, WC);
+
+			// Vertex B
+			const VectorRegister4Float IsB = VectorBitwiseAnd(VectorCompareGE(D3, Zero), VectorCompareLE(D4, D3));
+			WA = VectorSelect(IsB, Zero, WA);
+			WB = VectorSelect(IsB, One, WB);
+			WC = VectorSelect(IsB, Zero, WC);
+
+			// Vertex A
+			const VectorRegister4Float IsA = VectorBitwiseAnd(VectorCompareLE(D1, Zero), VectorCompareLE(D2, Zero));
+			WA = VectorSelect(IsA, One, WA);
+			WB = VectorSelect(IsA, Zero, WB);
+			WC = VectorSelect(IsA, Zero, WC);
+
+			// The region tests above assume a proper triangle. Degenerate (near zero area) triangles use the closest of the three edges instead.
+			// NOTE: Denom is |AB x AC|^2, so this is a test on the sine of the angle at A
+			const VectorRegister4Float DegenerateDenom = VectorMultiply(VectorSetFloat1(1.e-6f), VectorMultiply(GJKBatchDot(AB, AB), GJKBatchDot(AC, AC)));
+			const VectorRegister4Float IsDegenerate = VectorCompareLE(Denom, VectorMax(DegenerateDenom, VectorSetFloat1(UE_SMALL_NUMBER)));
+			if (VectorMaskBits(IsDegenerate))
+			{
+				VectorRegister4Float ABWA, ABWB, ACWA, ACWC, BCWB, BCWC;
+				GJKBatchClosestOnSegment(A, B, ABWA, ABWB);
+				GJKBatchClosestOnSegment(A, C, ACWA, ACWC);
+				GJKBatchClosestOnSegment(B, C, BCWB, BCWC);
+				const VectorRegister4Float ABDist2 = GJKBatchTriangleDistanceSquared(A, B, C, ABWA, ABWB, Zero);
+				const VectorRegister4Float ACDist2 = GJKBatchTriangleDistanceSquared(A, B, C, ACWA, Zero, ACWC);
+				const VectorRegister4Float BCDist2 = GJKBatchTriangleDistanceSquared(A, B, C, Zero, BCWB, BCWC);
+
+				const VectorRegister4Float UseAC = VectorCompareLT(ACDist2, ABDist2);
+				VectorRegister4Float EdgeWA = VectorSelect(UseAC, ACWA, ABWA);
+				VectorRegister4Float EdgeWB = VectorSelect(UseAC, Zero, ABWB);
+				VectorRegister4Float EdgeWC = VectorSelect(UseAC, ACWC, Zero);
+				const VectorRegister4Float UseBC = VectorCompareLT(BCDist2, VectorMin(ABDist2, ACDist2));
+				EdgeWA = VectorSelect(UseBC, Zero, EdgeWA);
+				EdgeWB = VectorSelect(UseBC, BCWB, EdgeWB);
+				EdgeWC = VectorSelect(UseBC, BCWC, EdgeWC);
+
+				WA = VectorSelect(IsDegenerate, EdgeWA, WA);
+				WB = VectorSelect(IsDegenerate, EdgeWB, WB);
+				WC = VectorSelect(IsDegenerate, EdgeWC, WC);
+			}
+
+			OutWA = WA;
+			OutWB = WB;
+			OutWC = WC;
+		}
+
+		// Barycentric weights of the point on tetrahedron P[0..3] closest to the origin, from the closest face that the origin is outside of.
+		// All weights are zero for lanes where the origin is inside the tetrahedron. See ClosestPtPointTetrahedron in Ericson, 5.1.6.
+		FORCEINLINE void GJKBatchClosestOnTetrahedron(const FGJKBatchVec3 (&P)[4], VectorRegister4Float (&OutWeights)[4])
+		{
+			// The vertices of each face, followed by the vertex opposite it
+			static constexpr int32 Faces[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+
+			const VectorRegister4Float Zero = VectorZeroFloat();
+			VectorRegister4Float BestDist2 = VectorSetFloat1(UE_BIG_NUMBER);
+			for (int32 Slot = 0; Slot < 4; ++Slot)
+			{
+				OutWeights[Slot] = Zero;
+			}
+
+			for (int32 FaceIndex = 0; FaceIndex < 4; ++FaceIndex)
+			{
+				const FGJKBatchVec3& A = P[Faces[FaceIndex][0]];
+				const FGJKBatchVec3& B = P[Faces[FaceIndex][1]];
+				const FGJKBatchVec3& C = P[Faces[FaceIndex][2]];
+				const FGJKBatchVec3& D = P[Faces[FaceIndex][3]];
+
+				// The origin is outside the face if it is not on the same side as the opposite vertex. All faces of a (nearly) flat tetrahedron count as outside.
+				const FGJKBatchVec3 Normal = GJKBatchCross(GJKBatchSubtract(B, A), GJKBatchSubtract(C, A));
+				const FGJKBatchVec3 AD = GJKBatchSubtract(D, A);
+				const VectorRegister4Float SignOrigin = VectorNegate(GJKBatchDot(A, Normal));
+				const VectorRegister4Float SignOpposite = GJKBatchDot(AD, Normal);
+				const VectorRegister4Float FlatSignOpposite2 = VectorMultiply(VectorSetFloat1(1.e-6f), VectorMultiply(GJKBatchDot(Normal, Normal), GJKBatchDot(AD, AD)));
+				const VectorRegister4Float IsFlat = VectorCompareLE(VectorMultiply(SignOpposite, SignOpposite), FlatSignOpposite2);
+				const VectorRegister4Float IsOutside = VectorBitwiseOr(IsFlat, VectorCompareLE(VectorMultiply(SignOrigin, SignOpposite), Zero));
+				if (!VectorMaskBits(IsOutside))
+				{
+					continue;
+				}
+
+				VectorRegister4Float FaceWeights[4];
+				FaceWeights[Faces[FaceIndex][3]] = Zero;
+				GJKBatchClosestOnTriangle(A, B, C, FaceWeights[Faces[FaceIndex][0]], FaceWeights[Faces[FaceIndex][1]], FaceWeights[Faces[FaceIndex][2]]);
+
+				const VectorRegister4Float Dist2 = GJKBatchTriangleDistanceSquared(A, B, C, FaceWeights[Faces[FaceIndex][0]], FaceWeights[Faces[FaceIndex][1]], FaceWeights[Faces[FaceIndex][2]]);
+				const VectorRegister4Float IsBest = VectorBitwiseAnd(IsOutside, VectorCompareLT(Dist2, BestDist2));
+				BestDist2 = VectorSelect(IsBest, Dist2, BestDist2);
+				for (int32 Slot = 0; Slot < 4; ++Slot)
+				{
+					OutWeights[Slot] = VectorSelect(IsBest, FaceWeights[Slot], OutWeights[Slot]);
+				}
+			}
+		}
+
+		// Barycentric weights of the closest point to the origin on the simplex in each lane. NumVerts holds the simplex size of each lane
+		// (as a float) and lanes with an empty simplex get all-zero weights. Only the simplex sizes present in some lane are evaluated.
+		FORCEINLINE void GJKBatchClosestOnSimplex(const FGJKBatchVec3 (&P)[4], const VectorRegister4Float& NumVerts, VectorRegister4Float (&OutWeights)[4])
+		{
+			const VectorRegister4Float Zero = VectorZeroFloat();
+			const VectorRegister4Float One = VectorOneFloat();
+
+			for (int32 Slot = 0; Slot < 4; ++Slot)
+			{
+				OutWeights[Slot] = Zero;
+			}
+
+			const VectorRegister4Float IsPoint = VectorCompareEQ(NumVerts, One);
+			OutWeights[0] = VectorSelect(IsPoint, One, OutWeights[0]);
+
+			const VectorRegister4Float IsSegment = VectorCompareEQ(NumVerts, VectorSetFloat1(2.0f));
+			if (VectorMaskBits(IsSegment))
+			{
+				VectorRegister4Float W0, W1;
+				GJKBatchClosestOnSegment(P[0], P[1], W0, W1);
+				OutWeights[0] = VectorSelect(IsSegment, W0, OutWeights[0]);
+				OutWeights[1] = VectorSelect(IsSegment, W1, OutWeights[1]);
+			}
+
+			const VectorRegister4Float IsTriangle = VectorCompareEQ(NumVerts, VectorSetFloat1(3.0f));
+			if (VectorMaskBits(IsTriangle))
+			{
+				VectorRegister4Float W0, W1, W2;
+				GJKBatchClosestOnTriangle(P[0], P[1], P[2], W0, W1, W2);
+				OutWeights[0] = VectorSelect(IsTriangle, W0, OutWeights[0]);
+				OutWeights[1] = VectorSelect(IsTriangle, W1, OutWeights[1]);
+				OutWeights[2] = VectorSelect(IsTriangle, W2, OutWeights[2]);
+			}
+
+			const VectorRegister4Float IsTetrahedron = VectorCompareEQ(NumVerts, VectorSetFloat1(4.0f));
+			if (VectorMaskBits(IsTetrahedron))
+			{
+				VectorRegister4Float TetrahedronWeights[4];
+				GJKBatchClosestOnTetrahedron(P, TetrahedronWeights);
+				for (int32 Slot = 0; Slot < 4; ++Slot)
+				{
+					OutWeights[Slot] = VectorSelect(IsTetrahedron, TetrahedronWeights[Slot], OutWeights[Slot]);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Run GJKDistance on many shape pairs of the same type, BatchSize pairs at a time.
+	 *
+	 * The support functions are evaluated per pair, but the simplex update (the closest point on the simplex to the origin and
+	 * the choice of which vertices to keep) is evaluated for 4 pairs at once with one SIMD register per vector component.
+	 * Each lane retires as soon as its pair has a result and is immediately refilled with the next pair, so a pair that needs
+	 * many iterations does not hold up the others. BatchSize must be a multiple of 4. Larger batches give the CPU more
+	 * independent work to overlap, at the cost of more evaluations of simplex cases that only some lanes need.
+	 *
+	 * The simplex is solved in single precision, so results may differ from GJKDistance by a small fraction of Epsilon.
+	 *
+	 * @param Pairs The shape pairs with their initial V. Results are written back to each pair.
+	 * @param Epsilon The algorithm terminates when the iterative distance reduction gets below this threshold.
+	 * @param MaxIts A limit on the number of iterations per pair.
+	 */
+	template<int32 BatchSize, typename GJKShapeTypeA, typename GJKShapeTypeB>
+	void GJKDistanceBatch(TArrayView<TGJKDistanceBatchPair<GJKShapeTypeA, GJKShapeTypeB>> Pairs, const FReal Epsilon = FReal(1.e-3), const int32 MaxIts = 16)
+	{
+		static_assert((BatchSize > 0) && ((BatchSize % 4) == 0), "GJKDistanceBatch processes lanes in groups of 4");
+		using FPair = TGJKDistanceBatchPair<GJKShapeTypeA, GJKShapeTypeB>;
+		constexpr int32 NumGroups = BatchSize / 4;
+		constexpr int32 MaxSimplexVerts = 4;
+
+		// SIMD state: the simplex vertices in A-B, their barycentric weights and the closest point on the simplex, one row per simplex slot
+		alignas(16) FRealSingle SimplexX[MaxSimplexVerts][BatchSize] = {};
+		alignas(16) FRealSingle SimplexY[MaxSimplexVerts][BatchSize] = {};
+		alignas(16) FRealSingle SimplexZ[MaxSimplexVerts][BatchSize] = {};
+		alignas(16) FRealSingle Barycentric[MaxSimplexVerts][BatchSize] = {};
+		alignas(16) FRealSingle NumVertsf[BatchSize] = {};
+		alignas(16) FRealSingle ClosestX[BatchSize] = {};
+		alignas(16) FRealSingle ClosestY[BatchSize] = {};
+		alignas(16) FRealSingle ClosestZ[BatchSize] = {};
+
+		// Scalar state for each lane
+		FVec3 SimplexA[BatchSize][MaxSimplexVerts];
+		FVec3 SimplexB[BatchSize][MaxSimplexVerts];
+		FVec3 V[BatchSize];
+		FReal VLen[BatchSize];
+		FReal Mu[BatchSize];
+		int32 NumIts[BatchSize];
+		int32 NumVerts[BatchSize];
+		int32 PairIndices[BatchSize];
+
+		int32 NextPairIndex = 0;
+		int32 NumActiveLanes = 0;
+
+		// Start the next pair in the lane. Pairs whose initial V is already within Epsilon of the origin overlap and are done (as in GJKDistance).
+		// Returns false if there are no more pairs.
+		auto StartLane = [&](const int32 Lane) -> bool
+		{
+			PairIndices[Lane] = INDEX_NONE;
+			NumVerts[Lane] = 0;
+			NumVertsf[Lane] = 0;
+			while (NextPairIndex < Pairs.Num())
+			{
+				const int32 PairIndex = NextPairIndex++;
+				FPair& Pair = Pairs[PairIndex];
+				const FReal InitialVLen = Pair.InitialV.Size();
+				if (InitialVLen > Epsilon)
+				{
+					PairIndices[Lane] = PairIndex;
+					V[Lane] = Pair.InitialV;
+					VLen[Lane] = InitialVLen;
+					Mu[Lane] = 0;
+					NumIts[Lane] = 0;
+					return true;
+				}
+				Pair.Result = EGJKDistanceResult::DeepContact;
+			}
+			return false;
+		};
+
+		// Write the result for a lane that has converged. See GJKDistance.
+		auto FinishLane = [&](const int32 Lane, const FVec3& SupportA, const FVec3& SupportB)
+		{
+			FPair& Pair = Pairs[PairIndices[Lane]];
+			const FReal AMargin = Pair.A.GetMargin();
+			const FReal BMargin = Pair.B.GetMargin();
+
+			FVec3 NearestA = SupportA;
+			FVec3 NearestB = SupportB;
+			if (NumVerts[Lane] > 0)
+			{
+				NearestA = FVec3(0);
+				NearestB = FVec3(0);
+				for (int32 Slot = 0; Slot < NumVerts[Lane]; ++Slot)
+				{
+					NearestA += FReal(Barycentric[Slot][Lane]) * SimplexA[Lane][Slot];
+					NearestB += FReal(Barycentric[Slot][Lane]) * SimplexB[Lane][Slot];
+				}
+			}
+
+			const FVec3 NormalA = -V[Lane] / VLen[Lane];
+			Pair.Distance = VLen[Lane] - (AMargin + BMargin);
+			Pair.DistanceLowerBound = Mu[Lane] - (AMargin + BMargin);
+			Pair.NearestA = NearestA + AMargin * NormalA;
+			Pair.NearestB = Pair.B.InverseTransformPositionNoScale(NearestB - BMargin * NormalA);
+			Pair.NormalA = NormalA;
+			Pair.Result = (Pair.Distance >= 0) ? EGJKDistanceResult::Separated : EGJKDistanceResult::Contact;
+		};
+
+		for (int32 Lane = 0; Lane < BatchSize; ++Lane)
+		{
+			if (StartLane(Lane))
+			{
+				++NumActiveLanes;
+			}
+		}
+
+		while (NumActiveLanes > 0)
+		{
+			// Find a new support point for each lane, retiring lanes that have stopped making progress
+			for (int32 Lane = 0; Lane < BatchSize; ++Lane)
+			{
+				if (PairIndices[Lane] == INDEX_NONE)
+				{
+					continue;
+				}
+
+				const FPair& Pair = Pairs[PairIndices[Lane]];
+				int32 VertexIndexA = INDEX_NONE, VertexIndexB = INDEX_NONE;
+				const FVec3 SupportA = Pair.A.SupportCore(-V[Lane], Pair.A.GetMargin(), nullptr, VertexIndexA);
+				const FVec3 SupportB = Pair.B.SupportCore(V[Lane], Pair.B.GetMargin(), nullptr, VertexIndexB);
+				const FVec3 W = SupportA - SupportB;
+
+				const FReal D = FVec3::DotProduct(V[Lane], W) / VLen[Lane];
+				Mu[Lane] = FMath::Max(Mu[Lane], D);
+
+				const bool bCloseEnough = ((VLen[Lane] - Mu[Lane]) < Epsilon);
+				if (bCloseEnough || (++NumIts[Lane] > MaxIts))
+				{
+					FinishLane(Lane, SupportA, SupportB);
+
+					// A refilled lane sits out the simplex update below (it has no vertices) and gets its first support point next time around
+					if (!StartLane(Lane))
+					{
+						--NumActiveLanes;
+					}
+					continue;
+				}
+
+				const int32 Slot = NumVerts[Lane]++;
+				check(Slot < MaxSimplexVerts);
+				SimplexX[Slot][Lane] = FRealSingle(W.X);
+				SimplexY[Slot][Lane] = FRealSingle(W.Y);
+				SimplexZ[Slot][Lane] = FRealSingle(W.Z);
+				SimplexA[Lane][Slot] = SupportA;
+				SimplexB[Lane][Slot] = SupportB;
+				NumVertsf[Lane] = FRealSingle(NumVerts[Lane]);
+			}
+
+			// Find the closest point to the origin on every simplex, 4 lanes at a time
+			for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+			{
+				const int32 LaneOffset = GroupIndex * 4;
+
+				Private::FGJKBatchVec3 P[MaxSimplexVerts];
+				for (int32 Slot = 0; Slot < MaxSimplexVerts; ++Slot)
+				{
+					P[Slot].X = VectorLoadAligned(&SimplexX[Slot][LaneOffset]);
+					P[Slot].Y = VectorLoadAligned(&SimplexY[Slot][LaneOffset]);
+					P[Slot].Z = VectorLoadAligned(&SimplexZ[Slot][LaneOffset]);
+				}
+
+				VectorRegister4Float Weights[MaxSimplexVerts];
+				Private::GJKBatchClosestOnSimplex(P, VectorLoadAligned(&NumVertsf[LaneOffset]), Weights);
+
+				Private::FGJKBatchVec3 Closest = { VectorZeroFloat(), VectorZeroFloat(), VectorZeroFloat() };
+				for (int32 Slot = 0; Slot < MaxSimplexVerts; ++Slot)
+				{
+					Closest = Private::GJKBatchMultiplyAdd(Weights[Slot], P[Slot], Closest);
+					VectorStoreAligned(Weights[Slot], &Barycentric[Slot][LaneOffset]);
+				}
+				VectorStoreAligned(Closest.X, &ClosestX[LaneOffset]);
+				VectorStoreAligned(Closest.Y, &ClosestY[LaneOffset]);
+				VectorStoreAligned(Closest.Z, &ClosestZ[LaneOffset]);
+			}
+
+			// Drop the simplex vertices that do not contribute to the closest point and retire lanes that reached the origin
+			for (int32 Lane = 0; Lane < BatchSize; ++Lane)
+			{
+				if ((PairIndices[Lane] == INDEX_NONE) || (NumVerts[Lane] == 0))
+				{
+					continue;
+				}
+
+				int32 NumKept = 0;
+				for (int32 Slot = 0; Slot < NumVerts[Lane]; ++Slot)
+				{
+					if (Barycentric[Slot][Lane] > 0)
+					{
+						SimplexX[NumKept][Lane] = SimplexX[Slot][Lane];
+						SimplexY[NumKept][Lane] = SimplexY[Slot][Lane];
+						SimplexZ[NumKept][Lane] = SimplexZ[Slot][Lane];
+						Barycentric[NumKept][Lane] = Barycentric[Slot][Lane];
+						SimplexA[Lane][NumKept] = SimplexA[Lane][Slot];
+						SimplexB[Lane][NumKept] = SimplexB[Lane][Slot];
+						++NumKept;
+					}
+				}
+				NumVerts[Lane] = NumKept;
+				NumVertsf[Lane] = FRealSingle(NumKept);
+
+				V[Lane] = FVec3(ClosestX[Lane], ClosestY[Lane], ClosestZ[Lane]);
+				VLen[Lane] = V[Lane].Size();
+				if (VLen[Lane] <= Epsilon)
+				{
+					// Our geometries overlap - we do not set any outputs
+					Pairs[PairIndices[Lane]].Result = EGJKDistanceResult::DeepContact;
+					if (!StartLane(Lane))
+					{
+						--NumActiveLanes;
+					}
+				}
+			}
+		}
+	}
+}
@@ -20,6 +20,21 @@ class FGraphColoring
 	template<typename DynamicParticlesType, int32 N, bool bAllDynamic = false>
 	static CHAOS_API TArray<TArray<int32>> ComputeGraphColoringParticlesOrRange(const TArray<TVector<int32,N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd);
 
+	/**
+	 * Jones-Plassmann colouring run in parallel rounds. Each round colours the edges that have the highest hashed priority among their uncoloured neighbours,
+	 * so the result only depends on the graph and not on the number of worker threads. Uses a few more colours than the serial greedy colouring.
+	 * ComputeGraphColoringParticlesOrRange switches to this for large graphs when p.Chaos.GraphColoring.Parallel is enabled.
+	 */
+	template<typename DynamicParticlesType, int32 N, bool bAllDynamic = false>
+	static CHAOS_API TArray<TArray<int32>> ComputeGraphColoringParallelParticlesOrRange(const TArray<TVector<int32,N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd);
+
+	/**
+	 * Move edges out of the largest colours into smaller colours they do not conflict with, targeting equal colour sizes rounded up to a multiple of BatchSize.
+	 * Keeps the number of colours, but leaves fewer partially filled SIMD batches and fewer small colours with little parallel work.
+	 */
+	template<typename DynamicParticlesType, int32 N, bool bAllDynamic = false>
+	static CHAOS_API void BalanceGraphColoring(TArray<TArray<int32>>& ColorGraph, const TArray<TVector<int32,N>>& Graph, const DynamicParticlesType& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd, const int32 BatchSize);
+
 	template<typename T, int32 N>
 	inline static TArray<TArray<int32>> ComputeGraphColoring(const TArray<TVector<int32, N>>& Graph, const TDynamicParticles<T, 3>& InParticles, const int32 GraphParticlesStart, const int32 GraphParticlesEnd)
 	{
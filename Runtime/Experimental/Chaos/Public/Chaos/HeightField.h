@@ -1099,6 +1099,14 @@ namespace Chaos
 		CHAOS_API bool WalkOnLowRes(FWalkingData& WalkingData, const FVec2& Scale2D, const FVec3& DirScaled) const;
 
 		CHAOS_API bool GridCast(const FVec3& StartPoint, const FVec3& Dir, const FReal Length, FHeightfieldRaycastVisitor& Visitor) const;
+
+		// Coarse to fine walk of the min/max height pyramid. Calls VisitCell(CellIndex, CurrentLength) for every cell whose bounds, inflated
+		// by InHalfExtents, are hit within CurrentLength, nearest nodes first. Returns true if VisitCell stopped the traversal by returning false.
+		template<typename CellVisitorType>
+		bool PyramidCast(const FVec3& StartPoint, const FVec3& Dir, const FReal Length, const FVec3& InHalfExtents, CellVisitorType&& VisitCell) const;
+		void GetMinMaxPyramidNodeBoundsScaled(int32 Level, int32 NodeX, int32 NodeY, FAABB3& OutBounds) const;
+		CHAOS_API void BuildMinMaxPyramid();
+
 		CHAOS_API bool GetGridIntersections(FBounds2D InFlatBounds, TArray<TVec2<int32>>& OutInterssctions) const;
 		CHAOS_API bool GetGridIntersectionsBatch(FBounds2D InFlatBounds, TArray<TVec2<int32>>& OutIntersections, const FAABBVectorized& Bounds) const;
 		
@@ -1117,6 +1125,18 @@ namespace Chaos
 		// Cached when bounds are requested. Mutable to allow GetBounds to be logical const
 		mutable FAABB3 CachedBounds;
 
+		struct FMinMaxPyramidLevel
+		{
+			int32 Offset;
+			int32 NumX;
+			int32 NumY;
+		};
+		// Min/max heights of blocks of cells for skipping empty space in long queries. Level 0 nodes cover 2x2 cells, every level above
+		// halves the resolution of the previous one down to a single node. Rebuilt from the heights with the query data, never serialized.
+		// With 4 byte nodes, level 0 costs 1 byte per cell and all levels together about 1.33 bytes per cell.
+		TArray<FMinMaxPyramidLevel> MinMaxPyramidLevels;
+		TArray<FDataType::MinMaxHeights> MinMaxPyramid;
+
 		CHAOS_API void CalcBounds();
 		CHAOS_API void BuildQueryData();
 
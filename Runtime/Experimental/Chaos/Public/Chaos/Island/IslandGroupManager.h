@@ -102,10 +102,33 @@ namespace Chaos
 			*/
 			inline int32 GetNumActiveGroups() const { return NumActiveGroups; }
 
+			/**
+			 * The total number of groups, including inactive groups
+			*/
+			inline int32 GetNumGroups() const { return IslandGroups.Num(); }
+
+			/**
+			 * The time in seconds spent solving the specified group in the last call to Solve (not including gather and scatter).
+			 * Zero for inactive groups.
+			*/
+			inline double GetGroupSolveTime(const int32 GroupIndex) const { return GroupSolveTimes[GroupIndex]; }
+
+			/**
+			 * The slowest group solve time divided by the average over the active groups in the last call to Solve.
+			 * 1 when the work is perfectly balanced across the groups.
+			*/
+			CHAOS_API double GetGroupSolveImbalance() const;
+
 			/**
 			 * Get the specified group
 			*/
 			inline FPBDIslandConstraintGroupSolver* GetGroup(const int32 GroupIndex) { return IslandGroups[GroupIndex].Get(); }
+			inline const FPBDIslandConstraintGroupSolver* GetGroup(const int32 GroupIndex) const { return IslandGroups[GroupIndex].Get(); }
+
+			/**
+			 * The number of worker threads the groups are sized for. Zero when solving on a single thread, in which case islands are never colored.
+			*/
+			inline int32 GetNumWorkerThreads() const { return NumWorkerThreads; }
 
 			/**
 			 * Pull all the active islands from the IslandManager and assign to groups.
@@ -173,6 +196,9 @@ namespace Chaos
 			int32 TargetNumConstraintsPerTask;
 			FIterationSettings Iterations;
 
+			// Per-group solve time from the last call to Solve
+			TArray<double> GroupSolveTimes;
+
 	#if CSV_PROFILER_STATS
 			double& GetThreadStatAccumulator(const int32 ThreadIndex, const FIslandGroupStats::EPerIslandStat StatId)
 			{
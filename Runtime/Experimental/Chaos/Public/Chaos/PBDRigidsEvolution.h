@@ -53,6 +53,8 @@ struct FBroadPhaseConfig
 	int32 AABBMaxTreeDepth;
 	FRealSingle MaxPayloadSize;
 	int32 IterationsPerTimeSlice;
+	// Static AABB trees are queried through 4-wide nodes, see TAABBTree::SetUseWideNodes
+	int32 UseWideNodes;
 
 	FBroadPhaseConfig()
 	{
@@ -64,6 +66,7 @@ struct FBroadPhaseConfig
 		AABBMaxTreeDepth = 200;
 		MaxPayloadSize = 100000;
 		IterationsPerTimeSlice = 4000;
+		UseWideNodes = 0;
 	}
 };
 
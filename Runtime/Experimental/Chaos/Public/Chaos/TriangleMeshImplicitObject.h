@@ -118,6 +118,85 @@ namespace Chaos
 			FChildData Children;
 		};
 
+		// Quantized layout: bounds are stored as 16 bit fractions of the bounds of the parent node (faces: of their leaf), which
+		// traversal decodes on the way down. Conservative rounding means the decoded bounds always contain the original ones.
+		static constexpr int32 QuantizedRange = TNumericLimits<uint16>::Max();
+		static constexpr int32 QuantizedFaceCountBits = 6;
+		static constexpr uint32 QuantizedFaceCountMask = (1u << QuantizedFaceCountBits) - 1;
+		static constexpr uint32 QuantizedEmptyChild = TNumericLimits<uint32>::Max();
+		// Per face: min xyz, max xyz
+		static constexpr int32 QuantizedFaceStride = 6;
+
+		struct FQuantizedChildData
+		{
+			// The packed child index, (ChildOrFaceIndex << QuantizedFaceCountBits) | FaceCount, is split over the unused W of min and max
+			FORCEINLINE uint32 GetPackedIndex() const
+			{
+				return uint32(Min[3]) | (uint32(Max[3]) << 16);
+			}
+
+			FORCEINLINE void SetPackedIndex(uint32 PackedIndex)
+			{
+				Min[3] = uint16(PackedIndex & 0xFFFF);
+				Max[3] = uint16(PackedIndex >> 16);
+			}
+
+			void Serialize(FArchive& Ar)
+			{
+				for (int32 Index = 0; Index < 4; ++Index)
+				{
+					Ar << Min[Index];
+					Ar << Max[Index];
+				}
+			}
+
+			uint16 Min[4];
+			uint16 Max[4];
+		};
+
+		struct FQuantizedNode
+		{
+			void Serialize(FArchive& Ar)
+			{
+				Children[0].Serialize(Ar);
+				Children[1].Serialize(Ar);
+			}
+			FQuantizedChildData Children[2];
+		};
+
+		// Decoded bounds of a node, that its children were quantized against
+		struct FQuantizedFrame
+		{
+			explicit FQuantizedFrame(const FAABBVectorized& Bounds)
+				: Min(Bounds.GetMin())
+				, Scale(VectorMultiply(VectorSubtract(Bounds.GetMax(), Bounds.GetMin()), VectorSetFloat1(1.0f / QuantizedRange)))
+			{
+				// Round the scale outwards until the top of the range decodes to at least the max, otherwise children touching the max
+				// of their parent could not be contained. Scale is never negative, so adding one to its bits steps to the next float up.
+				const VectorRegister4Float Range = VectorSetFloat1(FRealSingle(QuantizedRange));
+				for (int32 Iteration = 0; Iteration < 8; ++Iteration)
+				{
+					const VectorRegister4Float TooSmall = VectorCompareLT(VectorMultiplyAdd(Range, Scale, Min), Bounds.GetMax());
+					if (!VectorMaskBits(TooSmall))
+					{
+						break;
+					}
+					Scale = VectorCastIntToFloat(VectorIntSubtract(VectorCastFloatToInt(Scale), VectorCastFloatToInt(TooSmall)));
+				}
+			}
+
+			FORCEINLINE_DEBUGGABLE FAABBVectorized Decode(const uint16* QuantizedMin, const uint16* QuantizedMax) const
+			{
+				// The W lanes load index bits or the next face, the zero W of the frame clears them
+				return FAABBVectorized(
+					VectorMultiplyAdd(VectorLoadURGBA16N(const_cast<uint16*>(QuantizedMin)), Scale, Min),
+					VectorMultiplyAdd(VectorLoadURGBA16N(const_cast<uint16*>(QuantizedMax)), Scale, Min));
+			}
+
+			VectorRegister4Float Min;
+			VectorRegister4Float Scale;
+		};
+
 		template <typename SQVisitor>
 		FORCEINLINE_DEBUGGABLE void Raycast(const FVec3& Start, const FVec3& Dir, const FReal Length, SQVisitor& Visitor) const
 		{
@@ -231,9 +310,83 @@ namespace Chaos
 			return EVisitorResult::Continue;
 		}
 
+		template <typename BoundsFilterType, typename FaceVisitorType>
+		FORCEINLINE_DEBUGGABLE EVisitorResult VisitQuantizedFaces(int32 StartIndex, int32 IndexCount, const FQuantizedFrame& LeafFrame, BoundsFilterType& BoundsFilter, FaceVisitorType& FaceVisitor) const
+		{
+			const int32 EndIndex = (StartIndex + IndexCount);
+			for (int32 FaceIndex = StartIndex; FaceIndex < EndIndex; ++FaceIndex)
+			{
+				const uint16* QuantizedBounds = &QuantizedFaceBounds[FaceIndex * QuantizedFaceStride];
+				if (BoundsFilter(LeafFrame.Decode(QuantizedBounds, QuantizedBounds + 3)) == EFilterResult::Keep)
+				{
+					if (FaceVisitor(FaceIndex) == EVisitorResult::Stop)
+					{
+						return EVisitorResult::Stop;
+					}
+				}
+			}
+			return EVisitorResult::Continue;
+		}
+
+		template <typename BoundsFilterType, typename FaceVisitorType>
+		FORCEINLINE_DEBUGGABLE void VisitQuantizedTree(BoundsFilterType& BoundsFilter, FaceVisitorType& FaceVisitor) const
+		{
+			if (QuantizedNodes.Num() == 0)
+			{
+				return;
+			}
+
+			struct FStackEntry
+			{
+				FQuantizedFrame Frame;
+				int32 NodeIndex;
+			};
+			TArray<FStackEntry, TInlineAllocator<32>> NodeStack;
+			NodeStack.Push({ FQuantizedFrame(QuantizedRootBounds), 0 });
+			while (NodeStack.Num())
+			{
+				const FStackEntry Entry = NodeStack.Pop(EAllowShrinking::No);
+				check(QuantizedNodes.IsValidIndex(Entry.NodeIndex));
+				const FQuantizedNode& Node = QuantizedNodes[Entry.NodeIndex];
+
+				// Same order as VisitTree, so both layouts report hits in the same order
+				for (int32 ChildIndex = 0; ChildIndex < 2; ++ChildIndex)
+				{
+					const FQuantizedChildData& ChildData = Node.Children[ChildIndex];
+					const uint32 PackedIndex = ChildData.GetPackedIndex();
+					if (PackedIndex != QuantizedEmptyChild)
+					{
+						const FAABBVectorized ChildBounds = Entry.Frame.Decode(ChildData.Min, ChildData.Max);
+						if (BoundsFilter(ChildBounds) == EFilterResult::Keep)
+						{
+							const int32 ChildOrFaceIndex = int32(PackedIndex >> QuantizedFaceCountBits);
+							const int32 FaceCount = int32(PackedIndex & QuantizedFaceCountMask);
+							if (FaceCount > 0)
+							{
+								if (EVisitorResult::Stop == VisitQuantizedFaces(ChildOrFaceIndex, FaceCount, FQuantizedFrame(ChildBounds), BoundsFilter, FaceVisitor))
+								{
+									return;
+								}
+							}
+							else
+							{
+								NodeStack.Push({ FQuantizedFrame(ChildBounds), ChildOrFaceIndex });
+							}
+						}
+					}
+				}
+			}
+		}
+
 		template <typename BoundsFilterType, typename FaceVisitorType>
 		FORCEINLINE_DEBUGGABLE void VisitTree(BoundsFilterType& BoundsFilter, FaceVisitorType& FaceVisitor) const
 		{
+			if (bQuantized)
+			{
+				VisitQuantizedTree(BoundsFilter, FaceVisitor);
+				return;
+			}
+
 			if (Nodes.Num() == 0)
 			{
 				return;
@@ -276,6 +429,24 @@ namespace Chaos
 		void Serialize(FChaosArchive& Ar)
 		{
 			Ar.UsingCustomVersion(FUE5MainStreamObjectVersion::GUID);
+			Ar.UsingCustomVersion(FExternalPhysicsCustomObjectVersion::GUID);
+			if (Ar.CustomVer(FExternalPhysicsCustomObjectVersion::GUID) >= FExternalPhysicsCustomObjectVersion::TrimeshQuantizedBVH)
+			{
+				Ar << bQuantized;
+			}
+			else if (Ar.IsLoading())
+			{
+				bQuantized = false;
+			}
+
+			if (bQuantized)
+			{
+				Ar << QuantizedRootBounds;
+				Ar << QuantizedNodes;
+				Ar << QuantizedFaceBounds;
+				return;
+			}
+
 			Ar << Nodes;
 			Ar << FaceBounds;
 			if (Ar.CustomVer(FUE5MainStreamObjectVersion::GUID) < FUE5MainStreamObjectVersion::RemoveTriangleMeshBVHFaces)
@@ -284,9 +455,29 @@ namespace Chaos
 				Ar << TmpFaces;
 			}
 		}
-		
+
+		/** Clears both layouts */
+		CHAOS_API void Reset();
+
+		/**
+		 * Converts the tree to the quantized layout and frees the full precision one. Queries return the same faces, but bounds tests
+		 * are slightly looser. Returns false, leaving the tree unchanged, if a leaf or index is too large to pack.
+		 */
+		CHAOS_API bool Quantize();
+
+		bool IsQuantized() const { return bQuantized; }
+
+		CHAOS_API SIZE_T GetAllocatedSize() const;
+
 		TArray<FNode> Nodes;
 		TArray<FAABBVectorized> FaceBounds;
+
+		// Quantized layout, used instead of Nodes and FaceBounds when bQuantized is set
+		FAABBVectorized QuantizedRootBounds;
+		TArray<FQuantizedNode> QuantizedNodes;
+		// QuantizedFaceStride values per face, plus padding so that decoding the last face can load 4 values
+		TArray<uint16> QuantizedFaceBounds;
+		bool bQuantized = false;
 	};
 
 	FORCEINLINE_DEBUGGABLE FChaosArchive& operator<<(FChaosArchive& Ar, FTrimeshBVH::FChildData& ChildData)
@@ -301,6 +492,12 @@ namespace Chaos
 		return Ar;
 	}
 
+	FORCEINLINE_DEBUGGABLE FChaosArchive& operator<<(FChaosArchive& Ar, FTrimeshBVH::FQuantizedNode& Node)
+	{
+		Node.Serialize(Ar);
+		return Ar;
+	}
+
 	FORCEINLINE_DEBUGGABLE FChaosArchive& operator<<(FChaosArchive& Ar, FTrimeshBVH::FAABBType& Bounds)
 	{
 		TBox<FRealSingle, 3>::SerializeAsAABB(Ar, Bounds);
@@ -513,15 +513,336 @@ inline void CopyDataFromObject(FPBDJointSettings& Data, const FPBDJointConstrain
 	Data = Joint.GetSettings();
 }
 
+/**
+ * Describes how a history property is split into lanes for delta compression. Lanes hold the raw bits of the values (doubles as 64 bits,
+ * floats as 32 bits) so that the encoding is lossless, history is compared bit for bit against the live particle when checking for desyncs.
+ * Types without a specialization are never delta compressed.
+ */
+template <typename T>
+struct TRewindHistoryDeltaTraits
+{
+	static constexpr bool bSupported = false;
+	static constexpr int32 NumLanes = 1;
+	static constexpr uint32 FloatLaneMask = 0;
+	static void Gather(const T& Value, uint64* OutLanes) {}
+	static void Scatter(const uint64* Lanes, T& OutValue) {}
+};
+
+template <>
+struct TRewindHistoryDeltaTraits<FParticlePositionRotation>
+{
+	static constexpr bool bSupported = true;
+	static constexpr int32 NumLanes = 7;
+	// X is double, R is float
+	static constexpr uint32 FloatLaneMask = 0x78;
+
+	static void Gather(const FParticlePositionRotation& Value, uint64* OutLanes)
+	{
+		const FVec3& X = Value.GetX();
+		const FRotation3f R(Value.GetR());
+		OutLanes[0] = BitCast<uint64>(X.X);
+		OutLanes[1] = BitCast<uint64>(X.Y);
+		OutLanes[2] = BitCast<uint64>(X.Z);
+		OutLanes[3] = BitCast<uint32>(R.X);
+		OutLanes[4] = BitCast<uint32>(R.Y);
+		OutLanes[5] = BitCast<uint32>(R.Z);
+		OutLanes[6] = BitCast<uint32>(R.W);
+	}
+
+	static void Scatter(const uint64* Lanes, FParticlePositionRotation& OutValue)
+	{
+		OutValue.SetX(FVec3(BitCast<double>(Lanes[0]), BitCast<double>(Lanes[1]), BitCast<double>(Lanes[2])));
+		OutValue.SetR(FRotation3(FQuat4f(BitCast<float>(uint32(Lanes[3])), BitCast<float>(uint32(Lanes[4])), BitCast<float>(uint32(Lanes[5])), BitCast<float>(uint32(Lanes[6])))));
+	}
+};
+
+template <>
+struct TRewindHistoryDeltaTraits<FParticleVelocities>
+{
+	static constexpr bool bSupported = true;
+	static constexpr int32 NumLanes = 6;
+	static constexpr uint32 FloatLaneMask = 0x3F;
+
+	static void Gather(const FParticleVelocities& Value, uint64* OutLanes)
+	{
+		const FVec3f V(Value.GetV());
+		const FVec3f W(Value.GetW());
+		OutLanes[0] = BitCast<uint32>(V.X);
+		OutLanes[1] = BitCast<uint32>(V.Y);
+		OutLanes[2] = BitCast<uint32>(V.Z);
+		OutLanes[3] = BitCast<uint32>(W.X);
+		OutLanes[4] = BitCast<uint32>(W.Y);
+		OutLanes[5] = BitCast<uint32>(W.Z);
+	}
+
+	static void Scatter(const uint64* Lanes, FParticleVelocities& OutValue)
+	{
+		OutValue.SetV(FVec3(FVec3f(BitCast<float>(uint32(Lanes[0])), BitCast<float>(uint32(Lanes[1])), BitCast<float>(uint32(Lanes[2])))));
+		OutValue.SetW(FVec3(FVec3f(BitCast<float>(uint32(Lanes[3])), BitCast<float>(uint32(Lanes[4])), BitCast<float>(uint32(Lanes[5])))));
+	}
+};
+
+/**
+ * Delta compressed history of a property, in FrameAndPhase order. Every KeyframeInterval entries starts a keyframe, the entries after it store
+ * the difference to a linear prediction from the two previous entries: the XOR of the lane bits, with leading zero bytes dropped.
+ * Reading an entry decodes forward from its keyframe. The newest entry is kept uncompressed so that it can be written to after Add,
+ * and is encoded when the next entry is added.
+ */
+template <typename T>
+class TDeltaPropertyHistory
+{
+	using FTraits = TRewindHistoryDeltaTraits<T>;
+	static constexpr int32 NumLanes = FTraits::NumLanes;
+	static constexpr int32 NumControlBytes = (NumLanes + 1) / 2;
+
+public:
+	static constexpr int32 KeyframeInterval = 8;
+
+	explicit TDeltaPropertyHistory(int32 InCapacity)
+	: Capacity(InCapacity)
+	{
+	}
+
+	//Number of readable entries, older ones may still be stored until their keyframe block is evicted
+	int32 NumValid() const
+	{
+		return ValidCount;
+	}
+
+	int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+	//Number of entries stored or evicted since the last Empty. Unlike Num this doesn't change when old blocks are evicted, so it can be saved and restored
+	int32 NumRecorded() const
+	{
+		return NumEvicted + Entries.Num();
+	}
+
+	//Removes all entries after the first RecordedNum ones, see NumRecorded
+	void TruncateRecorded(const int32 RecordedNum)
+	{
+		Truncate(FMath::Max(RecordedNum - NumEvicted, 0));
+	}
+
+	FFrameAndPhase GetFrameAndPhase(const int32 Idx) const
+	{
+		return Entries[Idx].FrameAndPhase;
+	}
+
+	//Adds the newest entry and returns it for writing. Must be in FrameAndPhase order
+	T& Add(const FFrameAndPhase FrameAndPhase)
+	{
+		if (Entries.Num())
+		{
+			Encode(Entries.Num() - 1, Head);
+		}
+
+		//Drop the oldest block once none of it is readable
+		ValidCount = FMath::Min(ValidCount + 1, Capacity);
+		if (Entries.Num() + 1 - ValidCount > KeyframeInterval)
+		{
+			const int32 ByteShift = Entries[KeyframeInterval].Offset;
+			Bytes.RemoveAt(0, ByteShift, EAllowShrinking::No);
+			Entries.RemoveAt(0, KeyframeInterval, EAllowShrinking::No);
+			for (FEntry& Entry : Entries)
+			{
+				Entry.Offset -= ByteShift;
+			}
+			NumEvicted += KeyframeInterval;
+		}
+
+		Entries.Add({ FrameAndPhase, Bytes.Num() });
+		return Head;
+	}
+
+	//Decodes an entry. The returned pointer is valid until the next call on this history
+	const T* Read(const int32 Idx) const
+	{
+		if (Idx == Entries.Num() - 1)
+		{
+			return &Head;
+		}
+
+		uint64 Lanes[NumLanes];
+		DecodeLanes(Idx, Lanes, nullptr);
+		FTraits::Scatter(Lanes, Decoded);
+		return &Decoded;
+	}
+
+	//Removes all entries from NewNum onwards
+	void Truncate(const int32 NewNum)
+	{
+		if (NewNum >= Entries.Num())
+		{
+			return;
+		}
+
+		ValidCount = FMath::Max(ValidCount - (Entries.Num() - NewNum), 0);
+
+		if (NewNum > 0)
+		{
+			//The new newest entry goes back to being uncompressed
+			const int32 HeadIdx = NewNum - 1;
+			uint64 Lanes[NumLanes];
+			DecodeLanes(HeadIdx, Lanes, Previous);
+			FTraits::Scatter(Lanes, Head);
+			Bytes.SetNum(Entries[HeadIdx].Offset, EAllowShrinking::No);
+		}
+		else
+		{
+			Bytes.Reset();
+		}
+		Entries.SetNum(NewNum, EAllowShrinking::No);
+	}
+
+	void Empty()
+	{
+		Entries.Empty();
+		Bytes.Empty();
+		ValidCount = 0;
+		NumEvicted = 0;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Entries.GetAllocatedSize() + Bytes.GetAllocatedSize();
+	}
+
+private:
+	struct FEntry
+	{
+		FFrameAndPhase FrameAndPhase;
+		int32 Offset;
+	};
+
+	static bool IsFloatLane(const int32 Lane)
+	{
+		return (FTraits::FloatLaneMask >> Lane) & 1;
+	}
+
+	static void Predict(const int32 BlockIdx, const uint64 (&Prev)[2][NumLanes], uint64* OutPrediction)
+	{
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			if (BlockIdx == 0)
+			{
+				OutPrediction[Lane] = 0;
+			}
+			else if (BlockIdx == 1)
+			{
+				OutPrediction[Lane] = Prev[0][Lane];
+			}
+			else if (IsFloatLane(Lane))
+			{
+				const float Linear = 2.0f * BitCast<float>(uint32(Prev[0][Lane])) - BitCast<float>(uint32(Prev[1][Lane]));
+				OutPrediction[Lane] = BitCast<uint32>(Linear);
+			}
+			else
+			{
+				//Doubling is exact, so this gives the same bits whether or not the compiler fuses it
+				const double Linear = 2.0 * BitCast<double>(Prev[0][Lane]) - BitCast<double>(Prev[1][Lane]);
+				OutPrediction[Lane] = BitCast<uint64>(Linear);
+			}
+		}
+	}
+
+	static void Shift(uint64 (&Prev)[2][NumLanes], const uint64* Lanes)
+	{
+		FMemory::Memcpy(Prev[1], Prev[0], sizeof(Prev[0]));
+		FMemory::Memcpy(Prev[0], Lanes, sizeof(Prev[0]));
+	}
+
+	void Encode(const int32 Idx, const T& Value)
+	{
+		check(Bytes.Num() == Entries[Idx].Offset);
+
+		uint64 Lanes[NumLanes];
+		uint64 Prediction[NumLanes];
+		FTraits::Gather(Value, Lanes);
+		Predict(Idx % KeyframeInterval, Previous, Prediction);
+
+		const int32 ControlStart = Bytes.AddZeroed(NumControlBytes);
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			uint64 Delta = Lanes[Lane] ^ Prediction[Lane];
+			const int32 NumBytes = int32(64 - FMath::CountLeadingZeros64(Delta) + 7) / 8;
+			Bytes[ControlStart + Lane / 2] |= uint8(NumBytes << ((Lane & 1) * 4));
+			for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+			{
+				Bytes.Add(uint8(Delta));
+				Delta >>= 8;
+			}
+		}
+
+		Shift(Previous, Lanes);
+	}
+
+	//Decodes the lanes of entry Idx, and optionally the two entries before it as used for prediction
+	void DecodeLanes(const int32 Idx, uint64* OutLanes, uint64 (*OutPrevious)[NumLanes]) const
+	{
+		uint64 Prev[2][NumLanes] = {};
+		const int32 BlockStart = Idx - Idx % KeyframeInterval;
+		const uint8* Data = Bytes.GetData() + Entries[BlockStart].Offset;
+		for (int32 EntryIdx = BlockStart; ; ++EntryIdx)
+		{
+			uint64 Prediction[NumLanes];
+			Predict(EntryIdx - BlockStart, Prev, Prediction);
+
+			const uint8* Control = Data;
+			Data += NumControlBytes;
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				const int32 NumBytes = (Control[Lane / 2] >> ((Lane & 1) * 4)) & 0xF;
+				uint64 Delta = 0;
+				for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+				{
+					Delta |= uint64(Data[Byte]) << (Byte * 8);
+				}
+				Data += NumBytes;
+				OutLanes[Lane] = Prediction[Lane] ^ Delta;
+			}
+
+			if (EntryIdx == Idx)
+			{
+				if (OutPrevious)
+				{
+					FMemory::Memcpy(OutPrevious, Prev, sizeof(Prev));
+				}
+				return;
+			}
+			Shift(Prev, OutLanes);
+		}
+	}
+
+	int32 Capacity;
+	int32 ValidCount = 0;
+	//Entries dropped from the front with their keyframe block
+	int32 NumEvicted = 0;
+	TArray<FEntry> Entries;
+	TArray<uint8> Bytes;
+	T Head;
+	//Lanes of the two entries before Head, used to predict Head when it gets encoded
+	uint64 Previous[2][NumLanes] = {};
+	mutable T Decoded;
+};
+
 template <typename T, EChaosProperty PropName, bool bNoEntryIsHead = true>
 class TParticlePropertyBuffer
 {
 public:
-	explicit TParticlePropertyBuffer(int32 InCapacity)
+	//If bDeltaCompress is set (and T supports it), entries are stored in a TDeltaPropertyHistory instead of the properties pool.
+	//Writes must then be in FrameAndPhase order (no Insert), and a pointer returned by Read is only valid until the next call on this buffer.
+	explicit TParticlePropertyBuffer(int32 InCapacity, bool bDeltaCompress = false)
 	: Next(0)
 	, NumValid(0)
 	, Capacity(InCapacity)
 	{
+		if (bDeltaCompress && TRewindHistoryDeltaTraits<T>::bSupported)
+		{
+			DeltaHistory = MakeUnique<TDeltaPropertyHistory<T>>(InCapacity);
+		}
 	}
 
 	TParticlePropertyBuffer(TParticlePropertyBuffer<T, PropName>&& Other)
@@ -529,6 +850,7 @@ public:
 	, NumValid(Other.NumValid)
 	, Capacity(Other.Capacity)
 	, Buffer(MoveTemp(Other.Buffer))
+	, DeltaHistory(MoveTemp(Other.DeltaHistory))
 	{
 		Other.NumValid = 0;
 		Other.Next = 0;
@@ -559,12 +881,26 @@ public:
 	const T* Read(const FFrameAndPhase FrameAndPhase, const FDirtyPropertiesPool& Manager) const
 	{
 		const int32 Idx = FindIdx(FrameAndPhase);
-		return Idx != INDEX_NONE ? &GetPool(Manager).GetElement(Buffer[Idx].Ref) : nullptr;
+		if (Idx == INDEX_NONE)
+		{
+			return nullptr;
+		}
+		return DeltaHistory ? DeltaHistory->Read(Idx) : &GetPool(Manager).GetElement(Buffer[Idx].Ref);
 	}
 
 	//Get the FrameAndPhase of the head / last entry
 	const bool GetHeadFrameAndPhase(FFrameAndPhase& OutFrameAndPhase) const
 	{
+		if (DeltaHistory)
+		{
+			if (DeltaHistory->NumValid())
+			{
+				OutFrameAndPhase = DeltaHistory->GetFrameAndPhase(DeltaHistory->Num() - 1);
+				return true;
+			}
+			return false;
+		}
+
 		if (NumValid)
 		{
 			const int32 Prev = Next == 0 ? Buffer.Num() - 1 : Next - 1;
@@ -585,20 +921,41 @@ public:
 
 		Buffer.Empty();
 		NumValid = 0;
+
+		if (DeltaHistory)
+		{
+			DeltaHistory->Empty();
+		}
 	}
 
 	void Reset()
 	{
 		NumValid = 0;
+
+		if (DeltaHistory)
+		{
+			DeltaHistory->Truncate(0);
+		}
 	}
 
 	bool IsEmpty() const
 	{
-		return NumValid == 0;
+		return DeltaHistory ? DeltaHistory->NumValid() == 0 : NumValid == 0;
 	}
 
 	void ClearEntryAndFuture(const FFrameAndPhase FrameAndPhase)
 	{
+		if (DeltaHistory)
+		{
+			int32 NewNum = DeltaHistory->Num();
+			while (NewNum > DeltaHistory->Num() - DeltaHistory->NumValid() && !(DeltaHistory->GetFrameAndPhase(NewNum - 1) < FrameAndPhase))
+			{
+				--NewNum;
+			}
+			DeltaHistory->Truncate(NewNum);
+			return;
+		}
+
 		//Move next backwards until FrameAndPhase and anything more future than it is gone
 		while (NumValid)
 		{
@@ -616,12 +973,28 @@ public:
 
 	void ExtractBufferState(int32& ValidCount, int32& NextIterator) const
 	{
+		if (DeltaHistory)
+		{
+			//Old blocks may be evicted before the state is restored, so the position is saved relative to the first entry ever recorded
+			ValidCount = DeltaHistory->NumValid();
+			NextIterator = DeltaHistory->NumRecorded();
+			return;
+		}
+
 		ValidCount = NumValid;
 		NextIterator = Next;
 	}
 
 	void RestoreBufferState(const int32& ValidCount, const int32& NextIterator)
 	{
+		if (DeltaHistory)
+		{
+			//Compressed entries are gone once removed, so we can only go back to an earlier state
+			ensureMsgf(NextIterator <= DeltaHistory->NumRecorded(), TEXT("RestoreBufferState can't restore entries removed from a delta compressed buffer: %d > %d"), NextIterator, DeltaHistory->NumRecorded());
+			DeltaHistory->TruncateRecorded(NextIterator);
+			return;
+		}
+
 		NumValid = ValidCount;
 		Next = NextIterator;
 	}
@@ -646,6 +1019,7 @@ public:
 
 	T& Insert(const FFrameAndPhase FrameAndPhase, FDirtyPropertiesPool& Manager)
 	{
+		checkf(!DeltaHistory, TEXT("Insert is not supported on delta compressed buffers"));
 		T* Result = nullptr;
 
 		int32 FrameIndex = FindIdx(FrameAndPhase);
@@ -704,10 +1078,30 @@ public:
 		return *Result;
 	}
 
+	//Memory used by the entries of this buffer, including its elements in the properties pool
+	SIZE_T GetAllocatedSize() const
+	{
+		if (DeltaHistory)
+		{
+			return sizeof(TDeltaPropertyHistory<T>) + DeltaHistory->GetAllocatedSize();
+		}
+		return Buffer.GetAllocatedSize() + Buffer.Num() * sizeof(T);
+	}
+
+	bool IsDeltaCompressed() const
+	{
+		return DeltaHistory.IsValid();
+	}
+
 private:
 
 	const int32 FindIdx(const FFrameAndPhase FrameAndPhase) const
 	{
+		if (DeltaHistory)
+		{
+			return FindDeltaIdx(FrameAndPhase);
+		}
+
 		int32 Cur = Next;	//go in reverse order because hopefully we don't rewind too far back
 		int32 Result = INDEX_NONE;
 		for (int32 Count = 0; Count < NumValid; ++Count)
@@ -741,6 +1135,27 @@ private:
 		}
 	}
 
+	//Same as FindIdx, over the delta compressed history
+	const int32 FindDeltaIdx(const FFrameAndPhase FrameAndPhase) const
+	{
+		int32 Result = INDEX_NONE;
+		const int32 FirstValid = DeltaHistory->Num() - DeltaHistory->NumValid();
+		for (int32 Idx = DeltaHistory->Num() - 1; Idx >= FirstValid; --Idx)
+		{
+			if (DeltaHistory->GetFrameAndPhase(Idx) < FrameAndPhase)
+			{
+				break;
+			}
+			Result = Idx;
+		}
+
+		if (bNoEntryIsHead || Result == INDEX_NONE)
+		{
+			return Result;
+		}
+		return DeltaHistory->GetFrameAndPhase(Result) == FrameAndPhase ? Result : INDEX_NONE;
+	}
+
 	TPropertyPool<T>& GetPool(FDirtyPropertiesPool& Manager) { return Manager.GetPool<T, PropName>(); }
 	const TPropertyPool<T>& GetPool(const FDirtyPropertiesPool& Manager) const { return Manager.GetPool<T, PropName>(); }
 
@@ -751,10 +1166,9 @@ private:
 	template <bool bEnsureMonotonic>
 	T* WriteAccessImp(const FFrameAndPhase FrameAndPhase, FDirtyPropertiesPool& Manager)
 	{
-		if (NumValid)
+		FFrameAndPhase LatestFrameAndPhase;
+		if (GetHeadFrameAndPhase(LatestFrameAndPhase))
 		{
-			const int32 Prev = Next == 0 ? Buffer.Num() - 1 : Next - 1;
-			const FFrameAndPhase& LatestFrameAndPhase = Buffer[Prev].FrameAndPhase;
 			if (bEnsureMonotonic)
 			{
 				//Must write in monotonic growing order so that x_{n+1} > x_n
@@ -774,6 +1188,11 @@ private:
 			ValidateOrder();
 		}
 
+		if (DeltaHistory)
+		{
+			return &DeltaHistory->Add(FrameAndPhase);
+		}
+
 		T* Result;
 
 		if (Next < Buffer.Num())
@@ -826,6 +1245,7 @@ private:
 	int32 NumValid;
 	int32 Capacity;
 	TArray<FPropertyInterval> Buffer;
+	TUniquePtr<TDeltaPropertyHistory<T>> DeltaHistory;
 };
 
 
@@ -1045,6 +1465,9 @@ private:
 
 inline int32 ComputeCircularSize(int32 NumFrames) { return NumFrames * FFrameAndPhase::NumPhases; }
 
+//Whether new particle histories store positions and velocities delta compressed, see p.Resim.DeltaCompressHistory
+CHAOS_API bool ShouldDeltaCompressRewindHistory();
+
 struct FGeometryParticleStateBase
 {
 	PRAGMA_DISABLE_DEPRECATION_WARNINGS
@@ -1064,9 +1487,9 @@ struct FGeometryParticleStateBase
 	}
 
 	explicit FGeometryParticleStateBase(int32 NumFrames, bool bCacheOnePhase)
-		: ParticlePositionRotation(bCacheOnePhase ? NumFrames : ComputeCircularSize(NumFrames))
+		: ParticlePositionRotation(bCacheOnePhase ? NumFrames : ComputeCircularSize(NumFrames), ShouldDeltaCompressRewindHistory())
 		, NonFrequentData(bCacheOnePhase ? NumFrames : ComputeCircularSize(NumFrames))
-		, Velocities(bCacheOnePhase ? NumFrames : ComputeCircularSize(NumFrames))
+		, Velocities(bCacheOnePhase ? NumFrames : ComputeCircularSize(NumFrames), ShouldDeltaCompressRewindHistory())
 		, Dynamics(bCacheOnePhase ? NumFrames : ComputeCircularSize(NumFrames))
 		, DynamicsMisc(bCacheOnePhase ? NumFrames : ComputeCircularSize(NumFrames))
 		, MassProps(bCacheOnePhase ? NumFrames : ComputeCircularSize(NumFrames))
@@ -1145,6 +1568,14 @@ struct FGeometryParticleStateBase
 		return IsCleanExcludingDynamics(FrameAndPhase) && Dynamics.IsClean(FrameAndPhase);
 	}
 
+	//Memory used by the property histories, excluding the shapes
+	SIZE_T GetAllocatedSize() const
+	{
+		return ParticlePositionRotation.GetAllocatedSize() + NonFrequentData.GetAllocatedSize() + Velocities.GetAllocatedSize() + Dynamics.GetAllocatedSize()
+			+ DynamicsMisc.GetAllocatedSize() + MassProps.GetAllocatedSize() + KinematicTarget.GetAllocatedSize()
+			+ TargetPositions.GetAllocatedSize() + TargetVelocities.GetAllocatedSize() + TargetStates.GetAllocatedSize();
+	}
+
 	bool IsCleanExcludingDynamics(const FFrameAndPhase FrameAndPhase) const
 	{
 		return ParticlePositionRotation.IsClean(FrameAndPhase) &&
@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Dom/JsonArenaDocument.h"
+#include "HAL/UnrealMemory.h"
+#include "Serialization/Utf8JsonPullReader.h"
+
+namespace UE::Json
+{
+	bool FArenaDocument::Parse(FUtf8StringView Json)
+	{
+		Nodes.Reset();
+		ErrorMessage = TEXT("");
+		ErrorOffset = INDEX_NONE;
+
+		Text.SetNumUninitialized(Json.Len(), EAllowShrinking::No);
+		FMemory::Memcpy(Text.GetData(), Json.GetData(), Json.Len());
+		const FUtf8StringView Document(Text.GetData(), Text.Num());
+
+		// An unterminated string is reported by the reader as well
+		Index.Build(Document);
+		FUtf8PullReader Reader(Document, Index);
+
+		auto AddNode = [this](EJson Type, FUtf8StringView Span) -> FNode&
+		{
+			FNode& Node = Nodes.AddUninitialized_GetRef();
+			Node.Number = 0.0;
+			Node.Offset = Span.Len() ? uint32(Span.GetData() - Text.GetData()) : 0;
+			Node.Length = uint32(Span.Len());
+			Node.End = Nodes.Num();
+			Node.Num = 0;
+			Node.Type = Type;
+			Node.bBool = false;
+			return Node;
+		};
+
+		int32 Parents[FUtf8PullReader::MaxDepth];
+		int32 Depth = 0;
+
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation))
+		{
+			if (Depth > 0 && Notation != EJsonNotation::ObjectEnd && Notation != EJsonNotation::ArrayEnd)
+			{
+				FNode& Parent = Nodes[Parents[Depth - 1]];
+				++Parent.Num;
+				if (Parent.Type == EJson::Object)
+				{
+					AddNode(EJson::String, Reader.GetIdentifier());
+				}
+			}
+
+			switch (Notation)
+			{
+			case EJsonNotation::ObjectStart:
+				Parents[Depth++] = Nodes.Num();
+				AddNode(EJson::Object, FUtf8StringView());
+				break;
+
+			case EJsonNotation::ArrayStart:
+				Parents[Depth++] = Nodes.Num();
+				AddNode(EJson::Array, FUtf8StringView());
+				break;
+
+			case EJsonNotation::ObjectEnd:
+			case EJsonNotation::ArrayEnd:
+				Nodes[Parents[--Depth]].End = Nodes.Num();
+				break;
+
+			case EJsonNotation::String:
+				AddNode(EJson::String, Reader.GetRawString());
+				break;
+
+			case EJsonNotation::Number:
+				AddNode(EJson::Number, Reader.GetValueAsNumberString()).Number = Reader.GetValueAsNumber();
+				break;
+
+			case EJsonNotation::Boolean:
+				AddNode(EJson::Boolean, FUtf8StringView()).bBool = Reader.GetValueAsBoolean();
+				break;
+
+			case EJsonNotation::Null:
+				AddNode(EJson::Null, FUtf8StringView());
+				break;
+
+			case EJsonNotation::Error:
+			default:
+				ErrorMessage = Reader.GetErrorMessage();
+				ErrorOffset = Reader.GetErrorOffset();
+				Nodes.Reset();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void FArenaDocument::Reset()
+	{
+		Nodes.Empty();
+		Text.Empty();
+		Index.Reset();
+		ErrorMessage = TEXT("");
+		ErrorOffset = INDEX_NONE;
+	}
+
+	EJson FArenaValue::GetType() const
+	{
+		return Document ? Document->Nodes[Node].Type : EJson::None;
+	}
+
+	bool FArenaValue::AsBool() const
+	{
+		return GetType() == EJson::Boolean && Document->Nodes[Node].bBool;
+	}
+
+	double FArenaValue::AsNumber() const
+	{
+		return GetType() == EJson::Number ? Document->Nodes[Node].Number : 0.0;
+	}
+
+	FUtf8StringView FArenaValue::GetRawString() const
+	{
+		return GetType() == EJson::String ? Document->GetText(Document->Nodes[Node]) : FUtf8StringView();
+	}
+
+	bool FArenaValue::GetString(TStringBuilderBase<UTF8CHAR>& Out) const
+	{
+		return GetType() == EJson::String && FUtf8PullReader::DecodeString(GetRawString(), Out);
+	}
+
+	FString FArenaValue::AsString() const
+	{
+		TUtf8StringBuilder<256> Builder;
+		GetString(Builder);
+		return FString(Builder.ToView());
+	}
+
+	int32 FArenaValue::Num() const
+	{
+		const EJson Type = GetType();
+		return Type == EJson::Array || Type == EJson::Object ? Document->Nodes[Node].Num : 0;
+	}
+
+	FArenaValue FArenaValue::operator[](int32 InIndex) const
+	{
+		if (GetType() != EJson::Array || InIndex < 0 || InIndex >= Document->Nodes[Node].Num)
+		{
+			return FArenaValue();
+		}
+
+		int32 Child = Node + 1;
+		for (; InIndex > 0; --InIndex)
+		{
+			Child = Document->Nodes[Child].End;
+		}
+		return FArenaValue(Document, Child);
+	}
+
+	FArenaValue FArenaValue::Find(FUtf8StringView Key) const
+	{
+		if (GetType() == EJson::Object)
+		{
+			const int32 End = Document->Nodes[Node].End;
+			for (int32 Name = Node + 1; Name < End; Name = Document->Nodes[Name + 1].End)
+			{
+				if (Document->GetText(Document->Nodes[Name]).Equals(Key))
+				{
+					return FArenaValue(Document, Name + 1);
+				}
+			}
+		}
+		return FArenaValue();
+	}
+}
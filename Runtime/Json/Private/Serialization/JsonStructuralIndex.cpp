@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/JsonStructuralIndex.h"
+#include "HAL/UnrealMemory.h"
+#include "Math/UnrealMathUtility.h"
+#include "Math/VectorRegister.h"
+
+namespace UE::Json::Private
+{
+	/** One bit per byte of a 64 byte block */
+	struct FBlockMasks
+	{
+		uint64 Quote;
+		uint64 Backslash;
+		uint64 Operator;
+		uint64 Whitespace;
+	};
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS == 1 && !PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	template <typename CompareType>
+	FORCEINLINE uint64 CompareBlock(const __m128i (&Chunks)[4], CompareType&& Compare)
+	{
+		uint64 Mask = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			Mask |= uint64(uint32(_mm_movemask_epi8(Compare(Chunks[Index])))) << (Index * 16);
+		}
+		return Mask;
+	}
+
+	FORCEINLINE void ClassifyBlock(const UTF8CHAR* Block, FBlockMasks& Out)
+	{
+		const __m128i Chunks[4] =
+		{
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 0)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 16)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 32)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 48)),
+		};
+
+		Out.Quote = CompareBlock(Chunks, [](__m128i Chunk) { return _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('"')); });
+		Out.Backslash = CompareBlock(Chunks, [](__m128i Chunk) { return _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\\')); });
+		Out.Operator = CompareBlock(Chunks, [](__m128i Chunk)
+		{
+			const __m128i Braces = _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('{')), _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('}')));
+			const __m128i Brackets = _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('[')), _mm_cmpeq_epi8(Chunk, _mm_set1_epi8(']')));
+			const __m128i Separators = _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(':')), _mm_cmpeq_epi8(Chunk, _mm_set1_epi8(',')));
+			return _mm_or_si128(_mm_or_si128(Braces, Brackets), Separators);
+		});
+		Out.Whitespace = CompareBlock(Chunks, [](__m128i Chunk)
+		{
+			const __m128i Spaces = _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\t')));
+			const __m128i Newlines = _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\r')));
+			return _mm_or_si128(Spaces, Newlines);
+		});
+	}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS == 1 && PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	template <typename CompareType>
+	FORCEINLINE uint64 CompareBlock(const uint8x16_t (&Chunks)[4], CompareType&& Compare)
+	{
+		// Create the bitmask via masking and pairwise adds as there is no movemask
+		static const uint8 BitWeightsData[16] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+		const uint8x16_t BitWeights = vld1q_u8(BitWeightsData);
+
+		const uint8x16_t Bits0 = vandq_u8(Compare(Chunks[0]), BitWeights);
+		const uint8x16_t Bits1 = vandq_u8(Compare(Chunks[1]), BitWeights);
+		const uint8x16_t Bits2 = vandq_u8(Compare(Chunks[2]), BitWeights);
+		const uint8x16_t Bits3 = vandq_u8(Compare(Chunks[3]), BitWeights);
+
+		uint8x16_t Sum = vpaddq_u8(vpaddq_u8(Bits0, Bits1), vpaddq_u8(Bits2, Bits3));
+		Sum = vpaddq_u8(Sum, Sum);
+		return vgetq_lane_u64(vreinterpretq_u64_u8(Sum), 0);
+	}
+
+	FORCEINLINE void ClassifyBlock(const UTF8CHAR* Block, FBlockMasks& Out)
+	{
+		const uint8* Bytes = reinterpret_cast<const uint8*>(Block);
+		const uint8x16_t Chunks[4] = { vld1q_u8(Bytes + 0), vld1q_u8(Bytes + 16), vld1q_u8(Bytes + 32), vld1q_u8(Bytes + 48) };
+
+		Out.Quote = CompareBlock(Chunks, [](uint8x16_t Chunk) { return vceqq_u8(Chunk, vdupq_n_u8('"')); });
+		Out.Backslash = CompareBlock(Chunks, [](uint8x16_t Chunk) { return vceqq_u8(Chunk, vdupq_n_u8('\\')); });
+		Out.Operator = CompareBlock(Chunks, [](uint8x16_t Chunk)
+		{
+			const uint8x16_t Braces = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('{')), vceqq_u8(Chunk, vdupq_n_u8('}')));
+			const uint8x16_t Brackets = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('[')), vceqq_u8(Chunk, vdupq_n_u8(']')));
+			const uint8x16_t Separators = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8(':')), vceqq_u8(Chunk, vdupq_n_u8(',')));
+			return vorrq_u8(vorrq_u8(Braces, Brackets), Separators);
+		});
+		Out.Whitespace = CompareBlock(Chunks, [](uint8x16_t Chunk)
+		{
+			const uint8x16_t Spaces = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8(' ')), vceqq_u8(Chunk, vdupq_n_u8('\t')));
+			const uint8x16_t Newlines = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('\n')), vceqq_u8(Chunk, vdupq_n_u8('\r')));
+			return vorrq_u8(Spaces, Newlines);
+		});
+	}
+#else
+	// Slower path using scalar instructions.
+	FORCEINLINE void ClassifyBlock(const UTF8CHAR* Block, FBlockMasks& Out)
+	{
+		Out = {};
+		for (int32 Index = 0; Index < 64; ++Index)
+		{
+			const uint64 Bit = uint64(1) << Index;
+			switch (Block[Index])
+			{
+			case '"':
+				Out.Quote |= Bit;
+				break;
+			case '\\':
+				Out.Backslash |= Bit;
+				break;
+			case '{': case '}': case '[': case ']': case ':': case ',':
+				Out.Operator |= Bit;
+				break;
+			case ' ': case '\t': case '\n': case '\r':
+				Out.Whitespace |= Bit;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+#endif
+
+	/** Sets every bit from a set bit up to (excluding) the next set bit, i.e. the bits between pairs of quotes */
+	FORCEINLINE uint64 PrefixXor(uint64 Bits)
+	{
+		Bits ^= Bits << 1;
+		Bits ^= Bits << 2;
+		Bits ^= Bits << 4;
+		Bits ^= Bits << 8;
+		Bits ^= Bits << 16;
+		Bits ^= Bits << 32;
+		return Bits;
+	}
+
+	/**
+	 * Returns the characters escaped by the backslashes of the block, i.e. the characters following a run of an odd
+	 * number of backslashes. InOutPrevEscaped carries whether the first character of the next block is escaped.
+	 */
+	FORCEINLINE uint64 FindEscaped(uint64 Backslash, uint64& InOutPrevEscaped)
+	{
+		// A backslash that is itself escaped by the previous block does not start a run
+		Backslash &= ~InOutPrevEscaped;
+		const uint64 FollowsEscape = (Backslash << 1) | InOutPrevEscaped;
+
+		// Runs that start on an odd bit are moved onto the next run by the carry of the add, leaving the runs
+		// that start on an even bit as the set bits of the sum.
+		const uint64 EvenBits = 0x5555'5555'5555'5555ull;
+		const uint64 OddRunStarts = Backslash & ~EvenBits & ~FollowsEscape;
+		const uint64 RunsStartingOnEvenBits = OddRunStarts + Backslash;
+		InOutPrevEscaped = RunsStartingOnEvenBits < OddRunStarts ? 1 : 0;
+
+		// Every other character of a run is escaped, flipped for the runs that start on even bits
+		const uint64 InvertMask = RunsStartingOnEvenBits << 1;
+		return (EvenBits ^ InvertMask) & FollowsEscape;
+	}
+}
+
+namespace UE::Json
+{
+	bool FStructuralIndex::Build(FUtf8StringView Json)
+	{
+		using namespace UE::Json::Private;
+
+		const int32 Length = Json.Len();
+
+		// Every character can be structural at most once, which saves a capacity check per position
+		Positions.SetNumUninitialized(Length + 1, EAllowShrinking::No);
+		uint32* Out = Positions.GetData();
+
+		uint64 PrevEscaped = 0;
+		uint64 PrevInString = 0;
+		uint64 PrevScalar = 0;
+		UTF8CHAR PaddedBlock[64];
+
+		for (int32 BlockStart = 0; BlockStart < Length; BlockStart += 64)
+		{
+			const UTF8CHAR* Block = Json.GetData() + BlockStart;
+			if (Length - BlockStart < 64)
+			{
+				// Pad the last block with whitespace, which is never structural
+				FMemory::Memset(PaddedBlock, ' ', sizeof(PaddedBlock));
+				FMemory::Memcpy(PaddedBlock, Block, Length - BlockStart);
+				Block = PaddedBlock;
+			}
+
+			FBlockMasks Masks;
+			ClassifyBlock(Block, Masks);
+
+			const uint64 Escaped = FindEscaped(Masks.Backslash, PrevEscaped);
+			const uint64 Quote = Masks.Quote & ~Escaped;
+
+			// Includes the opening but not the closing quotes
+			const uint64 InString = PrefixXor(Quote) ^ PrevInString;
+			PrevInString = uint64(int64(InString) >> 63);
+
+			const uint64 Operator = Masks.Operator & ~InString;
+			const uint64 Scalar = ~(Masks.Operator | Masks.Whitespace | Quote | InString);
+			const uint64 ScalarStart = Scalar & ~((Scalar << 1) | PrevScalar);
+			PrevScalar = Scalar >> 63;
+
+			for (uint64 Structurals = Operator | ScalarStart | (Quote & InString); Structurals; Structurals &= Structurals - 1)
+			{
+				*Out++ = uint32(BlockStart) + uint32(FMath::CountTrailingZeros64(Structurals));
+			}
+		}
+
+		Positions.SetNum(int32(Out - Positions.GetData()), EAllowShrinking::No);
+		return PrevInString == 0;
+	}
+
+	void FStructuralIndex::Reset()
+	{
+		Positions.Empty();
+	}
+}
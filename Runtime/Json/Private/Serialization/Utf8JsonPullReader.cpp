@@ -0,0 +1,524 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/Utf8JsonPullReader.h"
+#include "Misc/CString.h"
+#include "Serialization/JsonStructuralIndex.h"
+
+namespace UE::Json::Private
+{
+	FORCEINLINE bool IsJsonWhitespace(UTF8CHAR Char)
+	{
+		return Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r';
+	}
+
+	FORCEINLINE bool IsDigit(UTF8CHAR Char)
+	{
+		return Char >= '0' && Char <= '9';
+	}
+
+	/** Validates -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)? */
+	static bool IsValidNumber(FUtf8StringView Number)
+	{
+		const UTF8CHAR* It = Number.GetData();
+		const UTF8CHAR* End = It + Number.Len();
+
+		if (It != End && *It == '-')
+		{
+			++It;
+		}
+		if (It == End || !IsDigit(*It))
+		{
+			return false;
+		}
+		if (*It++ != '0')
+		{
+			while (It != End && IsDigit(*It))
+			{
+				++It;
+			}
+		}
+		if (It != End && *It == '.')
+		{
+			if (++It == End || !IsDigit(*It))
+			{
+				return false;
+			}
+			while (It != End && IsDigit(*It))
+			{
+				++It;
+			}
+		}
+		if (It != End && (*It == 'e' || *It == 'E'))
+		{
+			if (++It != End && (*It == '+' || *It == '-'))
+			{
+				++It;
+			}
+			if (It == End || !IsDigit(*It))
+			{
+				return false;
+			}
+			while (It != End && IsDigit(*It))
+			{
+				++It;
+			}
+		}
+		return It == End;
+	}
+
+	static bool ParseHex4(const UTF8CHAR* It, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const UTF8CHAR Char = It[Index];
+			uint32 Digit;
+			if (Char >= '0' && Char <= '9')
+			{
+				Digit = uint32(Char - '0');
+			}
+			else if (Char >= 'a' && Char <= 'f')
+			{
+				Digit = uint32(Char - 'a' + 10);
+			}
+			else if (Char >= 'A' && Char <= 'F')
+			{
+				Digit = uint32(Char - 'A' + 10);
+			}
+			else
+			{
+				return false;
+			}
+			OutValue = (OutValue << 4) | Digit;
+		}
+		return true;
+	}
+
+	static void AppendCodepoint(uint32 Codepoint, TStringBuilderBase<UTF8CHAR>& Out)
+	{
+		if (Codepoint < 0x80)
+		{
+			Out.AppendChar(UTF8CHAR(Codepoint));
+		}
+		else if (Codepoint < 0x800)
+		{
+			Out.AppendChar(UTF8CHAR(0xC0 | (Codepoint >> 6)));
+			Out.AppendChar(UTF8CHAR(0x80 | (Codepoint & 0x3F)));
+		}
+		else if (Codepoint < 0x10000)
+		{
+			Out.AppendChar(UTF8CHAR(0xE0 | (Codepoint >> 12)));
+			Out.AppendChar(UTF8CHAR(0x80 | ((Codepoint >> 6) & 0x3F)));
+			Out.AppendChar(UTF8CHAR(0x80 | (Codepoint & 0x3F)));
+		}
+		else
+		{
+			Out.AppendChar(UTF8CHAR(0xF0 | (Codepoint >> 18)));
+			Out.AppendChar(UTF8CHAR(0x80 | ((Codepoint >> 12) & 0x3F)));
+			Out.AppendChar(UTF8CHAR(0x80 | ((Codepoint >> 6) & 0x3F)));
+			Out.AppendChar(UTF8CHAR(0x80 | (Codepoint & 0x3F)));
+		}
+	}
+}
+
+namespace UE::Json
+{
+	FUtf8PullReader::FUtf8PullReader(FUtf8StringView InJson, const FStructuralIndex& InIndex)
+		: Json(InJson)
+		, Positions(InIndex.GetPositions())
+	{
+	}
+
+	bool FUtf8PullReader::ReadNext(EJsonNotation& Notation)
+	{
+		using namespace UE::Json::Private;
+
+		if (ErrorOffset != INDEX_NONE || State == EState::Done)
+		{
+			return false;
+		}
+
+		Identifier.Reset();
+
+		if (State == EState::AfterValue)
+		{
+			if (Depth == 0)
+			{
+				if (NextPosition < Positions.Num())
+				{
+					return SetError(TEXT("Unexpected additional input found."), GetPosition(NextPosition), Notation);
+				}
+				State = EState::Done;
+				return false;
+			}
+
+			if (NextPosition == Positions.Num())
+			{
+				return SetError(TEXT("Unexpected end of input."), Json.Len(), Notation);
+			}
+
+			const UTF8CHAR Char = Json[GetPosition(NextPosition)];
+			if (Char == ',')
+			{
+				++NextPosition;
+				State = IsInObject() ? EState::Member : EState::Value;
+			}
+			else if (Char == (IsInObject() ? '}' : ']'))
+			{
+				return ReadContainerEnd(Notation);
+			}
+			else
+			{
+				return SetError(TEXT("Comma token expected, but not found."), GetPosition(NextPosition), Notation);
+			}
+		}
+
+		if (State == EState::FirstMember || State == EState::Member)
+		{
+			if (NextPosition == Positions.Num())
+			{
+				return SetError(TEXT("Unexpected end of input."), Json.Len(), Notation);
+			}
+
+			const int32 Position = GetPosition(NextPosition);
+			if (State == EState::FirstMember && Json[Position] == '}')
+			{
+				return ReadContainerEnd(Notation);
+			}
+			if (Json[Position] != '"')
+			{
+				return SetError(TEXT("String token expected, but not found."), Position, Notation);
+			}
+
+			++NextPosition;
+			if (!ReadString(Position, Identifier))
+			{
+				return SetError(TEXT("String Token Abruptly Ended."), Position, Notation);
+			}
+			if (NextPosition == Positions.Num() || Json[GetPosition(NextPosition)] != ':')
+			{
+				return SetError(TEXT("Colon token expected, but not found."), NextPosition < Positions.Num() ? GetPosition(NextPosition) : Json.Len(), Notation);
+			}
+			++NextPosition;
+		}
+		else if (State == EState::FirstElement)
+		{
+			if (NextPosition < Positions.Num() && Json[GetPosition(NextPosition)] == ']')
+			{
+				return ReadContainerEnd(Notation);
+			}
+		}
+
+		return ReadValue(Notation);
+	}
+
+	bool FUtf8PullReader::ReadValue(EJsonNotation& Notation)
+	{
+		using namespace UE::Json::Private;
+
+		if (NextPosition == Positions.Num())
+		{
+			return SetError(Depth == 0 && NextPosition == 0 ? TEXT("Improperly formatted.") : TEXT("Unexpected end of input."), Json.Len(), Notation);
+		}
+
+		const int32 Position = GetPosition(NextPosition++);
+		const UTF8CHAR Char = Json[Position];
+		switch (Char)
+		{
+		case '{':
+		case '[':
+			if (Depth == MaxDepth)
+			{
+				return SetError(TEXT("Maximum depth exceeded."), Position, Notation);
+			}
+			if (Char == '{')
+			{
+				ObjectBits[Depth / 64] |= uint64(1) << (Depth % 64);
+				Notation = EJsonNotation::ObjectStart;
+				State = EState::FirstMember;
+			}
+			else
+			{
+				ObjectBits[Depth / 64] &= ~(uint64(1) << (Depth % 64));
+				Notation = EJsonNotation::ArrayStart;
+				State = EState::FirstElement;
+			}
+			++Depth;
+			Token.Reset();
+			CurrentNotation = Notation;
+			return true;
+
+		case '"':
+			if (!ReadString(Position, Token))
+			{
+				return SetError(TEXT("String Token Abruptly Ended."), Position, Notation);
+			}
+			Notation = EJsonNotation::String;
+			break;
+
+		case 't':
+		case 'f':
+		case 'n':
+			Token = Json.Mid(Position, GetTokenEnd(NextPosition - 1) - Position);
+			if (Token.Equals(UTF8TEXTVIEW("true")) || Token.Equals(UTF8TEXTVIEW("false")))
+			{
+				bBoolValue = Char == 't';
+				Notation = EJsonNotation::Boolean;
+			}
+			else if (Token.Equals(UTF8TEXTVIEW("null")))
+			{
+				Notation = EJsonNotation::Null;
+			}
+			else
+			{
+				return SetError(TEXT("Invalid Json Token."), Position, Notation);
+			}
+			break;
+
+		default:
+			Token = Json.Mid(Position, GetTokenEnd(NextPosition - 1) - Position);
+			if (!IsValidNumber(Token))
+			{
+				return SetError(Char == '-' || IsDigit(Char) ? TEXT("Poorly formed Json Number Token.") : TEXT("Invalid Json Token."), Position, Notation);
+			}
+			Notation = EJsonNotation::Number;
+			break;
+		}
+
+		State = EState::AfterValue;
+		CurrentNotation = Notation;
+		return true;
+	}
+
+	bool FUtf8PullReader::ReadString(int32 Position, FUtf8StringView& OutString)
+	{
+		// The closing quote is the last character before the next structural one, other than whitespace. When the
+		// document ends inside the string there is no closing quote, unless the last quote in it is escaped.
+		const int32 End = GetTokenEnd(NextPosition - 1);
+		if (End - 1 <= Position || Json[End - 1] != '"')
+		{
+			return false;
+		}
+
+		int32 Backslashes = 0;
+		while (Json[End - 2 - Backslashes] == '\\')
+		{
+			++Backslashes;
+		}
+		if (Backslashes & 1)
+		{
+			return false;
+		}
+
+		OutString = Json.Mid(Position + 1, End - Position - 2);
+		return true;
+	}
+
+	bool FUtf8PullReader::ReadContainerEnd(EJsonNotation& Notation)
+	{
+		Notation = IsInObject() ? EJsonNotation::ObjectEnd : EJsonNotation::ArrayEnd;
+		++NextPosition;
+		--Depth;
+		Token.Reset();
+		State = EState::AfterValue;
+		CurrentNotation = Notation;
+		return true;
+	}
+
+	int32 FUtf8PullReader::GetTokenEnd(int32 PositionIndex) const
+	{
+		int32 End = PositionIndex + 1 < Positions.Num() ? GetPosition(PositionIndex + 1) : Json.Len();
+		while (End > GetPosition(PositionIndex) + 1 && Private::IsJsonWhitespace(Json[End - 1]))
+		{
+			--End;
+		}
+		return End;
+	}
+
+	bool FUtf8PullReader::SkipObject()
+	{
+		return SkipContainer(EJsonNotation::ObjectEnd);
+	}
+
+	bool FUtf8PullReader::SkipArray()
+	{
+		return SkipContainer(EJsonNotation::ArrayEnd);
+	}
+
+	bool FUtf8PullReader::SkipContainer(EJsonNotation EndNotation)
+	{
+		if (ErrorOffset != INDEX_NONE || Depth == 0 || IsInObject() != (EndNotation == EJsonNotation::ObjectEnd))
+		{
+			return false;
+		}
+
+		// Only brackets change the depth, so the contents can be skipped without reading their values. The grammar
+		// of the skipped values is not validated.
+		int32 SkippedDepth = 1;
+		while (NextPosition < Positions.Num())
+		{
+			const int32 Position = GetPosition(NextPosition);
+			const UTF8CHAR Char = Json[Position];
+			if (Char == '{' || Char == '[')
+			{
+				++SkippedDepth;
+			}
+			else if (Char == '}' || Char == ']')
+			{
+				if (--SkippedDepth == 0)
+				{
+					if (Char != (IsInObject() ? '}' : ']'))
+					{
+						EJsonNotation Notation;
+						return !SetError(TEXT("Mismatched end of object or array."), Position, Notation);
+					}
+					EJsonNotation Notation;
+					return ReadContainerEnd(Notation);
+				}
+			}
+			++NextPosition;
+		}
+
+		EJsonNotation Notation;
+		return !SetError(TEXT("Unexpected end of input."), Json.Len(), Notation);
+	}
+
+	bool FUtf8PullReader::SetError(const TCHAR* Message, int32 Offset, EJsonNotation& Notation)
+	{
+		ErrorMessage = Message;
+		ErrorOffset = Offset;
+		Identifier.Reset();
+		Token.Reset();
+		Notation = EJsonNotation::Error;
+		CurrentNotation = Notation;
+		return true;
+	}
+
+	FString FUtf8PullReader::GetValueAsString() const
+	{
+		TUtf8StringBuilder<256> Builder;
+		GetValueAsString(Builder);
+		return FString(Builder.ToView());
+	}
+
+	double FUtf8PullReader::GetValueAsNumber() const
+	{
+		check(CurrentNotation == EJsonNotation::Number);
+
+		// Numbers are plain ASCII and are only terminated by the next token in the document
+		TAnsiStringBuilder<64> Number;
+		for (UTF8CHAR Char : Token)
+		{
+			Number.AppendChar(ANSICHAR(Char));
+		}
+		return FCStringAnsi::Atod(*Number);
+	}
+
+	bool FUtf8PullReader::TryGetValueAsInt64(int64& OutValue) const
+	{
+		check(CurrentNotation == EJsonNotation::Number);
+
+		const UTF8CHAR* It = Token.GetData();
+		const UTF8CHAR* End = It + Token.Len();
+		const bool bNegative = *It == '-';
+		It += bNegative;
+
+		// Accumulate as a negative value, which has the larger range
+		int64 Value = 0;
+		for (; It != End; ++It)
+		{
+			if (!Private::IsDigit(*It))
+			{
+				return false;
+			}
+			const int64 Digit = *It - '0';
+			if (Value < (MIN_int64 + Digit) / 10)
+			{
+				return false;
+			}
+			Value = Value * 10 - Digit;
+		}
+
+		if (!bNegative)
+		{
+			if (Value == MIN_int64)
+			{
+				return false;
+			}
+			Value = -Value;
+		}
+
+		OutValue = Value;
+		return true;
+	}
+
+	bool FUtf8PullReader::DecodeString(FUtf8StringView RawString, TStringBuilderBase<UTF8CHAR>& Out)
+	{
+		const UTF8CHAR* It = RawString.GetData();
+		const UTF8CHAR* End = It + RawString.Len();
+
+		while (It != End)
+		{
+			// Copy the runs without escapes at once
+			const UTF8CHAR* RunEnd = It;
+			while (RunEnd != End && *RunEnd != '\\')
+			{
+				++RunEnd;
+			}
+			Out.Append(It, int32(RunEnd - It));
+			It = RunEnd;
+
+			if (It == End)
+			{
+				break;
+			}
+			if (End - It < 2)
+			{
+				return false;
+			}
+
+			const UTF8CHAR Escape = It[1];
+			It += 2;
+			switch (Escape)
+			{
+			case '"':	Out.AppendChar('"'); break;
+			case '\\':	Out.AppendChar('\\'); break;
+			case '/':	Out.AppendChar('/'); break;
+			case 'b':	Out.AppendChar('\b'); break;
+			case 'f':	Out.AppendChar('\f'); break;
+			case 'n':	Out.AppendChar('\n'); break;
+			case 'r':	Out.AppendChar('\r'); break;
+			case 't':	Out.AppendChar('\t'); break;
+			case 'u':
+			{
+				uint32 Codepoint;
+				if (End - It < 4 || !Private::ParseHex4(It, Codepoint))
+				{
+					return false;
+				}
+				It += 4;
+
+				// Surrogates that are not part of a pair are replaced, as they cannot be encoded in UTF-8
+				uint32 LowSurrogate;
+				if (Codepoint >= 0xD800 && Codepoint <= 0xDBFF && End - It >= 6 && It[0] == '\\' && It[1] == 'u'
+					&& Private::ParseHex4(It + 2, LowSurrogate) && LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+				{
+					It += 6;
+					Codepoint = 0x10000 + ((Codepoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+				}
+				else if (Codepoint >= 0xD800 && Codepoint <= 0xDFFF)
+				{
+					Codepoint = 0xFFFD;
+				}
+
+				Private::AppendCodepoint(Codepoint, Out);
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
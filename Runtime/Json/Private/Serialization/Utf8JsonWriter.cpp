@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Serialization/Utf8JsonWriter.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/CString.h"
+
+// Floating point std::to_chars is not available in every standard library we build with
+#define UE_JSON_HAS_FP_CHARCONV (PLATFORM_WINDOWS || PLATFORM_LINUX)
+
+#if UE_JSON_HAS_FP_CHARCONV
+#include <charconv>
+#endif
+
+namespace UE::Json::Private
+{
+	static constexpr char DigitPairs[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	int32 FormatUint64(uint64 Value, UTF8CHAR* Buffer)
+	{
+		// Write two digits at a time from the end of a scratch buffer, then move them to the front
+		UTF8CHAR Digits[20];
+		UTF8CHAR* It = Digits + UE_ARRAY_COUNT(Digits);
+		while (Value >= 100)
+		{
+			const uint32 Pair = uint32(Value % 100) * 2;
+			Value /= 100;
+			*--It = UTF8CHAR(DigitPairs[Pair + 1]);
+			*--It = UTF8CHAR(DigitPairs[Pair]);
+		}
+		if (Value >= 10)
+		{
+			const uint32 Pair = uint32(Value) * 2;
+			*--It = UTF8CHAR(DigitPairs[Pair + 1]);
+			*--It = UTF8CHAR(DigitPairs[Pair]);
+		}
+		else
+		{
+			*--It = UTF8CHAR('0' + Value);
+		}
+
+		const int32 Len = int32(Digits + UE_ARRAY_COUNT(Digits) - It);
+		FMemory::Memcpy(Buffer, It, Len);
+		return Len;
+	}
+
+	int32 FormatInt64(int64 Value, UTF8CHAR* Buffer)
+	{
+		if (Value < 0)
+		{
+			*Buffer = '-';
+			// Negate as unsigned so that MIN_int64 does not overflow
+			return 1 + FormatUint64(0 - uint64(Value), Buffer + 1);
+		}
+		return FormatUint64(uint64(Value), Buffer);
+	}
+
+	/**
+	 * Writes the shortest representation that reads back to the same value. Without to_chars, precisions from MinPrecision up are
+	 * tried until the value round trips. Any decimal with MinPrecision (FLT_DIG or DBL_DIG) digits round trips, so a shorter
+	 * representation is also the result of the first attempt with its trailing zeros removed by %g. Subnormals may get a few
+	 * more digits than necessary but still round trip.
+	 */
+	template <typename FloatType>
+	static int32 FormatFloatingPoint(FloatType Value, UTF8CHAR* Buffer, int32 MinPrecision, int32 MaxPrecision)
+	{
+		if (!FMath::IsFinite(Value))
+		{
+			FMemory::Memcpy(Buffer, "null", 4);
+			return 4;
+		}
+
+		ANSICHAR* Chars = reinterpret_cast<ANSICHAR*>(Buffer);
+#if UE_JSON_HAS_FP_CHARCONV
+		const std::to_chars_result Result = std::to_chars(Chars, Chars + MaxFormattedNumberLen, Value);
+		check(Result.ec == std::errc{});
+		return int32(Result.ptr - Chars);
+#else
+		int32 Len = 0;
+		for (int32 Precision = MinPrecision; Precision <= MaxPrecision; ++Precision)
+		{
+			Len = FCStringAnsi::Snprintf(Chars, MaxFormattedNumberLen, "%.*g", Precision, double(Value));
+			if (FloatType(FCStringAnsi::Atod(Chars)) == Value)
+			{
+				break;
+			}
+		}
+		return Len;
+#endif
+	}
+
+	int32 FormatDouble(double Value, UTF8CHAR* Buffer)
+	{
+		return FormatFloatingPoint(Value, Buffer, 15, 17);
+	}
+
+	int32 FormatFloat(float Value, UTF8CHAR* Buffer)
+	{
+		return FormatFloatingPoint(Value, Buffer, 6, 9);
+	}
+
+	int32 FindFirstEscapedChar(FUtf8StringView String)
+	{
+		const UTF8CHAR* Data = String.GetData();
+		const int32 Len = String.Len();
+		int32 Index = 0;
+
+		// Test 8 characters at a time for quotes, backslashes and control characters. The lowest set bit of the zero
+		// byte tests is exact, higher bits may be false positives.
+		constexpr uint64 Ones = 0x0101'0101'0101'0101ull;
+		constexpr uint64 HighBits = 0x8080'8080'8080'8080ull;
+		for (; Index + 8 <= Len; Index += 8)
+		{
+			uint64 Word;
+			FMemory::Memcpy(&Word, Data + Index, sizeof(Word));
+
+			const uint64 Quote = Word ^ (Ones * '"');
+			const uint64 Backslash = Word ^ (Ones * '\\');
+			const uint64 Escaped =
+				((Quote - Ones) & ~Quote) |
+				((Backslash - Ones) & ~Backslash) |
+				((Word - Ones * 0x20) & ~Word);
+
+			if (const uint64 Mask = Escaped & HighBits)
+			{
+				return Index + int32(FMath::CountTrailingZeros64(Mask) / 8);
+			}
+		}
+
+		for (; Index < Len; ++Index)
+		{
+			const UTF8CHAR Char = Data[Index];
+			if (Char == '"' || Char == '\\' || uint8(Char) < 0x20)
+			{
+				break;
+			}
+		}
+		return Index;
+	}
+
+	int32 FormatEscapedChar(UTF8CHAR Char, UTF8CHAR* Buffer)
+	{
+		Buffer[0] = '\\';
+		switch (Char)
+		{
+		case '"':	Buffer[1] = '"'; return 2;
+		case '\\':	Buffer[1] = '\\'; return 2;
+		case '\b':	Buffer[1] = 'b'; return 2;
+		case '\f':	Buffer[1] = 'f'; return 2;
+		case '\n':	Buffer[1] = 'n'; return 2;
+		case '\r':	Buffer[1] = 'r'; return 2;
+		case '\t':	Buffer[1] = 't'; return 2;
+		default:
+			break;
+		}
+
+		static constexpr char HexDigits[] = "0123456789abcdef";
+		Buffer[1] = 'u';
+		Buffer[2] = '0';
+		Buffer[3] = '0';
+		Buffer[4] = UTF8CHAR(HexDigits[uint8(Char) >> 4]);
+		Buffer[5] = UTF8CHAR(HexDigits[uint8(Char) & 0xF]);
+		return 6;
+	}
+}
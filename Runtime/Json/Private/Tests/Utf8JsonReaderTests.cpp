@@ -0,0 +1,289 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_TESTS
+
+#include "CoreMinimal.h"
+#include "Dom/JsonArenaDocument.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonStructuralIndex.h"
+#include "Serialization/Utf8JsonPullReader.h"
+#include "Tests/TestHarnessAdapter.h"
+
+namespace UE::Json::Private::Tests
+{
+	/** Reads the whole document, returning the notations as a string of single characters and E for an error */
+	static FString ReadNotations(FUtf8StringView Json)
+	{
+		FStructuralIndex Index;
+		Index.Build(Json);
+		FUtf8PullReader Reader(Json, Index);
+
+		FString Result;
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation))
+		{
+			switch (Notation)
+			{
+			case EJsonNotation::ObjectStart:	Result += TEXT("{"); break;
+			case EJsonNotation::ObjectEnd:		Result += TEXT("}"); break;
+			case EJsonNotation::ArrayStart:		Result += TEXT("["); break;
+			case EJsonNotation::ArrayEnd:		Result += TEXT("]"); break;
+			case EJsonNotation::Boolean:		Result += TEXT("b"); break;
+			case EJsonNotation::String:			Result += TEXT("s"); break;
+			case EJsonNotation::Number:			Result += TEXT("n"); break;
+			case EJsonNotation::Null:			Result += TEXT("0"); break;
+			case EJsonNotation::Error:			Result += TEXT("E"); break;
+			}
+		}
+		return Result;
+	}
+
+	/** Builds a document shaped like typical asset metadata: an array of objects with names, numbers, tags and escapes */
+	static void BuildBenchmarkDocument(TUtf8StringBuilder<1024>& Json, int32 NumEntries)
+	{
+		Json << "{\"version\": 3, \"entries\": [\n";
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			Json << (Index ? ",\n" : "");
+			Json << "  {\"id\": " << Index << ", \"name\": \"Entry_" << Index << "\", \"path\": \"/Game/Content/Props/Entry_" << Index << ".Entry_" << Index << "\",";
+			Json << " \"enabled\": " << ((Index & 1) == 0) << ", \"weight\": " << (double(Index) * 0.37 - 100.0) << ",";
+			Json << " \"bounds\": [" << Index * 0.5 << ", " << -Index * 0.25 << ", 12.5, 1e3],";
+			Json << " \"tags\": [\"static\", \"lod\", \"collision\"], \"parent\": null,";
+			Json << " \"description\": \"Line one\\nLine \\\"two\\\" with a \\u00e9 and a tab\\t.\"}";
+		}
+		Json << "\n]}\n";
+	}
+}
+
+TEST_CASE_NAMED(FUtf8JsonPullReaderTest, "System::Engine::FileSystem::JSON::Utf8PullReader", "[ApplicationContextMask][SmokeFilter]")
+{
+	using namespace UE::Json;
+	using namespace UE::Json::Private::Tests;
+
+	SECTION("Notations")
+	{
+		CHECK(ReadNotations(UTF8TEXTVIEW("{}")) == TEXT("{}"));
+		CHECK(ReadNotations(UTF8TEXTVIEW(" [ ] ")) == TEXT("[]"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("{\"a\":1,\"b\":[true,false,null,\"x\"],\"c\":{}}")) == TEXT("{n[bb0s]{}}"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("\"root\"")) == TEXT("s"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("-0.5e+10")) == TEXT("n"));
+	}
+
+	SECTION("Errors")
+	{
+		CHECK(ReadNotations(UTF8TEXTVIEW("")) == TEXT("E"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[1,]")) == TEXT("[nE"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("{\"a\" 1}")) == TEXT("{E"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("{\"a\":1 \"b\":2}")) == TEXT("{nE"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[1}")) == TEXT("[nE"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[tru]")) == TEXT("[E"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[01]")) == TEXT("[E"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[1.]")) == TEXT("[E"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[\"abc]")) == TEXT("[E"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[\"abc\\\"]")) == TEXT("[E"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[1] 2")) == TEXT("[n]E"));
+		CHECK(ReadNotations(UTF8TEXTVIEW("[[[")) == TEXT("[[[E"));
+	}
+
+	SECTION("Values")
+	{
+		const FUtf8StringView Json = UTF8TEXTVIEW("{\"int\": -9223372036854775808, \"big\": 18446744073709551616, \"float\": 2.5e-3, \"key\\\"s\": \"a\\\\b\\u00e9\\ud83d\\ude00\\n\"}");
+		FStructuralIndex Index;
+		REQUIRE(Index.Build(Json));
+		FUtf8PullReader Reader(Json, Index);
+
+		EJsonNotation Notation;
+		int64 IntValue = 0;
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::ObjectStart));
+
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::Number));
+		CHECK(Reader.GetIdentifier() == UTF8TEXTVIEW("int"));
+		CHECK(Reader.TryGetValueAsInt64(IntValue));
+		CHECK(IntValue == MIN_int64);
+
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::Number));
+		CHECK(!Reader.TryGetValueAsInt64(IntValue));
+		CHECK(Reader.GetValueAsNumber() == 18446744073709551616.0);
+
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::Number));
+		CHECK(!Reader.TryGetValueAsInt64(IntValue));
+		CHECK(Reader.GetValueAsNumber() == 2.5e-3);
+		CHECK(Reader.GetValueAsNumberString() == UTF8TEXTVIEW("2.5e-3"));
+
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::String));
+		CHECK(Reader.GetIdentifier() == UTF8TEXTVIEW("key\\\"s"));
+		CHECK(Reader.GetRawString() == UTF8TEXTVIEW("a\\\\b\\u00e9\\ud83d\\ude00\\n"));
+		TUtf8StringBuilder<64> Decoded;
+		CHECK(Reader.GetValueAsString(Decoded));
+		CHECK(Decoded.ToView() == UTF8TEXTVIEW("a\\b\xC3\xA9\xF0\x9F\x98\x80\n"));
+
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::ObjectEnd));
+		CHECK(!Reader.ReadNext(Notation));
+		CHECK(FCString::Strlen(Reader.GetErrorMessage()) == 0);
+
+		Decoded.Reset();
+		CHECK(!FUtf8PullReader::DecodeString(UTF8TEXTVIEW("\\x"), Decoded));
+		CHECK(!FUtf8PullReader::DecodeString(UTF8TEXTVIEW("\\u12"), Decoded));
+	}
+
+	SECTION("Escapes across blocks")
+	{
+		// Move runs of backslashes across the 64 byte blocks of the index
+		for (int32 Padding = 0; Padding < 70; ++Padding)
+		{
+			TUtf8StringBuilder<256> Json;
+			Json << "[\"";
+			for (int32 Index = 0; Index < Padding; ++Index)
+			{
+				Json << "x";
+			}
+			Json << "\\\\\\\"\\\\\", {\"k\": \"\\\"]\"}]";
+
+			CHECK(ReadNotations(Json.ToView()) == TEXT("[s{s}]"));
+		}
+	}
+
+	SECTION("Skip")
+	{
+		const FUtf8StringView Json = UTF8TEXTVIEW("[{\"a\": [1, {\"b\": \"]}\"}], \"c\": 2}, [3, [4]], 5]");
+		FStructuralIndex Index;
+		REQUIRE(Index.Build(Json));
+		FUtf8PullReader Reader(Json, Index);
+
+		EJsonNotation Notation;
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::ArrayStart));
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::ObjectStart));
+		CHECK(!Reader.SkipArray());
+		CHECK(Reader.SkipObject());
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::ArrayStart));
+		CHECK(Reader.SkipArray());
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::Number));
+		CHECK(Reader.GetValueAsNumber() == 5.0);
+		REQUIRE((Reader.ReadNext(Notation) && Notation == EJsonNotation::ArrayEnd));
+		CHECK(Reader.GetDepth() == 0);
+		CHECK(!Reader.ReadNext(Notation));
+	}
+
+	SECTION("Arena document")
+	{
+		FArenaDocument Document;
+		CHECK(!Document.Parse(UTF8TEXTVIEW("{\"a\": }")));
+		CHECK(!Document.GetRoot().IsValid());
+		CHECK(Document.GetErrorOffset() == 6);
+
+		REQUIRE(Document.Parse(UTF8TEXTVIEW("{\"name\": \"caf\\u00e9\", \"list\": [1, [2, 3], {\"x\": true}, null], \"\": 4}")));
+		const FArenaValue Root = Document.GetRoot();
+		CHECK(Root.GetType() == EJson::Object);
+		CHECK(Root.Num() == 3);
+		CHECK(Root.Find(UTF8TEXTVIEW("name")).AsString() == TEXT("caf\u00e9"));
+		CHECK(Root.Find(UTF8TEXTVIEW("")).AsNumber() == 4.0);
+		CHECK(!Root.Find(UTF8TEXTVIEW("missing")).IsValid());
+
+		const FArenaValue List = Root.Find(UTF8TEXTVIEW("list"));
+		CHECK(List.Num() == 4);
+		CHECK(List[0].AsNumber() == 1.0);
+		CHECK(List[1][1].AsNumber() == 3.0);
+		CHECK(List[2].Find(UTF8TEXTVIEW("x")).AsBool());
+		CHECK(List[3].GetType() == EJson::Null);
+		CHECK(!List[4].IsValid());
+
+		int32 NumElements = 0;
+		List.ForEachElement([&NumElements](FArenaValue) { ++NumElements; });
+		CHECK(NumElements == 4);
+
+		TArray<FString> Names;
+		Root.ForEachMember([&Names](FUtf8StringView Name, FArenaValue) { Names.Emplace(Name); });
+		CHECK(Names == TArray<FString>({ TEXT("name"), TEXT("list"), TEXT("") }));
+
+		// Values are copied, the source of the document can go away
+		{
+			TUtf8StringBuilder<16> Source;
+			Source << "[\"kept\"]";
+			REQUIRE(Document.Parse(Source.ToView()));
+		}
+		CHECK(Document.GetRoot()[0].GetRawString() == UTF8TEXTVIEW("kept"));
+	}
+}
+
+TEST_CASE_NAMED(FUtf8JsonPullReaderPerfTest, "System::Engine::FileSystem::JSON::Utf8PullReaderPerf", "[ApplicationContextMask][PerfFilter]")
+{
+	using namespace UE::Json;
+	using namespace UE::Json::Private::Tests;
+
+	// -JsonBenchmarkFile= replaces the generated document with a UTF-8 file
+	TArray<uint8> FileData;
+	TUtf8StringBuilder<1024> Generated;
+	FUtf8StringView Json;
+	FString BenchmarkFile;
+	if (FParse::Value(FCommandLine::Get(), TEXT("JsonBenchmarkFile="), BenchmarkFile) && FFileHelper::LoadFileToArray(FileData, *BenchmarkFile))
+	{
+		Json = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(FileData.GetData()), FileData.Num());
+	}
+	else
+	{
+		BuildBenchmarkDocument(Generated, 20000);
+		Json = Generated.ToView();
+	}
+
+	const int32 NumIterations = 10;
+	const double MegaBytes = double(Json.Len()) * NumIterations / (1024.0 * 1024.0);
+
+	auto Measure = [MegaBytes, NumIterations](const TCHAR* Name, TFunctionRef<bool()> Read)
+	{
+		bool bSuccess = true;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			bSuccess &= Read();
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		GLog->Logf(TEXT("%s: %.3f ms per document, %.1f MB/s"), Name, Seconds * 1000.0 / NumIterations, MegaBytes / Seconds);
+		return bSuccess;
+	};
+
+	CHECK(Measure(TEXT("TJsonReader"), [Json]()
+	{
+		TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(Json);
+		EJsonNotation Notation;
+		while (Reader->ReadNext(Notation) && Notation != EJsonNotation::Error)
+		{
+		}
+		return Notation != EJsonNotation::Error;
+	}));
+
+	CHECK(Measure(TEXT("FJsonSerializer::Deserialize"), [Json]()
+	{
+		TSharedPtr<FJsonValue> Value;
+		return FJsonSerializer::Deserialize(TJsonReaderFactory<UTF8CHAR>::CreateFromView(Json), Value);
+	}));
+
+	FStructuralIndex Index;
+	CHECK(Measure(TEXT("FStructuralIndex"), [Json, &Index]()
+	{
+		return Index.Build(Json);
+	}));
+
+	CHECK(Measure(TEXT("FUtf8PullReader"), [Json, &Index]()
+	{
+		Index.Build(Json);
+		FUtf8PullReader Reader(Json, Index);
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation) && Notation != EJsonNotation::Error)
+		{
+		}
+		return Notation != EJsonNotation::Error;
+	}));
+
+	FArenaDocument Document;
+	CHECK(Measure(TEXT("FArenaDocument"), [Json, &Document]()
+	{
+		return Document.Parse(Json);
+	}));
+}
+
+#endif // WITH_TESTS
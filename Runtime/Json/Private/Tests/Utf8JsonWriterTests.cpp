@@ -0,0 +1,201 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_TESTS
+
+#include "CoreMinimal.h"
+#include "Containers/Utf8String.h"
+#include "Dom/JsonArenaDocument.h"
+#include "HAL/PlatformTime.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/Utf8JsonWriter.h"
+#include "Tests/TestHarnessAdapter.h"
+
+namespace UE::Json::Private::Tests
+{
+	/** Writes the same document with TJsonWriter and TUtf8JsonWriter, their API matches for these calls */
+	template <typename WriterType>
+	static void WriteBenchmarkDocument(WriterType& Writer, int32 NumEntries)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("version"), 3);
+		Writer.WriteArrayStart(TEXT("entries"));
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("id"), Index);
+			Writer.WriteValue(TEXT("name"), TEXT("Entry name with a \"quote\""));
+			Writer.WriteValue(TEXT("path"), TEXT("/Game/Content/Props/Entry.Entry"));
+			Writer.WriteValue(TEXT("enabled"), (Index & 1) == 0);
+			Writer.WriteValue(TEXT("hash"), uint64(Index) * 0x9E3779B97F4A7C15ull);
+			Writer.WriteValue(TEXT("offset"), -int64(Index) * 1000);
+			Writer.WriteNull(TEXT("parent"));
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+	}
+}
+
+TEST_CASE_NAMED(FUtf8JsonWriterTest, "System::Engine::FileSystem::JSON::Utf8Writer", "[ApplicationContextMask][SmokeFilter]")
+{
+	using namespace UE::Json;
+	using namespace UE::Json::Private::Tests;
+
+	SECTION("Condensed")
+	{
+		TUtf8StringBuilder<256> Json;
+		FUtf8JsonBuilderOutput Output(Json);
+		FUtf8JsonWriter Writer(Output);
+
+		Writer.WriteObjectStart();
+		Writer.WriteValue(UTF8TEXTVIEW("min"), MIN_int64);
+		Writer.WriteValue(TEXT("max"), MAX_uint64);
+		Writer.WriteValue("double", 0.1);
+		Writer.WriteValue("float", 0.1f);
+		Writer.WriteValue("infinity", std::numeric_limits<double>::infinity());
+		Writer.WriteValue("escapes", TEXT("\"\\\n\x01/"));
+		Writer.WriteValue("utf16", TEXT("caf\u00e9 \U0001F600"));
+		Writer.WriteValue("utf8", UTF8TEXTVIEW("caf\xC3\xA9"));
+		Writer.WriteArrayStart("array");
+		Writer.WriteValue(true);
+		Writer.WriteNull();
+		Writer.WriteArrayStart();
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectStart();
+		Writer.WriteObjectEnd();
+		Writer.WriteArrayEnd();
+		Writer.WriteIdentifierPrefix("prefixed");
+		Writer.WriteValue(1);
+		Writer.WriteRawJsonValue("raw", UTF8TEXTVIEW("[1, 2]"));
+		Writer.WriteObjectEnd();
+		CHECK(Writer.IsComplete());
+
+		CHECK(Json.ToView() == UTF8TEXTVIEW("{\"min\":-9223372036854775808,\"max\":18446744073709551615,\"double\":0.1,\"float\":0.1,"
+			"\"infinity\":null,\"escapes\":\"\\\"\\\\\\n\\u0001/\",\"utf16\":\"caf\xC3\xA9 \xF0\x9F\x98\x80\",\"utf8\":\"caf\xC3\xA9\","
+			"\"array\":[true,null,[],{}],\"prefixed\":1,\"raw\":[1, 2]}"));
+	}
+
+	SECTION("Pretty")
+	{
+		TUtf8StringBuilder<256> Json;
+		FUtf8JsonBuilderOutput Output(Json);
+		FUtf8PrettyJsonWriter Writer(Output);
+
+		Writer.WriteObjectStart();
+		Writer.WriteArrayStart("a");
+		Writer.WriteValue(1);
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectStart("b");
+		Writer.WriteObjectEnd();
+		Writer.WriteObjectEnd();
+
+		TUtf8StringBuilder<64> Expected;
+		Expected << "{" LINE_TERMINATOR_ANSI "\t\"a\": [" LINE_TERMINATOR_ANSI "\t\t1" LINE_TERMINATOR_ANSI "\t]," LINE_TERMINATOR_ANSI "\t\"b\": {}" LINE_TERMINATOR_ANSI "}";
+		CHECK(Json.ToView() == Expected.ToView());
+	}
+
+	SECTION("Matches TJsonWriter")
+	{
+		FUtf8String Legacy;
+		TSharedRef<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> LegacyWriter = TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Legacy);
+		WriteBenchmarkDocument(*LegacyWriter, 10);
+		REQUIRE(LegacyWriter->Close());
+
+		TUtf8StringBuilder<1024> Json;
+		FUtf8JsonBuilderOutput Output(Json);
+		FUtf8JsonWriter Writer(Output);
+		WriteBenchmarkDocument(Writer, 10);
+
+		CHECK(Json.ToView() == FUtf8StringView(Legacy));
+	}
+
+	SECTION("Archive")
+	{
+		TArray<uint8> Bytes;
+		{
+			FMemoryWriter Archive(Bytes);
+			FUtf8JsonArchiveOutput Output(Archive);
+			TUtf8JsonWriter<FCondensedJsonFormat, FUtf8JsonArchiveOutput> Writer(Output);
+			WriteBenchmarkDocument(Writer, 1000);
+		}
+
+		// Larger than the buffer of the output, so it has been flushed several times
+		const FUtf8StringView Json(reinterpret_cast<const UTF8CHAR*>(Bytes.GetData()), Bytes.Num());
+		FArenaDocument Document;
+		REQUIRE(Document.Parse(Json));
+		const FArenaValue Entries = Document.GetRoot().Find(UTF8TEXTVIEW("entries"));
+		CHECK(Entries.Num() == 1000);
+		CHECK(Entries[999].Find(UTF8TEXTVIEW("id")).AsNumber() == 999.0);
+		CHECK(Entries[999].Find(UTF8TEXTVIEW("name")).AsString() == TEXT("Entry name with a \"quote\""));
+	}
+}
+
+TEST_CASE_NAMED(FUtf8JsonWriterPerfTest, "System::Engine::FileSystem::JSON::Utf8WriterPerf", "[ApplicationContextMask][PerfFilter]")
+{
+	using namespace UE::Json;
+	using namespace UE::Json::Private::Tests;
+
+	const int32 NumEntries = 20000;
+	const int32 NumIterations = 10;
+
+	auto Measure = [NumIterations](const TCHAR* Name, TFunctionRef<int32()> Write)
+	{
+		int32 Size = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Size = Write();
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		GLog->Logf(TEXT("%s: %.3f ms per document, %.1f MB/s"), Name, Seconds * 1000.0 / NumIterations, double(Size) * NumIterations / (1024.0 * 1024.0 * Seconds));
+		return Size;
+	};
+
+	// The usual path for a UTF-8 payload, written as TCHAR and converted
+	const int32 LegacySize = Measure(TEXT("TJsonWriter<TCHAR> + UTF-8 conversion"), []()
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		WriteBenchmarkDocument(*Writer, NumEntries);
+		Writer->Close();
+		FTCHARToUTF8 Utf8(*Json, Json.Len());
+		return Utf8.Length();
+	});
+
+	Measure(TEXT("TJsonWriter<UTF8CHAR>"), []()
+	{
+		FUtf8String Json;
+		TSharedRef<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> Writer = TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Json);
+		WriteBenchmarkDocument(*Writer, NumEntries);
+		Writer->Close();
+		return Json.Len();
+	});
+
+	// Reused across iterations, as a long lived payload builder would be
+	TUtf8StringBuilder<1024> Builder;
+	const int32 Size = Measure(TEXT("TUtf8JsonWriter to a string builder"), [&Builder]()
+	{
+		Builder.Reset();
+		FUtf8JsonBuilderOutput Output(Builder);
+		FUtf8JsonWriter Writer(Output);
+		WriteBenchmarkDocument(Writer, NumEntries);
+		return Builder.Len();
+	});
+	CHECK(Size == LegacySize);
+
+	TArray<uint8> Bytes;
+	Measure(TEXT("TUtf8JsonWriter to an archive"), [&Bytes]()
+	{
+		Bytes.Reset();
+		FMemoryWriter Archive(Bytes);
+		FUtf8JsonArchiveOutput Output(Archive);
+		TUtf8JsonWriter<FCondensedJsonFormat, FUtf8JsonArchiveOutput> Writer(Output);
+		WriteBenchmarkDocument(Writer, NumEntries);
+		Output.Flush();
+		return Bytes.Num();
+	});
+}
+
+#endif // WITH_TESTS
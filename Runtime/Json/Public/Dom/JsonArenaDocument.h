@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "Misc/StringBuilder.h"
+#include "Serialization/JsonStructuralIndex.h"
+#include "Serialization/JsonTypes.h"
+
+namespace UE::Json
+{
+	class FArenaDocument;
+
+	/**
+	 * Read-only view of a value of an FArenaDocument, valid until the document is parsed again or destroyed.
+	 * Accessing a value as the wrong type returns an empty result instead of asserting.
+	 */
+	class FArenaValue
+	{
+	public:
+		FArenaValue() = default;
+
+		FORCEINLINE bool IsValid() const
+		{
+			return Document != nullptr;
+		}
+
+		JSON_API EJson GetType() const;
+
+		/** Returns this value as a boolean, or false if it is not a boolean */
+		JSON_API bool AsBool() const;
+
+		/** Returns this value as a double, or zero if it is not a number */
+		JSON_API double AsNumber() const;
+
+		/** Returns the contents of this string with its escapes intact, or an empty view if it is not a string */
+		JSON_API FUtf8StringView GetRawString() const;
+
+		/** Appends the unescaped contents of this string to Out, returns false if it is not a valid string */
+		JSON_API bool GetString(TStringBuilderBase<UTF8CHAR>& Out) const;
+
+		/** Returns this value as an unescaped string, or an empty string if it is not a string */
+		JSON_API FString AsString() const;
+
+		/** Returns the number of elements of an array or members of an object */
+		JSON_API int32 Num() const;
+
+		/** Returns the element of an array at Index, found by walking the elements before it */
+		JSON_API FArenaValue operator[](int32 Index) const;
+
+		/** Returns the member of an object named Key, compared with the member names as they are escaped in the document */
+		JSON_API FArenaValue Find(FUtf8StringView Key) const;
+
+		/** Calls Visitor(FArenaValue) for every element of an array */
+		template <typename VisitorType>
+		void ForEachElement(VisitorType&& Visitor) const;
+
+		/** Calls Visitor(FUtf8StringView RawName, FArenaValue) for every member of an object */
+		template <typename VisitorType>
+		void ForEachMember(VisitorType&& Visitor) const;
+
+	private:
+		friend FArenaDocument;
+
+		FArenaValue(const FArenaDocument* InDocument, int32 InNode)
+			: Document(InDocument)
+			, Node(InNode)
+		{
+		}
+
+		const FArenaDocument* Document = nullptr;
+		int32 Node = INDEX_NONE;
+	};
+
+	/**
+	 * Read-only JSON DOM that stores the whole document in a few flat arrays instead of a tree of shared FJsonValue and
+	 * FJsonObject allocations. Values are laid out depth first, each array or object followed by its children, and
+	 * strings and numbers refer to a copy of the text of the document.
+	 *
+	 * The arrays are reused by every parse, so parsing documents of a similar size repeatedly does not allocate.
+	 */
+	class FArenaDocument
+	{
+	public:
+		/** Parses Json, replacing the previous contents of the document. The document keeps a copy of Json. */
+		JSON_API bool Parse(FUtf8StringView Json);
+
+		/** Returns the root value, invalid if the last parse failed */
+		FORCEINLINE FArenaValue GetRoot() const
+		{
+			return Nodes.Num() ? FArenaValue(this, 0) : FArenaValue();
+		}
+
+		/** Empty if the last parse succeeded */
+		FORCEINLINE const TCHAR* GetErrorMessage() const
+		{
+			return ErrorMessage;
+		}
+
+		/** Byte offset of the error of the last parse, or INDEX_NONE */
+		FORCEINLINE int32 GetErrorOffset() const
+		{
+			return ErrorOffset;
+		}
+
+		/** Empties the document and frees its memory */
+		JSON_API void Reset();
+
+	private:
+		friend FArenaValue;
+
+		struct FNode
+		{
+			/** Value of numbers */
+			double Number;
+			/** Span of strings and numbers in Text, escapes intact and without quotes */
+			uint32 Offset;
+			uint32 Length;
+			/** Index of the node following this value and its children */
+			int32 End;
+			/** Number of elements or members of arrays and objects */
+			int32 Num;
+			EJson Type;
+			bool bBool;
+		};
+
+		FORCEINLINE FUtf8StringView GetText(const FNode& InNode) const
+		{
+			return FUtf8StringView(Text.GetData() + InNode.Offset, int32(InNode.Length));
+		}
+
+		/** Object members are stored as a string node for their name followed by their value */
+		TArray<FNode> Nodes;
+		TArray<UTF8CHAR> Text;
+		FStructuralIndex Index;
+		const TCHAR* ErrorMessage = TEXT("");
+		int32 ErrorOffset = INDEX_NONE;
+	};
+
+	template <typename VisitorType>
+	void FArenaValue::ForEachElement(VisitorType&& Visitor) const
+	{
+		if (GetType() == EJson::Array)
+		{
+			const int32 End = Document->Nodes[Node].End;
+			for (int32 Child = Node + 1; Child < End; Child = Document->Nodes[Child].End)
+			{
+				Visitor(FArenaValue(Document, Child));
+			}
+		}
+	}
+
+	template <typename VisitorType>
+	void FArenaValue::ForEachMember(VisitorType&& Visitor) const
+	{
+		if (GetType() == EJson::Object)
+		{
+			const int32 End = Document->Nodes[Node].End;
+			for (int32 Name = Node + 1; Name < End; Name = Document->Nodes[Name + 1].End)
+			{
+				Visitor(Document->GetText(Document->Nodes[Name]), FArenaValue(Document, Name + 1));
+			}
+		}
+	}
+}
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/StringView.h"
+#include "HAL/Platform.h"
+
+namespace UE::Json
+{
+	/**
+	 * Positions of the structural characters of a UTF-8 JSON document, found 64 bytes at a time with SIMD
+	 * compares and bit arithmetic instead of a character by character state machine (as described by
+	 * Langdale and Lemire, "Parsing Gigabytes of JSON per Second").
+	 *
+	 * The structural characters are the { } [ ] : and , outside of strings, the opening quote of every string
+	 * and the first character of every other scalar value. Readers walk the positions instead of the bytes,
+	 * so whitespace and the contents of strings are never looked at one character at a time.
+	 *
+	 * Only the string boundaries are validated here, the grammar is validated by the reader of the index.
+	 */
+	class FStructuralIndex
+	{
+	public:
+		/**
+		 * Indexes the structural characters of Json, reusing the memory of any previous build.
+		 *
+		 * @return False if Json ends inside a string.
+		 */
+		JSON_API bool Build(FUtf8StringView Json);
+
+		/** Byte offsets of the structural characters in the order they appear in the document */
+		FORCEINLINE TConstArrayView<uint32> GetPositions() const
+		{
+			return Positions;
+		}
+
+		/** Empties the index and frees its memory */
+		JSON_API void Reset();
+
+	private:
+		TArray<uint32> Positions;
+	};
+}
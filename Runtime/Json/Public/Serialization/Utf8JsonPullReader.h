@@ -0,0 +1,148 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "Misc/StringBuilder.h"
+#include "Serialization/JsonTypes.h"
+
+namespace UE::Json
+{
+	class FStructuralIndex;
+
+	/**
+	 * Pull reader of a UTF-8 JSON document that walks the FStructuralIndex of the document instead of its characters.
+	 *
+	 * Follows the notation based API of TJsonReader: ReadNext returns true for every notation that is read, including the
+	 * first error, and false once the document has been read or after an error. Unlike TJsonReader it never allocates.
+	 * Identifiers, strings and numbers are views of the document with their escapes intact, see DecodeString to unescape
+	 * them into a caller provided builder.
+	 *
+	 * The grammar is validated, unescaped control characters in strings and invalid UTF-8 are not.
+	 */
+	class FUtf8PullReader
+	{
+	public:
+		/** Json and Index must outlive the reader, Index must have been built from Json */
+		JSON_API FUtf8PullReader(FUtf8StringView InJson, const FStructuralIndex& InIndex);
+
+		JSON_API bool ReadNext(EJsonNotation& Notation);
+
+		/** Skips the rest of the object or array that was just started, including its end */
+		JSON_API bool SkipObject();
+		JSON_API bool SkipArray();
+
+		/** Name of the current value if it is a member of an object, with its escapes intact */
+		FORCEINLINE FUtf8StringView GetIdentifier() const
+		{
+			return Identifier;
+		}
+
+		/** Contents of the current string value between its quotes, with its escapes intact */
+		FORCEINLINE FUtf8StringView GetRawString() const
+		{
+			check(CurrentNotation == EJsonNotation::String);
+			return Token;
+		}
+
+		/** Appends the unescaped current string value to Out, returns false if it contains an invalid escape */
+		FORCEINLINE bool GetValueAsString(TStringBuilderBase<UTF8CHAR>& Out) const
+		{
+			check(CurrentNotation == EJsonNotation::String);
+			return DecodeString(Token, Out);
+		}
+
+		/** Unescaped current string value, allocates */
+		JSON_API FString GetValueAsString() const;
+
+		JSON_API double GetValueAsNumber() const;
+
+		/** Returns false if the current number has a fraction or exponent or does not fit */
+		JSON_API bool TryGetValueAsInt64(int64& OutValue) const;
+
+		FORCEINLINE FUtf8StringView GetValueAsNumberString() const
+		{
+			check(CurrentNotation == EJsonNotation::Number);
+			return Token;
+		}
+
+		FORCEINLINE bool GetValueAsBoolean() const
+		{
+			check(CurrentNotation == EJsonNotation::Boolean);
+			return bBoolValue;
+		}
+
+		/** Empty if no error occurred */
+		FORCEINLINE const TCHAR* GetErrorMessage() const
+		{
+			return ErrorMessage;
+		}
+
+		/** Byte offset in the document of the error, or INDEX_NONE */
+		FORCEINLINE int32 GetErrorOffset() const
+		{
+			return ErrorOffset;
+		}
+
+		/** Number of objects and arrays the reader is in */
+		FORCEINLINE int32 GetDepth() const
+		{
+			return Depth;
+		}
+
+		/** Appends the unescaped contents of a string or identifier to Out, returns false if it contains an invalid escape */
+		static JSON_API bool DecodeString(FUtf8StringView RawString, TStringBuilderBase<UTF8CHAR>& Out);
+
+		/** Maximum number of nested objects and arrays */
+		static constexpr int32 MaxDepth = 1024;
+
+	private:
+		enum class EState : uint8
+		{
+			Value,
+			FirstMember,
+			Member,
+			FirstElement,
+			AfterValue,
+			Done,
+		};
+
+		bool ReadValue(EJsonNotation& Notation);
+		bool ReadString(int32 Position, FUtf8StringView& OutString);
+		bool ReadContainerEnd(EJsonNotation& Notation);
+		bool SkipContainer(EJsonNotation EndNotation);
+		bool SetError(const TCHAR* Message, int32 Offset, EJsonNotation& Notation);
+
+		/** End of the token that starts at the structural character at PositionIndex, excluding trailing whitespace */
+		int32 GetTokenEnd(int32 PositionIndex) const;
+
+		FORCEINLINE int32 GetPosition(int32 PositionIndex) const
+		{
+			return int32(Positions[PositionIndex]);
+		}
+
+		FORCEINLINE bool IsInObject() const
+		{
+			return Depth > 0 && (ObjectBits[(Depth - 1) / 64] & (uint64(1) << ((Depth - 1) % 64))) != 0;
+		}
+
+		FUtf8StringView Json;
+		TConstArrayView<uint32> Positions;
+		int32 NextPosition = 0;
+
+		FUtf8StringView Identifier;
+		FUtf8StringView Token;
+		EJsonNotation CurrentNotation = EJsonNotation::Error;
+		bool bBoolValue = false;
+
+		EState State = EState::Value;
+		int32 Depth = 0;
+		/** One bit per depth, set for objects and cleared for arrays */
+		uint64 ObjectBits[MaxDepth / 64] = {};
+
+		const TCHAR* ErrorMessage = TEXT("");
+		int32 ErrorOffset = INDEX_NONE;
+	};
+}
@@ -0,0 +1,532 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/StringView.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/StringBuilder.h"
+#include "Serialization/Archive.h"
+
+namespace UE::Json
+{
+	namespace Private
+	{
+		/** Number of characters Format* may write */
+		constexpr int32 MaxFormattedNumberLen = 32;
+
+		/** Writes Value in decimal to Buffer, returns the number of characters written */
+		JSON_API int32 FormatInt64(int64 Value, UTF8CHAR* Buffer);
+		JSON_API int32 FormatUint64(uint64 Value, UTF8CHAR* Buffer);
+
+		/**
+		 * Writes the shortest representation of Value that reads back to the same value to Buffer, or null if Value is
+		 * not finite as JSON has no representation for it. Returns the number of characters written.
+		 */
+		JSON_API int32 FormatDouble(double Value, UTF8CHAR* Buffer);
+		JSON_API int32 FormatFloat(float Value, UTF8CHAR* Buffer);
+
+		/** Returns the length of the prefix of String that can be written to a JSON string without escaping */
+		JSON_API int32 FindFirstEscapedChar(FUtf8StringView String);
+
+		/** Writes the escape sequence of a character that FindFirstEscapedChar stopped at, returns its length */
+		JSON_API int32 FormatEscapedChar(UTF8CHAR Char, UTF8CHAR* Buffer);
+	}
+
+	/** Format of TUtf8JsonWriter without any whitespace */
+	struct FCondensedJsonFormat
+	{
+		static constexpr bool bPretty = false;
+	};
+
+	/** Format of TUtf8JsonWriter with a line per value, indented with tabs */
+	struct FPrettyJsonFormat
+	{
+		static constexpr bool bPretty = true;
+	};
+
+	/** Output of TUtf8JsonWriter that appends to a string builder */
+	class FUtf8JsonBuilderOutput
+	{
+	public:
+		explicit FUtf8JsonBuilderOutput(FUtf8StringBuilderBase& InBuilder)
+			: Builder(InBuilder)
+		{
+		}
+
+		FORCEINLINE void Write(const UTF8CHAR* Data, int32 Num)
+		{
+			Builder.Append(Data, Num);
+		}
+
+		FORCEINLINE void WriteChar(UTF8CHAR Char)
+		{
+			Builder.AppendChar(Char);
+		}
+
+	private:
+		FUtf8StringBuilderBase& Builder;
+	};
+
+	/**
+	 * Output of TUtf8JsonWriter that serializes to an archive. Writes are gathered in an inline buffer so the archive
+	 * sees a few large writes instead of one per token. The buffer is flushed when the output is destroyed.
+	 */
+	class FUtf8JsonArchiveOutput
+	{
+	public:
+		explicit FUtf8JsonArchiveOutput(FArchive& InArchive)
+			: Archive(InArchive)
+		{
+		}
+
+		~FUtf8JsonArchiveOutput()
+		{
+			Flush();
+		}
+
+		FUtf8JsonArchiveOutput(const FUtf8JsonArchiveOutput&) = delete;
+		FUtf8JsonArchiveOutput& operator=(const FUtf8JsonArchiveOutput&) = delete;
+
+		FORCEINLINE void Write(const UTF8CHAR* Data, int32 Num)
+		{
+			if (Used + Num > BufferSize)
+			{
+				Flush();
+				if (Num > BufferSize)
+				{
+					Archive.Serialize(const_cast<UTF8CHAR*>(Data), Num);
+					return;
+				}
+			}
+			FMemory::Memcpy(Buffer + Used, Data, Num);
+			Used += Num;
+		}
+
+		FORCEINLINE void WriteChar(UTF8CHAR Char)
+		{
+			if (Used == BufferSize)
+			{
+				Flush();
+			}
+			Buffer[Used++] = Char;
+		}
+
+		void Flush()
+		{
+			if (Used)
+			{
+				Archive.Serialize(Buffer, Used);
+				Used = 0;
+			}
+		}
+
+	private:
+		static constexpr int32 BufferSize = 4096;
+
+		FArchive& Archive;
+		int32 Used = 0;
+		UTF8CHAR Buffer[BufferSize];
+	};
+
+	/**
+	 * JSON writer that writes UTF-8 directly to its output. Unlike TJsonWriter it is not virtual, does not allocate, and
+	 * the format is a template parameter so the whitespace of the condensed format compiles away.
+	 *
+	 * FStringView strings are transcoded to UTF-8 while they are escaped, FUtf8StringView strings are copied as they are.
+	 * Usage mistakes, such as a value without a name in an object, are caught by checks.
+	 *
+	 * @param FormatType FCondensedJsonFormat or FPrettyJsonFormat.
+	 * @param OutputType FUtf8JsonBuilderOutput, FUtf8JsonArchiveOutput or any type with the same Write and WriteChar.
+	 */
+	template <typename FormatType, typename OutputType>
+	class TUtf8JsonWriter
+	{
+	public:
+		/** Maximum number of nested objects and arrays */
+		static constexpr int32 MaxDepth = 1024;
+
+		explicit TUtf8JsonWriter(OutputType& InOutput)
+			: Output(InOutput)
+		{
+		}
+
+		void WriteObjectStart()
+		{
+			BeginValue();
+			PushContainer(true);
+			Output.WriteChar('{');
+		}
+
+		template <typename NameType>
+		void WriteObjectStart(const NameType& Name)
+		{
+			WriteName(Name);
+			PushContainer(true);
+			Output.WriteChar('{');
+		}
+
+		void WriteObjectEnd()
+		{
+			check(IsInObject());
+			PopContainer();
+			Output.WriteChar('}');
+		}
+
+		void WriteArrayStart()
+		{
+			BeginValue();
+			PushContainer(false);
+			Output.WriteChar('[');
+		}
+
+		template <typename NameType>
+		void WriteArrayStart(const NameType& Name)
+		{
+			WriteName(Name);
+			PushContainer(false);
+			Output.WriteChar('[');
+		}
+
+		void WriteArrayEnd()
+		{
+			check(Depth > 0 && !IsInObject());
+			PopContainer();
+			Output.WriteChar(']');
+		}
+
+		/** Writes an element of an array or the root value */
+		template <typename ValueType>
+		void WriteValue(const ValueType& Value)
+		{
+			BeginValue();
+			WriteValueOnly(Value);
+		}
+
+		/** Writes a member of an object */
+		template <typename NameType, typename ValueType>
+		void WriteValue(const NameType& Name, const ValueType& Value)
+		{
+			WriteName(Name);
+			WriteValueOnly(Value);
+		}
+
+		void WriteNull()
+		{
+			WriteValue(nullptr);
+		}
+
+		template <typename NameType>
+		void WriteNull(const NameType& Name)
+		{
+			WriteValue(Name, nullptr);
+		}
+
+		/** Writes Json as a value without validating it, Json must be a valid JSON value */
+		void WriteRawJsonValue(FUtf8StringView Json)
+		{
+			BeginValue();
+			Output.Write(Json.GetData(), Json.Len());
+		}
+
+		template <typename NameType>
+		void WriteRawJsonValue(const NameType& Name, FUtf8StringView Json)
+		{
+			WriteName(Name);
+			Output.Write(Json.GetData(), Json.Len());
+		}
+
+		/** WriteIdentifierPrefix(Name) followed by WriteValue(Value) is equivalent to WriteValue(Name, Value) */
+		template <typename NameType>
+		void WriteIdentifierPrefix(const NameType& Name)
+		{
+			WriteName(Name);
+			bPendingName = true;
+		}
+
+		/** Returns whether a complete value has been written, i.e. every object and array has been ended */
+		bool IsComplete() const
+		{
+			return Depth == 0 && bHasValue;
+		}
+
+	private:
+		/** Writes the separator, line break and indentation that come before a value in the current container */
+		FORCEINLINE void BeginValue()
+		{
+			check(!IsInObject() || bPendingName);
+			if (bPendingName)
+			{
+				bPendingName = false;
+				return;
+			}
+			check(Depth > 0 || !bHasValue);
+			if (bHasValue && Depth > 0)
+			{
+				Output.WriteChar(',');
+			}
+			if constexpr (FormatType::bPretty)
+			{
+				if (Depth > 0)
+				{
+					WriteLineBreak(Depth);
+				}
+			}
+			bHasValue = true;
+		}
+
+		template <typename NameType>
+		FORCEINLINE void WriteName(const NameType& Name)
+		{
+			check(IsInObject() && !bPendingName);
+			BeginValueInObject();
+			WriteString(Name);
+			Output.WriteChar(':');
+			if constexpr (FormatType::bPretty)
+			{
+				Output.WriteChar(' ');
+			}
+		}
+
+		FORCEINLINE void BeginValueInObject()
+		{
+			if (bHasValue)
+			{
+				Output.WriteChar(',');
+			}
+			if constexpr (FormatType::bPretty)
+			{
+				WriteLineBreak(Depth);
+			}
+			bHasValue = true;
+		}
+
+		FORCEINLINE void PushContainer(bool bObject)
+		{
+			check(Depth < MaxDepth);
+			if (bObject)
+			{
+				ObjectBits[Depth / 64] |= uint64(1) << (Depth % 64);
+			}
+			else
+			{
+				ObjectBits[Depth / 64] &= ~(uint64(1) << (Depth % 64));
+			}
+			++Depth;
+			bHasValue = false;
+		}
+
+		FORCEINLINE void PopContainer()
+		{
+			check(!bPendingName);
+			--Depth;
+			if constexpr (FormatType::bPretty)
+			{
+				if (bHasValue)
+				{
+					WriteLineBreak(Depth);
+				}
+			}
+			// The container itself is the value of its parent
+			bHasValue = true;
+		}
+
+		FORCEINLINE bool IsInObject() const
+		{
+			return Depth > 0 && (ObjectBits[(Depth - 1) / 64] & (uint64(1) << ((Depth - 1) % 64))) != 0;
+		}
+
+		void WriteLineBreak(int32 Indent)
+		{
+			Output.Write(reinterpret_cast<const UTF8CHAR*>(LINE_TERMINATOR_ANSI), UE_ARRAY_COUNT(LINE_TERMINATOR_ANSI) - 1);
+			for (; Indent > 0; --Indent)
+			{
+				Output.WriteChar('\t');
+			}
+		}
+
+		FORCEINLINE void WriteValueOnly(bool Value)
+		{
+			if (Value)
+			{
+				Output.Write(UTF8TEXT("true"), 4);
+			}
+			else
+			{
+				Output.Write(UTF8TEXT("false"), 5);
+			}
+		}
+
+		FORCEINLINE void WriteValueOnly(TYPE_OF_NULLPTR)
+		{
+			Output.Write(UTF8TEXT("null"), 4);
+		}
+
+		FORCEINLINE void WriteValueOnly(int32 Value)
+		{
+			WriteValueOnly(int64(Value));
+		}
+
+		FORCEINLINE void WriteValueOnly(uint32 Value)
+		{
+			WriteValueOnly(uint64(Value));
+		}
+
+		FORCEINLINE void WriteValueOnly(int64 Value)
+		{
+			UTF8CHAR Buffer[Private::MaxFormattedNumberLen];
+			Output.Write(Buffer, Private::FormatInt64(Value, Buffer));
+		}
+
+		FORCEINLINE void WriteValueOnly(uint64 Value)
+		{
+			UTF8CHAR Buffer[Private::MaxFormattedNumberLen];
+			Output.Write(Buffer, Private::FormatUint64(Value, Buffer));
+		}
+
+		FORCEINLINE void WriteValueOnly(float Value)
+		{
+			UTF8CHAR Buffer[Private::MaxFormattedNumberLen];
+			Output.Write(Buffer, Private::FormatFloat(Value, Buffer));
+		}
+
+		FORCEINLINE void WriteValueOnly(double Value)
+		{
+			UTF8CHAR Buffer[Private::MaxFormattedNumberLen];
+			Output.Write(Buffer, Private::FormatDouble(Value, Buffer));
+		}
+
+		template <typename StringType>
+		FORCEINLINE void WriteValueOnly(const StringType& Value)
+		{
+			WriteString(Value);
+		}
+
+		void WriteString(FUtf8StringView String)
+		{
+			Output.WriteChar('"');
+			while (!String.IsEmpty())
+			{
+				const int32 Run = Private::FindFirstEscapedChar(String);
+				Output.Write(String.GetData(), Run);
+				if (Run == String.Len())
+				{
+					break;
+				}
+
+				UTF8CHAR Escape[8];
+				Output.Write(Escape, Private::FormatEscapedChar(String[Run], Escape));
+				String.RightChopInline(Run + 1);
+			}
+			Output.WriteChar('"');
+		}
+
+		FORCEINLINE void WriteString(const UTF8CHAR* String)
+		{
+			WriteString(FUtf8StringView(String));
+		}
+
+		FORCEINLINE void WriteString(const ANSICHAR* String)
+		{
+			WriteString(FAnsiStringView(String));
+		}
+
+		/** ANSI strings are written as they are, so they must be 7 bit ASCII */
+		FORCEINLINE void WriteString(FAnsiStringView String)
+		{
+			WriteString(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(String.GetData()), String.Len()));
+		}
+
+		FORCEINLINE void WriteString(const TCHAR* String)
+		{
+			WriteString(FStringView(String));
+		}
+
+		FORCEINLINE void WriteString(const FString& String)
+		{
+			WriteString(FStringView(String));
+		}
+
+		/** Transcodes String to UTF-8 in chunks on the stack, escaping it on the way */
+		void WriteString(FStringView String)
+		{
+			constexpr int32 ChunkSize = 256;
+			UTF8CHAR Chunk[ChunkSize];
+			int32 Used = 0;
+
+			Output.WriteChar('"');
+			for (int32 Index = 0; Index < String.Len(); ++Index)
+			{
+				// Leave room for the longest encoding or escape of a character
+				if (Used > ChunkSize - 8)
+				{
+					Output.Write(Chunk, Used);
+					Used = 0;
+				}
+
+				uint32 Codepoint = uint32(String[Index]);
+				if (Codepoint < 0x80)
+				{
+					if (Codepoint < 0x20 || Codepoint == '"' || Codepoint == '\\')
+					{
+						Used += Private::FormatEscapedChar(UTF8CHAR(Codepoint), Chunk + Used);
+					}
+					else
+					{
+						Chunk[Used++] = UTF8CHAR(Codepoint);
+					}
+					continue;
+				}
+
+				if constexpr (sizeof(TCHAR) == 2)
+				{
+					if (Codepoint >= 0xD800 && Codepoint <= 0xDBFF && Index + 1 < String.Len()
+						&& uint32(String[Index + 1]) >= 0xDC00 && uint32(String[Index + 1]) <= 0xDFFF)
+					{
+						Codepoint = 0x10000 + ((Codepoint - 0xD800) << 10) + (uint32(String[++Index]) - 0xDC00);
+					}
+				}
+				if ((Codepoint >= 0xD800 && Codepoint <= 0xDFFF) || Codepoint > 0x10FFFF)
+				{
+					// Surrogates that are not part of a pair cannot be encoded in UTF-8
+					Codepoint = 0xFFFD;
+				}
+
+				if (Codepoint < 0x800)
+				{
+					Chunk[Used++] = UTF8CHAR(0xC0 | (Codepoint >> 6));
+				}
+				else
+				{
+					if (Codepoint < 0x10000)
+					{
+						Chunk[Used++] = UTF8CHAR(0xE0 | (Codepoint >> 12));
+					}
+					else
+					{
+						Chunk[Used++] = UTF8CHAR(0xF0 | (Codepoint >> 18));
+						Chunk[Used++] = UTF8CHAR(0x80 | ((Codepoint >> 12) & 0x3F));
+					}
+					Chunk[Used++] = UTF8CHAR(0x80 | ((Codepoint >> 6) & 0x3F));
+				}
+				Chunk[Used++] = UTF8CHAR(0x80 | (Codepoint & 0x3F));
+			}
+			Chunk[Used++] = '"';
+			Output.Write(Chunk, Used);
+		}
+
+		OutputType& Output;
+		int32 Depth = 0;
+		/** Whether the current container, or the root when Depth is zero, has a value */
+		bool bHasValue = false;
+		/** Whether a name has been written and its value has not */
+		bool bPendingName = false;
+		/** One bit per depth, set for objects and cleared for arrays */
+		uint64 ObjectBits[MaxDepth / 64] = {};
+	};
+
+	/** Condensed UTF-8 writer appending to a string builder */
+	using FUtf8JsonWriter = TUtf8JsonWriter<FCondensedJsonFormat, FUtf8JsonBuilderOutput>;
+
+	/** Pretty UTF-8 writer appending to a string builder */
+	using FUtf8PrettyJsonWriter = TUtf8JsonWriter<FPrettyJsonFormat, FUtf8JsonBuilderOutput>;
+}
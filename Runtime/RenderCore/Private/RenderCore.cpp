@@ -20,6 +20,7 @@ void UpdateShaderDevelopmentMode();
 
 void InitRenderGraph();
 void ShutdownRenderGraph();
+void InitSceneRenderingAllocator();
 
 static void InitPixelRenderCounters();
 
@@ -33,6 +34,7 @@ public:
 		IConsoleManager::Get().RegisterConsoleVariableSink_Handle(FConsoleCommandDelegate::CreateStatic(&UpdateShaderDevelopmentMode));
 
 		InitRenderGraph();
+		InitSceneRenderingAllocator();
 		InitPixelRenderCounters();
 	}
 
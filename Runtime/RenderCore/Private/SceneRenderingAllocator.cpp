@@ -0,0 +1,506 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	SceneRenderingAllocator.cpp: Per thread block arenas of the scene rendering allocator.
+=============================================================================*/
+
+#include "RendererInterface.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/ThreadManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+static int32 GSceneRenderingAllocatorThreadArena = 1;
+static FAutoConsoleVariableRef CVarSceneRenderingAllocatorThreadArena(
+	TEXT("r.SceneRenderingAllocator.ThreadArena"),
+	GSceneRenderingAllocatorThreadArena,
+	TEXT("Recycles the blocks of the scene rendering allocator through per thread arenas that are trimmed at the end of each frame.\n")
+	TEXT("0: every block is allocated and freed through FMalloc\n")
+	TEXT("1: released blocks are kept by the arena of the thread that allocated them (default)"),
+	ECVF_RenderThreadSafe);
+
+static int32 GSceneRenderingAllocatorThreadArenaMaxBlocks = 64;
+static FAutoConsoleVariableRef CVarSceneRenderingAllocatorThreadArenaMaxBlocks(
+	TEXT("r.SceneRenderingAllocator.ThreadArena.MaxBlocks"),
+	GSceneRenderingAllocatorThreadArenaMaxBlocks,
+	TEXT("Maximum number of 64KB blocks a thread arena keeps from one frame to the next (default 64)."),
+	ECVF_RenderThreadSafe);
+
+static FAutoConsoleCommandWithOutputDevice GSceneRenderingAllocatorDumpStatsCmd(
+	TEXT("r.SceneRenderingAllocator.DumpStats"),
+	TEXT("Prints the scene rendering allocator bytes of the last frame and the current and peak arena sizes of every thread."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FSceneRenderingBlockArenaAllocator::DumpStats));
+
+DECLARE_LLM_MEMORY_STAT(TEXT("SceneRenderingAllocator"), STAT_SceneRenderingAllocatorLLM, STATGROUP_LLMFULL);
+LLM_DEFINE_TAG(SceneRenderingAllocator, NAME_None, NAME_None, GET_STATFNAME(STAT_SceneRenderingAllocatorLLM), GET_STATFNAME(STAT_SceneRenderingAllocatorLLM));
+
+TRACE_DECLARE_MEMORY_COUNTER(SceneRenderingAllocator_FrameBytes, TEXT("SceneRenderingAllocator/FrameBytes"));
+TRACE_DECLARE_MEMORY_COUNTER(SceneRenderingAllocator_ArenaBytes, TEXT("SceneRenderingAllocator/ArenaBytes"));
+TRACE_DECLARE_MEMORY_COUNTER(SceneRenderingAllocator_PeakArenaBytes, TEXT("SceneRenderingAllocator/PeakArenaBytes"));
+
+namespace UE::SceneRenderingAllocator::Private
+{
+
+static constexpr SIZE_T BlockSize = FSceneRenderingBlockArenaAllocator::BlockSize;
+
+// Hard limit of the blocks an arena keeps from one frame to the next, r.SceneRenderingAllocator.ThreadArena.MaxBlocks is clamped to it
+static constexpr int32 MaxArenaBlocks = 256;
+
+class FThreadArena;
+
+// Stored right after the BlockSize bytes of every block, so that whichever thread releases a block finds the arena that handed it out
+struct FBlockTrailer
+{
+	// Null for blocks allocated while the arenas are disabled
+	FThreadArena* Owner = nullptr;
+	// Link in the lists of cached blocks
+	FBlockTrailer* Next = nullptr;
+};
+
+static FBlockTrailer* GetTrailer(void* Block)
+{
+	return reinterpret_cast<FBlockTrailer*>(static_cast<uint8*>(Block) + BlockSize);
+}
+
+static void* GetBlock(FBlockTrailer* Trailer)
+{
+	return reinterpret_cast<uint8*>(Trailer) - BlockSize;
+}
+
+static FBlockTrailer* MallocBlock(uint32 Alignment, FThreadArena* Owner)
+{
+	LLM_SCOPE_BYTAG(SceneRenderingAllocator);
+	void* Block = FMemory::Malloc(BlockSize + sizeof(FBlockTrailer), FMath::Max<uint32>(Alignment, alignof(FBlockTrailer)));
+	return new (GetTrailer(Block)) FBlockTrailer{ Owner, nullptr };
+}
+
+// Frees a list of blocks and returns how many there were
+static int32 FreeBlocks(FBlockTrailer* Blocks)
+{
+	int32 NumBlocks = 0;
+	while (Blocks)
+	{
+		FBlockTrailer* Next = Blocks->Next;
+		FMemory::Free(GetBlock(Blocks));
+		Blocks = Next;
+		++NumBlocks;
+	}
+	return NumBlocks;
+}
+
+static int32 GetMaxArenaBlocks()
+{
+	return GSceneRenderingAllocatorThreadArena ? FMath::Clamp(GSceneRenderingAllocatorThreadArenaMaxBlocks, 0, MaxArenaBlocks) : 0;
+}
+
+// Blocks cached for one thread. No lock is taken: released blocks are pushed on a lock-free list that is only ever emptied as a whole,
+// by the owning thread when it runs out of blocks or by the end of frame trim, so no thread follows the link of a block another thread took.
+// Arenas are never freed so that blocks can be returned to them after their thread exited, dead arenas are reused by new threads.
+class FThreadArena
+{
+	// Blocks released by any thread, including the owning one
+	std::atomic<FBlockTrailer*> ReturnedBlocks { nullptr };
+
+	// Owning thread only, the blocks taken from ReturnedBlocks that were not handed out yet
+	FBlockTrailer* LocalBlocks = nullptr;
+	int32 NumLocalBlocks = 0;
+
+	// Set by EndFrame to the number of blocks the owning thread should keep in LocalBlocks, INDEX_NONE once applied
+	std::atomic<int32> LocalBlocksToKeep { INDEX_NONE };
+
+	// Written by the owning thread only
+	std::atomic<uint64> NumAllocatedBytes { 0 };
+	std::atomic<uint64> NumHandedOutBlocks { 0 };
+	std::atomic<uint64> NumMallocBlocks { 0 };
+	std::atomic<int32> PublishedNumLocalBlocks { 0 };
+
+	// Written by any thread
+	std::atomic<uint64> NumReturnedBlocks { 0 };
+	std::atomic<uint64> NumFreedBlocks { 0 };
+
+	// EndFrame only, under the registry lock
+	uint64 EndFrameAllocatedBytes = 0;
+	uint64 EndFrameHandedOutBlocks = 0;
+
+	void SetNumLocalBlocks(int32 InNumLocalBlocks)
+	{
+		NumLocalBlocks = InNumLocalBlocks;
+		PublishedNumLocalBlocks.store(NumLocalBlocks, std::memory_order_relaxed);
+	}
+
+	void TrimLocalBlocks(int32 NumBlocksToKeep)
+	{
+		FBlockTrailer* BlocksToFree = nullptr;
+		while (NumLocalBlocks > NumBlocksToKeep)
+		{
+			FBlockTrailer* Trailer = LocalBlocks;
+			LocalBlocks = Trailer->Next;
+			Trailer->Next = BlocksToFree;
+			BlocksToFree = Trailer;
+			SetNumLocalBlocks(NumLocalBlocks - 1);
+		}
+		NumFreedBlocks.fetch_add(FreeBlocks(BlocksToFree), std::memory_order_relaxed);
+	}
+
+	// Takes ReturnedBlocks as a whole, keeps the first NumBlocksToKeep and frees the others
+	void TrimReturnedBlocks(int32 NumBlocksToKeep)
+	{
+		FBlockTrailer* Blocks = ReturnedBlocks.exchange(nullptr, std::memory_order_acquire);
+		if (Blocks == nullptr)
+		{
+			return;
+		}
+
+		FBlockTrailer* KeptHead = nullptr;
+		FBlockTrailer* KeptTail = nullptr;
+		for (int32 Index = 0; Index < NumBlocksToKeep && Blocks; ++Index)
+		{
+			FBlockTrailer* Next = Blocks->Next;
+			Blocks->Next = nullptr;
+			if (KeptTail)
+			{
+				KeptTail->Next = Blocks;
+			}
+			else
+			{
+				KeptHead = Blocks;
+			}
+			KeptTail = Blocks;
+			Blocks = Next;
+		}
+
+		NumFreedBlocks.fetch_add(FreeBlocks(Blocks), std::memory_order_relaxed);
+
+		if (KeptHead)
+		{
+			FBlockTrailer* Head = ReturnedBlocks.load(std::memory_order_relaxed);
+			do
+			{
+				KeptTail->Next = Head;
+			}
+			while (!ReturnedBlocks.compare_exchange_weak(Head, KeptHead, std::memory_order_release, std::memory_order_relaxed));
+		}
+	}
+
+public:
+	uint32 ThreadId = 0;
+	std::atomic<bool> bThreadAlive { false };
+
+	// Stats published by EndFrame
+	std::atomic<uint64> LastFrameBytes { 0 };
+	std::atomic<uint64> PeakFrameBytes { 0 };
+	std::atomic<uint64> PeakArenaBytes { 0 };
+
+	void Acquire()
+	{
+		check(LocalBlocks == nullptr);
+		ThreadId = FPlatformTLS::GetCurrentThreadId();
+		LocalBlocksToKeep.store(INDEX_NONE, std::memory_order_relaxed);
+		LastFrameBytes.store(0, std::memory_order_relaxed);
+		PeakFrameBytes.store(0, std::memory_order_relaxed);
+		PeakArenaBytes.store(0, std::memory_order_relaxed);
+		EndFrameAllocatedBytes = NumAllocatedBytes.load(std::memory_order_relaxed);
+		EndFrameHandedOutBlocks = NumHandedOutBlocks.load(std::memory_order_relaxed);
+		bThreadAlive.store(true, std::memory_order_release);
+	}
+
+	// Called by the owning thread when it exits. Blocks returned after this are freed by the next EndFrame.
+	void Release()
+	{
+		TrimLocalBlocks(0);
+		bThreadAlive.store(false, std::memory_order_release);
+		TrimReturnedBlocks(0);
+	}
+
+	// Called by the owning thread only
+	void* AllocBlock(uint32 Alignment)
+	{
+		NumAllocatedBytes.store(NumAllocatedBytes.load(std::memory_order_relaxed) + BlockSize, std::memory_order_relaxed);
+
+		if (!GSceneRenderingAllocatorThreadArena)
+		{
+			return GetBlock(MallocBlock(Alignment, nullptr));
+		}
+
+		NumHandedOutBlocks.store(NumHandedOutBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+		if (LocalBlocksToKeep.load(std::memory_order_relaxed) != INDEX_NONE)
+		{
+			TrimLocalBlocks(LocalBlocksToKeep.exchange(INDEX_NONE, std::memory_order_relaxed));
+		}
+
+		if (LocalBlocks == nullptr)
+		{
+			LocalBlocks = ReturnedBlocks.exchange(nullptr, std::memory_order_acquire);
+
+			int32 NumTakenBlocks = 0;
+			for (FBlockTrailer* Trailer = LocalBlocks; Trailer; Trailer = Trailer->Next)
+			{
+				++NumTakenBlocks;
+			}
+			SetNumLocalBlocks(NumTakenBlocks);
+		}
+
+		if (NumLocalBlocks > 0)
+		{
+			FBlockTrailer* Trailer = LocalBlocks;
+			LocalBlocks = Trailer->Next;
+			SetNumLocalBlocks(NumLocalBlocks - 1);
+			return GetBlock(Trailer);
+		}
+
+		NumMallocBlocks.store(NumMallocBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return GetBlock(MallocBlock(Alignment, this));
+	}
+
+	// Called by any thread for a block this arena handed out
+	void ReturnBlock(FBlockTrailer* Trailer)
+	{
+		NumReturnedBlocks.fetch_add(1, std::memory_order_relaxed);
+
+		FBlockTrailer* Head = ReturnedBlocks.load(std::memory_order_relaxed);
+		do
+		{
+			Trailer->Next = Head;
+		}
+		while (!ReturnedBlocks.compare_exchange_weak(Head, Trailer, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// Called by the owning thread only
+	void AddOversizedBytes(SIZE_T Size)
+	{
+		NumAllocatedBytes.store(NumAllocatedBytes.load(std::memory_order_relaxed) + Size, std::memory_order_relaxed);
+	}
+
+	// Publishes the stats of the frame and trims the arena back to what its thread needed during that frame, the next one most likely needs as much.
+	// The blocks the owning thread holds locally are trimmed by that thread the next time it allocates.
+	void EndFrame()
+	{
+		const uint64 AllocatedBytes = NumAllocatedBytes.load(std::memory_order_relaxed);
+		const uint64 HandedOutBlocks = NumHandedOutBlocks.load(std::memory_order_relaxed);
+		const uint64 FrameBytes = AllocatedBytes - EndFrameAllocatedBytes;
+		const int32 FrameBlocks = int32(FMath::Min<uint64>(HandedOutBlocks - EndFrameHandedOutBlocks, MAX_int32));
+		EndFrameAllocatedBytes = AllocatedBytes;
+		EndFrameHandedOutBlocks = HandedOutBlocks;
+
+		const bool bAlive = bThreadAlive.load(std::memory_order_acquire);
+		if (bAlive)
+		{
+			LastFrameBytes.store(FrameBytes, std::memory_order_relaxed);
+			PeakFrameBytes.store(FMath::Max(PeakFrameBytes.load(std::memory_order_relaxed), FrameBytes), std::memory_order_relaxed);
+			PeakArenaBytes.store(FMath::Max(PeakArenaBytes.load(std::memory_order_relaxed), GetStats().ArenaBytes), std::memory_order_relaxed);
+		}
+
+		const int32 NumBlocksToKeep = bAlive ? FMath::Min(FrameBlocks, GetMaxArenaBlocks()) : 0;
+		if (bAlive)
+		{
+			LocalBlocksToKeep.store(NumBlocksToKeep, std::memory_order_relaxed);
+		}
+		TrimReturnedBlocks(FMath::Max(NumBlocksToKeep - PublishedNumLocalBlocks.load(std::memory_order_relaxed), 0));
+	}
+
+	FSceneRenderingBlockArenaAllocator::FThreadStats GetStats() const
+	{
+		// The counters are updated independently, so while other threads allocate or release the result is only approximate
+		const uint64 Freed = NumFreedBlocks.load(std::memory_order_relaxed);
+		const uint64 Returned = NumReturnedBlocks.load(std::memory_order_relaxed);
+		const uint64 HandedOut = NumHandedOutBlocks.load(std::memory_order_relaxed);
+		const uint64 Mallocs = NumMallocBlocks.load(std::memory_order_relaxed);
+
+		FSceneRenderingBlockArenaAllocator::FThreadStats Stats;
+		Stats.LastFrameBytes = LastFrameBytes.load(std::memory_order_relaxed);
+		Stats.PeakFrameBytes = PeakFrameBytes.load(std::memory_order_relaxed);
+		Stats.ArenaBytes = FMath::Max<int64>(int64(Mallocs + Returned) - int64(HandedOut + Freed), 0) * BlockSize;
+		Stats.PeakArenaBytes = FMath::Max(PeakArenaBytes.load(std::memory_order_relaxed), Stats.ArenaBytes);
+		Stats.NumOutstandingBlocks = int64(HandedOut) - int64(Returned);
+		Stats.NumMallocBlocks = Mallocs;
+		Stats.bThreadAlive = bThreadAlive.load(std::memory_order_relaxed);
+		return Stats;
+	}
+};
+
+class FThreadArenaRegistry
+{
+	FCriticalSection Mutex;
+	TArray<FThreadArena*> Arenas;
+
+public:
+	static FThreadArenaRegistry& Get()
+	{
+		static FThreadArenaRegistry Registry;
+		return Registry;
+	}
+
+	FThreadArena* Register()
+	{
+		FScopeLock Lock(&Mutex);
+
+		FThreadArena* Arena = nullptr;
+		for (FThreadArena* Entry : Arenas)
+		{
+			if (!Entry->bThreadAlive.load(std::memory_order_acquire))
+			{
+				Arena = Entry;
+				break;
+			}
+		}
+
+		if (Arena == nullptr)
+		{
+			Arena = Arenas.Add_GetRef(new FThreadArena);
+		}
+
+		Arena->Acquire();
+		return Arena;
+	}
+
+	template<typename FunctionType>
+	void ForEach(FunctionType&& Function)
+	{
+		FScopeLock Lock(&Mutex);
+		for (FThreadArena* Arena : Arenas)
+		{
+			Function(*Arena);
+		}
+	}
+};
+
+static FThreadArena& GetThreadArena()
+{
+	struct FThreadArenaHandle
+	{
+		FThreadArena* Arena = FThreadArenaRegistry::Get().Register();
+
+		~FThreadArenaHandle()
+		{
+			Arena->Release();
+		}
+	};
+
+	static thread_local FThreadArenaHandle Handle;
+	return *Handle.Arena;
+}
+
+} // namespace UE::SceneRenderingAllocator::Private
+
+void InitSceneRenderingAllocator()
+{
+	FCoreDelegates::OnEndFrameRT.AddStatic(&FSceneRenderingBlockArenaAllocator::EndFrame);
+}
+
+void* FSceneRenderingBlockArenaAllocator::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	using namespace UE::SceneRenderingAllocator::Private;
+
+	if (Size == BlockSize)
+	{
+		return GetThreadArena().AllocBlock(Alignment);
+	}
+
+	GetThreadArena().AddOversizedBytes(Size);
+
+	LLM_SCOPE_BYTAG(SceneRenderingAllocator);
+	return FMemory::Malloc(Size, Alignment);
+}
+
+void FSceneRenderingBlockArenaAllocator::Free(void* Pointer, SIZE_T Size)
+{
+	using namespace UE::SceneRenderingAllocator::Private;
+
+	if (Size == BlockSize)
+	{
+		FBlockTrailer* Trailer = GetTrailer(Pointer);
+		if (Trailer->Owner)
+		{
+			Trailer->Owner->ReturnBlock(Trailer);
+		}
+		else
+		{
+			FMemory::Free(Pointer);
+		}
+	}
+	else
+	{
+		FMemory::Free(Pointer);
+	}
+}
+
+void FSceneRenderingBlockArenaAllocator::EndFrame()
+{
+	using namespace UE::SceneRenderingAllocator::Private;
+
+	uint64 FrameBytes = 0;
+	uint64 ArenaBytes = 0;
+	uint64 PeakArenaBytes = 0;
+	FThreadArenaRegistry::Get().ForEach([&FrameBytes, &ArenaBytes, &PeakArenaBytes](FThreadArena& Arena)
+	{
+		// Trimmed here rather than by the owning thread so that the arenas of threads that went idle or exited give their blocks back too
+		Arena.EndFrame();
+
+		const FThreadStats Stats = Arena.GetStats();
+		if (Stats.bThreadAlive)
+		{
+			FrameBytes += Stats.LastFrameBytes;
+			PeakArenaBytes += Stats.PeakArenaBytes;
+		}
+		ArenaBytes += Stats.ArenaBytes;
+	});
+
+	TRACE_COUNTER_SET(SceneRenderingAllocator_FrameBytes, FrameBytes);
+	TRACE_COUNTER_SET(SceneRenderingAllocator_ArenaBytes, ArenaBytes);
+	TRACE_COUNTER_SET(SceneRenderingAllocator_PeakArenaBytes, PeakArenaBytes);
+}
+
+bool FSceneRenderingBlockArenaAllocator::GetThreadStats(uint32 ThreadId, FThreadStats& OutStats)
+{
+	using namespace UE::SceneRenderingAllocator::Private;
+
+	bool bFound = false;
+	FThreadArenaRegistry::Get().ForEach([ThreadId, &OutStats, &bFound](const FThreadArena& Arena)
+	{
+		if (!bFound && Arena.ThreadId == ThreadId)
+		{
+			OutStats = Arena.GetStats();
+			bFound = true;
+		}
+	});
+	return bFound;
+}
+
+void FSceneRenderingBlockArenaAllocator::DumpStats(FOutputDevice& Ar)
+{
+	using namespace UE::SceneRenderingAllocator::Private;
+
+	Ar.Logf(TEXT("SceneRenderingAllocator thread arenas (%s):"), GSceneRenderingAllocatorThreadArena ? TEXT("enabled") : TEXT("disabled"));
+	Ar.Logf(TEXT("%-32s %16s %16s %16s %16s"), TEXT("Thread"), TEXT("LastFrameKB"), TEXT("PeakFrameKB"), TEXT("ArenaKB"), TEXT("PeakArenaKB"));
+
+	uint64 TotalLastFrameBytes = 0;
+	uint64 TotalArenaBytes = 0;
+	uint64 TotalPeakArenaBytes = 0;
+	FThreadArenaRegistry::Get().ForEach([&Ar, &TotalLastFrameBytes, &TotalArenaBytes, &TotalPeakArenaBytes](const FThreadArena& Arena)
+	{
+		const FThreadStats Stats = Arena.GetStats();
+		if (!Stats.bThreadAlive)
+		{
+			return;
+		}
+
+		TotalLastFrameBytes += Stats.LastFrameBytes;
+		TotalArenaBytes += Stats.ArenaBytes;
+		TotalPeakArenaBytes += Stats.PeakArenaBytes;
+
+		FString ThreadName = FThreadManager::GetThreadName(Arena.ThreadId);
+		if (ThreadName.IsEmpty())
+		{
+			ThreadName = FString::Printf(TEXT("Thread %u"), Arena.ThreadId);
+		}
+
+		Ar.Logf(TEXT("%-32s %16") UINT64_FMT TEXT(" %16") UINT64_FMT TEXT(" %16") UINT64_FMT TEXT(" %16") UINT64_FMT, *ThreadName,
+			Stats.LastFrameBytes / 1024, Stats.PeakFrameBytes / 1024, Stats.ArenaBytes / 1024, Stats.PeakArenaBytes / 1024);
+	});
+
+	Ar.Logf(TEXT("%-32s %16") UINT64_FMT TEXT(" %16s %16") UINT64_FMT TEXT(" %16") UINT64_FMT, TEXT("Total"), TotalLastFrameBytes / 1024, TEXT(""), TotalArenaBytes / 1024, TotalPeakArenaBytes / 1024);
+}
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/Thread.h"
+#include "RendererInterface.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneRenderingAllocatorCrossThreadFreeTest, "System.Renderer.SceneRenderingAllocator.CrossThreadFree", \
+	EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ClientContext | \
+	EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext)
+
+bool FSceneRenderingAllocatorCrossThreadFreeTest::RunTest(const FString& Parameters)
+{
+	using FAllocator = FSceneRenderingBlockArenaAllocator;
+
+	IConsoleVariable* ThreadArenaCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.SceneRenderingAllocator.ThreadArena"));
+	if (!TestNotNull(TEXT("r.SceneRenderingAllocator.ThreadArena exists"), ThreadArenaCVar))
+	{
+		return false;
+	}
+	const int32 PreviousThreadArena = ThreadArenaCVar->GetInt();
+	ThreadArenaCVar->Set(1, ECVF_SetByCode);
+
+	const int32 NumBlocks = 8;
+	TArray<void*> Blocks;
+	TArray<void*> ReusedBlocks;
+	FAllocator::FThreadStats StatsAfterAlloc;
+	FAllocator::FThreadStats StatsAfterReuse;
+	FAllocator::FThreadStats StatsAfterRelease;
+	uint32 OwnerThreadId = 0;
+	FEventRef Allocated;
+	FEventRef Released;
+
+	// The owner thread allocates blocks that this thread releases, then allocates again and must get the same blocks back
+	FThread OwnerThread(TEXT("SceneRenderingAllocatorTest"), [&]
+	{
+		OwnerThreadId = FPlatformTLS::GetCurrentThreadId();
+		for (int32 Index = 0; Index < NumBlocks; ++Index)
+		{
+			Blocks.Add(FAllocator::Malloc(FAllocator::BlockSize, FAllocator::BlockSize));
+		}
+		FAllocator::GetThreadStats(OwnerThreadId, StatsAfterAlloc);
+		Allocated->Trigger();
+
+		Released->Wait();
+		for (int32 Index = 0; Index < NumBlocks; ++Index)
+		{
+			ReusedBlocks.Add(FAllocator::Malloc(FAllocator::BlockSize, FAllocator::BlockSize));
+		}
+		FAllocator::GetThreadStats(OwnerThreadId, StatsAfterReuse);
+
+		for (void* Block : ReusedBlocks)
+		{
+			FAllocator::Free(Block, FAllocator::BlockSize);
+		}
+		FAllocator::GetThreadStats(OwnerThreadId, StatsAfterRelease);
+	});
+
+	Allocated->Wait();
+	for (void* Block : Blocks)
+	{
+		FAllocator::Free(Block, FAllocator::BlockSize);
+	}
+	Released->Trigger();
+
+	// Joining waits for the thread to exit, which gives its arena back
+	OwnerThread.Join();
+
+	FAllocator::FThreadStats StatsAfterExit;
+	const bool bFoundAfterExit = FAllocator::GetThreadStats(OwnerThreadId, StatsAfterExit);
+
+	ThreadArenaCVar->Set(PreviousThreadArena, ECVF_SetByCode);
+
+	TestEqual(TEXT("All blocks are outstanding after the first allocation"), StatsAfterAlloc.NumOutstandingBlocks, int64(NumBlocks));
+
+	int32 NumReused = 0;
+	for (void* Block : ReusedBlocks)
+	{
+		NumReused += Blocks.Contains(Block) ? 1 : 0;
+	}
+	TestEqual(TEXT("Blocks released by another thread are reused by the thread that allocated them"), NumReused, NumBlocks);
+	TestEqual(TEXT("Reusing the blocks allocates nothing"), StatsAfterReuse.NumMallocBlocks, StatsAfterAlloc.NumMallocBlocks);
+
+	TestEqual(TEXT("No block is outstanding once all are released"), StatsAfterRelease.NumOutstandingBlocks, int64(0));
+
+	// The arena may have been reused by a new thread in the meantime, in which case it no longer has this thread id
+	if (bFoundAfterExit)
+	{
+		TestFalse(TEXT("The arena is released when its thread exits"), StatsAfterExit.bThreadAlive);
+		TestEqual(TEXT("The arena of an exited thread keeps no blocks"), StatsAfterExit.ArenaBytes, uint64(0));
+		TestEqual(TEXT("The arena of an exited thread has no outstanding blocks"), StatsAfterExit.NumOutstandingBlocks, int64(0));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
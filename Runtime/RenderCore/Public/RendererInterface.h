@@ -52,6 +52,45 @@ namespace Nanite
 
 class FRHITransientTexture;
 
+/**
+ * Block allocator behind the scene rendering allocator, which bump allocates frame data out of its blocks. Every thread has a small arena
+ * of blocks that it hands out again without going through FMalloc, so frame data keeps reusing already committed pages. Each block ends
+ * with a small trailer naming the arena that handed it out, and a released block is pushed on a lock-free list of that arena whichever
+ * thread releases it. EndFrame trims every arena back to what its thread needed during the frame (r.SceneRenderingAllocator.ThreadArena).
+ */
+struct FSceneRenderingBlockArenaAllocator
+{
+	static constexpr uint32 BlockSize = FPageAllocator::PageSize;
+	static constexpr bool SupportsAlignment = true;
+	static constexpr bool UsesFMalloc       = true;
+	static constexpr uint32 MaxAlignment	= UE_MBC_MAX_SMALL_POOL_ALIGNMENT;
+
+	static RENDERCORE_API void* Malloc(SIZE_T Size, uint32 Alignment);
+	static RENDERCORE_API void Free(void* Pointer, SIZE_T Size);
+
+	/** Publishes the stats of the frame and trims all thread arenas, including the ones of threads that are idle. */
+	static RENDERCORE_API void EndFrame();
+
+	/** Prints the per thread bytes of the last frame and the current and peak arena sizes. */
+	static RENDERCORE_API void DumpStats(FOutputDevice& Ar);
+
+	struct FThreadStats
+	{
+		uint64 LastFrameBytes = 0;
+		uint64 PeakFrameBytes = 0;
+		uint64 ArenaBytes = 0;
+		uint64 PeakArenaBytes = 0;
+		/** Blocks handed out by the arena and not released yet, by any thread */
+		int64 NumOutstandingBlocks = 0;
+		/** Blocks the arena had to allocate because it had none cached */
+		uint64 NumMallocBlocks = 0;
+		bool bThreadAlive = false;
+	};
+
+	/** Gets the stats of the arena of the thread ThreadId, which may have exited since. Returns false if that thread never had an arena. */
+	static RENDERCORE_API bool GetThreadStats(uint32 ThreadId, FThreadStats& OutStats);
+};
+
 struct FSceneRenderingBlockAllocationTag
 {
 	static constexpr uint32 BlockSize = 64 * 1024;		// Blocksize used to allocate from
@@ -60,7 +99,7 @@ struct FSceneRenderingBlockAllocationTag
 	static constexpr bool InlineBlockAllocation = false;  // Inline or Noinline the BlockAllocation which can have an impact on Performance
 	static constexpr const char* TagName = "SceneRenderingAllocator";
 
-	using Allocator = TBlockAllocationLockFreeCache<BlockSize, FAlignedAllocator>;
+	using Allocator = FSceneRenderingBlockArenaAllocator;
 };
 
 using FSceneRenderingBulkObjectAllocator = TConcurrentLinearBulkObjectAllocator<FSceneRenderingBlockAllocationTag>;
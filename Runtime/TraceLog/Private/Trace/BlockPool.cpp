@@ -200,6 +200,9 @@ FWriteBuffer* Writer_AllocateBlockFromPool()
 
 	if (StallStart)
 	{
+#if TRACE_PRIVATE_STATISTICS
+		AtomicAddRelaxed(&GTraceStatistics.BlocksBlocked, uint64(1));
+#endif
 		const uint64 StallEnd = TimeGetRelativeTimestamp();
 		LogStall(StallStart, StallEnd);
 	}
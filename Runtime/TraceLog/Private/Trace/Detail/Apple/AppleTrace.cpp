@@ -5,6 +5,7 @@
 #if TRACE_PRIVATE_MINIMAL_ENABLED && PLATFORM_APPLE
 
 #include <arpa/inet.h>
+#include <dispatch/dispatch.h>
 #include <string.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -57,6 +58,33 @@ void ThreadDestroy(UPTRINT Handle)
 	// no-op
 }
 
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SemaphoreCreate()
+{
+	// Unnamed POSIX semaphores are not supported on Apple platforms
+	return UPTRINT(dispatch_semaphore_create(0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreWait(UPTRINT Handle)
+{
+	dispatch_semaphore_wait((dispatch_semaphore_t)Handle, DISPATCH_TIME_FOREVER);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreRelease(UPTRINT Handle, uint32 Count)
+{
+	for (; Count > 0; --Count)
+	{
+		dispatch_semaphore_signal((dispatch_semaphore_t)Handle);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreDestroy(UPTRINT Handle)
+{
+	dispatch_release((dispatch_semaphore_t)Handle);
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -256,6 +284,51 @@ UPTRINT FileOpen(const ANSICHAR* Path)
 	return UPTRINT(Out + 1);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT FileMapOpen(const ANSICHAR* Path)
+{
+	int Flags = O_CREAT|O_RDWR|O_TRUNC;
+	int Mode = S_IRUSR|S_IWUSR|S_IRGRP|S_IWGRP|S_IROTH|S_IWOTH;
+
+	int Out = open(Path, Flags, Mode);
+	if (Out < 0)
+	{
+		return 0;
+	}
+
+	return UPTRINT(Out + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FileMapReserve(UPTRINT Handle, uint64 Size)
+{
+	int Inner = int(Handle) - 1;
+	return ftruncate(Inner, off_t(Size)) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* FileMapView(UPTRINT Handle, uint64 Offset, uint32 Size)
+{
+	int Inner = int(Handle) - 1;
+	void* View = mmap(nullptr, Size, PROT_READ|PROT_WRITE, MAP_SHARED, Inner, off_t(Offset));
+	return (View != MAP_FAILED) ? View : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileMapUnview(void* View, uint32 Size)
+{
+	munmap(View, Size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileMapClose(UPTRINT Handle, uint64 Size)
+{
+	int Inner = int(Handle) - 1;
+	// Trim the reserved space that was never written to
+	[[maybe_unused]] int Result = ftruncate(Inner, off_t(Size));
+	close(Inner);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int32 GetLastErrorCode()
 {
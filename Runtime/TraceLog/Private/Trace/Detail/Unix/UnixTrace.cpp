@@ -9,6 +9,7 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <pthread.h>
+#include <semaphore.h>
 #include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -22,6 +23,10 @@ namespace UE {
 namespace Trace {
 namespace Private {
 
+////////////////////////////////////////////////////////////////////////////////
+void*	Writer_MemoryAllocate(SIZE_T, uint32);
+void	Writer_MemoryFree(void*, uint32);
+
 ////////////////////////////////////////////////////////////////////////////////
 UPTRINT ThreadCreate(const ANSICHAR* Name, void (*Entry)())
 {
@@ -57,6 +62,41 @@ void ThreadDestroy(UPTRINT Handle)
 	// no-op
 }
 
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SemaphoreCreate()
+{
+	auto* Semaphore = (sem_t*)Writer_MemoryAllocate(sizeof(sem_t), alignof(sem_t));
+	if (sem_init(Semaphore, 0, 0) != 0)
+	{
+		Writer_MemoryFree(Semaphore, sizeof(sem_t));
+		return 0;
+	}
+	return UPTRINT(Semaphore);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreWait(UPTRINT Handle)
+{
+	while (sem_wait((sem_t*)Handle) != 0 && errno == EINTR)
+	{
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreRelease(UPTRINT Handle, uint32 Count)
+{
+	for (; Count > 0; --Count)
+	{
+		sem_post((sem_t*)Handle);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreDestroy(UPTRINT Handle)
+{
+	sem_destroy((sem_t*)Handle);
+	Writer_MemoryFree((void*)Handle, sizeof(sem_t));
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -255,6 +295,59 @@ UPTRINT FileOpen(const ANSICHAR* Path)
 	return UPTRINT(Out + 1);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT FileMapOpen(const ANSICHAR* Path)
+{
+	int Flags = O_CREAT|O_RDWR|O_TRUNC;
+	int Mode = S_IRUSR|S_IWUSR|S_IRGRP|S_IWGRP|S_IROTH|S_IWOTH;
+
+	int Out = open(Path, Flags, Mode);
+	if (Out < 0)
+	{
+		return 0;
+	}
+
+	return UPTRINT(Out + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FileMapReserve(UPTRINT Handle, uint64 Size)
+{
+	int Inner = int(Handle) - 1;
+	// Allocate the blocks up front. Writing to a sparse page of a shared
+	// mapping when the disk is full raises SIGBUS instead of failing.
+	int Result = posix_fallocate(Inner, 0, off_t(Size));
+	if (Result != 0)
+	{
+		errno = Result;
+		return false;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* FileMapView(UPTRINT Handle, uint64 Offset, uint32 Size)
+{
+	int Inner = int(Handle) - 1;
+	void* View = mmap(nullptr, Size, PROT_READ|PROT_WRITE, MAP_SHARED, Inner, off_t(Offset));
+	return (View != MAP_FAILED) ? View : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileMapUnview(void* View, uint32 Size)
+{
+	munmap(View, Size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileMapClose(UPTRINT Handle, uint64 Size)
+{
+	int Inner = int(Handle) - 1;
+	// Trim the reserved space that was never written to
+	[[maybe_unused]] int Result = ftruncate(Inner, off_t(Size));
+	close(Inner);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int32 GetLastErrorCode()
 {
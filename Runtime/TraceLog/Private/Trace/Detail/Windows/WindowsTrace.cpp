@@ -63,6 +63,30 @@ void ThreadDestroy(UPTRINT Handle)
 	CloseHandle(HANDLE(Handle));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT SemaphoreCreate()
+{
+	HANDLE Handle = CreateSemaphoreW(nullptr, 0, MAXLONG, nullptr);
+	return UPTRINT(Handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreWait(UPTRINT Handle)
+{
+	WaitForSingleObject(HANDLE(Handle), INFINITE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreRelease(UPTRINT Handle, uint32 Count)
+{
+	ReleaseSemaphore(HANDLE(Handle), LONG(Count), nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SemaphoreDestroy(UPTRINT Handle)
+{
+	CloseHandle(HANDLE(Handle));
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -283,6 +307,73 @@ UPTRINT FileOpen(const ANSICHAR* Path)
 	return UPTRINT(Out) + 1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+UPTRINT FileMapOpen(const ANSICHAR* Path)
+{
+	// Mapping a view for writing requires read access too
+	DWORD Access = GENERIC_READ|GENERIC_WRITE;
+	DWORD Share = FILE_SHARE_READ;
+	DWORD Disposition = CREATE_ALWAYS;
+	DWORD Flags = FILE_ATTRIBUTE_NORMAL;
+	HANDLE Out = CreateFileA(Path, Access, Share, nullptr, Disposition, Flags, nullptr);
+	if (Out == INVALID_HANDLE_VALUE)
+	{
+		return 0;
+	}
+
+	return UPTRINT(Out) + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FileMapReserve(UPTRINT Handle, uint64 Size)
+{
+	HANDLE Inner = HANDLE(Handle - 1);
+
+	LARGE_INTEGER Position;
+	Position.QuadPart = LONGLONG(Size);
+	if (!SetFilePointerEx(Inner, Position, nullptr, FILE_BEGIN))
+	{
+		return false;
+	}
+
+	return SetEndOfFile(Inner) != FALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* FileMapView(UPTRINT Handle, uint64 Offset, uint32 Size)
+{
+	HANDLE Inner = HANDLE(Handle - 1);
+
+	const uint64 MappingSize = Offset + Size;
+	HANDLE Mapping = CreateFileMappingA(Inner, nullptr, PAGE_READWRITE, DWORD(MappingSize >> 32), DWORD(MappingSize), nullptr);
+	if (Mapping == nullptr)
+	{
+		return nullptr;
+	}
+
+	// The view keeps the mapping object alive
+	void* View = MapViewOfFile(Mapping, FILE_MAP_WRITE, DWORD(Offset >> 32), DWORD(Offset), Size);
+	FSetLastErrorScope _(GetLastError());
+	CloseHandle(Mapping);
+	return View;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileMapUnview(void* View, uint32)
+{
+	UnmapViewOfFile(View);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileMapClose(UPTRINT Handle, uint64 Size)
+{
+	// Trim the reserved space that was never written to
+	FileMapReserve(Handle, Size);
+
+	HANDLE Inner = HANDLE(Handle - 1);
+	CloseHandle(Inner);
+}
+
 	
 ////////////////////////////////////////////////////////////////////////////////
 int32 GetLastErrorCode()
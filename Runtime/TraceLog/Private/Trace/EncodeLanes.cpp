@@ -0,0 +1,291 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Platform.h"
+#include "Trace/Config.h"
+
+#if TRACE_PRIVATE_MINIMAL_ENABLED
+
+#include "Trace/Detail/Atomic.h"
+#include "Trace/Detail/Transport.h"
+
+namespace UE {
+namespace Trace {
+namespace Private {
+
+// This here to aid future maintenance of a trace's transport packets.
+static_assert(ETransport::Active == ETransport::TidPacketSync, "Encode lanes are transport aware");
+
+////////////////////////////////////////////////////////////////////////////////
+int32		EncodeNoInstr(const void*, int32, void*, int32);
+void*		Writer_MemoryAllocate(SIZE_T, uint32);
+void		Writer_MemoryFree(void*, uint32);
+void		Writer_TailAppend(uint32, uint8* __restrict, uint32);
+void		Writer_TailAppendEncoded(const FTidPacketEncoded*);
+extern FStatistics GTraceStatistics;
+
+/*
+ * Encode lanes take the LZ4 encoding of drained blocks off the worker thread.
+ * Writer_DrainBuffers() collects the blocks it drains into a batch instead of
+ * sending them one at a time. Flushing the batch publishes it to the lane
+ * threads and the worker thread, which claim and encode blocks until there are
+ * none left. Once every block is encoded the worker thread sends the packets
+ * in the order the blocks were drained, so the order of each thread's events
+ * is unchanged.
+ *
+ * Lanes sleep on a semaphore that the worker thread releases once per lane
+ * when it publishes a batch. As the worker thread encodes too, a lane that is
+ * late to a batch costs nothing but the help it would have provided; it finds
+ * no items left to claim and goes back to sleep.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+struct FEncodeItem
+{
+	uint8*	Data;
+	uint32	ThreadId;
+	uint32	Size;
+};
+
+// Buffer size is expressed as "A + B" where A is a maximum expected input size
+// (i.e. at least GPoolBlockSize) and B is LZ4 overhead as per LZ4_COMPRESSBOUND.
+typedef TTidPacketEncoded<UE_TRACE_BLOCK_SIZE + 64> FEncodedPacket;
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+#define T_ALIGN alignas(PLATFORM_CACHE_LINE_SIZE)
+static const uint32				GEncodeMinSize		= 385; // smaller blocks are sent raw
+static const uint32				GMaxEncodeItems		= 256;
+static const uint32				GMaxEncodeLanes		= 32;
+static FEncodeItem*				GEncodeItems;		// = nullptr
+static FEncodedPacket*			GEncodedPackets;	// = nullptr
+static uint32					GEncodeNumItems;	// = 0
+static UPTRINT					GEncodeLaneThreads[GMaxEncodeLanes];
+static uint32					GEncodeNumLanes;	// = 0
+static UPTRINT					GEncodeWake;		// = 0; semaphore lanes wait on for a batch
+T_ALIGN static volatile uint32	GEncodeBatch;		// = 0; batch serial << 16 | number of items
+T_ALIGN static volatile uint32	GEncodeClaim;		// = 0; batch serial << 16 | next item to claim
+T_ALIGN static volatile uint32	GEncodeDone;		// = 0
+T_ALIGN static volatile bool	GEncodeLanesQuit;	// = false
+#undef T_ALIGN
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_EncodeItem(uint32 Index)
+{
+	const FEncodeItem& Item = GEncodeItems[Index];
+	FEncodedPacket& Packet = GEncodedPackets[Index];
+
+	Packet.ThreadId = FTidPacketBase::EncodedMarker;
+	Packet.ThreadId |= uint16(Item.ThreadId & FTidPacketBase::ThreadIdMask);
+#if UE_TRACE_PACKET_VERIFICATION
+	Packet.ThreadId |= FTidPacketBase::Verification;
+#endif
+	Packet.DecodedSize = uint16(Item.Size);
+	Packet.PacketSize = uint16(EncodeNoInstr(Item.Data, Item.Size, Packet.Data, sizeof(Packet.Data)));
+	Packet.PacketSize += sizeof(FTidPacketEncoded);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static uint32 Writer_EncodeBatch(uint32 Batch)
+{
+	// Claiming is a CAS on the batch serial and item index together so that a
+	// thread which read the previous batch can not claim items of this one.
+	const uint32 Serial = Batch & 0xffff'0000;
+	const uint32 NumItems = Batch & 0xffff;
+	uint32 NumEncoded = 0;
+	while (true)
+	{
+		uint32 Claim = AtomicLoadRelaxed(&GEncodeClaim);
+		if ((Claim & 0xffff'0000) != Serial || (Claim & 0xffff) >= NumItems)
+		{
+			break;
+		}
+
+		if (!AtomicCompareExchangeAcquire(&GEncodeClaim, Claim + 1, Claim))
+		{
+			continue;
+		}
+
+		const uint32 Index = Claim & 0xffff;
+		if (GEncodeItems[Index].Size >= GEncodeMinSize)
+		{
+			Writer_EncodeItem(Index);
+			++NumEncoded;
+		}
+
+		AtomicAddRelease(&GEncodeDone, 1u);
+	}
+
+	return NumEncoded;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void Writer_EncodeLaneThread()
+{
+	ThreadRegister(TEXT("TraceEncode"), 0, INT_MAX);
+
+	uint32 LastBatch = 0;
+	while (!AtomicLoadRelaxed(&GEncodeLanesQuit))
+	{
+		uint32 Batch = AtomicLoadAcquire(&GEncodeBatch);
+		if (Batch == LastBatch || (Batch & 0xffff) == 0)
+		{
+#if TRACE_PRIVATE_HAS_SEMAPHORE
+			SemaphoreWait(GEncodeWake);
+#else
+			ThreadSleep(1);
+#endif
+			continue;
+		}
+
+		LastBatch = Batch;
+		if (uint32 NumEncoded = Writer_EncodeBatch(Batch))
+		{
+#if TRACE_PRIVATE_STATISTICS
+			AtomicAddRelaxed(&GTraceStatistics.BlocksEncodedOnLanes, uint64(NumEncoded));
+#endif
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Writer_EncodeLanesFlush()
+{
+	const uint32 NumItems = GEncodeNumItems;
+	if (NumItems == 0)
+	{
+		return;
+	}
+
+	FProfilerScope _(__func__);
+
+	// Publish the batch
+	const uint32 Serial = (AtomicLoadRelaxed(&GEncodeBatch) + 0x1'0000) & 0xffff'0000;
+	AtomicStoreRelaxed(&GEncodeDone, 0u);
+	AtomicStoreRelaxed(&GEncodeClaim, Serial);
+	AtomicStoreRelease(&GEncodeBatch, Serial | NumItems);
+#if TRACE_PRIVATE_HAS_SEMAPHORE
+	SemaphoreRelease(GEncodeWake, GEncodeNumLanes);
+#endif
+
+	// Help out, then wait for the lanes to finish the blocks they claimed
+	Writer_EncodeBatch(Serial | NumItems);
+	while (AtomicLoadAcquire(&GEncodeDone) < NumItems)
+	{
+		PlatformYield();
+	}
+
+	for (uint32 Index = 0; Index < NumItems; ++Index)
+	{
+		FEncodeItem& Item = GEncodeItems[Index];
+		if (Item.Size < GEncodeMinSize)
+		{
+			Writer_TailAppend(Item.ThreadId, Item.Data, Item.Size);
+		}
+		else
+		{
+			Writer_TailAppendEncoded(&GEncodedPackets[Index]);
+		}
+	}
+
+	GEncodeNumItems = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Writer_EncodeLanesAppend(uint32 ThreadId, uint8* __restrict Data, uint32 Size)
+{
+	if (GEncodeNumLanes == 0)
+	{
+		return Writer_TailAppend(ThreadId, Data, Size);
+	}
+
+	GEncodeItems[GEncodeNumItems++] = { Data, ThreadId, Size };
+	if (GEncodeNumItems == GMaxEncodeItems)
+	{
+		Writer_EncodeLanesFlush();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Writer_InitializeEncodeLanes(uint32 NumLanes)
+{
+	if (GEncodeNumLanes != 0 || NumLanes == 0)
+	{
+		return;
+	}
+
+	NumLanes = (NumLanes < GMaxEncodeLanes) ? NumLanes : GMaxEncodeLanes;
+
+	const uint32 ItemsSize = sizeof(FEncodeItem) * GMaxEncodeItems;
+	const uint32 PacketsSize = sizeof(FEncodedPacket) * GMaxEncodeItems;
+	GEncodeItems = (FEncodeItem*)Writer_MemoryAllocate(ItemsSize, alignof(FEncodeItem));
+	GEncodedPackets = (FEncodedPacket*)Writer_MemoryAllocate(PacketsSize, PLATFORM_CACHE_LINE_SIZE);
+#if TRACE_PRIVATE_STATISTICS
+	AtomicAddRelaxed(&GTraceStatistics.FixedBufferAllocated, ItemsSize + PacketsSize);
+#endif
+
+#if TRACE_PRIVATE_HAS_SEMAPHORE
+	GEncodeWake = SemaphoreCreate();
+	if (!GEncodeWake)
+	{
+		return;
+	}
+#endif
+
+	AtomicStoreRelaxed(&GEncodeLanesQuit, false);
+	for (uint32 Index = 0; Index < NumLanes; ++Index)
+	{
+		UPTRINT Thread = ThreadCreate("TraceEncode", Writer_EncodeLaneThread);
+		if (!Thread)
+		{
+			break;
+		}
+
+		GEncodeLaneThreads[GEncodeNumLanes++] = Thread;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Writer_ShutdownEncodeLanes()
+{
+	if (GEncodeItems == nullptr)
+	{
+		return;
+	}
+
+	Writer_EncodeLanesFlush();
+
+	AtomicStoreRelaxed(&GEncodeLanesQuit, true);
+#if TRACE_PRIVATE_HAS_SEMAPHORE
+	SemaphoreRelease(GEncodeWake, GEncodeNumLanes);
+#endif
+	for (uint32 Index = 0; Index < GEncodeNumLanes; ++Index)
+	{
+		ThreadJoin(GEncodeLaneThreads[Index]);
+		ThreadDestroy(GEncodeLaneThreads[Index]);
+	}
+	GEncodeNumLanes = 0;
+#if TRACE_PRIVATE_HAS_SEMAPHORE
+	if (GEncodeWake)
+	{
+		SemaphoreDestroy(GEncodeWake);
+		GEncodeWake = 0;
+	}
+#endif
+
+	const uint32 ItemsSize = sizeof(FEncodeItem) * GMaxEncodeItems;
+	const uint32 PacketsSize = sizeof(FEncodedPacket) * GMaxEncodeItems;
+	Writer_MemoryFree(GEncodeItems, ItemsSize);
+	Writer_MemoryFree(GEncodedPackets, PacketsSize);
+#if TRACE_PRIVATE_STATISTICS
+	AtomicSubRelaxed(&GTraceStatistics.FixedBufferAllocated, ItemsSize + PacketsSize);
+#endif
+	GEncodeItems = nullptr;
+	GEncodedPackets = nullptr;
+}
+
+} // namespace Private
+} // namespace Trace
+} // namespace UE
+
+#endif // TRACE_PRIVATE_MINIMAL_ENABLED
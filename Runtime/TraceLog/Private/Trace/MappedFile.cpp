@@ -0,0 +1,223 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Message.h"
+#include "Platform.h"
+#include "Trace/Config.h"
+
+#if TRACE_PRIVATE_MINIMAL_ENABLED
+
+#include "Trace/Detail/Atomic.h"
+#include <string.h>
+
+namespace UE {
+namespace Trace {
+namespace Private {
+
+////////////////////////////////////////////////////////////////////////////////
+bool		Writer_RelayTo(UPTRINT, IoWriteFunc, IoCloseFunc, uint16);
+extern FStatistics GTraceStatistics;
+
+#if TRACE_PRIVATE_ALLOW_FILE && TRACE_PRIVATE_HAS_FILE_MAP
+
+/*
+ * A mapped file is written by copying packets into a view of the current
+ * segment of the file. When the view is full it is unmapped, leaving it to the
+ * OS to write the pages back, and the next segment is mapped. The worker thread
+ * thus never waits on a write and the pages of a trace that was cut short by a
+ * crash still reach the file.
+ *
+ * Space is reserved a segment at a time, before any packet is copied into it.
+ * When no more can be reserved, or MaxSize is reached, the file is considered
+ * full and the rest of the trace is dropped. This keeps the file a valid trace
+ * that ends on a whole packet, and the worker thread keeps draining blocks so
+ * producers do not stall on the block pool.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+struct FMappedFile
+{
+	UPTRINT	Handle;
+	uint8*	View;
+	uint64	ViewOffset;		// file offset of View
+	uint64	Reserved;		// bytes of the file that are allocated
+	uint64	MaxSize;		// zero when unlimited
+	uint32	SegmentSize;
+	uint32	Cursor;			// write offset in View
+	bool	bFull;
+};
+
+// TraceLog must be ready after value-init so that it can be used before
+// dynamic-init. Thus statically-scoped objects cannot have [con|des]tructors.
+static FMappedFile GMappedFile; // = {}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool MappedFile_Reserve(FMappedFile* File, uint64 End)
+{
+	if (End <= File->Reserved)
+	{
+		return true;
+	}
+
+	uint64 Reserve = ((End + File->SegmentSize - 1) / File->SegmentSize) * File->SegmentSize;
+	if (File->MaxSize && Reserve > File->MaxSize)
+	{
+		if (End > File->MaxSize)
+		{
+			UE_TRACE_MESSAGE_F(Display, "Mapped trace file reached its maximum size (%llu bytes), dropping the rest of the trace", (unsigned long long)File->MaxSize);
+			return false;
+		}
+		Reserve = File->MaxSize;
+	}
+
+	if (!FileMapReserve(File->Handle, Reserve))
+	{
+		UE_TRACE_ERRORMESSAGE_F(WriteError, GetLastErrorCode(), "Reserving %llu bytes of mapped trace file, dropping the rest of the trace", (unsigned long long)Reserve);
+		return false;
+	}
+
+	File->Reserved = Reserve;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool MappedFile_MapSegment(FMappedFile* File, uint64 Offset)
+{
+	uint64 Remaining = File->Reserved - Offset;
+	uint32 Size = (Remaining < File->SegmentSize) ? uint32(Remaining) : File->SegmentSize;
+
+	File->View = (uint8*)FileMapView(File->Handle, Offset, Size);
+	File->ViewOffset = Offset;
+	File->Cursor = 0;
+	return File->View != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static uint32 MappedFile_GetViewSize(const FMappedFile* File)
+{
+	uint64 Remaining = File->Reserved - File->ViewOffset;
+	return (Remaining < File->SegmentSize) ? uint32(Remaining) : File->SegmentSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool MappedFile_Write(UPTRINT Handle, const void* Data, uint32 Size)
+{
+	auto* File = (FMappedFile*)Handle;
+
+	if (!File->bFull)
+	{
+		// Reserve the whole packet up front so that it is never partially written.
+		File->bFull = !MappedFile_Reserve(File, File->ViewOffset + File->Cursor + Size);
+	}
+
+	if (File->bFull)
+	{
+#if TRACE_PRIVATE_STATISTICS
+		AtomicAddRelaxed(&GTraceStatistics.WritesDropped, uint64(1));
+#endif
+		return true;
+	}
+
+	const uint8* Cursor = (const uint8*)Data;
+	while (Size)
+	{
+		uint32 ViewSize = MappedFile_GetViewSize(File);
+		if (File->Cursor == ViewSize)
+		{
+			FileMapUnview(File->View, ViewSize);
+			if (!MappedFile_MapSegment(File, File->ViewOffset + ViewSize))
+			{
+				return false;
+			}
+			ViewSize = MappedFile_GetViewSize(File);
+		}
+
+		uint32 CopySize = ViewSize - File->Cursor;
+		CopySize = (CopySize < Size) ? CopySize : Size;
+		memcpy(File->View + File->Cursor, Cursor, CopySize);
+
+		File->Cursor += CopySize;
+		Cursor += CopySize;
+		Size -= CopySize;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void MappedFile_Close(UPTRINT Handle)
+{
+	auto* File = (FMappedFile*)Handle;
+
+	if (File->View != nullptr)
+	{
+		FileMapUnview(File->View, MappedFile_GetViewSize(File));
+	}
+
+	FileMapClose(File->Handle, File->ViewOffset + File->Cursor);
+
+	// Allow another mapped file to be written
+	AtomicStoreRelease(&File->Handle, UPTRINT(0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Writer_WriteToMapped(const ANSICHAR* Path, uint32 SegmentSize, uint64 MaxSize, uint16 Flags)
+{
+	// Only one mapped file can be written at a time. There is no one else
+	// opening one, so a load will do instead of a CAS.
+	if (AtomicLoadAcquire(&GMappedFile.Handle))
+	{
+		return false;
+	}
+
+	// Views have to start on a multiple of the allocation granularity
+	const uint32 Rounding = (1 << 20) - 1;
+	SegmentSize = (SegmentSize > Rounding) ? SegmentSize : Rounding;
+	SegmentSize = (SegmentSize + Rounding) & ~Rounding;
+
+	UPTRINT FileHandle = FileMapOpen(Path);
+	if (!FileHandle)
+	{
+		UE_TRACE_ERRORMESSAGE_F(FileOpenError, GetLastErrorCode(), "Opening file (%s)", Path);
+		return false;
+	}
+
+	FMappedFile& File = GMappedFile;
+	File = {};
+	File.SegmentSize = SegmentSize;
+	File.MaxSize = MaxSize;
+	File.Handle = FileHandle;
+	const uint64 InitialSize = (MaxSize && MaxSize < SegmentSize) ? MaxSize : SegmentSize;
+	if (!MappedFile_Reserve(&File, InitialSize) || !MappedFile_MapSegment(&File, 0))
+	{
+		UE_TRACE_ERRORMESSAGE_F(FileOpenError, GetLastErrorCode(), "Mapping file (%s)", Path);
+		FileMapClose(FileHandle, 0);
+		File = {};
+		return false;
+	}
+
+	if (!Writer_RelayTo(UPTRINT(&File), MappedFile_Write, MappedFile_Close, Flags))
+	{
+		FileMapUnview(File.View, MappedFile_GetViewSize(&File));
+		FileMapClose(FileHandle, 0);
+		File = {};
+		return false;
+	}
+
+	return true;
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////
+bool Writer_WriteToMapped(const ANSICHAR*, uint32, uint64, uint16)
+{
+	return false;
+}
+
+#endif // TRACE_PRIVATE_ALLOW_FILE && TRACE_PRIVATE_HAS_FILE_MAP
+
+} // namespace Private
+} // namespace Trace
+} // namespace UE
+
+#endif // TRACE_PRIVATE_MINIMAL_ENABLED
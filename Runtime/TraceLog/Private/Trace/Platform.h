@@ -17,6 +17,18 @@ void	ThreadSleep(uint32 Milliseconds);
 void	ThreadJoin(UPTRINT Handle);
 void	ThreadDestroy(UPTRINT Handle);
 
+////////////////////////////////////////////////////////////////////////////////
+#if !defined(TRACE_PRIVATE_HAS_SEMAPHORE)
+#	define	TRACE_PRIVATE_HAS_SEMAPHORE	(PLATFORM_WINDOWS || PLATFORM_UNIX || PLATFORM_APPLE || PLATFORM_ANDROID)
+#endif
+
+#if TRACE_PRIVATE_HAS_SEMAPHORE
+UPTRINT	SemaphoreCreate();
+void	SemaphoreWait(UPTRINT Handle);
+void	SemaphoreRelease(UPTRINT Handle, uint32 Count);
+void	SemaphoreDestroy(UPTRINT Handle);
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 uint64				TimeGetFrequency();
 /**
@@ -44,6 +56,19 @@ void	IoClose(UPTRINT Handle);
 
 ////////////////////////////////////////////////////////////////////////////////
 UPTRINT	FileOpen(const ANSICHAR* Path);
+
+////////////////////////////////////////////////////////////////////////////////
+#if !defined(TRACE_PRIVATE_HAS_FILE_MAP)
+#	define	TRACE_PRIVATE_HAS_FILE_MAP	(PLATFORM_WINDOWS || PLATFORM_UNIX || PLATFORM_APPLE || PLATFORM_ANDROID)
+#endif
+
+#if TRACE_PRIVATE_HAS_FILE_MAP
+UPTRINT	FileMapOpen(const ANSICHAR* Path);
+bool	FileMapReserve(UPTRINT Handle, uint64 Size);
+void*	FileMapView(UPTRINT Handle, uint64 Offset, uint32 Size);
+void	FileMapUnview(void* View, uint32 Size);
+void	FileMapClose(UPTRINT Handle, uint64 Size);
+#endif
 	
 ////////////////////////////////////////////////////////////////////////////////
 int32	GetLastErrorCode();
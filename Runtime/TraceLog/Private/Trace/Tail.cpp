@@ -273,6 +273,31 @@ void Writer_TailAppend(uint32 ThreadId, uint8* __restrict Data, uint32 Size)
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void Writer_TailAppendEncoded(const FTidPacketEncoded* Packet)
+{
+	// Same as Writer_TailAppend() for a packet that has already been encoded,
+	// by one of the encode lanes.
+	if (GPacketRing.IsActive())
+	{
+		if (uint32(Packet->PacketSize) > GPacketRing.GetSize())
+		{
+			GPacketRing.Reset();
+		}
+		else
+		{
+			auto* Dest = GPacketRing.Append<FTidPacketEncoded>(Packet->PacketSize - sizeof(FTidPacketEncoded));
+			::memcpy(Dest, Packet, Packet->PacketSize);
+		}
+	}
+
+	Writer_SendDataRaw(Packet, Packet->PacketSize);
+#if UE_TRACE_PACKET_VERIFICATION
+	const uint64 Serial = GPacketSerial++;
+	Writer_SendDataRaw(&Serial, sizeof(uint64));
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void Writer_TailOnConnect()
 {
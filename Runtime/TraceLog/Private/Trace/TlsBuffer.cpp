@@ -18,6 +18,8 @@ namespace Private {
 
 ////////////////////////////////////////////////////////////////////////////////
 void				Writer_TailAppend(uint32, uint8* __restrict, uint32);
+void				Writer_EncodeLanesAppend(uint32, uint8* __restrict, uint32);
+void				Writer_EncodeLanesFlush();
 FWriteBuffer*		Writer_AllocateBlockFromPool();
 uint32				Writer_GetThreadId();
 void				Writer_FreeBlockListToPool(FWriteBuffer*, FWriteBuffer*);
@@ -138,7 +140,7 @@ TRACELOG_API FWriteBuffer* Writer_NextBuffer()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-static bool Writer_DrainBuffer(uint32 ThreadId, FWriteBuffer* Buffer)
+static bool Writer_DrainBuffer(uint32 ThreadId, FWriteBuffer* Buffer, bool bUseEncodeLanes=false)
 {
 	uint8* Committed = AtomicLoadAcquire((uint8**)&Buffer->Committed);
 
@@ -149,7 +151,14 @@ static bool Writer_DrainBuffer(uint32 ThreadId, FWriteBuffer* Buffer)
 		GTraceStatistics.BytesTraced += SizeToReap;
 #endif
 
-		Writer_TailAppend(ThreadId, Buffer->Reaped, SizeToReap);
+		if (bUseEncodeLanes)
+		{
+			Writer_EncodeLanesAppend(ThreadId, Buffer->Reaped, SizeToReap);
+		}
+		else
+		{
+			Writer_TailAppend(ThreadId, Buffer->Reaped, SizeToReap);
+		}
 		Buffer->Reaped = Committed;
 	}
 
@@ -223,7 +232,7 @@ void Writer_DrainBuffers()
 					break;
 				}
 
-				if (Writer_DrainBuffer(ThreadId, Buffer))
+				if (Writer_DrainBuffer(ThreadId, Buffer, true))
 				{
 					break;
 				}
@@ -241,6 +250,10 @@ void Writer_DrainBuffers()
 		}
 	}
 
+	// Blocks collected for the encode lanes still point into the retirees, so
+	// they have to be sent before the retirees can be reused.
+	Writer_EncodeLanesFlush();
+
 	// Put the retirees we found back into the system again.
 	if (RetireList.Head != nullptr)
 	{
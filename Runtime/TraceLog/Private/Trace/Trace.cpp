@@ -26,6 +26,7 @@ void	Writer_Update();
 bool	Writer_SendTo(const ANSICHAR*, uint32, uint32);
 bool	Writer_WriteTo(const ANSICHAR*, uint32);
 bool	Writer_RelayTo(UPTRINT, IoWriteFunc, IoCloseFunc, uint16);
+bool	Writer_WriteToMapped(const ANSICHAR*, uint32, uint64, uint16);
 bool	Writer_WriteSnapshotTo(const ANSICHAR*);
 bool	Writer_SendSnapshotTo(const ANSICHAR*, uint32);
 bool	Writer_IsTracing();
@@ -125,6 +126,9 @@ void GetStatistics(FStatistics& Out)
 	Out.BytesEmitted = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.BytesEmitted);
 	Out.MemoryUsed = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.MemoryUsed);
 	Out.BlockPoolAllocated = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.BlockPoolAllocated);
+	Out.BlocksBlocked = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.BlocksBlocked);
+	Out.WritesDropped = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.WritesDropped);
+	Out.BlocksEncodedOnLanes = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.BlocksEncodedOnLanes);
 	Out.SharedBufferAllocated = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.SharedBufferAllocated);
 	Out.FixedBufferAllocated = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.FixedBufferAllocated);
 	Out.CacheAllocated = Private::AtomicLoadRelaxed(&Private::GTraceStatistics.CacheAllocated);
@@ -148,6 +152,14 @@ bool WriteTo(const TCHAR* InPath, uint16 Flags)
 	return Private::Writer_WriteTo(Path, Flags);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool WriteToMapped(const TCHAR* InPath, uint32 SegmentSize, uint64 MaxSize, uint16 Flags)
+{
+	char Path[512];
+	ToAnsiCheap(Path, InPath);
+	return Private::Writer_WriteToMapped(Path, SegmentSize, MaxSize, Flags);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool RelayTo(UPTRINT InHandle, IoWriteFunc WriteFunc, IoCloseFunc CloseFunc, uint16 Flags)
 {
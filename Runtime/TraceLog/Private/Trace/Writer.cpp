@@ -53,6 +53,8 @@ void			Writer_CallbackOnConnect();
 void			Writer_InitializePool();
 void			Writer_ShutdownPool();
 void			Writer_DrainBuffers();
+void			Writer_InitializeEncodeLanes(uint32);
+void			Writer_ShutdownEncodeLanes();
 void			Writer_DrainLocalBuffers();
 void			Writer_EndThreadBuffer();
 uint32			Writer_GetControlPort();
@@ -671,7 +673,7 @@ static bool Writer_UpdateConnection()
 	// Reject the pending connection if we've already got a connection
 	if (GDataHandle)
 	{
-		GWriterState.Close(PendingDataHandle);
+		PendingWriterState.Close(PendingDataHandle);
 		return false;
 	}
 
@@ -928,6 +930,7 @@ static void Writer_InternalShutdown()
 	}
 
 	Writer_WorkerJoin();
+	Writer_ShutdownEncodeLanes();
 
 	if (GDataHandle)
 	{
@@ -1007,6 +1010,8 @@ void Writer_Initialize(const FInitializeDesc& Desc)
 		GSleepTimeInMS = Desc.ThreadSleepTimeInMS;
 	}
 
+	Writer_InitializeEncodeLanes(Desc.EncodeLaneCount);
+
 	if (Desc.bUseWorkerThread)
 	{
 		Writer_WorkerCreate();
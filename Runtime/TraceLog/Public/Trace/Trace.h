@@ -148,6 +148,7 @@ struct FInitializeDesc
 	OnUpdateFunc*		OnUpdateFunc		= nullptr;
 	OnScopeBeginFunc*	OnScopeBeginFunc	= nullptr;
 	OnScopeEndFunc*		OnScopeEndFunc		= nullptr;
+	uint32				EncodeLaneCount		= 0; // threads that encode drained blocks alongside the worker thread, 0 to encode on the worker thread only
 };
 
 typedef uint32 FChannelId;
@@ -216,6 +217,9 @@ struct FStatistics
 	uint64	BytesEmitted			= 0;	// Bytes emitted but potentially not yet written
 	uint64	MemoryUsed				= 0;	// Memory allocated by TraceLog allocator functions
 	uint64	BlockPoolAllocated		= 0;	// Memory allocated for the (TLS) block pool.
+	uint64	BlocksBlocked			= 0;	// Block allocations that stalled on the block pool limit
+	uint64	WritesDropped			= 0;	// Writes to the output dropped because it was full
+	uint64	BlocksEncodedOnLanes	= 0;	// Blocks encoded by encode lane threads instead of the worker thread
 	uint32	SharedBufferAllocated	= 0;	// Memory allocated for shared buffers
 	uint32	FixedBufferAllocated	= 0;	// Memory allocated for fixed buffers (tail, send)
 	uint32	CacheAllocated			= 0;	// Total memory allocated in cache buffers
@@ -309,6 +313,20 @@ UE_TRACE_API bool	SendTo(const TCHAR* Host, uint32 Port=0, uint16 Flags=FSendFla
  */
 UE_TRACE_API bool	WriteTo(const TCHAR* Path, uint16 Flags=FSendFlags::None) UE_TRACE_IMPL(false);
 
+/**
+ * Setup TraceLog to output to a new or existing file that is written through memory mapped segments instead of
+ * file writes, to take effect next update. Space for the file is reserved a segment at a time. If MaxSize is
+ * reached or no more space can be reserved the rest of the trace is dropped instead of stalling the worker
+ * thread, see FStatistics::WritesDropped. Will fail if another pending output has been queued, if a mapped
+ * file is already being written or if the file location is not writeable.
+ * @param Path Target path
+ * @param SegmentSize Size of each mapped segment in bytes, rounded up to a multiple of 1MiB
+ * @param MaxSize Maximum size of the file in bytes, 0 for no limit
+ * @param Flags Options for the connection
+ * @return True if the file could be opened or created correctly, false otherwise
+ */
+UE_TRACE_API bool	WriteToMapped(const TCHAR* Path, uint32 SegmentSize=64 << 20, uint64 MaxSize=0, uint16 Flags=FSendFlags::None) UE_TRACE_IMPL(false);
+
 /**
  * Setup TraceLog to output to user defined callback, to take effect next update. Will fail if another pending
  * output has been queued.